@@ -23,10 +23,14 @@
 #define DATABASEHANDLER_H_
 
 #include "audiomanagertypes.h"
+#include "config.h"
 #include <map>
 #include <vector>
 #include <string>
+#ifndef WITH_DATABASE_MAP
 #include <sqlite3.h>
+#include <time.h>
+#endif
 
 namespace am
 {
@@ -46,6 +50,7 @@ class CAmRoutingTreeItem;
 
 /**
  * This class handles and abstracts the database
+ * With WITH_DATABASE_MAP the data is kept in an in-memory object model instead of sqlite (CAmDatabaseHandlerMap.cpp)
  */
 class CAmDatabaseHandler
 {
@@ -110,6 +115,7 @@ public:
     am_Error_e getListMainConnections(std::vector<am_MainConnection_s>& listMainConnections) const;
     am_Error_e getListDomains(std::vector<am_Domain_s>& listDomains) const;
     am_Error_e getListConnections(std::vector<am_Connection_s>& listConnections) const;
+    am_Error_e getListConnectionsReserved(std::vector<am_Connection_s>& listConnections) const;
     am_Error_e getListSinks(std::vector<am_Sink_s>& listSinks) const;
     am_Error_e getListSources(std::vector<am_Source_s>& lisSources) const;
     am_Error_e getListSourceClasses(std::vector<am_SourceClass_s>& listSourceClasses) const;
@@ -152,12 +158,96 @@ public:
     bool existSinkClass(const am_sinkClass_t sinkClassID) const;
     bool existSourceClass(const am_sourceClass_t sourceClassID) const;
     void registerObserver(CAmDatabaseObserver *iObserver);
+    void logStatementStatistics() const;
+    am_Error_e beginTransaction();
+    am_Error_e commitTransaction();
+    uint32_t getTopologyRevision() const;
+    uint32_t getConnectionRevision() const;
     bool sourceVisible(const am_sourceID_t sourceID) const;
     bool sinkVisible(const am_sinkID_t sinkID) const;
 
 private:
     am_timeSync_t calculateMainConnectionDelay(const am_mainConnectionID_t mainConnectionID) const; //!< calculates a new main connection delay
+#ifdef WITH_DATABASE_MAP
+    /**
+     * a domain in the object model, reserved domains were only peeked by name
+     */
+    struct am_DomainEntry_s
+    {
+        am_Domain_s domain; //!< the domain data
+        bool reserved; //!< true if the domain was peeked but not entered yet
+    };
+
+    /**
+     * a sink in the object model, reserved sinks were only peeked by name
+     */
+    struct am_SinkEntry_s
+    {
+        am_Sink_s sink; //!< the sink data
+        bool reserved; //!< true if the sink was peeked but not entered yet
+    };
+
+    /**
+     * a source in the object model, reserved sources were only peeked by name
+     */
+    struct am_SourceEntry_s
+    {
+        am_Source_s source; //!< the source data
+        bool reserved; //!< true if the source was peeked but not entered yet
+    };
+
+    /**
+     * a connection in the object model, reserved connections are not final yet
+     */
+    struct am_ConnectionEntry_s
+    {
+        am_Connection_s connection; //!< the connection data
+        bool reserved; //!< true until changeConnectionFinal was called
+    };
+
+    typedef std::map<am_domainID_t, am_DomainEntry_s> MapDomain; //!< domains indexed by ID
+    typedef std::map<am_sourceClass_t, am_SourceClass_s> MapSourceClass; //!< source classes indexed by ID
+    typedef std::map<am_sinkClass_t, am_SinkClass_s> MapSinkClass; //!< sink classes indexed by ID
+    typedef std::map<am_sinkID_t, am_SinkEntry_s> MapSink; //!< sinks indexed by ID
+    typedef std::map<am_sourceID_t, am_SourceEntry_s> MapSource; //!< sources indexed by ID
+    typedef std::map<am_gatewayID_t, am_Gateway_s> MapGateway; //!< gateways indexed by ID
+    typedef std::map<am_crossfaderID_t, am_Crossfader_s> MapCrossfader; //!< crossfaders indexed by ID
+    typedef std::map<am_connectionID_t, am_ConnectionEntry_s> MapConnection; //!< connections indexed by ID
+    typedef std::map<am_mainConnectionID_t, am_MainConnection_s> MapMainConnection; //!< main connections indexed by ID
+
+    MapDomain mMapDomain; //!< all domains
+    MapSourceClass mMapSourceClass; //!< all source classes
+    MapSinkClass mMapSinkClass; //!< all sink classes
+    MapSink mMapSink; //!< all sinks
+    MapSource mMapSource; //!< all sources
+    MapGateway mMapGateway; //!< all gateways
+    MapCrossfader mMapCrossfader; //!< all crossfaders
+    MapConnection mMapConnection; //!< all connections
+    MapMainConnection mMapMainConnection; //!< all main connections
+    std::vector<am_SystemProperty_s> mListSystemProperties; //!< the system properties
+    am_domainID_t mLastDomainID; //!< highest domainID ever assigned
+    am_sourceClass_t mLastSourceClassID; //!< highest sourceClassID ever assigned
+    am_sinkClass_t mLastSinkClassID; //!< highest sinkClassID ever assigned
+    am_sinkID_t mLastSinkID; //!< highest sinkID ever assigned
+    am_sourceID_t mLastSourceID; //!< highest sourceID ever assigned
+    am_gatewayID_t mLastGatewayID; //!< highest gatewayID ever assigned
+    am_crossfaderID_t mLastCrossfaderID; //!< highest crossfaderID ever assigned
+    am_connectionID_t mLastConnectionID; //!< highest connectionID ever assigned
+    am_mainConnectionID_t mLastMainConnectionID; //!< highest mainConnectionID ever assigned
+    std::string mPath; //!< path to the database, unused by the object model
+    CAmDatabaseObserver *mpDatabaseObserver; //!< pointer to the Observer
+    bool mFirstStaticSink; //!< bool for dynamic range handling
+    bool mFirstStaticSource; //!< bool for dynamic range handling
+    bool mFirstStaticGateway; //!< bool for dynamic range handling
+    bool mFirstStaticSinkClass; //!< bool for dynamic range handling
+    bool mFirstStaticSourceClass; //!< bool for dynamic range handling
+    bool mFirstStaticCrossfader; //!< bool for dynamic range handling
+    uint16_t mTransactionDepth; //!< nesting depth of beginTransaction
+    uint32_t mTopologyRevision; //!< incremented whenever domains, sinks, sources or gateways are entered or removed
+    uint32_t mConnectionRevision; //!< incremented whenever connections are entered or removed
+#else
     bool sqQuery(const std::string& query); //!< queries the database
+    bool sqQuery(const std::string& query, const int id); //!< queries the database with a bound ID
     bool openDatabase(); //!< opens the database
     void createTables(); //!< creates all tables from the static table
     sqlite3 *mpDatabase; //!< pointer to the database
@@ -171,6 +261,30 @@ private:
     bool mFirstStaticCrossfader; //!< bool for dynamic range handling
     typedef std::map<am_gatewayID_t, std::vector<bool> > ListConnectionFormat; //!< type for list of connection formats
     ListConnectionFormat mListConnectionFormat; //!< list of connection formats
+    uint16_t mTransactionDepth; //!< nesting depth of beginTransaction
+    uint32_t mTopologyRevision; //!< incremented whenever domains, sinks, sources or gateways are entered or removed
+    uint32_t mConnectionRevision; //!< incremented whenever connections are entered or removed
+
+    /**
+     * a prepared statement in the statement cache together with its statistics
+     */
+    struct am_Statement_s
+    {
+        sqlite3_stmt* statement; //!< the prepared statement, NULL if not prepared (yet)
+        bool inUse; //!< true between prepareStatement and finalizeStatement
+        uint32_t calls; //!< number of times the statement was used
+        uint64_t time; //!< cumulative time in ns between prepareStatement and finalizeStatement
+        timespec start; //!< start of the current use
+    };
+    typedef std::map<std::string, am_Statement_s> MapStatement; //!< statements indexed by their SQL text
+    mutable MapStatement mMapStatement; //!< the statement cache
+    int prepareStatement(const std::string& command, sqlite3_stmt** statement) const; //!< takes a statement from the cache
+    int finalizeStatement(sqlite3_stmt* statement) const; //!< hands a statement back to the cache
+    void invalidateStatements(const std::string& table); //!< finalizes the cached statements of a table
+#endif
+#ifdef UNIT_TEST
+    friend class IAmDatabaseBackdoor;
+#endif
 };
 
 }
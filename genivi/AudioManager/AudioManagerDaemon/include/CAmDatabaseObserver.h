@@ -24,6 +24,9 @@
 
 #include "audiomanagertypes.h"
 #include <queue>
+#include <vector>
+#include <map>
+#include "shared/CAmSocketHandler.h"
 #include "shared/CAmSerializer.h"
 
 namespace am
@@ -32,7 +35,6 @@ namespace am
 class CAmTelnetServer;
 class CAmCommandSender;
 class CAmRoutingSender;
-class CAmSocketHandler;
 
 /**
  * This class observes the Database and notifies other classes about important events, mainly the CommandSender.
@@ -66,12 +68,54 @@ public:
     void sinkMuteStateChanged(const am_sinkID_t sinkID, const am_MuteState_e muteState);
     void systemPropertyChanged(const am_SystemProperty_s& SystemProperty);
     void timingInformationChanged(const am_mainConnectionID_t mainConnection, const am_timeSync_t time);
+    void beginBatch();
+    void commitBatch();
+    void rollbackBatch();
+    void setCoalescingFrame(const timespec frame);
 
 private:
+    /**
+     * command side notifications collected during a registration batch
+     */
+    struct am_Batch_s
+    {
+        std::vector<am_SinkType_s> listNewSinks; //!< visible sinks entered during the batch
+        std::vector<am_SourceType_s> listNewSources; //!< visible sources entered during the batch
+        bool sinkClassesChanged; //!< true if the number of sink classes changed during the batch
+        bool sourceClassesChanged; //!< true if the number of source classes changed during the batch
+    };
+
+    /**
+     * command side notifications collected during one coalescing frame, only the latest value per object is kept
+     */
+    struct am_Frame_s
+    {
+        std::map<am_sinkID_t, am_mainVolume_t> mapVolume; //!< the latest main volume per sink
+        std::map<std::pair<am_sinkID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s> mapSinkSoundProperty; //!< the latest main sound property per sink and type
+        std::map<std::pair<am_sourceID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s> mapSourceSoundProperty; //!< the latest main sound property per source and type
+        std::map<am_SystemPropertyType_e, am_SystemProperty_s> mapSystemProperty; //!< the latest system property per type
+    };
+
+    void sendBatch(const am_Batch_s batch); //!< sends the notifications of a batch, called via the serializer
+    am_SinkType_s* batchSink(const am_sinkID_t sinkID); //!< returns the sink if it was entered in the open batch, NULL otherwise
+    am_SourceType_s* batchSource(const am_sourceID_t sourceID); //!< returns the source if it was entered in the open batch, NULL otherwise
+    bool coalescing() const; //!< true if notifications are coalesced, false if they are sent one by one
+    void startFrame(); //!< starts the frame timer unless a frame is already running
+    void flushSink(const am_sinkID_t sinkID); //!< sends the changes of the sink collected in the running frame ahead of a change that is not coalesced
+    void flushSource(const am_sourceID_t sourceID); //!< sends the changes of the source collected in the running frame ahead of a change that is not coalesced
+    void frameUp(sh_timerHandle_t handle, void* userData); //!< timer callback, sends the notifications collected during the frame
     CAmCommandSender *mCommandSender; //!< pointer to the comandSender
     CAmRoutingSender* mRoutingSender; //!< pointer to the routingSender
     CAmTelnetServer* mTelnetServer; //!< pointer to the telnetserver
     CAmSerializer mSerializer; //!< serializer to handle the CommandInterface via the mainloop
+    bool mBatch; //!< true while a registration batch is open
+    am_Batch_s mPendingBatch; //!< notifications collected in the open batch
+    CAmSocketHandler* mSocketHandler; //!< pointer to the sockethandler, used for the frame timer
+    TAmShTimerCallBack<CAmDatabaseObserver> mFrameCallback; //!< callback of the frame timer
+    timespec mFrame; //!< length of a coalescing frame, zero disables coalescing
+    sh_timerHandle_t mFrameHandle; //!< handle of the frame timer, 0 until the first frame was started
+    bool mFrameRunning; //!< true while a frame is running
+    am_Frame_s mPendingFrame; //!< notifications collected in the running frame
 };
 
 }
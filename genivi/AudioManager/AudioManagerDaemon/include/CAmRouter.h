@@ -22,6 +22,8 @@
 #ifndef ROUTER_H_
 #define ROUTER_H_
 
+#include <map>
+#include <set>
 #include "audiomanagertypes.h"
 
 namespace am
@@ -32,6 +34,10 @@ class CAmControlSender;
 
 /**
  * Implements an autorouting algorithm for connecting sinks and sources via different audio domains.
+ * The domain/gateway graph and the routes found in it are kept in memory and are only rebuilt when the
+ * topology revision of the database changes, so repeated requests do not need to query the database.
+ * Routes are searched cheapest first, every gateway has a cost, and only the best MAX_ROUTES routes are returned.
+ * MAX_ROUTES and the cost of busy gateways BUSY_GATEWAY_COST are set at build time.
  */
 class CAmRouter
 {
@@ -41,11 +47,63 @@ public:
     am_Error_e getRoute(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s>& returnList);
 
 private:
+    /**
+     * the topology part of a route, the connection formats are chosen for every request
+     */
+    struct am_RouteCandidate_s
+    {
+        std::vector<am_RoutingElement_s> listRoutingElements; //!< the hops of the route, without connection formats
+        std::vector<am_gatewayID_t> listGatewayIDs; //!< the gateways the route passes
+    };
+
+    /**
+     * the routes found between a source and a sink
+     */
+    struct am_RouteCacheEntry_s
+    {
+        uint32_t connectionRevision; //!< connection revision the routes were found with, only relevant for free routes
+        std::vector<am_RouteCandidate_s> listCandidates; //!< the routes
+    };
+
+    typedef std::pair<am_sourceID_t, am_sinkID_t> RouteKey; //!< a route is cached per source and sink
+    typedef std::map<RouteKey, am_RouteCacheEntry_s> MapRouteCache; //!< cached routes
+    typedef std::map<am_gatewayID_t, am_Gateway_s> MapGateway; //!< gateways indexed by ID
+    typedef std::map<am_domainID_t, std::vector<am_gatewayID_t> > MapDomainGateways; //!< gateway IDs indexed by the domain of their sink
+    typedef std::map<uint16_t, std::vector<am_ConnectionFormat_e> > MapConnectionFormats; //!< sorted connection formats indexed by sink or source ID
+
+    /**
+     * a partial route in the search, it ends in a domain and knows the formats that can be sent on from there
+     */
+    struct am_RouteLabel_s
+    {
+        uint32_t cost; //!< summed cost of the gateways
+        int parent; //!< index of the label this one was extended from, -1 for the source
+        am_gatewayID_t gatewayID; //!< the gateway that led into the domain, 0 for the source
+        am_domainID_t domainID; //!< the domain the partial route ends in
+        std::vector<am_ConnectionFormat_e> listFormats; //!< sorted formats that can leave the domain on this route
+    };
+    typedef std::pair<am_domainID_t, std::vector<am_ConnectionFormat_e> > RouteState; //!< the search state of a label
+
+    void updateGraph(); //!< brings the graph up to the revisions of the database
+    am_Error_e findRouteCandidates(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_RouteCandidate_s>& listCandidates); //!< searches the graph for the cheapest routes
+    uint32_t gatewayCost(const bool onlyfree, const am_gatewayID_t gatewayID) const; //!< returns the cost of a gateway
+    const std::vector<am_ConnectionFormat_e>& getSinkConnectionFormats(const am_sinkID_t sinkID); //!< returns the cached sink connection formats
+    const std::vector<am_ConnectionFormat_e>& getSourceConnectionFormats(const am_sourceID_t sourceID); //!< returns the cached source connection formats
     am_Error_e findBestWay(am_sinkID_t sinkID, am_sourceID_t sourceID, std::vector<am_RoutingElement_s>& listRoute, std::vector<am_RoutingElement_s>::iterator routeIterator, std::vector<am_gatewayID_t>::iterator gatewayIterator);
-    void listPossibleConnectionFormats(const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_ConnectionFormat_e>& listFormats) const;
+    void listPossibleConnectionFormats(const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_ConnectionFormat_e>& listFormats);
     void listRestrictedOutputFormatsGateways(const am_gatewayID_t gatewayID, const am_ConnectionFormat_e sinkConnectionFormat, std::vector<am_ConnectionFormat_e>& listFormats) const;
     CAmDatabaseHandler* mpDatabaseHandler; //!< pointer to database handler
     CAmControlSender* mpControlSender; //!< pointer the controlsender - is used to retrieve information for the optimal route
+    bool mGraphValid; //!< false until the graph was built for the first time
+    uint32_t mTopologyRevision; //!< topology revision of the database the graph was built with
+    uint32_t mConnectionRevision; //!< connection revision of the database mSetBusyGateways was built with
+    MapGateway mMapGateway; //!< all gateways
+    MapDomainGateways mMapDomainGateways; //!< the edges of the graph, in database order
+    std::set<am_gatewayID_t> mSetBusyGateways; //!< gateways whose sink or source is used by a connection
+    MapConnectionFormats mMapSinkConnectionFormats; //!< connection formats of the sinks used so far
+    MapConnectionFormats mMapSourceConnectionFormats; //!< connection formats of the sources used so far
+    MapRouteCache mMapRoutes; //!< cached routes
+    MapRouteCache mMapFreeRoutes; //!< cached routes that use only free gateways
 };
 
 /**
@@ -23,11 +23,11 @@
 #define ROUTINGRECEIVER_H_
 
 #include "routing/IAmRoutingReceive.h"
+#include "shared/CAmSocketHandler.h"
 
 namespace am
 {
 
-class CAmSocketHandler;
 class CAmDbusWrapper;
 class CAmDatabaseHandler;
 class CAmRoutingSender;
@@ -89,6 +89,10 @@ public:
     void waitOnRundown(bool rundown); //!< tells the RoutingReceiver to start waiting for all handles to be confirmed
 
 private:
+    void openStartupBatch(); //!< opens the registration batch of the startup if the startup is running
+    void commitStartupBatch(); //!< commits the registration batch of the startup if it is open
+    void startupBatchUp(sh_timerHandle_t handle, void* userData); //!< timer callback, commits the registration batch when its time is up
+
     CAmDatabaseHandler *mpDatabaseHandler; //!< pointer to the databaseHandler
     CAmRoutingSender *mpRoutingSender; //!< pointer to the routingSender
     CAmControlSender *mpControlSender; //!< pointer to the controlSender
@@ -100,6 +104,9 @@ private:
     uint16_t handleCount; //!< counts all handles
     bool mWaitStartup; //!< if true confirmation will be sent if list of handles = 0
     bool mWaitRundown; //!< if true confirmation will be sent if list of handles = 0
+    TAmShTimerCallBack<CAmRoutingReceiver> mStartupBatchCallback; //!< callback of the registration batch timer
+    sh_timerHandle_t mStartupBatchHandle; //!< handle of the registration batch timer, 0 until the first batch was opened
+    bool mStartupBatch; //!< true while the registration batch of the startup is open
 
 };
 
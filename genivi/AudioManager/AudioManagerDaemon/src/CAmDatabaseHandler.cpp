@@ -21,6 +21,8 @@
 
 #include "CAmDatabaseHandler.h"
 #include <cassert>
+#include <cctype>
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 #include <fstream>
@@ -34,64 +36,75 @@ namespace am
 {
 
 /**
- * Macro to handle SQLITE errors on prepare
+ * Macro to handle SQLITE errors on prepare, the statement is taken from the statement cache
  */
 #define MY_SQLITE_PREPARE_V2(db,zSql,nByte,ppStmt,pzTail)                                                               \
-        if ((eCode = sqlite3_prepare_v2(db, zSql, nByte, ppStmt, pzTail)))                                              \
+        if ((eCode = prepareStatement(zSql, ppStmt)))                                                                   \
         {                                                                                                               \
             logError("CAmDatabaseHandler::my_sqlite_prepare_v2 on Command",zSql,"failed with errorCode:", eCode);       \
             return (E_DATABASE_ERROR);                                                                                  \
         }
 
 #define MY_SQLITE_PREPARE_V2_BOOL(db,zSql,nByte,ppStmt,pzTail)                                                          \
-        if ((eCode = sqlite3_prepare_v2(db, zSql, nByte, ppStmt, pzTail)))                                              \
+        if ((eCode = prepareStatement(zSql, ppStmt)))                                                                   \
         {                                                                                                               \
             logError("CAmDatabaseHandler::my_sqlite_prepare_v2_bool on Command",zSql,"failed with errorCode:", eCode);       \
             return (false);                                                                                             \
         }
 
 /**
- * Macro to handle SQLITE errors bind text
+ * Macro to handle SQLITE errors bind text, the statement is handed back to the statement cache
  */
 #define MY_SQLITE_BIND_TEXT(query,index,text,size,static_)                                                              \
         if ((eCode = sqlite3_bind_text(query, index, text, size, static_)))                                             \
         {                                                                                                               \
             logError("CAmDatabaseHandler::sqlite3_bind_text failed with errorCode:", eCode);                            \
+            finalizeStatement(query);                                                                                   \
             return (E_DATABASE_ERROR);                                                                                  \
         }
 
 /**
- * Macro to handle SQLITE errors on bind int
+ * Macro to handle SQLITE errors on bind int, the statement is handed back to the statement cache
  */
 #define MY_SQLITE_BIND_INT(query, index, data)                                                                          \
         if((eCode = sqlite3_bind_int(query, index, data)))                                                              \
         {                                                                                                               \
             logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);                             \
+            finalizeStatement(query);                                                                                   \
             return (E_DATABASE_ERROR);                                                                                  \
         }
 
+#define MY_SQLITE_BIND_INT_BOOL(query, index, data)                                                                     \
+        if((eCode = sqlite3_bind_int(query, index, data)))                                                              \
+        {                                                                                                               \
+            logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);                             \
+            finalizeStatement(query);                                                                                   \
+            return (false);                                                                                             \
+        }
+
 /**
- * Macro to handle SQLITE errors on reset
+ * Macro to handle SQLITE errors on reset, the statement is handed back to the statement cache
  */
 #define MY_SQLITE_RESET(query)                                                                                          \
         if((eCode = sqlite3_reset(query)))                                                                              \
         {                                                                                                               \
             logError("CAmDatabaseHandler::sqlite3_reset failed with errorCode:", eCode);                                \
+            finalizeStatement(query);                                                                                   \
             return (E_DATABASE_ERROR);                                                                                  \
         }
 
 /**
- * Macro to handle SQLITE finalize
+ * Macro to handle SQLITE finalize, cached statements are only reset for the next use
  */
 #define MY_SQLITE_FINALIZE(query)                                                                                       \
-        if((eCode = sqlite3_finalize(query)))                                                                           \
+        if((eCode = finalizeStatement(query)))                                                                          \
         {                                                                                                               \
             logError("CAmDatabaseHandler::sqlite3_finalize failed with errorCode:", eCode);                             \
             return (E_DATABASE_ERROR);                                                                                  \
         }
 
 #define MY_SQLITE_FINALIZE_BOOL(query)                                                                                  \
-        if((eCode = sqlite3_finalize(query)))                                                                           \
+        if((eCode = finalizeStatement(query)))                                                                          \
         {                                                                                                               \
             logError("CAmDatabaseHandler::sqlite3_finalize failed with errorCode:", eCode);                             \
             return (true);                                                                                              \
@@ -107,6 +120,17 @@ namespace am
 #define CONNECTION_TABLE "Connections" //!< connection table
 #define MAINCONNECTION_TABLE "MainConnections" //!< main connection table
 #define SYSTEM_TABLE "SystemProperties" //!< system properties table
+#define SINK_CONNECTIONFORMAT_TABLE "SinkConnectionFormats" //!< connection formats of all sinks
+#define SINK_SOUNDPROPERTY_TABLE "SinkSoundProperties" //!< sound properties of all sinks
+#define SINK_MAINSOUNDPROPERTY_TABLE "SinkMainSoundProperties" //!< main sound properties of all visible sinks
+#define SOURCE_CONNECTIONFORMAT_TABLE "SourceConnectionFormats" //!< connection formats of all sources
+#define SOURCE_SOUNDPROPERTY_TABLE "SourceSoundProperties" //!< sound properties of all sources
+#define SOURCE_MAINSOUNDPROPERTY_TABLE "SourceMainSoundProperties" //!< main sound properties of all visible sources
+#define GATEWAY_SOURCEFORMAT_TABLE "GatewaySourceFormats" //!< source formats of all gateways
+#define GATEWAY_SINKFORMAT_TABLE "GatewaySinkFormats" //!< sink formats of all gateways
+#define SINK_CLASSPROPERTY_TABLE "SinkClassProperties" //!< class properties of all sink classes
+#define SOURCE_CLASSPROPERTY_TABLE "SourceClassProperties" //!< class properties of all source classes
+#define MAINCONNECTION_ROUTE_TABLE "MainConnectionRoutes" //!< routes of all main connections
 /**
  * table that holds table informations
  */
@@ -120,7 +144,36 @@ const std::string databaseTables[] =
         " Crossfaders (crossfaderID INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT, name VARCHAR(50), sinkID_A INTEGER, sinkID_B INTEGER, sourceID INTEGER, hotSink INTEGER);", //
         " Connections (connectionID INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT, sourceID INTEGER, sinkID INTEGER, delay INTEGER, connectionFormat INTEGER, reserved BOOL);", //
         " MainConnections (mainConnectionID INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT, sourceID INTEGER, sinkID INTEGER, connectionState INTEGER, delay INTEGER);", //
-        " SystemProperties (type INTEGER PRIMARY KEY, value INTEGER);" };
+        " SystemProperties (type INTEGER PRIMARY KEY, value INTEGER);", //
+        " SinkConnectionFormats (sinkID INTEGER, soundFormat INTEGER);", //
+        " SinkSoundProperties (sinkID INTEGER, soundPropertyType INTEGER, value INTEGER);", //
+        " SinkMainSoundProperties (sinkID INTEGER, soundPropertyType INTEGER, value INTEGER);", //
+        " SourceConnectionFormats (sourceID INTEGER, soundFormat INTEGER);", //
+        " SourceSoundProperties (sourceID INTEGER, soundPropertyType INTEGER, value INTEGER);", //
+        " SourceMainSoundProperties (sourceID INTEGER, soundPropertyType INTEGER, value INTEGER);", //
+        " GatewaySourceFormats (gatewayID INTEGER, soundFormat INTEGER);", //
+        " GatewaySinkFormats (gatewayID INTEGER, soundFormat INTEGER);", //
+        " SinkClassProperties (sinkClassID INTEGER, classProperty INTEGER, value INTEGER);", //
+        " SourceClassProperties (sourceClassID INTEGER, classProperty INTEGER, value INTEGER);", //
+        " MainConnectionRoutes (mainConnectionID INTEGER, connectionID INTEGER);" };
+
+/**
+ * the per object tables are keyed by the object ID, the indexes keep lookups and deletes of one object independent of the number of objects.
+ * Only the ID is indexed so that the rows of one object are read back in the order they were entered.
+ */
+const std::string databaseIndexes[] =
+{ " SinkConnectionFormatsIndex ON SinkConnectionFormats (sinkID);", //
+        " SinkSoundPropertiesIndex ON SinkSoundProperties (sinkID);", //
+        " SinkMainSoundPropertiesIndex ON SinkMainSoundProperties (sinkID);", //
+        " SourceConnectionFormatsIndex ON SourceConnectionFormats (sourceID);", //
+        " SourceSoundPropertiesIndex ON SourceSoundProperties (sourceID);", //
+        " SourceMainSoundPropertiesIndex ON SourceMainSoundProperties (sourceID);", //
+        " GatewaySourceFormatsIndex ON GatewaySourceFormats (gatewayID);", //
+        " GatewaySinkFormatsIndex ON GatewaySinkFormats (gatewayID);", //
+        " SinkClassPropertiesIndex ON SinkClassProperties (sinkClassID);", //
+        " SourceClassPropertiesIndex ON SourceClassProperties (sourceClassID);", //
+        " MainConnectionRoutesIndex ON MainConnectionRoutes (mainConnectionID);", //
+        " MainConnectionRoutesConnectionIndex ON MainConnectionRoutes (connectionID);" };
 
 /**
  * template to converts T to std::string
@@ -145,7 +198,11 @@ CAmDatabaseHandler::CAmDatabaseHandler(std::string databasePath) :
         mFirstStaticSinkClass(true), //
         mFirstStaticSourceClass(true), //
         mFirstStaticCrossfader(true), //
-        mListConnectionFormat()
+        mListConnectionFormat(), //
+        mTransactionDepth(0), //
+        mTopologyRevision(0), //
+        mConnectionRevision(0), //
+        mMapStatement()
 {
 
     std::ifstream infile(mPath.c_str());
@@ -167,6 +224,8 @@ CAmDatabaseHandler::CAmDatabaseHandler(std::string databasePath) :
 
 CAmDatabaseHandler::~CAmDatabaseHandler()
 {
+    logStatementStatistics();
+    invalidateStatements("");
     logInfo("Closed Database");
     sqlite3_close(mpDatabase);
 }
@@ -181,12 +240,14 @@ am_Error_e CAmDatabaseHandler::enterDomainDB(const am_Domain_s & domainData, am_
     //first check for a reserved domain
     sqlite3_stmt* query = NULL;
     int eCode = 0;
+    am_domainID_t reservedID = 0;
     std::string command = "SELECT domainID FROM " + std::string(DOMAIN_TABLE) + " WHERE name=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
     MY_SQLITE_BIND_TEXT(query, 1, domainData.name.c_str(), domainData.name.size(), SQLITE_STATIC)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
-        command = "UPDATE " + std::string(DOMAIN_TABLE) + " SET name=?, busname=?, nodename=?, early=?, complete=?, state=?, reserved=? WHERE domainID=" + i2s(sqlite3_column_int(query, 0));
+        reservedID = sqlite3_column_int(query, 0);
+        command = "UPDATE " + std::string(DOMAIN_TABLE) + " SET name=?, busname=?, nodename=?, early=?, complete=?, state=?, reserved=? WHERE domainID=?";
     }
     else if (eCode == SQLITE_DONE)
     {
@@ -196,6 +257,7 @@ am_Error_e CAmDatabaseHandler::enterDomainDB(const am_Domain_s & domainData, am_
     else
     {
         logError("DatabaseHandler::enterDomainDB SQLITE Step error code:", eCode);
+        MY_SQLITE_FINALIZE(query)
         return (E_DATABASE_ERROR);
     }
 
@@ -209,6 +271,10 @@ am_Error_e CAmDatabaseHandler::enterDomainDB(const am_Domain_s & domainData, am_
     MY_SQLITE_BIND_INT(query, 5, domainData.complete)
     MY_SQLITE_BIND_INT(query, 6, domainData.state)
     MY_SQLITE_BIND_INT(query, 7, 0)
+    if (reservedID != 0)
+    {
+        MY_SQLITE_BIND_INT(query, 8, reservedID)
+    }
 
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -218,7 +284,7 @@ am_Error_e CAmDatabaseHandler::enterDomainDB(const am_Domain_s & domainData, am_
     }
     MY_SQLITE_FINALIZE(query)
 
-    domainID = sqlite3_last_insert_rowid(mpDatabase);
+    domainID = (reservedID != 0) ? reservedID : sqlite3_last_insert_rowid(mpDatabase);
     logInfo("DatabaseHandler::enterDomainDB entered new domain with name=", domainData.name, "busname=", domainData.busname, "nodename=", domainData.nodename, "assigned ID:", domainID);
 
     am_Domain_s domain = domainData;
@@ -226,6 +292,7 @@ am_Error_e CAmDatabaseHandler::enterDomainDB(const am_Domain_s & domainData, am_
     if (mpDatabaseObserver)
         mpDatabaseObserver->newDomain(domain);
 
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -282,13 +349,10 @@ am_Error_e CAmDatabaseHandler::enterMainConnectionDB(const am_MainConnection_s &
     }
     MY_SQLITE_FINALIZE(query)
 
-    //now we create a table with references to the connections;
-    command = "CREATE TABLE MainConnectionRoute" + i2s(connectionID) + std::string("(connectionID INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-
-    command = "INSERT INTO MainConnectionRoute" + i2s(connectionID) + "(connectionID) VALUES (?)";
+    //now we store the route of the main connection
+    command = "INSERT INTO " + std::string(MAINCONNECTION_ROUTE_TABLE) + "(connectionID,mainConnectionID) VALUES (?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, connectionID)
     std::vector<am_connectionID_t>::const_iterator listConnectionIterator(mainConnectionData.listConnectionID.begin());
     for (; listConnectionIterator < mainConnectionData.listConnectionID.end(); ++listConnectionIterator)
     {
@@ -335,6 +399,7 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
 
     sqlite3_stmt *query = NULL;
     int eCode = 0;
+    am_sinkID_t reservedID = 0;
     std::string command = "SELECT sinkID FROM " + std::string(SINK_TABLE) + " WHERE name=? AND reserved=1";
 
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
@@ -342,7 +407,8 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
-        command = "UPDATE " + std::string(SINK_TABLE) + " SET name=?, domainID=?, sinkClassID=?, volume=?, visible=?, availability=?, availabilityReason=?, muteState=?, mainVolume=?, reserved=? WHERE sinkID=" + i2s(sqlite3_column_int(query, 0));
+        reservedID = sqlite3_column_int(query, 0);
+        command = "UPDATE " + std::string(SINK_TABLE) + " SET name=?, domainID=?, sinkClassID=?, volume=?, visible=?, availability=?, availabilityReason=?, muteState=?, mainVolume=?, reserved=? WHERE sinkID=?";
     }
     else if (eCode == SQLITE_DONE)
     {
@@ -383,8 +449,14 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
     MY_SQLITE_BIND_INT(query, 9, sinkData.mainVolume)
     MY_SQLITE_BIND_INT(query, 10, 0)
 
+    //a reserved sink keeps its ID
+    if (reservedID != 0)
+    {
+        MY_SQLITE_BIND_INT(query, 11, reservedID)
+    }
+
     //if the ID is not created, we add it to the query
-    if (sinkData.sinkID != 0)
+    else if (sinkData.sinkID != 0)
     {
         MY_SQLITE_BIND_INT(query, 11, sinkData.sinkID)
     }
@@ -422,17 +494,10 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
     }
     MY_SQLITE_FINALIZE(query)
 
-    //now we need to create the additional tables:
-    command = "CREATE TABLE SinkConnectionFormat" + i2s(sinkID) + std::string("(soundFormat INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-    command = "CREATE TABLE SinkSoundProperty" + i2s(sinkID) + std::string("(soundPropertyType INTEGER, value INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-
     //fill ConnectionFormats
-    command = "INSERT INTO SinkConnectionFormat" + i2s(sinkID) + std::string("(soundFormat) VALUES (?)");
+    command = "INSERT INTO " + std::string(SINK_CONNECTIONFORMAT_TABLE) + "(soundFormat,sinkID) VALUES (?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sinkID)
     std::vector<am_ConnectionFormat_e>::const_iterator connectionFormatIterator = sinkData.listConnectionFormats.begin();
     for (; connectionFormatIterator < sinkData.listConnectionFormats.end(); ++connectionFormatIterator)
     {
@@ -445,10 +510,12 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
         }
         MY_SQLITE_RESET(query)
     }
+    MY_SQLITE_FINALIZE(query)
 
     //Fill SinkSoundProperties
-    command = "INSERT INTO SinkSoundProperty" + i2s(sinkID) + std::string("(soundPropertyType,value) VALUES (?,?)");
+    command = "INSERT INTO " + std::string(SINK_SOUNDPROPERTY_TABLE) + "(soundPropertyType,value,sinkID) VALUES (?,?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sinkID)
     std::vector<am_SoundProperty_s>::const_iterator SoundPropertyIterator = sinkData.listSoundProperties.begin();
     for (; SoundPropertyIterator < sinkData.listSoundProperties.end(); ++SoundPropertyIterator)
     {
@@ -462,16 +529,14 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
         }
         MY_SQLITE_RESET(query)
     }
+    MY_SQLITE_FINALIZE(query)
 
     if (sinkData.visible == true)
     {
-        command = "CREATE TABLE SinkMainSoundProperty" + i2s(sinkID) + std::string("(soundPropertyType INTEGER, value INTEGER)");
-        if (!this->sqQuery(command))
-            return (E_DATABASE_ERROR);
-
         //Fill MainSinkSoundProperties
-        command = "INSERT INTO SinkMainSoundProperty" + i2s(sinkID) + std::string("(soundPropertyType,value) VALUES (?,?)");
+        command = "INSERT INTO " + std::string(SINK_MAINSOUNDPROPERTY_TABLE) + "(soundPropertyType,value,sinkID) VALUES (?,?,?)";
         MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+        MY_SQLITE_BIND_INT(query, 3, sinkID)
         std::vector<am_MainSoundProperty_s>::const_iterator mainSoundPropertyIterator = sinkData.listMainSoundProperties.begin();
         for (; mainSoundPropertyIterator < sinkData.listMainSoundProperties.end(); ++mainSoundPropertyIterator)
         {
@@ -493,6 +558,7 @@ am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID
     sink.sinkID = sinkID;
     if (mpDatabaseObserver != NULL)
         mpDatabaseObserver->newSink(sink);
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -645,16 +711,10 @@ am_Error_e CAmDatabaseHandler::enterGatewayDB(const am_Gateway_s & gatewayData,
     //now the convertion matrix todo: change the map implementation sometimes to blob in sqlite
     mListConnectionFormat.insert(std::make_pair(gatewayID, gatewayData.convertionMatrix));
 
-    command = "CREATE TABLE GatewaySourceFormat" + i2s(gatewayID) + std::string("(soundFormat INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-    command = "CREATE TABLE GatewaySinkFormat" + i2s(gatewayID) + std::string("(soundFormat INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-
     //fill ConnectionFormats
-    command = "INSERT INTO GatewaySourceFormat" + i2s(gatewayID) + std::string("(soundFormat) VALUES (?)");
+    command = "INSERT INTO " + std::string(GATEWAY_SOURCEFORMAT_TABLE) + "(soundFormat,gatewayID) VALUES (?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, gatewayID)
     std::vector<am_ConnectionFormat_e>::const_iterator connectionFormatIterator = gatewayData.listSourceFormats.begin();
     for (; connectionFormatIterator < gatewayData.listSourceFormats.end(); ++connectionFormatIterator)
     {
@@ -669,8 +729,9 @@ am_Error_e CAmDatabaseHandler::enterGatewayDB(const am_Gateway_s & gatewayData,
     }
     MY_SQLITE_FINALIZE(query)
 
-    command = "INSERT INTO GatewaySinkFormat" + i2s(gatewayID) + std::string("(soundFormat) VALUES (?)");
+    command = "INSERT INTO " + std::string(GATEWAY_SINKFORMAT_TABLE) + "(soundFormat,gatewayID) VALUES (?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, gatewayID)
     connectionFormatIterator = gatewayData.listSinkFormats.begin();
     for (; connectionFormatIterator < gatewayData.listSinkFormats.end(); ++connectionFormatIterator)
     {
@@ -690,6 +751,7 @@ am_Error_e CAmDatabaseHandler::enterGatewayDB(const am_Gateway_s & gatewayData,
     gateway.gatewayID = gatewayID;
     if (mpDatabaseObserver)
         mpDatabaseObserver->newGateway(gateway);
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -706,6 +768,7 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
     sqlite3_stmt* query = NULL;
     ;
     int eCode = 0;
+    am_sourceID_t reservedID = 0;
     std::string command = "SELECT sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE name=? AND reserved=1";
 
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
@@ -713,7 +776,8 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
-        command = "UPDATE " + std::string(SOURCE_TABLE) + " SET name=?, domainID=?, sourceClassID=?, sourceState=?, volume=?, visible=?, availability=?, availabilityReason=?, interruptState=?, reserved=? WHERE sourceID=" + i2s(sqlite3_column_int(query, 0));
+        reservedID = sqlite3_column_int(query, 0);
+        command = "UPDATE " + std::string(SOURCE_TABLE) + " SET name=?, domainID=?, sourceClassID=?, sourceState=?, volume=?, visible=?, availability=?, availabilityReason=?, interruptState=?, reserved=? WHERE sourceID=?";
     }
     else if (eCode == SQLITE_DONE)
     {
@@ -754,8 +818,14 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
     MY_SQLITE_BIND_INT(query, 9, sourceData.interruptState)
     MY_SQLITE_BIND_INT(query, 10, 0)
 
+    //a reserved source keeps its ID
+    if (reservedID != 0)
+    {
+        MY_SQLITE_BIND_INT(query, 11, reservedID)
+    }
+
     //if the ID is not created, we add it to the query
-    if (sourceData.sourceID != 0)
+    else if (sourceData.sourceID != 0)
     {
         MY_SQLITE_BIND_INT(query, 11, sourceData.sourceID)
     }
@@ -793,17 +863,10 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
     }
     MY_SQLITE_FINALIZE(query)
 
-    //now we need to create the additional tables:
-    command = "CREATE TABLE SourceConnectionFormat" + i2s(sourceID) + std::string("(soundFormat INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-    command = "CREATE TABLE SourceSoundProperty" + i2s(sourceID) + std::string("(soundPropertyType INTEGER, value INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-
     //fill ConnectionFormats
-    command = "INSERT INTO SourceConnectionFormat" + i2s(sourceID) + std::string("(soundFormat) VALUES (?)");
+    command = "INSERT INTO " + std::string(SOURCE_CONNECTIONFORMAT_TABLE) + "(soundFormat,sourceID) VALUES (?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sourceID)
     std::vector<am_ConnectionFormat_e>::const_iterator connectionFormatIterator = sourceData.listConnectionFormats.begin();
     for (; connectionFormatIterator < sourceData.listConnectionFormats.end(); ++connectionFormatIterator)
     {
@@ -819,8 +882,9 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
     MY_SQLITE_FINALIZE(query)
 
     //Fill SinkSoundProperties
-    command = "INSERT INTO SourceSoundProperty" + i2s(sourceID) + std::string("(soundPropertyType,value) VALUES (?,?)");
+    command = "INSERT INTO " + std::string(SOURCE_SOUNDPROPERTY_TABLE) + "(soundPropertyType,value,sourceID) VALUES (?,?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sourceID)
     std::vector<am_SoundProperty_s>::const_iterator SoundPropertyIterator = sourceData.listSoundProperties.begin();
     for (; SoundPropertyIterator < sourceData.listSoundProperties.end(); ++SoundPropertyIterator)
     {
@@ -839,13 +903,10 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
 
     if (sourceData.visible == true)
     {
-        command = "CREATE TABLE SourceMainSoundProperty" + i2s(sourceID) + std::string("(soundPropertyType INTEGER, value INTEGER)");
-        if (!this->sqQuery(command))
-            return (E_DATABASE_ERROR);
-
         //Fill MainSinkSoundProperties
-        command = "INSERT INTO SourceMainSoundProperty" + i2s(sourceID) + std::string("(soundPropertyType,value) VALUES (?,?)");
+        command = "INSERT INTO " + std::string(SOURCE_MAINSOUNDPROPERTY_TABLE) + "(soundPropertyType,value,sourceID) VALUES (?,?,?)";
         MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+        MY_SQLITE_BIND_INT(query, 3, sourceID)
         std::vector<am_MainSoundProperty_s>::const_iterator mainSoundPropertyIterator = sourceData.listMainSoundProperties.begin();
         for (; mainSoundPropertyIterator < sourceData.listMainSoundProperties.end(); ++mainSoundPropertyIterator)
         {
@@ -868,6 +929,7 @@ am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_
     source.sourceID = sourceID;
     if (mpDatabaseObserver)
         mpDatabaseObserver->newSource(source);
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -910,12 +972,13 @@ am_Error_e CAmDatabaseHandler::changeMainConnectionRouteDB(const am_mainConnecti
     MY_SQLITE_FINALIZE(query)
 
     //now we delete the data in the table
-    command = "DELETE from MainConnectionRoute" + i2s(mainconnectionID);
-    if (!this->sqQuery(command))
+    command = "DELETE from " + std::string(MAINCONNECTION_ROUTE_TABLE) + " WHERE mainConnectionID=?";
+    if (!this->sqQuery(command, mainconnectionID))
         return (E_DATABASE_ERROR);
 
-    command = "INSERT INTO MainConnectionRoute" + i2s(mainconnectionID) + "(connectionID) VALUES (?)";
+    command = "INSERT INTO " + std::string(MAINCONNECTION_ROUTE_TABLE) + "(connectionID,mainConnectionID) VALUES (?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, mainconnectionID)
     std::vector<am_connectionID_t>::const_iterator listConnectionIterator(listConnectionID.begin());
     for (; listConnectionIterator != listConnectionID.end(); ++listConnectionIterator)
     {
@@ -947,8 +1010,9 @@ am_Error_e CAmDatabaseHandler::changeMainConnectionStateDB(const am_mainConnecti
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(MAINCONNECTION_TABLE) + " SET connectionState=? WHERE mainConnectionID=" + i2s(mainconnectionID);
+    command = "UPDATE " + std::string(MAINCONNECTION_TABLE) + " SET connectionState=? WHERE mainConnectionID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, mainconnectionID)
     MY_SQLITE_BIND_INT(query, 1, connectionState)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -976,8 +1040,9 @@ am_Error_e CAmDatabaseHandler::changeSinkMainVolumeDB(const am_mainVolume_t main
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(SINK_TABLE) + " SET mainVolume=? WHERE sinkID=" + i2s(sinkID);
+    command = "UPDATE " + std::string(SINK_TABLE) + " SET mainVolume=? WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sinkID)
     MY_SQLITE_BIND_INT(query, 1, mainVolume)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -1009,8 +1074,9 @@ am_Error_e CAmDatabaseHandler::changeSinkAvailabilityDB(const am_Availability_s
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(SINK_TABLE) + " SET availability=?, availabilityReason=? WHERE sinkID=" + i2s(sinkID);
+    command = "UPDATE " + std::string(SINK_TABLE) + " SET availability=?, availabilityReason=? WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sinkID)
     MY_SQLITE_BIND_INT(query, 1, availability.availability)
     MY_SQLITE_BIND_INT(query, 2, availability.availabilityReason)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
@@ -1041,8 +1107,9 @@ am_Error_e CAmDatabaseHandler::changDomainStateDB(const am_DomainState_e domainS
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(DOMAIN_TABLE) + " SET state=? WHERE domainID=" + i2s(domainID);
+    command = "UPDATE " + std::string(DOMAIN_TABLE) + " SET state=? WHERE domainID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, domainID)
     MY_SQLITE_BIND_INT(query, 1, domainState)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -1070,8 +1137,9 @@ am_Error_e CAmDatabaseHandler::changeSinkMuteStateDB(const am_MuteState_e muteSt
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(SINK_TABLE) + " SET muteState=? WHERE sinkID=" + i2s(sinkID);
+    command = "UPDATE " + std::string(SINK_TABLE) + " SET muteState=? WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sinkID)
     MY_SQLITE_BIND_INT(query, 1, muteState)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -1102,8 +1170,10 @@ am_Error_e CAmDatabaseHandler::changeMainSinkSoundPropertyDB(const am_MainSoundP
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE SinkMainSoundProperty" + i2s(sinkID) + " SET value=? WHERE soundPropertyType=" + i2s(soundProperty.type);
+    command = "UPDATE " + std::string(SINK_MAINSOUNDPROPERTY_TABLE) + " SET value=? WHERE soundPropertyType=? AND sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sinkID)
+    MY_SQLITE_BIND_INT(query, 2, soundProperty.type)
     MY_SQLITE_BIND_INT(query, 1, soundProperty.value)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -1132,8 +1202,10 @@ am_Error_e CAmDatabaseHandler::changeMainSourceSoundPropertyDB(const am_MainSoun
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE SourceMainSoundProperty" + i2s(sourceID) + " SET value=? WHERE soundPropertyType=" + i2s(soundProperty.type);
+    command = "UPDATE " + std::string(SOURCE_MAINSOUNDPROPERTY_TABLE) + " SET value=? WHERE soundPropertyType=? AND sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sourceID)
+    MY_SQLITE_BIND_INT(query, 2, soundProperty.type)
     MY_SQLITE_BIND_INT(query, 1, soundProperty.value)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -1164,8 +1236,9 @@ am_Error_e CAmDatabaseHandler::changeSourceAvailabilityDB(const am_Availability_
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(SOURCE_TABLE) + " SET availability=?, availabilityReason=? WHERE sourceID=" + i2s(sourceID);
+    command = "UPDATE " + std::string(SOURCE_TABLE) + " SET availability=?, availabilityReason=? WHERE sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sourceID)
     MY_SQLITE_BIND_INT(query, 1, availability.availability)
     MY_SQLITE_BIND_INT(query, 2, availability.availabilityReason)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
@@ -1220,11 +1293,11 @@ am_Error_e CAmDatabaseHandler::removeMainConnectionDB(const am_mainConnectionID_
     {
         return (E_NON_EXISTENT);
     }
-    std::string command = "DELETE from " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=" + i2s(mainConnectionID);
-    std::string command1 = "DROP table MainConnectionRoute" + i2s(mainConnectionID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=?";
+    std::string command1 = "DELETE from " + std::string(MAINCONNECTION_ROUTE_TABLE) + " WHERE mainConnectionID=?";
+    if (!sqQuery(command, mainConnectionID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command1))
+    if (!sqQuery(command1, mainConnectionID))
         return (E_DATABASE_ERROR);
     logInfo("DatabaseHandler::removeMainConnectionDB removed:", mainConnectionID);
     if (mpDatabaseObserver)
@@ -1246,19 +1319,19 @@ am_Error_e CAmDatabaseHandler::removeSinkDB(const am_sinkID_t sinkID)
 
     bool visible = sinkVisible(sinkID);
 
-    std::string command = "DELETE from " + std::string(SINK_TABLE) + " WHERE sinkID=" + i2s(sinkID);
-    std::string command1 = "DROP table SinkConnectionFormat" + i2s(sinkID);
-    std::string command2 = "DROP table SinkSoundProperty" + i2s(sinkID);
-    std::string command3 = "DROP table SinkMainSoundProperty" + i2s(sinkID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(SINK_TABLE) + " WHERE sinkID=?";
+    std::string command1 = "DELETE from " + std::string(SINK_CONNECTIONFORMAT_TABLE) + " WHERE sinkID=?";
+    std::string command2 = "DELETE from " + std::string(SINK_SOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
+    std::string command3 = "DELETE from " + std::string(SINK_MAINSOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
+    if (!sqQuery(command, sinkID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command1))
+    if (!sqQuery(command1, sinkID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command2))
+    if (!sqQuery(command2, sinkID))
         return (E_DATABASE_ERROR);
-    if (visible) //only drop table if it ever existed
+    if (visible) //only visible sinks have main sound properties
     {
-        if (!sqQuery(command3))
+        if (!sqQuery(command3, sinkID))
             return (E_DATABASE_ERROR);
     }
     logInfo("DatabaseHandler::removeSinkDB removed:", sinkID);
@@ -1266,6 +1339,7 @@ am_Error_e CAmDatabaseHandler::removeSinkDB(const am_sinkID_t sinkID)
     if (mpDatabaseObserver != NULL)
         mpDatabaseObserver->removedSink(sinkID, visible);
 
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -1280,25 +1354,26 @@ am_Error_e CAmDatabaseHandler::removeSourceDB(const am_sourceID_t sourceID)
 
     bool visible = sourceVisible(sourceID);
 
-    std::string command = "DELETE from " + std::string(SOURCE_TABLE) + " WHERE sourceID=" + i2s(sourceID);
-    std::string command1 = "DROP table SourceConnectionFormat" + i2s(sourceID);
-    std::string command2 = "DROP table SourceMainSoundProperty" + i2s(sourceID);
-    std::string command3 = "DROP table SourceSoundProperty" + i2s(sourceID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(SOURCE_TABLE) + " WHERE sourceID=?";
+    std::string command1 = "DELETE from " + std::string(SOURCE_CONNECTIONFORMAT_TABLE) + " WHERE sourceID=?";
+    std::string command2 = "DELETE from " + std::string(SOURCE_MAINSOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
+    std::string command3 = "DELETE from " + std::string(SOURCE_SOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
+    if (!sqQuery(command, sourceID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command1))
+    if (!sqQuery(command1, sourceID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command3))
+    if (!sqQuery(command3, sourceID))
         return (E_DATABASE_ERROR);
 
     if(visible)
     {
-        if (!sqQuery(command2))
+        if (!sqQuery(command2, sourceID))
             return (E_DATABASE_ERROR);
     }
     logInfo("DatabaseHandler::removeSourceDB removed:", sourceID);
     if (mpDatabaseObserver)
         mpDatabaseObserver->removedSource(sourceID, visible);
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -1310,12 +1385,19 @@ am_Error_e CAmDatabaseHandler::removeGatewayDB(const am_gatewayID_t gatewayID)
     {
         return (E_NON_EXISTENT);
     }
-    std::string command = "DELETE from " + std::string(GATEWAY_TABLE) + " WHERE gatewayID=" + i2s(gatewayID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(GATEWAY_TABLE) + " WHERE gatewayID=?";
+    std::string command1 = "DELETE from " + std::string(GATEWAY_SOURCEFORMAT_TABLE) + " WHERE gatewayID=?";
+    std::string command2 = "DELETE from " + std::string(GATEWAY_SINKFORMAT_TABLE) + " WHERE gatewayID=?";
+    if (!sqQuery(command, gatewayID))
+        return (E_DATABASE_ERROR);
+    if (!sqQuery(command1, gatewayID))
+        return (E_DATABASE_ERROR);
+    if (!sqQuery(command2, gatewayID))
         return (E_DATABASE_ERROR);
     logInfo("DatabaseHandler::removeGatewayDB removed:", gatewayID);
     if (mpDatabaseObserver)
         mpDatabaseObserver->removeGateway(gatewayID);
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -1327,8 +1409,8 @@ am_Error_e CAmDatabaseHandler::removeCrossfaderDB(const am_crossfaderID_t crossf
     {
         return (E_NON_EXISTENT);
     }
-    std::string command = "DELETE from " + std::string(CROSSFADER_TABLE) + " WHERE crossfaderID=" + i2s(crossfaderID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(CROSSFADER_TABLE) + " WHERE crossfaderID=?";
+    if (!sqQuery(command, crossfaderID))
         return (E_DATABASE_ERROR);
     logInfo("DatabaseHandler::removeDomainDB removed:", crossfaderID);
     if (mpDatabaseObserver)
@@ -1344,12 +1426,13 @@ am_Error_e CAmDatabaseHandler::removeDomainDB(const am_domainID_t domainID)
     {
         return (E_NON_EXISTENT);
     }
-    std::string command = "DELETE from " + std::string(DOMAIN_TABLE) + " WHERE domainID=" + i2s(domainID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(DOMAIN_TABLE) + " WHERE domainID=?";
+    if (!sqQuery(command, domainID))
         return (E_DATABASE_ERROR);
     logInfo("DatabaseHandler::removeDomainDB removed:", domainID);
     if (mpDatabaseObserver)
         mpDatabaseObserver->removeDomain(domainID);
+    mTopologyRevision++;
     return (E_OK);
 }
 
@@ -1361,11 +1444,11 @@ am_Error_e CAmDatabaseHandler::removeSinkClassDB(const am_sinkClass_t sinkClassI
     {
         return (E_NON_EXISTENT);
     }
-    std::string command = "DELETE from " + std::string(SINK_CLASS_TABLE) + " WHERE sinkClassID=" + i2s(sinkClassID);
-    std::string command1 = "DROP table SinkClassProperties" + i2s(sinkClassID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(SINK_CLASS_TABLE) + " WHERE sinkClassID=?";
+    std::string command1 = "DELETE from " + std::string(SINK_CLASSPROPERTY_TABLE) + " WHERE sinkClassID=?";
+    if (!sqQuery(command, sinkClassID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command1))
+    if (!sqQuery(command1, sinkClassID))
         return (E_DATABASE_ERROR);
 
     logInfo("DatabaseHandler::removeSinkClassDB removed:", sinkClassID);
@@ -1383,11 +1466,11 @@ am_Error_e CAmDatabaseHandler::removeSourceClassDB(const am_sourceClass_t source
     {
         return (E_NON_EXISTENT);
     }
-    std::string command = "DELETE from " + std::string(SOURCE_CLASS_TABLE) + " WHERE sourceClassID=" + i2s(sourceClassID);
-    std::string command1 = "DROP table SourceClassProperties" + i2s(sourceClassID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(SOURCE_CLASS_TABLE) + " WHERE sourceClassID=?";
+    std::string command1 = "DELETE from " + std::string(SOURCE_CLASSPROPERTY_TABLE) + " WHERE sourceClassID=?";
+    if (!sqQuery(command, sourceClassID))
         return (E_DATABASE_ERROR);
-    if (!sqQuery(command1))
+    if (!sqQuery(command1, sourceClassID))
         return (E_DATABASE_ERROR);
     logInfo("DatabaseHandler::removeSourceClassDB removed:", sourceClassID);
     if (mpDatabaseObserver)
@@ -1399,10 +1482,11 @@ am_Error_e CAmDatabaseHandler::removeConnection(const am_connectionID_t connecti
 {
     assert(connectionID!=0);
 
-    std::string command = "DELETE from " + std::string(CONNECTION_TABLE) + " WHERE connectionID=" + i2s(connectionID);
-    if (!sqQuery(command))
+    std::string command = "DELETE from " + std::string(CONNECTION_TABLE) + " WHERE connectionID=?";
+    if (!sqQuery(command, connectionID))
         return (E_DATABASE_ERROR);
     logInfo("DatabaseHandler::removeConnection removed:", connectionID);
+    mConnectionRevision++;
     return (E_OK);
 }
 
@@ -1417,8 +1501,9 @@ am_Error_e CAmDatabaseHandler::getSourceClassInfoDB(const am_sourceID_t sourceID
     sqlite3_stmt* query = NULL;
     int eCode = 0;
     am_ClassProperty_s propertyTemp;
-    std::string command = "SELECT sourceClassID FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=" + (i2s(sourceID));
+    std::string command = "SELECT sourceClassID FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sourceID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1434,8 +1519,9 @@ am_Error_e CAmDatabaseHandler::getSourceClassInfoDB(const am_sourceID_t sourceID
 
     MY_SQLITE_FINALIZE(query)
 
-    command = "SELECT name FROM " + std::string(SOURCE_CLASS_TABLE) + " WHERE sourceClassID=" + (i2s(classInfo.sourceClassID));
+    command = "SELECT name FROM " + std::string(SOURCE_CLASS_TABLE) + " WHERE sourceClassID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, classInfo.sourceClassID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1452,8 +1538,9 @@ am_Error_e CAmDatabaseHandler::getSourceClassInfoDB(const am_sourceID_t sourceID
     MY_SQLITE_FINALIZE(query)
 
     //read out Properties
-    command = "SELECT classProperty, value FROM SourceClassProperties" + i2s(classInfo.sourceClassID);
+    command = "SELECT classProperty, value FROM " + std::string(SOURCE_CLASSPROPERTY_TABLE) + " WHERE sourceClassID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, classInfo.sourceClassID)
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         propertyTemp.classProperty = (am_ClassProperty_e) sqlite3_column_int(query, 0);
@@ -1487,8 +1574,9 @@ am_Error_e CAmDatabaseHandler::getSinkInfoDB(const am_sinkID_t sinkID, am_Sink_s
     am_ConnectionFormat_e tempConnectionFormat;
     am_SoundProperty_s tempSoundProperty;
     am_MainSoundProperty_s tempMainSoundProperty;
-    std::string command = "SELECT name, domainID, sinkClassID, volume, visible, availability, availabilityReason, muteState, mainVolume, sinkID FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 and sinkID=" + i2s(sinkID);
+    std::string command = "SELECT name, domainID, sinkClassID, volume, visible, availability, availabilityReason, muteState, mainVolume, sinkID FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 and sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1504,8 +1592,9 @@ am_Error_e CAmDatabaseHandler::getSinkInfoDB(const am_sinkID_t sinkID, am_Sink_s
         sinkData.sinkID = sqlite3_column_int(query, 9);
 
         //read out the connectionFormats
-        std::string commandConnectionFormat = "SELECT soundFormat FROM SinkConnectionFormat" + i2s(sinkID);
+        std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(SINK_CONNECTIONFORMAT_TABLE) + " WHERE sinkID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qConnectionFormat, 1, sinkID)
         while ((eCode = sqlite3_step(qConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qConnectionFormat, 0);
@@ -1515,8 +1604,9 @@ am_Error_e CAmDatabaseHandler::getSinkInfoDB(const am_sinkID_t sinkID, am_Sink_s
         MY_SQLITE_FINALIZE(qConnectionFormat)
 
         //read out sound properties
-        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM SinkSoundProperty" + i2s(sinkID);
+        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SINK_SOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandSoundProperty.c_str(), -1, &qSoundProperty, NULL)
+        MY_SQLITE_BIND_INT(qSoundProperty, 1, sinkID)
         while ((eCode = sqlite3_step(qSoundProperty)) == SQLITE_ROW)
         {
             tempSoundProperty.type = (am_SoundPropertyType_e) sqlite3_column_int(qSoundProperty, 0);
@@ -1527,8 +1617,9 @@ am_Error_e CAmDatabaseHandler::getSinkInfoDB(const am_sinkID_t sinkID, am_Sink_s
         MY_SQLITE_FINALIZE(qSoundProperty)
 
         //read out MainSoundProperties
-        std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM SinkMainSoundProperty" + i2s(sinkID);
+        std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SINK_MAINSOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandMainSoundProperty.c_str(), -1, &qMAinSoundProperty, NULL)
+        MY_SQLITE_BIND_INT(qMAinSoundProperty, 1, sinkID)
         while ((eCode = sqlite3_step(qMAinSoundProperty)) == SQLITE_ROW)
         {
             tempMainSoundProperty.type = (am_MainSoundPropertyType_e) sqlite3_column_int(qMAinSoundProperty, 0);
@@ -1565,8 +1656,9 @@ am_Error_e CAmDatabaseHandler::getSourceInfoDB(const am_sourceID_t sourceID, am_
     am_ConnectionFormat_e tempConnectionFormat;
     am_SoundProperty_s tempSoundProperty;
     am_MainSoundProperty_s tempMainSoundProperty;
-    std::string command = "SELECT name, domainID, sourceClassID, sourceState, volume, visible, availability, availabilityReason, interruptState, sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE reserved=0 AND sourceID=" + i2s(sourceID);
+    std::string command = "SELECT name, domainID, sourceClassID, sourceState, volume, visible, availability, availabilityReason, interruptState, sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE reserved=0 AND sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sourceID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1582,8 +1674,9 @@ am_Error_e CAmDatabaseHandler::getSourceInfoDB(const am_sourceID_t sourceID, am_
         sourceData.sourceID = sqlite3_column_int(query, 9);
 
         //read out the connectionFormats
-        std::string commandConnectionFormat = "SELECT soundFormat FROM SourceConnectionFormat" + i2s(sourceID);
+        std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(SOURCE_CONNECTIONFORMAT_TABLE) + " WHERE sourceID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qConnectionFormat, 1, sourceID)
         while ((eCode = sqlite3_step(qConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qConnectionFormat, 0);
@@ -1593,8 +1686,9 @@ am_Error_e CAmDatabaseHandler::getSourceInfoDB(const am_sourceID_t sourceID, am_
         MY_SQLITE_FINALIZE(qConnectionFormat)
 
         //read out sound properties
-        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM SourceSoundProperty" + i2s(sourceID);
+        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SOURCE_SOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandSoundProperty.c_str(), -1, &qSoundProperty, NULL);
+        MY_SQLITE_BIND_INT(qSoundProperty, 1, sourceID)
         while ((eCode = sqlite3_step(qSoundProperty)) == SQLITE_ROW)
         {
             tempSoundProperty.type = (am_SoundPropertyType_e) sqlite3_column_int(qSoundProperty, 0);
@@ -1605,8 +1699,9 @@ am_Error_e CAmDatabaseHandler::getSourceInfoDB(const am_sourceID_t sourceID, am_
         MY_SQLITE_FINALIZE(qSoundProperty)
 
         //read out MainSoundProperties
-        std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM SourceMainSoundProperty" + i2s(sourceID);
+        std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SOURCE_MAINSOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandMainSoundProperty.c_str(), -1, &qMAinSoundProperty, NULL)
+        MY_SQLITE_BIND_INT(qMAinSoundProperty, 1, sourceID)
         while ((eCode = sqlite3_step(qMAinSoundProperty)) == SQLITE_ROW)
         {
             tempMainSoundProperty.type = (am_MainSoundPropertyType_e) sqlite3_column_int(qMAinSoundProperty, 0);
@@ -1638,9 +1733,10 @@ am_Error_e am::CAmDatabaseHandler::getMainConnectionInfoDB(const am_mainConnecti
     sqlite3_stmt *query = NULL, *query1 = NULL;
     int eCode = 0;
     am_MainConnection_s temp;
-    std::string command = "SELECT mainConnectionID, sourceID, sinkID, connectionState, delay FROM " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=" + i2s(mainConnectionID);
-    std::string command1 = "SELECT connectionID FROM MainConnectionRoute";
+    std::string command = "SELECT mainConnectionID, sourceID, sinkID, connectionState, delay FROM " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=?";
+    std::string command1 = "SELECT connectionID FROM " + std::string(MAINCONNECTION_ROUTE_TABLE) + " WHERE mainConnectionID=? ORDER BY rowid";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, mainConnectionID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1649,8 +1745,8 @@ am_Error_e am::CAmDatabaseHandler::getMainConnectionInfoDB(const am_mainConnecti
         mainConnectionData.sinkID = sqlite3_column_int(query, 2);
         mainConnectionData.connectionState = (am_ConnectionState_e) sqlite3_column_int(query, 3);
         mainConnectionData.delay = sqlite3_column_int(query, 4);
-        std::string statement = command1 + i2s(mainConnectionID);
-        MY_SQLITE_PREPARE_V2(mpDatabase, statement.c_str(), -1, &query1, NULL)
+        MY_SQLITE_PREPARE_V2(mpDatabase, command1.c_str(), -1, &query1, NULL)
+        MY_SQLITE_BIND_INT(query1, 1, mainConnectionID)
         while ((eCode = sqlite3_step(query1)) == SQLITE_ROW)
         {
             mainConnectionData.listConnectionID.push_back(sqlite3_column_int(query1, 0));
@@ -1683,8 +1779,9 @@ am_Error_e CAmDatabaseHandler::changeSinkClassInfoDB(const am_SinkClass_s& sinkC
         return (E_NON_EXISTENT);
 
     //fill ConnectionFormats
-    std::string command = "UPDATE SinkClassProperties" + i2s(sinkClass.sinkClassID) + " set value=? WHERE classProperty=?;";
+    std::string command = "UPDATE " + std::string(SINK_CLASSPROPERTY_TABLE) + " set value=? WHERE classProperty=? AND sinkClassID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sinkClass.sinkClassID)
     std::vector<am_ClassProperty_s>::const_iterator Iterator = sinkClass.listClassProperties.begin();
     for (; Iterator < sinkClass.listClassProperties.end(); ++Iterator)
     {
@@ -1718,8 +1815,9 @@ am_Error_e CAmDatabaseHandler::changeSourceClassInfoDB(const am_SourceClass_s& s
         return (E_NON_EXISTENT);
 
     //fill ConnectionFormats
-    std::string command = "UPDATE SourceClassProperties" + i2s(sourceClass.sourceClassID) + " set value=? WHERE classProperty=?;";
+    std::string command = "UPDATE " + std::string(SOURCE_CLASSPROPERTY_TABLE) + " set value=? WHERE classProperty=? AND sourceClassID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sourceClass.sourceClassID)
     std::vector<am_ClassProperty_s>::const_iterator Iterator = sourceClass.listClassProperties.begin();
     for (; Iterator < sourceClass.listClassProperties.end(); ++Iterator)
     {
@@ -1751,8 +1849,9 @@ am_Error_e CAmDatabaseHandler::getSinkClassInfoDB(const am_sinkID_t sinkID, am_S
     sqlite3_stmt* query = NULL;
     int eCode = 0;
     am_ClassProperty_s propertyTemp;
-    std::string command = "SELECT sinkClassID FROM " + std::string(SINK_TABLE) + " WHERE sinkID=" + (i2s(sinkID));
+    std::string command = "SELECT sinkClassID FROM " + std::string(SINK_TABLE) + " WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1768,8 +1867,9 @@ am_Error_e CAmDatabaseHandler::getSinkClassInfoDB(const am_sinkID_t sinkID, am_S
 
     MY_SQLITE_FINALIZE(query)
 
-    command = "SELECT name FROM " + std::string(SINK_CLASS_TABLE) + " WHERE sinkClassID=" + (i2s(sinkClass.sinkClassID));
+    command = "SELECT name FROM " + std::string(SINK_CLASS_TABLE) + " WHERE sinkClassID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkClass.sinkClassID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1786,8 +1886,9 @@ am_Error_e CAmDatabaseHandler::getSinkClassInfoDB(const am_sinkID_t sinkID, am_S
     MY_SQLITE_FINALIZE(query)
 
     //read out Properties
-    command = "SELECT classProperty, value FROM SinkClassProperties" + i2s(sinkClass.sinkClassID);
+    command = "SELECT classProperty, value FROM " + std::string(SINK_CLASSPROPERTY_TABLE) + " WHERE sinkClassID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkClass.sinkClassID)
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         propertyTemp.classProperty = (am_ClassProperty_e) sqlite3_column_int(query, 0);
@@ -1816,8 +1917,9 @@ am_Error_e CAmDatabaseHandler::getGatewayInfoDB(const am_gatewayID_t gatewayID,
     sqlite3_stmt* query = NULL, *qSinkConnectionFormat = NULL, *qSourceConnectionFormat = NULL;
     int eCode = 0;
     am_ConnectionFormat_e tempConnectionFormat;
-    std::string command = "SELECT name, sinkID, sourceID, domainSinkID, domainSourceID, controlDomainID, gatewayID FROM " + std::string(GATEWAY_TABLE) + " WHERE gatewayID=" + i2s(gatewayID);
+    std::string command = "SELECT name, sinkID, sourceID, domainSinkID, domainSourceID, controlDomainID, gatewayID FROM " + std::string(GATEWAY_TABLE) + " WHERE gatewayID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, gatewayID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1841,8 +1943,9 @@ am_Error_e CAmDatabaseHandler::getGatewayInfoDB(const am_gatewayID_t gatewayID,
         gatewayData.convertionMatrix = iter->second;
 
         //read out the connectionFormats
-        std::string commandConnectionFormat = "SELECT soundFormat FROM GatewaySourceFormat" + i2s(gatewayData.gatewayID);
+        std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(GATEWAY_SOURCEFORMAT_TABLE) + " WHERE gatewayID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qSourceConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qSourceConnectionFormat, 1, gatewayData.gatewayID)
         while ((eCode = sqlite3_step(qSourceConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qSourceConnectionFormat, 0);
@@ -1852,8 +1955,9 @@ am_Error_e CAmDatabaseHandler::getGatewayInfoDB(const am_gatewayID_t gatewayID,
         MY_SQLITE_FINALIZE(qSourceConnectionFormat)
 
         //read out sound properties
-        commandConnectionFormat = "SELECT soundFormat FROM GatewaySinkFormat" + i2s(gatewayData.gatewayID);
+        commandConnectionFormat = "SELECT soundFormat FROM " + std::string(GATEWAY_SINKFORMAT_TABLE) + " WHERE gatewayID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qSinkConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qSinkConnectionFormat, 1, gatewayData.gatewayID)
         while ((eCode = sqlite3_step(qSinkConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qSinkConnectionFormat, 0);
@@ -1886,8 +1990,9 @@ am_Error_e CAmDatabaseHandler::getCrossfaderInfoDB(const am_crossfaderID_t cross
     }
     sqlite3_stmt* query = NULL;
     int eCode = 0;
-    std::string command = "SELECT name, sinkID_A, sinkID_B, sourceID, hotSink,crossfaderID FROM " + std::string(CROSSFADER_TABLE) + " WHERE crossfaderID=" + i2s(crossfaderID);
+    std::string command = "SELECT name, sinkID_A, sinkID_B, sourceID, hotSink,crossfaderID FROM " + std::string(CROSSFADER_TABLE) + " WHERE crossfaderID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, crossfaderID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1922,8 +2027,9 @@ am_Error_e CAmDatabaseHandler::getListSinksOfDomain(const am_domainID_t domainID
     sqlite3_stmt* query = NULL;
     int eCode = 0;
     am_sinkID_t temp;
-    std::string command = "SELECT sinkID FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 AND domainID=" + (i2s(domainID));
+    std::string command = "SELECT sinkID FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 AND domainID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, domainID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1953,9 +2059,10 @@ am_Error_e CAmDatabaseHandler::getListSourcesOfDomain(const am_domainID_t domain
     sqlite3_stmt* query = NULL;
     int eCode = 0;
     am_sourceID_t temp;
-    std::string command = "SELECT sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE reserved=0 AND domainID=" + i2s(domainID);
+    std::string command = "SELECT sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE reserved=0 AND domainID=?";
 
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, domainID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -1987,8 +2094,9 @@ am_Error_e CAmDatabaseHandler::getListCrossfadersOfDomain(const am_domainID_t do
     int eCode = 0;
     am_crossfaderID_t temp;
 
-    std::string command = "SELECT c.crossfaderID FROM " + std::string(CROSSFADER_TABLE) + " c," + std::string(SOURCE_TABLE) + " s WHERE c.sourceID=s.sourceID AND s.domainID=" + i2s(domainID);
+    std::string command = "SELECT c.crossfaderID FROM " + std::string(CROSSFADER_TABLE) + " c," + std::string(SOURCE_TABLE) + " s WHERE c.sourceID=s.sourceID AND s.domainID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, domainID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -2021,8 +2129,9 @@ am_Error_e CAmDatabaseHandler::getListGatewaysOfDomain(const am_domainID_t domai
     int eCode = 0;
     am_gatewayID_t temp;
 
-    std::string command = "SELECT gatewayID FROM " + std::string(GATEWAY_TABLE) + " WHERE controlDomainID=" + i2s(domainID);
+    std::string command = "SELECT gatewayID FROM " + std::string(GATEWAY_TABLE) + " WHERE controlDomainID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, domainID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -2049,7 +2158,7 @@ am_Error_e CAmDatabaseHandler::getListMainConnections(std::vector<am_MainConnect
     int eCode = 0;
     am_MainConnection_s temp;
     std::string command = "SELECT mainConnectionID, sourceID, sinkID, connectionState, delay FROM " + std::string(MAINCONNECTION_TABLE);
-    std::string command1 = "SELECT connectionID FROM MainConnectionRoute";
+    std::string command1 = "SELECT connectionID FROM " + std::string(MAINCONNECTION_ROUTE_TABLE) + " WHERE mainConnectionID=? ORDER BY rowid";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
@@ -2059,8 +2168,8 @@ am_Error_e CAmDatabaseHandler::getListMainConnections(std::vector<am_MainConnect
         temp.sinkID = sqlite3_column_int(query, 2);
         temp.connectionState = (am_ConnectionState_e) sqlite3_column_int(query, 3);
         temp.delay = sqlite3_column_int(query, 4);
-        std::string statement = command1 + i2s(temp.mainConnectionID);
-        MY_SQLITE_PREPARE_V2(mpDatabase, statement.c_str(), -1, &query1, NULL)
+        MY_SQLITE_PREPARE_V2(mpDatabase, command1.c_str(), -1, &query1, NULL)
+        MY_SQLITE_BIND_INT(query1, 1, temp.mainConnectionID)
         while ((eCode = sqlite3_step(query1)) == SQLITE_ROW)
         {
             temp.listConnectionID.push_back(sqlite3_column_int(query1, 0));
@@ -2145,6 +2254,42 @@ am_Error_e CAmDatabaseHandler::getListConnections(std::vector<am_Connection_s> &
     return (E_OK);
 }
 
+/**
+ * returns the connections that are not final yet
+ * @param listConnections the list of reserved connections
+ * @return E_OK on success, E_DATABASE_ERROR on error
+ */
+am_Error_e CAmDatabaseHandler::getListConnectionsReserved(std::vector<am_Connection_s> & listConnections) const
+{
+    listConnections.clear();
+    sqlite3_stmt* query = NULL;
+    int eCode = 0;
+    am_Connection_s temp;
+    std::string command = "SELECT connectionID, sourceID, sinkID, delay, connectionFormat FROM " + std::string(CONNECTION_TABLE) + " WHERE reserved=1";
+    MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+
+    while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
+    {
+        temp.connectionID = sqlite3_column_int(query, 0);
+        temp.sourceID = sqlite3_column_int(query, 1);
+        temp.sinkID = sqlite3_column_int(query, 2);
+        temp.delay = sqlite3_column_int(query, 3);
+        temp.connectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(query, 4);
+        listConnections.push_back(temp);
+    }
+
+    if (eCode != SQLITE_DONE)
+    {
+        logError("DatabaseHandler::getListConnectionsReserved SQLITE error code:", eCode);
+        MY_SQLITE_FINALIZE(query)
+        return (E_DATABASE_ERROR);
+    }
+
+    MY_SQLITE_FINALIZE(query)
+
+    return (E_OK);
+}
+
 am_Error_e CAmDatabaseHandler::getListSinks(std::vector<am_Sink_s> & listSinks) const
 {
     listSinks.clear();
@@ -2171,8 +2316,9 @@ am_Error_e CAmDatabaseHandler::getListSinks(std::vector<am_Sink_s> & listSinks)
         temp.sinkID = sqlite3_column_int(query, 9);
 
         //read out the connectionFormats
-        std::string commandConnectionFormat = "SELECT soundFormat FROM SinkConnectionFormat" + i2s(temp.sinkID);
+        std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(SINK_CONNECTIONFORMAT_TABLE) + " WHERE sinkID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qConnectionFormat, 1, temp.sinkID)
         while ((eCode = sqlite3_step(qConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qConnectionFormat, 0);
@@ -2182,8 +2328,9 @@ am_Error_e CAmDatabaseHandler::getListSinks(std::vector<am_Sink_s> & listSinks)
         MY_SQLITE_FINALIZE(qConnectionFormat)
 
         //read out sound properties
-        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM SinkSoundProperty" + i2s(temp.sinkID);
+        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SINK_SOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandSoundProperty.c_str(), -1, &qSoundProperty, NULL)
+        MY_SQLITE_BIND_INT(qSoundProperty, 1, temp.sinkID)
         while ((eCode = sqlite3_step(qSoundProperty)) == SQLITE_ROW)
         {
             tempSoundProperty.type = (am_SoundPropertyType_e) sqlite3_column_int(qSoundProperty, 0);
@@ -2196,8 +2343,9 @@ am_Error_e CAmDatabaseHandler::getListSinks(std::vector<am_Sink_s> & listSinks)
         //read out MainSoundProperties if sink is visible
         if(temp.visible)
         {
-            std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM SinkMainSoundProperty" + i2s(temp.sinkID);
+            std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SINK_MAINSOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
             MY_SQLITE_PREPARE_V2(mpDatabase, commandMainSoundProperty.c_str(), -1, &qMAinSoundProperty, NULL)
+            MY_SQLITE_BIND_INT(qMAinSoundProperty, 1, temp.sinkID)
             while ((eCode = sqlite3_step(qMAinSoundProperty)) == SQLITE_ROW)
             {
                 tempMainSoundProperty.type = (am_MainSoundPropertyType_e) sqlite3_column_int(qMAinSoundProperty, 0);
@@ -2252,8 +2400,9 @@ am_Error_e CAmDatabaseHandler::getListSources(std::vector<am_Source_s> & listSou
         temp.sourceID = sqlite3_column_int(query, 9);
 
         //read out the connectionFormats
-        std::string commandConnectionFormat = "SELECT soundFormat FROM SourceConnectionFormat" + i2s(temp.sourceID);
+        std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(SOURCE_CONNECTIONFORMAT_TABLE) + " WHERE sourceID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qConnectionFormat, 1, temp.sourceID)
         while ((eCode = sqlite3_step(qConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qConnectionFormat, 0);
@@ -2263,8 +2412,9 @@ am_Error_e CAmDatabaseHandler::getListSources(std::vector<am_Source_s> & listSou
         MY_SQLITE_FINALIZE(qConnectionFormat)
 
         //read out sound properties
-        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM SourceSoundProperty" + i2s(temp.sourceID);
+        std::string commandSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SOURCE_SOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandSoundProperty.c_str(), -1, &qSoundProperty, NULL)
+        MY_SQLITE_BIND_INT(qSoundProperty, 1, temp.sourceID)
         while ((eCode = sqlite3_step(qSoundProperty)) == SQLITE_ROW)
         {
             tempSoundProperty.type = (am_SoundPropertyType_e) sqlite3_column_int(qSoundProperty, 0);
@@ -2277,8 +2427,9 @@ am_Error_e CAmDatabaseHandler::getListSources(std::vector<am_Source_s> & listSou
         //read out MainSoundProperties if source is visible
         if(temp.visible)
         {
-            std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM SourceMainSoundProperty" + i2s(temp.sourceID);
+            std::string commandMainSoundProperty = "SELECT soundPropertyType, value FROM " + std::string(SOURCE_MAINSOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
             MY_SQLITE_PREPARE_V2(mpDatabase, commandMainSoundProperty.c_str(), -1, &qMAinSoundProperty, NULL)
+            MY_SQLITE_BIND_INT(qMAinSoundProperty, 1, temp.sourceID)
             while ((eCode = sqlite3_step(qMAinSoundProperty)) == SQLITE_ROW)
             {
                 tempMainSoundProperty.type = (am_MainSoundPropertyType_e) sqlite3_column_int(qMAinSoundProperty, 0);
@@ -2327,8 +2478,9 @@ am_Error_e CAmDatabaseHandler::getListSourceClasses(std::vector<am_SourceClass_s
         classTemp.name = std::string((const char*) sqlite3_column_text(query, 1));
 
         //read out Properties
-        command2 = "SELECT classProperty, value FROM SourceClassProperties" + i2s(classTemp.sourceClassID);
+        command2 = "SELECT classProperty, value FROM " + std::string(SOURCE_CLASSPROPERTY_TABLE) + " WHERE sourceClassID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, command2.c_str(), -1, &subQuery, NULL)
+        MY_SQLITE_BIND_INT(subQuery, 1, classTemp.sourceClassID)
 
         while ((eCode1 = sqlite3_step(subQuery)) == SQLITE_ROW)
         {
@@ -2421,14 +2573,15 @@ am_Error_e CAmDatabaseHandler::getListGateways(std::vector<am_Gateway_s> & listG
         if (iter == mListConnectionFormat.end())
         {
             logError("DatabaseHandler::getListGateways database error with convertionFormat");
-
+            MY_SQLITE_FINALIZE(query)
             return (E_DATABASE_ERROR);
         }
         temp.convertionMatrix = iter->second;
 
         //read out the connectionFormats
-        std::string commandConnectionFormat = "SELECT soundFormat FROM GatewaySourceFormat" + i2s(temp.gatewayID);
+        std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(GATEWAY_SOURCEFORMAT_TABLE) + " WHERE gatewayID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qSourceConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qSourceConnectionFormat, 1, temp.gatewayID)
         while ((eCode = sqlite3_step(qSourceConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qSourceConnectionFormat, 0);
@@ -2438,8 +2591,9 @@ am_Error_e CAmDatabaseHandler::getListGateways(std::vector<am_Gateway_s> & listG
         MY_SQLITE_FINALIZE(qSourceConnectionFormat)
 
         //read out sound properties
-        commandConnectionFormat = "SELECT soundFormat FROM GatewaySinkFormat" + i2s(temp.gatewayID);
+        commandConnectionFormat = "SELECT soundFormat FROM " + std::string(GATEWAY_SINKFORMAT_TABLE) + " WHERE gatewayID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qSinkConnectionFormat, NULL)
+        MY_SQLITE_BIND_INT(qSinkConnectionFormat, 1, temp.gatewayID)
         while ((eCode = sqlite3_step(qSinkConnectionFormat)) == SQLITE_ROW)
         {
             tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qSinkConnectionFormat, 0);
@@ -2484,8 +2638,9 @@ am_Error_e CAmDatabaseHandler::getListSinkClasses(std::vector<am_SinkClass_s> &
         classTemp.name = std::string((const char*) sqlite3_column_text(query, 1));
 
         //read out Properties
-        command2 = "SELECT classProperty, value FROM SinkClassProperties" + i2s(classTemp.sinkClassID);
+        command2 = "SELECT classProperty, value FROM " + std::string(SINK_CLASSPROPERTY_TABLE) + " WHERE sinkClassID=?";
         MY_SQLITE_PREPARE_V2(mpDatabase, command2.c_str(), -1, &subQuery, NULL)
+        MY_SQLITE_BIND_INT(subQuery, 1, classTemp.sinkClassID)
 
         while ((eCode = sqlite3_step(subQuery)) == SQLITE_ROW)
         {
@@ -2497,7 +2652,8 @@ am_Error_e CAmDatabaseHandler::getListSinkClasses(std::vector<am_SinkClass_s> &
         if (eCode != SQLITE_DONE)
         {
             logError("DatabaseHandler::getListSourceClasses SQLITE error code:", eCode);
-
+            finalizeStatement(subQuery);
+            finalizeStatement(query);
             return (E_DATABASE_ERROR);
         }
 
@@ -2626,8 +2782,9 @@ am_Error_e CAmDatabaseHandler::getListMainSinkSoundProperties(const am_sinkID_t
     sqlite3_stmt* query = NULL;
     int eCode = 0;
     am_MainSoundProperty_s temp;
-    std::string command = "SELECT soundPropertyType, value FROM SinkMainSoundProperty" + i2s(sinkID);
+    std::string command = "SELECT soundPropertyType, value FROM " + std::string(SINK_MAINSOUNDPROPERTY_TABLE) + " WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -2658,8 +2815,9 @@ am_Error_e CAmDatabaseHandler::getListMainSourceSoundProperties(const am_sourceI
     sqlite3_stmt* query = NULL;
     int eCode = 0;
     am_MainSoundProperty_s temp;
-    std::string command = "SELECT soundPropertyType, value FROM SourceMainSoundProperty" + i2s(sourceID);
+    std::string command = "SELECT soundPropertyType, value FROM " + std::string(SOURCE_MAINSOUNDPROPERTY_TABLE) + " WHERE sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sourceID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -2715,8 +2873,9 @@ am_Error_e am::CAmDatabaseHandler::getListSinkConnectionFormats(const am_sinkID_
     sqlite3_stmt *qConnectionFormat = NULL;
     int eCode = 0;
     am_ConnectionFormat_e tempConnectionFormat;
-    std::string commandConnectionFormat = "SELECT soundFormat FROM SinkConnectionFormat" + i2s(sinkID);
+    std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(SINK_CONNECTIONFORMAT_TABLE) + " WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qConnectionFormat, NULL)
+    MY_SQLITE_BIND_INT(qConnectionFormat, 1, sinkID)
     while ((eCode = sqlite3_step(qConnectionFormat)) == SQLITE_ROW)
     {
         tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qConnectionFormat, 0);
@@ -2736,8 +2895,9 @@ am_Error_e am::CAmDatabaseHandler::getListSourceConnectionFormats(const am_sourc
     am_ConnectionFormat_e tempConnectionFormat;
 
     //read out the connectionFormats
-    std::string commandConnectionFormat = "SELECT soundFormat FROM SourceConnectionFormat" + i2s(sourceID);
+    std::string commandConnectionFormat = "SELECT soundFormat FROM " + std::string(SOURCE_CONNECTIONFORMAT_TABLE) + " WHERE sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, commandConnectionFormat.c_str(), -1, &qConnectionFormat, NULL)
+    MY_SQLITE_BIND_INT(qConnectionFormat, 1, sourceID)
     while ((eCode = sqlite3_step(qConnectionFormat)) == SQLITE_ROW)
     {
         tempConnectionFormat = (am_ConnectionFormat_e) sqlite3_column_int(qConnectionFormat, 0);
@@ -2771,8 +2931,9 @@ am_Error_e CAmDatabaseHandler::getTimingInformation(const am_mainConnectionID_t
     sqlite3_stmt *query = NULL;
     int eCode = 0;
 
-    std::string command = "SELECT delay FROM " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=" + i2s(mainConnectionID);
+    std::string command = "SELECT delay FROM " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, mainConnectionID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -2806,6 +2967,157 @@ bool CAmDatabaseHandler::sqQuery(const std::string& query)
     return (true);
 }
 
+/**
+ * returns the prepared statement for a query from the statement cache. The statement is prepared on first use only
+ * and is reset and reused afterwards. If the same statement is still stepped further up the call stack, a private
+ * statement is prepared that is finalized again by finalizeStatement.
+ * @param command the SQL text, values must be bound instead of being part of the text
+ * @param statement the statement
+ * @return the sqlite error code
+ */
+int CAmDatabaseHandler::prepareStatement(const std::string& command, sqlite3_stmt** statement) const
+{
+    am_Statement_s& entry = mMapStatement[command];
+    entry.calls++;
+    if (entry.inUse)
+        return (sqlite3_prepare_v2(mpDatabase, command.c_str(), -1, statement, NULL));
+
+    int eCode = SQLITE_OK;
+    if (entry.statement == NULL && (eCode = sqlite3_prepare_v2(mpDatabase, command.c_str(), -1, &entry.statement, NULL)) != SQLITE_OK)
+    {
+        entry.statement = NULL;
+        return (eCode);
+    }
+
+    sqlite3_clear_bindings(entry.statement);
+    entry.inUse = true;
+    clock_gettime(CLOCK_MONOTONIC, &entry.start);
+    *statement = entry.statement;
+    return (SQLITE_OK);
+}
+
+/**
+ * hands a statement back to the statement cache. Cached statements are reset, others are finalized.
+ * @param statement the statement
+ * @return the sqlite error code
+ */
+int CAmDatabaseHandler::finalizeStatement(sqlite3_stmt* statement) const
+{
+    MapStatement::iterator iter = mMapStatement.find(sqlite3_sql(statement));
+    if (iter == mMapStatement.end() || iter->second.statement != statement)
+        return (sqlite3_finalize(statement));
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    iter->second.time += (now.tv_sec - iter->second.start.tv_sec) * 1000000000LL + (now.tv_nsec - iter->second.start.tv_nsec);
+    iter->second.inUse = false;
+    return (sqlite3_reset(statement));
+}
+
+/**
+ * checks if a statement refers to a table. Only whole names match, so Connections does not match
+ * MainConnections.
+ * @param command the SQL text
+ * @param table the table name, an empty name matches all statements
+ * @return true if the table is part of the statement
+ */
+static bool statementUsesTable(const std::string& command, const std::string& table)
+{
+    if (table.empty())
+        return (true);
+
+    size_t pos = command.find(table);
+    while (pos != std::string::npos)
+    {
+        size_t end = pos + table.size();
+        bool startsName = (pos == 0) || (!isalnum(command[pos - 1]) && command[pos - 1] != '_');
+        bool endsName = (end == command.size()) || (!isalnum(command[end]) && command[end] != '_');
+        if (startsName && endsName)
+            return (true);
+        pos = command.find(table, pos + 1);
+    }
+    return (false);
+}
+
+/**
+ * finalizes all cached statements that refer to a table, the statistics are kept. A statement that is still in use
+ * is removed from the cache and finalized when it is handed back by finalizeStatement.
+ * @param table the table name, an empty name matches all statements
+ */
+void CAmDatabaseHandler::invalidateStatements(const std::string& table)
+{
+    MapStatement::iterator iter = mMapStatement.begin();
+    for (; iter != mMapStatement.end(); ++iter)
+    {
+        if (iter->second.statement != NULL && statementUsesTable(iter->first, table))
+        {
+            if (!iter->second.inUse)
+                sqlite3_finalize(iter->second.statement);
+            iter->second.statement = NULL;
+            iter->second.inUse = false;
+        }
+    }
+}
+
+/**
+ * sorts statement statistics by cumulative time, most expensive first
+ */
+static bool compareStatementTime(const std::pair<uint64_t, std::string>& a, const std::pair<uint64_t, std::string>& b)
+{
+    return (a.first > b.first);
+}
+
+/**
+ * logs the number of calls and the cumulative time of every statement, the most expensive statements first
+ */
+void CAmDatabaseHandler::logStatementStatistics() const
+{
+    std::vector<std::pair<uint64_t, std::string> > listStatements;
+    MapStatement::const_iterator iter = mMapStatement.begin();
+    for (; iter != mMapStatement.end(); ++iter)
+        listStatements.push_back(std::make_pair(iter->second.time, iter->first));
+    std::sort(listStatements.begin(), listStatements.end(), compareStatementTime);
+
+    logInfo("DatabaseHandler::logStatementStatistics number of statements:", (uint32_t)listStatements.size());
+    std::vector<std::pair<uint64_t, std::string> >::const_iterator listIterator = listStatements.begin();
+    for (; listIterator != listStatements.end(); ++listIterator)
+    {
+        const am_Statement_s& entry = mMapStatement.find(listIterator->second)->second;
+        logInfo("DatabaseHandler::logStatementStatistics calls:", entry.calls, "time[us]:", (uint64_t)(entry.time / 1000), "statement:", listIterator->second);
+    }
+}
+
+/**
+ * executes a query with a single ID parameter through the statement cache
+ * @param query the query, the ID is bound to the only parameter
+ * @param id the ID
+ * @return true on success
+ */
+bool CAmDatabaseHandler::sqQuery(const std::string& query, const int id)
+{
+    sqlite3_stmt* statement = NULL;
+    int eCode = 0;
+    if ((eCode = prepareStatement(query, &statement)) != SQLITE_OK)
+    {
+        logError("DatabaseHandler::sqQuery SQL Query failed:", query.c_str(), "error code:", eCode);
+        return (false);
+    }
+    if ((eCode = sqlite3_bind_int(statement, 1, id)) != SQLITE_OK)
+    {
+        logError("DatabaseHandler::sqQuery SQL Query failed:", query.c_str(), "error code:", eCode);
+        finalizeStatement(statement);
+        return (false);
+    }
+    eCode = sqlite3_step(statement);
+    finalizeStatement(statement);
+    if (eCode != SQLITE_DONE)
+    {
+        logError("DatabaseHandler::sqQuery SQL Query failed:", query.c_str(), "error code:", eCode);
+        return (false);
+    }
+    return (true);
+}
+
 bool CAmDatabaseHandler::openDatabase()
 {
     if (sqlite3_open_v2(mPath.c_str(), &mpDatabase, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, NULL) == SQLITE_OK)
@@ -2882,6 +3194,7 @@ am_Error_e CAmDatabaseHandler::enterConnectionDB(const am_Connection_s& connecti
     connectionID = sqlite3_last_insert_rowid(mpDatabase);
 
     logInfo("DatabaseHandler::enterConnectionDB entered new connection sourceID=", connection.sourceID, "sinkID=", connection.sinkID, "sourceID=", connection.sourceID, "connectionFormat=", connection.connectionFormat, "assigned ID=", connectionID);
+    mConnectionRevision++;
     return (E_OK);
 }
 
@@ -2934,14 +3247,10 @@ am_Error_e CAmDatabaseHandler::enterSinkClassDB(const am_SinkClass_s & sinkClass
 
     sinkClassID = sqlite3_last_insert_rowid(mpDatabase); //todo:change last_insert implementations for mulithread usage...
 
-    //now we need to create the additional tables:
-    command = "CREATE TABLE SinkClassProperties" + i2s(sinkClassID) + std::string("(classProperty INTEGER, value INTEGER)");
-    if (!this->sqQuery(command))
-        return (E_DATABASE_ERROR);
-
     //fill ConnectionFormats
-    command = "INSERT INTO SinkClassProperties" + i2s(sinkClassID) + std::string("(classProperty,value) VALUES (?,?)");
+    command = "INSERT INTO " + std::string(SINK_CLASSPROPERTY_TABLE) + "(classProperty,value,sinkClassID) VALUES (?,?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sinkClassID)
     std::vector<am_ClassProperty_s>::const_iterator Iterator = sinkClass.listClassProperties.begin();
     for (; Iterator < sinkClass.listClassProperties.end(); ++Iterator)
     {
@@ -3013,13 +3322,10 @@ am_Error_e CAmDatabaseHandler::enterSourceClassDB(am_sourceClass_t & sourceClass
 
     sourceClassID = sqlite3_last_insert_rowid(mpDatabase); //todo:change last_insert implementations for mulithread usage...
 
-    //now we need to create the additional tables:
-    command = "CREATE TABLE SourceClassProperties" + i2s(sourceClassID) + std::string("(classProperty INTEGER, value INTEGER)");
-    assert(sqQuery(command));
-
     //fill ConnectionFormats
-    command = "INSERT INTO SourceClassProperties" + i2s(sourceClassID) + std::string("(classProperty,value) VALUES (?,?)");
+    command = "INSERT INTO " + std::string(SOURCE_CLASSPROPERTY_TABLE) + "(classProperty,value,sourceClassID) VALUES (?,?,?)";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sourceClassID)
     std::vector<am_ClassProperty_s>::const_iterator Iterator = sourceClass.listClassProperties.begin();
     for (; Iterator < sourceClass.listClassProperties.end(); ++Iterator)
     {
@@ -3085,10 +3391,11 @@ am_Error_e CAmDatabaseHandler::enterSystemProperties(const std::vector<am_System
 bool CAmDatabaseHandler::existMainConnection(const am_mainConnectionID_t mainConnectionID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT mainConnectionID FROM " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=" + i2s(mainConnectionID);
+    std::string command = "SELECT mainConnectionID FROM " + std::string(MAINCONNECTION_TABLE) + " WHERE mainConnectionID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, mainConnectionID)
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
     else if (eCode != SQLITE_ROW)
@@ -3109,10 +3416,11 @@ bool CAmDatabaseHandler::existMainConnection(const am_mainConnectionID_t mainCon
 bool CAmDatabaseHandler::existSource(const am_sourceID_t sourceID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE reserved=0 AND sourceID=" + i2s(sourceID);
+    std::string command = "SELECT sourceID FROM " + std::string(SOURCE_TABLE) + " WHERE reserved=0 AND sourceID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, sourceID)
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
     else if (eCode != SQLITE_ROW)
@@ -3141,12 +3449,14 @@ bool CAmDatabaseHandler::existSourceNameOrID(const am_sourceID_t sourceID, const
     if ((eCode = sqlite3_bind_text(query, 1, name.c_str(), name.size(), SQLITE_STATIC)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_text failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
     if ((eCode = sqlite3_bind_int(query, 2, sourceID)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3177,6 +3487,7 @@ bool CAmDatabaseHandler::existSourceName(const std::string & name) const
     if ((eCode = sqlite3_bind_text(query, 1, name.c_str(), name.size(), SQLITE_STATIC)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_text failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3200,10 +3511,11 @@ bool CAmDatabaseHandler::existSourceName(const std::string & name) const
 bool CAmDatabaseHandler::existSink(const am_sinkID_t sinkID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT sinkID FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 AND sinkID=" + i2s(sinkID);
+    std::string command = "SELECT sinkID FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 AND sinkID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, sinkID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
@@ -3233,12 +3545,14 @@ bool CAmDatabaseHandler::existSinkNameOrID(const am_sinkID_t sinkID, const std::
     if ((eCode = sqlite3_bind_text(query, 1, name.c_str(), name.size(), SQLITE_STATIC)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_text failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
     if ((eCode = sqlite3_bind_int(query, 2, sinkID)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3270,6 +3584,7 @@ bool CAmDatabaseHandler::existSinkName(const std::string & name) const
     if ((eCode = sqlite3_bind_text(query, 1, name.c_str(), name.size(), SQLITE_STATIC)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_text failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3293,10 +3608,11 @@ bool CAmDatabaseHandler::existSinkName(const std::string & name) const
 bool CAmDatabaseHandler::existDomain(const am_domainID_t domainID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT domainID FROM " + std::string(DOMAIN_TABLE) + " WHERE reserved=0 AND domainID=" + i2s(domainID);
+    std::string command = "SELECT domainID FROM " + std::string(DOMAIN_TABLE) + " WHERE reserved=0 AND domainID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, domainID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
@@ -3318,10 +3634,11 @@ bool CAmDatabaseHandler::existDomain(const am_domainID_t domainID) const
 bool CAmDatabaseHandler::existGateway(const am_gatewayID_t gatewayID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT gatewayID FROM " + std::string(GATEWAY_TABLE) + " WHERE gatewayID=" + i2s(gatewayID);
+    std::string command = "SELECT gatewayID FROM " + std::string(GATEWAY_TABLE) + " WHERE gatewayID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, gatewayID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
@@ -3340,10 +3657,11 @@ am_Error_e CAmDatabaseHandler::getDomainOfSource(const am_sourceID_t sourceID, a
     assert(sourceID!=0);
 
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT domainID FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=" + i2s(sourceID);
+    std::string command = "SELECT domainID FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=?";
     int eCode = 0;
     am_Error_e returnVal = E_DATABASE_ERROR;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sourceID)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         domainID = sqlite3_column_int(query, 0);
@@ -3363,10 +3681,11 @@ am_Error_e am::CAmDatabaseHandler::getDomainOfSink(const am_sinkID_t sinkID, am_
     assert(sinkID!=0);
 
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT domainID FROM " + std::string(SINK_TABLE) + " WHERE sinkID=" + i2s(sinkID);
+    std::string command = "SELECT domainID FROM " + std::string(SINK_TABLE) + " WHERE sinkID=?";
     int eCode = 0;
     am_Error_e returnVal = E_DATABASE_ERROR;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -3390,10 +3709,11 @@ am_Error_e am::CAmDatabaseHandler::getDomainOfSink(const am_sinkID_t sinkID, am_
 bool CAmDatabaseHandler::existSinkClass(const am_sinkClass_t sinkClassID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT sinkClassID FROM " + std::string(SINK_CLASS_TABLE) + " WHERE sinkClassID=" + i2s(sinkClassID);
+    std::string command = "SELECT sinkClassID FROM " + std::string(SINK_CLASS_TABLE) + " WHERE sinkClassID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, sinkClassID)
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
     else if (eCode != SQLITE_ROW)
@@ -3414,10 +3734,11 @@ bool CAmDatabaseHandler::existSinkClass(const am_sinkClass_t sinkClassID) const
 bool CAmDatabaseHandler::existSourceClass(const am_sourceClass_t sourceClassID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT sourceClassID FROM " + std::string(SOURCE_CLASS_TABLE) + " WHERE sourceClassID=" + i2s(sourceClassID);
+    std::string command = "SELECT sourceClassID FROM " + std::string(SOURCE_CLASS_TABLE) + " WHERE sourceClassID=?";
     int eCode = 0;
     bool returnVal = true;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, sourceClassID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
         returnVal = false;
@@ -3435,8 +3756,8 @@ am_Error_e CAmDatabaseHandler::changeConnectionTimingInformation(const am_connec
 {
     assert(connectionID!=0);
 
-    sqlite3_stmt *query = NULL, *queryMainConnectionSubIDs = NULL;
-    int eCode = 0, eCode1 = 0;
+    sqlite3_stmt *query = NULL;
+    int eCode = 0;
     std::string command = "UPDATE " + std::string(CONNECTION_TABLE) + " set delay=? WHERE connectionID=?";
 
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
@@ -3454,30 +3775,17 @@ am_Error_e CAmDatabaseHandler::changeConnectionTimingInformation(const am_connec
 
     //now we need to find all mainConnections that use the changed connection and update their timing
 
-    int tempMainConnectionID;
-    //first get all route tables for all mainconnections
-    command = "SELECT name FROM sqlite_master WHERE type ='table' and name LIKE 'MainConnectionRoute%'";
+    am_mainConnectionID_t tempMainConnectionID;
+    //the route table is indexed by connectionID, so only the routes containing the connection are read
+    command = "SELECT DISTINCT mainConnectionID FROM " + std::string(MAINCONNECTION_ROUTE_TABLE) + " WHERE connectionID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, connectionID)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
-        //now check if the connection ID is in this table
-        std::string tablename = std::string((const char*) sqlite3_column_text(query, 0));
-        std::string command2 = "SELECT connectionID FROM " + tablename + " WHERE connectionID=" + i2s(connectionID);
-        MY_SQLITE_PREPARE_V2(mpDatabase, command2.c_str(), -1, &queryMainConnectionSubIDs, NULL)
-        if ((eCode1 = sqlite3_step(queryMainConnectionSubIDs)) == SQLITE_ROW)
-        {
-            //if the connection ID is in, recalculate the mainconnection delay
-            std::stringstream(tablename.substr(tablename.find_first_not_of("MainConnectionRoute"))) >> tempMainConnectionID;
-            changeDelayMainConnection(calculateMainConnectionDelay(tempMainConnectionID), tempMainConnectionID);
-        }
-        else if (eCode1 != SQLITE_DONE)
-        {
-            logError("DatabaseHandler::changeConnectionTimingInformation SQLITE error code:", eCode1);
-
-            return (E_DATABASE_ERROR);
-        }
-        MY_SQLITE_FINALIZE(queryMainConnectionSubIDs)
+        //the connection ID is in this route, recalculate the mainconnection delay
+        tempMainConnectionID = sqlite3_column_int(query, 0);
+        changeDelayMainConnection(calculateMainConnectionDelay(tempMainConnectionID), tempMainConnectionID);
     }
 
     if (eCode != SQLITE_DONE)
@@ -3518,11 +3826,12 @@ am_timeSync_t CAmDatabaseHandler::calculateMainConnectionDelay(const am_mainConn
 {
     assert(mainConnectionID!=0);
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT sum(Connections.delay),min(Connections.delay) FROM " + std::string(CONNECTION_TABLE) + ",MainConnectionRoute" + i2s(mainConnectionID) + " WHERE MainConnectionRoute" + i2s(mainConnectionID) + ".connectionID = Connections.connectionID";
+    std::string command = "SELECT sum(Connections.delay),min(Connections.delay) FROM " + std::string(CONNECTION_TABLE) + "," + std::string(MAINCONNECTION_ROUTE_TABLE) + " WHERE MainConnectionRoutes.mainConnectionID=? AND MainConnectionRoutes.connectionID = Connections.connectionID";
     int eCode = 0;
     am_timeSync_t delay = 0;
     am_timeSync_t min = 0;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, mainConnectionID)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         delay = sqlite3_column_int(query, 0);
@@ -3535,18 +3844,85 @@ am_timeSync_t CAmDatabaseHandler::calculateMainConnectionDelay(const am_mainConn
         return (E_DATABASE_ERROR);
     }
 
-    if ((eCode = sqlite3_finalize(query)) != SQLITE_OK)
-    {
-        logError("DatabaseHandler::calculateMainConnectionDelay SQLITE Finalize error code:", eCode);
-        MY_SQLITE_FINALIZE(query)
-        return (E_DATABASE_ERROR);
-    }
+    MY_SQLITE_FINALIZE(query)
     if (min < 0)
         delay = -1;
     return (delay);
 
 }
 
+/**
+ * opens a registration batch. All following changes are written in one sqlite transaction and the
+ * observer collects the command side notifications until the batch is committed.
+ * Batches can be nested, only the outermost commitTransaction writes the batch.
+ * @return E_OK on success, E_DATABASE_ERROR if the transaction could not be started
+ */
+am_Error_e CAmDatabaseHandler::beginTransaction()
+{
+    if (mTransactionDepth == 0)
+    {
+        if (!sqQuery("BEGIN TRANSACTION"))
+        {
+            logError("DatabaseHandler::beginTransaction could not begin transaction");
+            return (E_DATABASE_ERROR);
+        }
+        if (mpDatabaseObserver)
+            mpDatabaseObserver->beginBatch();
+    }
+    mTransactionDepth++;
+    return (E_OK);
+}
+
+/**
+ * closes a registration batch opened with beginTransaction. If the commit fails, the batch is rolled back and
+ * the command side is not told about it.
+ * @return E_OK on success, E_NOT_POSSIBLE if no batch is open, E_DATABASE_ERROR if the commit failed
+ */
+am_Error_e CAmDatabaseHandler::commitTransaction()
+{
+    if (mTransactionDepth == 0)
+    {
+        logError("DatabaseHandler::commitTransaction no transaction open");
+        return (E_NOT_POSSIBLE);
+    }
+
+    if (--mTransactionDepth > 0)
+        return (E_OK);
+
+    if (!sqQuery("COMMIT TRANSACTION"))
+    {
+        //a transaction that stays open would swallow every following change, so it is rolled back
+        logError("DatabaseHandler::commitTransaction could not commit transaction, the changes of the batch are rolled back");
+        if (!sqQuery("ROLLBACK TRANSACTION"))
+            logError("DatabaseHandler::commitTransaction could not roll back transaction");
+        if (mpDatabaseObserver)
+            mpDatabaseObserver->rollbackBatch();
+        return (E_DATABASE_ERROR);
+    }
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->commitBatch();
+    return (E_OK);
+}
+
+/**
+ * the topology revision changes whenever domains, sinks, sources or gateways are entered or removed.
+ * Users that cache routing information compare it to find out if their cache is still valid.
+ * @return the topology revision
+ */
+uint32_t CAmDatabaseHandler::getTopologyRevision() const
+{
+    return (mTopologyRevision);
+}
+
+/**
+ * the connection revision changes whenever connections are entered or removed
+ * @return the connection revision
+ */
+uint32_t CAmDatabaseHandler::getConnectionRevision() const
+{
+    return (mConnectionRevision);
+}
+
 /**
  * registers the Observer at the Database
  * @param iObserver pointer to the observer
@@ -3566,10 +3942,11 @@ bool CAmDatabaseHandler::sourceVisible(const am_sourceID_t sourceID) const
 {
     assert(sourceID!=0);
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT visible FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=" + i2s(sourceID);
+    std::string command = "SELECT visible FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=?";
     int eCode = 0;
     bool returnVal = false;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, sourceID)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
     {
@@ -3593,10 +3970,11 @@ bool CAmDatabaseHandler::sourceVisible(const am_sourceID_t sourceID) const
 bool CAmDatabaseHandler::sinkVisible(const am_sinkID_t sinkID) const
 {
     sqlite3_stmt* query = NULL;
-    std::string command = "SELECT visible FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 AND sinkID=" + i2s(sinkID);
+    std::string command = "SELECT visible FROM " + std::string(SINK_TABLE) + " WHERE reserved=0 AND sinkID=?";
     int eCode = 0;
     bool returnVal = false;
     MY_SQLITE_PREPARE_V2_BOOL(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT_BOOL(query, 1, sinkID)
     if ((eCode = sqlite3_step(query)) == SQLITE_DONE)
     {
         returnVal = sqlite3_column_int(query, 0);
@@ -3628,18 +4006,21 @@ bool CAmDatabaseHandler::existConnection(const am_Connection_s connection)
     if ((eCode = sqlite3_bind_int(query, 1, connection.sinkID)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
     if ((eCode = sqlite3_bind_int(query, 2, connection.sourceID)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
     if ((eCode = sqlite3_bind_int(query, 3, connection.connectionFormat)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3671,6 +4052,7 @@ bool CAmDatabaseHandler::existConnectionID(const am_connectionID_t connectionID)
     if ((eCode = sqlite3_bind_int(query, 1, connectionID)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3702,6 +4084,7 @@ bool CAmDatabaseHandler::existcrossFader(const am_crossfaderID_t crossfaderID) c
     if ((eCode = sqlite3_bind_int(query, 1, crossfaderID)))
     {
         logError("CAmDatabaseHandler::sqlite3_bind_int failed with errorCode:", eCode);
+        finalizeStatement(query);
         return (false);
     }
 
@@ -3722,9 +4105,10 @@ am_Error_e CAmDatabaseHandler::getSoureState(const am_sourceID_t sourceID, am_So
     assert(sourceID!=0);
     sqlite3_stmt* query = NULL;
     sourceState = SS_UNKNNOWN;
-    std::string command = "SELECT sourceState FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=" + i2s(sourceID);
+    std::string command = "SELECT sourceState FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=?";
     int eCode = 0;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sourceID)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         sourceState = (am_SourceState_e) sqlite3_column_int(query, 0);
@@ -3742,9 +4126,10 @@ am_Error_e CAmDatabaseHandler::changeSourceState(const am_sourceID_t sourceID, c
     assert(sourceID!=0);
     assert(sourceState>=SS_UNKNNOWN && sourceState<=SS_MAX);
     sqlite3_stmt* query = NULL;
-    std::string command = "UPDATE " + std::string(SOURCE_TABLE) + " SET sourceState=? WHERE sourceID=" + i2s(sourceID);
+    std::string command = "UPDATE " + std::string(SOURCE_TABLE) + " SET sourceState=? WHERE sourceID=?";
     int eCode = 0;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sourceID)
     MY_SQLITE_BIND_INT(query, 1, sourceState)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -3762,9 +4147,10 @@ am_Error_e CAmDatabaseHandler::getSinkVolume(const am_sinkID_t sinkID, am_volume
     assert(sinkID!=0);
     sqlite3_stmt* query = NULL;
     volume = -1;
-    std::string command = "SELECT volume FROM " + std::string(SINK_TABLE) + " WHERE sinkID=" + i2s(sinkID);
+    std::string command = "SELECT volume FROM " + std::string(SINK_TABLE) + " WHERE sinkID=?";
     int eCode = 0;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sinkID)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         volume = sqlite3_column_int(query, 0);
@@ -3782,9 +4168,10 @@ am_Error_e CAmDatabaseHandler::getSourceVolume(const am_sourceID_t sourceID, am_
     assert(sourceID!=0);
     sqlite3_stmt* query = NULL;
     volume = -1;
-    std::string command = "SELECT volume FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=" + i2s(sourceID);
+    std::string command = "SELECT volume FROM " + std::string(SOURCE_TABLE) + " WHERE sourceID=?";
     int eCode = 0;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, sourceID)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         volume = sqlite3_column_int(query, 0);
@@ -3805,8 +4192,10 @@ am_Error_e CAmDatabaseHandler::getSinkSoundPropertyValue(const am_sinkID_t sinkI
 
     sqlite3_stmt* query = NULL;
     int eCode = 0;
-    std::string command = "SELECT value FROM SinkSoundProperty" + i2s(sinkID) + " WHERE soundPropertyType=" + i2s(propertyType);
+    std::string command = "SELECT value FROM " + std::string(SINK_SOUNDPROPERTY_TABLE) + " WHERE soundPropertyType=? AND sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sinkID)
+    MY_SQLITE_BIND_INT(query, 1, propertyType)
 
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -3832,8 +4221,10 @@ am_Error_e CAmDatabaseHandler::getSourceSoundPropertyValue(const am_sourceID_t s
 
     sqlite3_stmt* query = NULL;
     int eCode = 0;
-    std::string command = "SELECT value FROM SourceSoundProperty" + i2s(sourceID) + " WHERE soundPropertyType=" + i2s(propertyType);
+    std::string command = "SELECT value FROM " + std::string(SOURCE_SOUNDPROPERTY_TABLE) + " WHERE soundPropertyType=? AND sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sourceID)
+    MY_SQLITE_BIND_INT(query, 1, propertyType)
 
     while ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
@@ -3857,9 +4248,10 @@ am_Error_e CAmDatabaseHandler::getDomainState(const am_domainID_t domainID, am_D
     assert(domainID!=0);
     sqlite3_stmt* query = NULL;
     state = DS_UNKNOWN;
-    std::string command = "SELECT domainState FROM " + std::string(DOMAIN_TABLE) + " WHERE domainID=" + i2s(domainID);
+    std::string command = "SELECT domainState FROM " + std::string(DOMAIN_TABLE) + " WHERE domainID=?";
     int eCode = 0;
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 1, domainID)
     if ((eCode = sqlite3_step(query)) == SQLITE_ROW)
     {
         state = (am_DomainState_e) sqlite3_column_int(query, 0);
@@ -4022,8 +4414,9 @@ am_Error_e CAmDatabaseHandler::changeSinkVolume(const am_sinkID_t sinkID, const
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(SINK_TABLE) + " SET volume=? WHERE sinkID=" + i2s(sinkID);
+    command = "UPDATE " + std::string(SINK_TABLE) + " SET volume=? WHERE sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sinkID)
     MY_SQLITE_BIND_INT(query, 1, volume)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -4049,8 +4442,9 @@ am_Error_e CAmDatabaseHandler::changeSourceVolume(const am_sourceID_t sourceID,
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(SOURCE_TABLE) + " SET volume=? WHERE sourceID=" + i2s(sourceID);
+    command = "UPDATE " + std::string(SOURCE_TABLE) + " SET volume=? WHERE sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, sourceID)
     MY_SQLITE_BIND_INT(query, 1, volume)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -4078,8 +4472,10 @@ am_Error_e CAmDatabaseHandler::changeSourceSoundPropertyDB(const am_SoundPropert
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE SourceSoundProperty" + i2s(sourceID) + " SET value=? WHERE soundPropertyType=" + i2s(soundProperty.type);
+    command = "UPDATE " + std::string(SOURCE_SOUNDPROPERTY_TABLE) + " SET value=? WHERE soundPropertyType=? AND sourceID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sourceID)
+    MY_SQLITE_BIND_INT(query, 2, soundProperty.type)
     MY_SQLITE_BIND_INT(query, 1, soundProperty.value)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -4106,8 +4502,10 @@ am_Error_e CAmDatabaseHandler::changeSinkSoundPropertyDB(const am_SoundProperty_
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE SinkSoundProperty" + i2s(sinkID) + " SET value=? WHERE soundPropertyType=" + i2s(soundProperty.type);
+    command = "UPDATE " + std::string(SINK_SOUNDPROPERTY_TABLE) + " SET value=? WHERE soundPropertyType=? AND sinkID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 3, sinkID)
+    MY_SQLITE_BIND_INT(query, 2, soundProperty.type)
     MY_SQLITE_BIND_INT(query, 1, soundProperty.value)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -4135,8 +4533,9 @@ am_Error_e CAmDatabaseHandler::changeCrossFaderHotSink(const am_crossfaderID_t c
     {
         return (E_NON_EXISTENT);
     }
-    command = "UPDATE " + std::string(CROSSFADER_TABLE) + " SET hotsink=? WHERE crossfaderID=" + i2s(crossfaderID);
+    command = "UPDATE " + std::string(CROSSFADER_TABLE) + " SET hotsink=? WHERE crossfaderID=?";
     MY_SQLITE_PREPARE_V2(mpDatabase, command.c_str(), -1, &query, NULL)
+    MY_SQLITE_BIND_INT(query, 2, crossfaderID)
     MY_SQLITE_BIND_INT(query, 1, hotsink)
     if ((eCode = sqlite3_step(query)) != SQLITE_DONE)
     {
@@ -4261,5 +4660,10 @@ void CAmDatabaseHandler::createTables()
         if (!sqQuery("CREATE TABLE " + databaseTables[i]))
             throw std::runtime_error("CAmDatabaseHandler Could not create tables!");
     }
+    for (uint16_t i = 0; i < sizeof(databaseIndexes) / sizeof(databaseIndexes[0]); i++)
+    {
+        if (!sqQuery("CREATE INDEX " + databaseIndexes[i]))
+            throw std::runtime_error("CAmDatabaseHandler Could not create indexes!");
+    }
 }
 }
@@ -0,0 +1,1988 @@
+/**
+ * Copyright (C) 2026, AudioManager contributors
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author AudioManager contributors 2026
+ *
+ * \file CAmDatabaseHandlerMap.cpp
+ * For further information see http://www.genivi.org/.
+ *
+ * In-memory implementation of CAmDatabaseHandler, selected with WITH_DATABASE_MAP.
+ * All objects are kept in maps indexed by their ID, so lookups need no SQL at all.
+ * The behaviour including the ID assignment follows the sqlite implementation.
+ *
+ */
+
+#include "CAmDatabaseHandler.h"
+#include <cassert>
+#include <limits>
+#include <vector>
+#include <string>
+#include "CAmDatabaseObserver.h"
+#include "CAmRouter.h"
+#include "shared/CAmDltWrapper.h"
+
+namespace am
+{
+
+/**
+ * hands out the next ID like an autoincrement column: one above the highest ID ever used
+ * @param lastID the highest ID used so far, is updated
+ * @param newID the new ID
+ * @return false if the ID range is exhausted
+ */
+template<typename T>
+inline bool nextID(T& lastID, T& newID)
+{
+    if (lastID == std::numeric_limits<T>::max())
+        return (false);
+    newID = ++lastID;
+    return (true);
+}
+
+/**
+ * records a statically assigned ID, so that generated IDs are always above it
+ * @param lastID the highest ID used so far, is updated
+ * @param id the assigned ID
+ */
+template<typename T>
+inline void useID(T& lastID, const T id)
+{
+    if (id > lastID)
+        lastID = id;
+}
+
+CAmDatabaseHandler::CAmDatabaseHandler(std::string databasePath) :
+        mMapDomain(), //
+        mMapSourceClass(), //
+        mMapSinkClass(), //
+        mMapSink(), //
+        mMapSource(), //
+        mMapGateway(), //
+        mMapCrossfader(), //
+        mMapConnection(), //
+        mMapMainConnection(), //
+        mListSystemProperties(), //
+        mLastDomainID(0), //
+        mLastSourceClassID(0), //
+        mLastSinkClassID(0), //
+        mLastSinkID(0), //
+        mLastSourceID(0), //
+        mLastGatewayID(0), //
+        mLastCrossfaderID(0), //
+        mLastConnectionID(0), //
+        mLastMainConnectionID(0), //
+        mPath(databasePath), //
+        mpDatabaseObserver(NULL), //
+        mFirstStaticSink(true), //
+        mFirstStaticSource(true), //
+        mFirstStaticGateway(true), //
+        mFirstStaticSinkClass(true), //
+        mFirstStaticSourceClass(true), //
+        mFirstStaticCrossfader(true), //
+        mTransactionDepth(0), //
+        mTopologyRevision(0), //
+        mConnectionRevision(0)
+{
+    logInfo("DatabaseHandler::DatabaseHandler uses the in-memory object model, database path not used:", mPath);
+}
+
+CAmDatabaseHandler::~CAmDatabaseHandler()
+{
+    logInfo("Closed Database");
+}
+
+am_Error_e CAmDatabaseHandler::enterDomainDB(const am_Domain_s & domainData, am_domainID_t & domainID)
+{
+    assert(domainData.domainID==0);
+    assert(!domainData.name.empty());
+    assert(!domainData.busname.empty());
+    assert(domainData.state>=DS_UNKNOWN && domainData.state<=DS_MAX);
+
+    //first check for a reserved domain
+    MapDomain::iterator iter = mMapDomain.begin();
+    for (; iter != mMapDomain.end(); ++iter)
+    {
+        if (iter->second.domain.name == domainData.name)
+            break;
+    }
+
+    if (iter != mMapDomain.end())
+    {
+        domainID = iter->first;
+    }
+    else if (!nextID(mLastDomainID, domainID))
+    {
+        logError("DatabaseHandler::enterDomainDB no more domainIDs available");
+        return (E_DATABASE_ERROR);
+    }
+
+    am_DomainEntry_s& entry = mMapDomain[domainID];
+    entry.domain = domainData;
+    entry.domain.domainID = domainID;
+    entry.reserved = false;
+
+    logInfo("DatabaseHandler::enterDomainDB entered new domain with name=", domainData.name, "busname=", domainData.busname, "nodename=", domainData.nodename, "state=", domainData.state, "assigned ID:", domainID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->newDomain(entry.domain);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterMainConnectionDB(const am_MainConnection_s & mainConnectionData, am_mainConnectionID_t & connectionID)
+{
+    assert(mainConnectionData.mainConnectionID==0);
+    assert(mainConnectionData.connectionState>=CS_UNKNOWN && mainConnectionData.connectionState<=CS_MAX);
+    assert(mainConnectionData.sinkID!=0);
+    assert(mainConnectionData.sourceID!=0);
+
+    //the route must only consist of known connections, the delay is the sum of all connection delays
+    int16_t delay = 0;
+    std::vector<am_connectionID_t>::const_iterator elementIterator = mainConnectionData.listConnectionID.begin();
+    for (; elementIterator != mainConnectionData.listConnectionID.end(); ++elementIterator)
+    {
+        MapConnection::const_iterator connection = mMapConnection.find(*elementIterator);
+        if (connection == mMapConnection.end())
+        {
+            logError("DatabaseHandler::enterMainConnectionDB did not find route for MainConnection:", *elementIterator);
+            return (E_DATABASE_ERROR);
+        }
+        if (connection->second.connection.delay != -1 && delay != -1)
+            delay += connection->second.connection.delay;
+        else
+            delay = -1;
+    }
+
+    if (!nextID(mLastMainConnectionID, connectionID))
+    {
+        logError("DatabaseHandler::enterMainConnectionDB no more mainConnectionIDs available");
+        return (E_DATABASE_ERROR);
+    }
+
+    am_MainConnection_s& mainConnection = mMapMainConnection[connectionID];
+    mainConnection = mainConnectionData;
+    mainConnection.mainConnectionID = connectionID;
+    mainConnection.delay = -1;
+
+    logInfo("DatabaseHandler::enterMainConnectionDB entered new mainConnection with sourceID", mainConnectionData.sourceID, "sinkID:", mainConnectionData.sinkID, "delay:", delay, "assigned ID:", connectionID);
+
+    if (mpDatabaseObserver)
+    {
+        am_MainConnectionType_s mainConnectionType;
+        mainConnectionType.mainConnectionID = connectionID;
+        mainConnectionType.sourceID = mainConnectionData.sourceID;
+        mainConnectionType.sinkID = mainConnectionData.sinkID;
+        mainConnectionType.connectionState = mainConnectionData.connectionState;
+        mainConnectionType.delay = delay;
+        mpDatabaseObserver->newMainConnection(mainConnectionType);
+        mpDatabaseObserver->mainConnectionStateChanged(connectionID, mainConnectionData.connectionState);
+    }
+
+    //finally, we update the delay value for the maintable
+    if (delay == 0)
+        delay = -1;
+    return (changeDelayMainConnection(delay, connectionID));
+}
+
+am_Error_e CAmDatabaseHandler::enterSinkDB(const am_Sink_s & sinkData, am_sinkID_t & sinkID)
+{
+    assert(sinkData.sinkID<DYNAMIC_ID_BOUNDARY);
+    assert(sinkData.domainID!=0);
+    assert(!sinkData.name.empty());
+    assert(sinkData.sinkClassID!=0);
+    assert(!sinkData.listConnectionFormats.empty());
+    assert(sinkData.muteState>=MS_UNKNOWN && sinkData.muteState<=MS_MAX);
+
+    //check if a reserved sink with that name exists
+    MapSink::const_iterator iter = mMapSink.begin();
+    for (; iter != mMapSink.end(); ++iter)
+    {
+        if (iter->second.reserved && iter->second.sink.name == sinkData.name)
+            break;
+    }
+
+    if (iter != mMapSink.end())
+    {
+        sinkID = iter->first;
+    }
+    else if (sinkData.sinkID == 0 && !mFirstStaticSink && !existSinkName(sinkData.name))
+    {
+        if (!nextID(mLastSinkID, sinkID))
+        {
+            logError("DatabaseHandler::enterSinkDB no more sinkIDs available");
+            return (E_DATABASE_ERROR);
+        }
+    }
+    else
+    {
+        //check if the ID already exists
+        if (existSinkNameOrID(sinkData.sinkID, sinkData.name))
+            return (E_ALREADY_EXISTS);
+
+        //the first dynamic sink starts at the boundary
+        if (sinkData.sinkID != 0)
+        {
+            sinkID = sinkData.sinkID;
+        }
+        else
+        {
+            sinkID = DYNAMIC_ID_BOUNDARY;
+            mFirstStaticSink = false;
+        }
+
+        if (mMapSink.find(sinkID) != mMapSink.end())
+        {
+            logError("DatabaseHandler::enterSinkDB sinkID already reserved by other name:", sinkID);
+            return (E_ALREADY_EXISTS);
+        }
+        useID(mLastSinkID, sinkID);
+    }
+
+    am_SinkEntry_s& entry = mMapSink[sinkID];
+    entry.sink = sinkData;
+    entry.sink.sinkID = sinkID;
+    entry.reserved = false;
+
+    //main sound properties are only kept for visible sinks
+    if (!entry.sink.visible)
+        entry.sink.listMainSoundProperties.clear();
+
+    logInfo("DatabaseHandler::enterSinkDB entered new sink with name", sinkData.name, "domainID:", sinkData.domainID, "classID:", sinkData.sinkClassID, "volume:", sinkData.volume, "assigned ID:", sinkID);
+
+    if (mpDatabaseObserver != NULL)
+        mpDatabaseObserver->newSink(entry.sink);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterCrossfaderDB(const am_Crossfader_s & crossfaderData, am_crossfaderID_t & crossfaderID)
+{
+    assert(crossfaderData.crossfaderID<DYNAMIC_ID_BOUNDARY);
+    assert(crossfaderData.hotSink>=HS_UNKNOWN && crossfaderData.hotSink<=HS_MAX);
+    assert(!crossfaderData.name.empty());
+    assert(existSink(crossfaderData.sinkID_A));
+    assert(existSink(crossfaderData.sinkID_B));
+    assert(existSource(crossfaderData.sourceID));
+
+    if (crossfaderData.crossfaderID == 0 && !mFirstStaticCrossfader)
+    {
+        if (!nextID(mLastCrossfaderID, crossfaderID))
+        {
+            logError("DatabaseHandler::enterCrossfaderDB no more crossfaderIDs available");
+            return (E_DATABASE_ERROR);
+        }
+    }
+    else
+    {
+        //check if the ID already exists
+        if (existcrossFader(crossfaderData.crossfaderID))
+            return (E_ALREADY_EXISTS);
+
+        //the first dynamic crossfader starts at the boundary
+        if (crossfaderData.crossfaderID != 0)
+        {
+            crossfaderID = crossfaderData.crossfaderID;
+        }
+        else
+        {
+            crossfaderID = DYNAMIC_ID_BOUNDARY;
+            mFirstStaticCrossfader = false;
+        }
+        useID(mLastCrossfaderID, crossfaderID);
+    }
+
+    am_Crossfader_s& crossfader = mMapCrossfader[crossfaderID];
+    crossfader = crossfaderData;
+    crossfader.crossfaderID = crossfaderID;
+
+    logInfo("DatabaseHandler::enterCrossfaderDB entered new crossfader with name=", crossfaderData.name, "sinkA= ", crossfaderData.sinkID_A, "sinkB=", crossfaderData.sinkID_B, "source=", crossfaderData.sourceID, "assigned ID:", crossfaderID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->newCrossfader(crossfader);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterGatewayDB(const am_Gateway_s & gatewayData, am_gatewayID_t & gatewayID)
+{
+    assert(gatewayData.gatewayID<DYNAMIC_ID_BOUNDARY);
+    assert(gatewayData.sinkID!=0);
+    assert(gatewayData.sourceID!=0);
+    assert(gatewayData.controlDomainID!=0);
+    assert(gatewayData.domainSinkID!=0);
+    assert(gatewayData.domainSourceID!=0);
+    assert(!gatewayData.name.empty());
+    assert(!gatewayData.convertionMatrix.empty());
+    assert(!gatewayData.listSinkFormats.empty());
+    assert(!gatewayData.listSourceFormats.empty());
+    assert(existSink(gatewayData.sinkID));
+    assert(existSource(gatewayData.sourceID));
+
+    if (gatewayData.gatewayID == 0 && !mFirstStaticGateway)
+    {
+        if (!nextID(mLastGatewayID, gatewayID))
+        {
+            logError("DatabaseHandler::enterGatewayDB no more gatewayIDs available");
+            return (E_DATABASE_ERROR);
+        }
+    }
+    else
+    {
+        //check if the ID already exists
+        if (existGateway(gatewayData.gatewayID))
+            return (E_ALREADY_EXISTS);
+
+        //the first dynamic gateway starts at the boundary
+        if (gatewayData.gatewayID != 0)
+        {
+            gatewayID = gatewayData.gatewayID;
+        }
+        else
+        {
+            gatewayID = DYNAMIC_ID_BOUNDARY;
+            mFirstStaticGateway = false;
+        }
+        useID(mLastGatewayID, gatewayID);
+    }
+
+    am_Gateway_s& gateway = mMapGateway[gatewayID];
+    gateway = gatewayData;
+    gateway.gatewayID = gatewayID;
+
+    logInfo("DatabaseHandler::enterGatewayDB entered new gateway with name", gatewayData.name, "sourceID:", gatewayData.sourceID, "sinkID:", gatewayData.sinkID, "controlDomainID:", gatewayData.controlDomainID, "assigned ID:", gatewayID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->newGateway(gateway);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterSourceDB(const am_Source_s & sourceData, am_sourceID_t & sourceID)
+{
+    assert(sourceData.sourceID<DYNAMIC_ID_BOUNDARY);
+    assert(sourceData.domainID!=0);
+    assert(!sourceData.name.empty());
+    assert(sourceData.sourceClassID!=0);
+    assert(!sourceData.listConnectionFormats.empty());
+    assert(sourceData.sourceState>=SS_UNKNNOWN && sourceData.sourceState<=SS_MAX);
+
+    //check if a reserved source with that name exists
+    MapSource::const_iterator iter = mMapSource.begin();
+    for (; iter != mMapSource.end(); ++iter)
+    {
+        if (iter->second.reserved && iter->second.source.name == sourceData.name)
+            break;
+    }
+
+    if (iter != mMapSource.end())
+    {
+        sourceID = iter->first;
+    }
+    else if (sourceData.sourceID == 0 && !mFirstStaticSource && !existSourceName(sourceData.name))
+    {
+        if (!nextID(mLastSourceID, sourceID))
+        {
+            logError("DatabaseHandler::enterSourceDB no more sourceIDs available");
+            return (E_DATABASE_ERROR);
+        }
+    }
+    else
+    {
+        //check if the ID already exists
+        if (existSourceNameOrID(sourceData.sourceID, sourceData.name))
+            return (E_ALREADY_EXISTS);
+
+        //the first dynamic source starts at the boundary
+        if (sourceData.sourceID != 0)
+        {
+            sourceID = sourceData.sourceID;
+        }
+        else
+        {
+            sourceID = DYNAMIC_ID_BOUNDARY;
+            mFirstStaticSource = false;
+        }
+
+        if (mMapSource.find(sourceID) != mMapSource.end())
+        {
+            logError("DatabaseHandler::enterSourceDB sourceID already reserved by other name:", sourceID);
+            return (E_ALREADY_EXISTS);
+        }
+        useID(mLastSourceID, sourceID);
+    }
+
+    am_SourceEntry_s& entry = mMapSource[sourceID];
+    entry.source = sourceData;
+    entry.source.sourceID = sourceID;
+    entry.reserved = false;
+
+    //main sound properties are only kept for visible sources
+    if (!entry.source.visible)
+        entry.source.listMainSoundProperties.clear();
+
+    logInfo("DatabaseHandler::enterSourceDB entered new source with name", sourceData.name, "domainID:", sourceData.domainID, "classID:", sourceData.sourceClassID, "visible:", sourceData.visible, "assigned ID:", sourceID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->newSource(entry.source);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeMainConnectionRouteDB(const am_mainConnectionID_t mainconnectionID, const std::vector<am_connectionID_t>& listConnectionID)
+{
+    assert(mainconnectionID!=0);
+
+    MapMainConnection::iterator iter = mMapMainConnection.find(mainconnectionID);
+    if (iter == mMapMainConnection.end())
+        return (E_NON_EXISTENT);
+
+    std::vector<am_connectionID_t>::const_iterator elementIterator = listConnectionID.begin();
+    for (; elementIterator != listConnectionID.end(); ++elementIterator)
+    {
+        if (mMapConnection.find(*elementIterator) == mMapConnection.end())
+        {
+            logError("DatabaseHandler::changeMainConnectionRouteDB did not find route for MainConnection:", *elementIterator);
+            return (E_DATABASE_ERROR);
+        }
+    }
+
+    iter->second.listConnectionID = listConnectionID;
+
+    logInfo("DatabaseHandler::changeMainConnectionRouteDB entered new route:", mainconnectionID);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeMainConnectionStateDB(const am_mainConnectionID_t mainconnectionID, const am_ConnectionState_e connectionState)
+{
+    assert(mainconnectionID!=0);
+    assert(connectionState>=CS_UNKNOWN && connectionState<=CS_MAX);
+
+    MapMainConnection::iterator iter = mMapMainConnection.find(mainconnectionID);
+    if (iter == mMapMainConnection.end())
+        return (E_NON_EXISTENT);
+
+    iter->second.connectionState = connectionState;
+
+    logInfo("DatabaseHandler::changeMainConnectionStateDB changed mainConnectionState of MainConnection:", mainconnectionID, "to:", connectionState);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->mainConnectionStateChanged(mainconnectionID, connectionState);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSinkMainVolumeDB(const am_mainVolume_t mainVolume, const am_sinkID_t sinkID)
+{
+    assert(sinkID!=0);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.sink.mainVolume = mainVolume;
+
+    logInfo("DatabaseHandler::changeSinkMainVolumeDB changed mainVolume of sink:", sinkID, "to:", mainVolume);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->volumeChanged(sinkID, mainVolume);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSinkAvailabilityDB(const am_Availability_s & availability, const am_sinkID_t sinkID)
+{
+    assert(sinkID!=0);
+    assert(availability.availability>=A_UNKNOWN && availability.availability<=A_MAX);
+    assert(availability.availabilityReason>=AR_UNKNOWN && availability.availabilityReason<=AR_MAX);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.sink.available = availability;
+
+    logInfo("DatabaseHandler::changeSinkAvailabilityDB changed sinkAvailability of sink:", sinkID, "to:", availability.availability, "Reason:", availability.availabilityReason);
+
+    if (mpDatabaseObserver && iter->second.sink.visible)
+        mpDatabaseObserver->sinkAvailabilityChanged(sinkID, availability);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changDomainStateDB(const am_DomainState_e domainState, const am_domainID_t domainID)
+{
+    assert(domainID!=0);
+    assert(domainState>=DS_UNKNOWN && domainState<=DS_MAX);
+
+    MapDomain::iterator iter = mMapDomain.find(domainID);
+    if (iter == mMapDomain.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.domain.state = domainState;
+
+    logInfo("DatabaseHandler::changDomainStateDB changed domainState of domain:", domainID, "to:", domainState);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSinkMuteStateDB(const am_MuteState_e muteState, const am_sinkID_t sinkID)
+{
+    assert(sinkID!=0);
+    assert(muteState>=MS_UNKNOWN && muteState<=MS_MAX);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.sink.muteState = muteState;
+
+    logInfo("DatabaseHandler::changeSinkMuteStateDB changed sinkMuteState of sink:", sinkID, "to:", muteState);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->sinkMuteStateChanged(sinkID, muteState);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeMainSinkSoundPropertyDB(const am_MainSoundProperty_s & soundProperty, const am_sinkID_t sinkID)
+{
+    assert(soundProperty.type>=MSP_UNKNOWN && soundProperty.type<=MSP_MAX);
+    assert(sinkID!=0);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    std::vector<am_MainSoundProperty_s>::iterator propertyIterator = iter->second.sink.listMainSoundProperties.begin();
+    for (; propertyIterator != iter->second.sink.listMainSoundProperties.end(); ++propertyIterator)
+    {
+        if (propertyIterator->type == soundProperty.type)
+            propertyIterator->value = soundProperty.value;
+    }
+
+    logInfo("DatabaseHandler::changeMainSinkSoundPropertyDB changed MainSinkSoundProperty of sink:", sinkID, "type:", soundProperty.type, "to:", soundProperty.value);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->mainSinkSoundPropertyChanged(sinkID, soundProperty);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeMainSourceSoundPropertyDB(const am_MainSoundProperty_s & soundProperty, const am_sourceID_t sourceID)
+{
+    assert(soundProperty.type>=MSP_UNKNOWN && soundProperty.type<=MSP_MAX);
+    assert(sourceID!=0);
+
+    MapSource::iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    std::vector<am_MainSoundProperty_s>::iterator propertyIterator = iter->second.source.listMainSoundProperties.begin();
+    for (; propertyIterator != iter->second.source.listMainSoundProperties.end(); ++propertyIterator)
+    {
+        if (propertyIterator->type == soundProperty.type)
+            propertyIterator->value = soundProperty.value;
+    }
+
+    logInfo("DatabaseHandler::changeMainSourceSoundPropertyDB changed MainSinkSoundProperty of source:", sourceID, "type:", soundProperty.type, "to:", soundProperty.value);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->mainSourceSoundPropertyChanged(sourceID, soundProperty);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSourceAvailabilityDB(const am_Availability_s & availability, const am_sourceID_t sourceID)
+{
+    assert(sourceID!=0);
+    assert(availability.availability>=A_UNKNOWN && availability.availability<=A_MAX);
+    assert(availability.availabilityReason>=AR_UNKNOWN && availability.availabilityReason<=AR_MAX);
+
+    MapSource::iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.source.available = availability;
+
+    logInfo("DatabaseHandler::changeSourceAvailabilityDB changed changeSourceAvailabilityDB of source:", sourceID, "to:", availability.availability, "Reason:", availability.availabilityReason);
+
+    if (mpDatabaseObserver && iter->second.source.visible)
+        mpDatabaseObserver->sourceAvailabilityChanged(sourceID, availability);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSystemPropertyDB(const am_SystemProperty_s & property)
+{
+    assert(property.type>=SYP_UNKNOWN && property.type<=SYP_MAX);
+
+    std::vector<am_SystemProperty_s>::iterator iter = mListSystemProperties.begin();
+    for (; iter != mListSystemProperties.end(); ++iter)
+    {
+        if (iter->type == property.type)
+            iter->value = property.value;
+    }
+
+    logInfo("DatabaseHandler::changeSystemPropertyDB changed system property");
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->systemPropertyChanged(property);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeMainConnectionDB(const am_mainConnectionID_t mainConnectionID)
+{
+    assert(mainConnectionID!=0);
+
+    if (mMapMainConnection.erase(mainConnectionID) == 0)
+        return (E_NON_EXISTENT);
+
+    logInfo("DatabaseHandler::removeMainConnectionDB removed:", mainConnectionID);
+
+    if (mpDatabaseObserver)
+    {
+        mpDatabaseObserver->mainConnectionStateChanged(mainConnectionID, CS_DISCONNECTED);
+        mpDatabaseObserver->removedMainConnection(mainConnectionID);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeSinkDB(const am_sinkID_t sinkID)
+{
+    assert(sinkID!=0);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    bool visible = iter->second.sink.visible;
+    mMapSink.erase(iter);
+
+    logInfo("DatabaseHandler::removeSinkDB removed:", sinkID);
+
+    if (mpDatabaseObserver != NULL)
+        mpDatabaseObserver->removedSink(sinkID, visible);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeSourceDB(const am_sourceID_t sourceID)
+{
+    assert(sourceID!=0);
+
+    MapSource::iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    bool visible = iter->second.source.visible;
+    mMapSource.erase(iter);
+
+    logInfo("DatabaseHandler::removeSourceDB removed:", sourceID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->removedSource(sourceID, visible);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeGatewayDB(const am_gatewayID_t gatewayID)
+{
+    assert(gatewayID!=0);
+
+    if (mMapGateway.erase(gatewayID) == 0)
+        return (E_NON_EXISTENT);
+
+    logInfo("DatabaseHandler::removeGatewayDB removed:", gatewayID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->removeGateway(gatewayID);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeCrossfaderDB(const am_crossfaderID_t crossfaderID)
+{
+    assert(crossfaderID!=0);
+
+    if (mMapCrossfader.erase(crossfaderID) == 0)
+        return (E_NON_EXISTENT);
+
+    logInfo("DatabaseHandler::removeCrossfaderDB removed:", crossfaderID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->removeCrossfader(crossfaderID);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeDomainDB(const am_domainID_t domainID)
+{
+    assert(domainID!=0);
+
+    MapDomain::iterator iter = mMapDomain.find(domainID);
+    if (iter == mMapDomain.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    mMapDomain.erase(iter);
+
+    logInfo("DatabaseHandler::removeDomainDB removed:", domainID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->removeDomain(domainID);
+    mTopologyRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeSinkClassDB(const am_sinkClass_t sinkClassID)
+{
+    assert(sinkClassID!=0);
+
+    if (mMapSinkClass.erase(sinkClassID) == 0)
+        return (E_NON_EXISTENT);
+
+    logInfo("DatabaseHandler::removeSinkClassDB removed:", sinkClassID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->numberOfSinkClassesChanged();
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeSourceClassDB(const am_sourceClass_t sourceClassID)
+{
+    assert(sourceClassID!=0);
+
+    if (mMapSourceClass.erase(sourceClassID) == 0)
+        return (E_NON_EXISTENT);
+
+    logInfo("DatabaseHandler::removeSourceClassDB removed:", sourceClassID);
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->numberOfSourceClassesChanged();
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::removeConnection(const am_connectionID_t connectionID)
+{
+    assert(connectionID!=0);
+
+    mMapConnection.erase(connectionID);
+
+    logInfo("DatabaseHandler::removeConnection removed:", connectionID);
+    mConnectionRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSourceClassInfoDB(const am_sourceID_t sourceID, am_SourceClass_s & classInfo) const
+{
+    assert(sourceID!=0);
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    MapSourceClass::const_iterator classIterator = mMapSourceClass.find(iter->second.source.sourceClassID);
+    if (classIterator == mMapSourceClass.end())
+    {
+        logError("DatabaseHandler::getSourceClassInfoDB sourceClass not found:", iter->second.source.sourceClassID);
+        return (E_DATABASE_ERROR);
+    }
+
+    classInfo = classIterator->second;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSinkInfoDB(const am_sinkID_t sinkID, am_Sink_s & sinkData) const
+{
+    assert(sinkID!=0);
+
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    sinkData = iter->second.sink;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSourceInfoDB(const am_sourceID_t sourceID, am_Source_s & sourceData) const
+{
+    assert(sourceID!=0);
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    sourceData = iter->second.source;
+    return (E_OK);
+}
+
+am_Error_e am::CAmDatabaseHandler::getMainConnectionInfoDB(const am_mainConnectionID_t mainConnectionID, am_MainConnection_s & mainConnectionData) const
+{
+    assert(mainConnectionID!=0);
+
+    MapMainConnection::const_iterator iter = mMapMainConnection.find(mainConnectionID);
+    if (iter == mMapMainConnection.end())
+        return (E_NON_EXISTENT);
+
+    mainConnectionData = iter->second;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSinkClassInfoDB(const am_SinkClass_s& sinkClass)
+{
+    assert(sinkClass.sinkClassID!=0);
+    assert(!sinkClass.listClassProperties.empty());
+
+    MapSinkClass::iterator iter = mMapSinkClass.find(sinkClass.sinkClassID);
+    if (iter == mMapSinkClass.end())
+        return (E_NON_EXISTENT);
+
+    //only the values of the known properties are changed
+    std::vector<am_ClassProperty_s>::const_iterator newIterator = sinkClass.listClassProperties.begin();
+    for (; newIterator != sinkClass.listClassProperties.end(); ++newIterator)
+    {
+        std::vector<am_ClassProperty_s>::iterator propertyIterator = iter->second.listClassProperties.begin();
+        for (; propertyIterator != iter->second.listClassProperties.end(); ++propertyIterator)
+        {
+            if (propertyIterator->classProperty == newIterator->classProperty)
+                propertyIterator->value = newIterator->value;
+        }
+    }
+
+    logInfo("DatabaseHandler::setSinkClassInfoDB set setSinkClassInfo");
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSourceClassInfoDB(const am_SourceClass_s& sourceClass)
+{
+    assert(sourceClass.sourceClassID!=0);
+    assert(!sourceClass.listClassProperties.empty());
+
+    MapSourceClass::iterator iter = mMapSourceClass.find(sourceClass.sourceClassID);
+    if (iter == mMapSourceClass.end())
+        return (E_NON_EXISTENT);
+
+    //only the values of the known properties are changed
+    std::vector<am_ClassProperty_s>::const_iterator newIterator = sourceClass.listClassProperties.begin();
+    for (; newIterator != sourceClass.listClassProperties.end(); ++newIterator)
+    {
+        std::vector<am_ClassProperty_s>::iterator propertyIterator = iter->second.listClassProperties.begin();
+        for (; propertyIterator != iter->second.listClassProperties.end(); ++propertyIterator)
+        {
+            if (propertyIterator->classProperty == newIterator->classProperty)
+                propertyIterator->value = newIterator->value;
+        }
+    }
+
+    logInfo("DatabaseHandler::setSinkClassInfoDB set setSinkClassInfo");
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSinkClassInfoDB(const am_sinkID_t sinkID, am_SinkClass_s & sinkClass) const
+{
+    assert(sinkID!=0);
+
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    MapSinkClass::const_iterator classIterator = mMapSinkClass.find(iter->second.sink.sinkClassID);
+    if (classIterator == mMapSinkClass.end())
+    {
+        logError("DatabaseHandler::getSinkClassInfoDB sinkClass not found:", iter->second.sink.sinkClassID);
+        return (E_DATABASE_ERROR);
+    }
+
+    sinkClass = classIterator->second;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getGatewayInfoDB(const am_gatewayID_t gatewayID, am_Gateway_s & gatewayData) const
+{
+    assert(gatewayID!=0);
+
+    MapGateway::const_iterator iter = mMapGateway.find(gatewayID);
+    if (iter == mMapGateway.end())
+        return (E_NON_EXISTENT);
+
+    gatewayData = iter->second;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getCrossfaderInfoDB(const am_crossfaderID_t crossfaderID, am_Crossfader_s & crossfaderData) const
+{
+    assert(crossfaderID!=0);
+
+    MapCrossfader::const_iterator iter = mMapCrossfader.find(crossfaderID);
+    if (iter == mMapCrossfader.end())
+        return (E_NON_EXISTENT);
+
+    crossfaderData = iter->second;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSinksOfDomain(const am_domainID_t domainID, std::vector<am_sinkID_t> & listSinkID) const
+{
+    assert(domainID!=0);
+    listSinkID.clear();
+    if (!existDomain(domainID))
+        return (E_NON_EXISTENT);
+
+    MapSink::const_iterator iter = mMapSink.begin();
+    for (; iter != mMapSink.end(); ++iter)
+    {
+        if (!iter->second.reserved && iter->second.sink.domainID == domainID)
+            listSinkID.push_back(iter->first);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSourcesOfDomain(const am_domainID_t domainID, std::vector<am_sourceID_t> & listSourceID) const
+{
+    assert(domainID!=0);
+    listSourceID.clear();
+    if (!existDomain(domainID))
+        return (E_NON_EXISTENT);
+
+    MapSource::const_iterator iter = mMapSource.begin();
+    for (; iter != mMapSource.end(); ++iter)
+    {
+        if (!iter->second.reserved && iter->second.source.domainID == domainID)
+            listSourceID.push_back(iter->first);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListCrossfadersOfDomain(const am_domainID_t domainID, std::vector<am_crossfaderID_t> & listCrossfader) const
+{
+    assert(domainID!=0);
+    listCrossfader.clear();
+    if (!existDomain(domainID))
+        return (E_NON_EXISTENT);
+
+    //a crossfader belongs to the domain of its source
+    MapCrossfader::const_iterator iter = mMapCrossfader.begin();
+    for (; iter != mMapCrossfader.end(); ++iter)
+    {
+        MapSource::const_iterator source = mMapSource.find(iter->second.sourceID);
+        if (source != mMapSource.end() && source->second.source.domainID == domainID)
+            listCrossfader.push_back(iter->first);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListGatewaysOfDomain(const am_domainID_t domainID, std::vector<am_gatewayID_t> & listGatewaysID) const
+{
+    assert(domainID!=0);
+    listGatewaysID.clear();
+    if (!existDomain(domainID))
+        return (E_NON_EXISTENT);
+
+    MapGateway::const_iterator iter = mMapGateway.begin();
+    for (; iter != mMapGateway.end(); ++iter)
+    {
+        if (iter->second.controlDomainID == domainID)
+            listGatewaysID.push_back(iter->first);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListMainConnections(std::vector<am_MainConnection_s> & listMainConnections) const
+{
+    listMainConnections.clear();
+
+    MapMainConnection::const_iterator iter = mMapMainConnection.begin();
+    for (; iter != mMapMainConnection.end(); ++iter)
+        listMainConnections.push_back(iter->second);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListDomains(std::vector<am_Domain_s> & listDomains) const
+{
+    listDomains.clear();
+
+    MapDomain::const_iterator iter = mMapDomain.begin();
+    for (; iter != mMapDomain.end(); ++iter)
+    {
+        if (!iter->second.reserved)
+            listDomains.push_back(iter->second.domain);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListConnections(std::vector<am_Connection_s> & listConnections) const
+{
+    listConnections.clear();
+
+    MapConnection::const_iterator iter = mMapConnection.begin();
+    for (; iter != mMapConnection.end(); ++iter)
+    {
+        if (!iter->second.reserved)
+            listConnections.push_back(iter->second.connection);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListConnectionsReserved(std::vector<am_Connection_s> & listConnections) const
+{
+    listConnections.clear();
+
+    MapConnection::const_iterator iter = mMapConnection.begin();
+    for (; iter != mMapConnection.end(); ++iter)
+    {
+        if (iter->second.reserved)
+            listConnections.push_back(iter->second.connection);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSinks(std::vector<am_Sink_s> & listSinks) const
+{
+    listSinks.clear();
+
+    MapSink::const_iterator iter = mMapSink.begin();
+    for (; iter != mMapSink.end(); ++iter)
+    {
+        if (!iter->second.reserved)
+            listSinks.push_back(iter->second.sink);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSources(std::vector<am_Source_s> & listSources) const
+{
+    listSources.clear();
+
+    MapSource::const_iterator iter = mMapSource.begin();
+    for (; iter != mMapSource.end(); ++iter)
+    {
+        if (!iter->second.reserved)
+            listSources.push_back(iter->second.source);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSourceClasses(std::vector<am_SourceClass_s> & listSourceClasses) const
+{
+    listSourceClasses.clear();
+
+    MapSourceClass::const_iterator iter = mMapSourceClass.begin();
+    for (; iter != mMapSourceClass.end(); ++iter)
+        listSourceClasses.push_back(iter->second);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListCrossfaders(std::vector<am_Crossfader_s> & listCrossfaders) const
+{
+    listCrossfaders.clear();
+
+    MapCrossfader::const_iterator iter = mMapCrossfader.begin();
+    for (; iter != mMapCrossfader.end(); ++iter)
+        listCrossfaders.push_back(iter->second);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListGateways(std::vector<am_Gateway_s> & listGateways) const
+{
+    listGateways.clear();
+
+    MapGateway::const_iterator iter = mMapGateway.begin();
+    for (; iter != mMapGateway.end(); ++iter)
+        listGateways.push_back(iter->second);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSinkClasses(std::vector<am_SinkClass_s> & listSinkClasses) const
+{
+    listSinkClasses.clear();
+
+    MapSinkClass::const_iterator iter = mMapSinkClass.begin();
+    for (; iter != mMapSinkClass.end(); ++iter)
+        listSinkClasses.push_back(iter->second);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListVisibleMainConnections(std::vector<am_MainConnectionType_s> & listConnections) const
+{
+    listConnections.clear();
+    am_MainConnectionType_s temp;
+
+    MapMainConnection::const_iterator iter = mMapMainConnection.begin();
+    for (; iter != mMapMainConnection.end(); ++iter)
+    {
+        temp.mainConnectionID = iter->second.mainConnectionID;
+        temp.sourceID = iter->second.sourceID;
+        temp.sinkID = iter->second.sinkID;
+        temp.connectionState = iter->second.connectionState;
+        temp.delay = iter->second.delay;
+        listConnections.push_back(temp);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListMainSinks(std::vector<am_SinkType_s> & listMainSinks) const
+{
+    listMainSinks.clear();
+    am_SinkType_s temp;
+
+    MapSink::const_iterator iter = mMapSink.begin();
+    for (; iter != mMapSink.end(); ++iter)
+    {
+        if (iter->second.reserved || !iter->second.sink.visible)
+            continue;
+        temp.name = iter->second.sink.name;
+        temp.sinkID = iter->first;
+        temp.availability = iter->second.sink.available;
+        temp.muteState = iter->second.sink.muteState;
+        temp.volume = iter->second.sink.mainVolume;
+        temp.sinkClassID = iter->second.sink.sinkClassID;
+        listMainSinks.push_back(temp);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListMainSources(std::vector<am_SourceType_s> & listMainSources) const
+{
+    listMainSources.clear();
+    am_SourceType_s temp;
+
+    MapSource::const_iterator iter = mMapSource.begin();
+    for (; iter != mMapSource.end(); ++iter)
+    {
+        if (iter->second.reserved || !iter->second.source.visible)
+            continue;
+        temp.name = iter->second.source.name;
+        temp.sourceClassID = iter->second.source.sourceClassID;
+        temp.sourceID = iter->first;
+        temp.availability = iter->second.source.available;
+        listMainSources.push_back(temp);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListMainSinkSoundProperties(const am_sinkID_t sinkID, std::vector<am_MainSoundProperty_s> & listSoundProperties) const
+{
+    assert(sinkID!=0);
+
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_DATABASE_ERROR);
+
+    listSoundProperties = iter->second.sink.listMainSoundProperties;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListMainSourceSoundProperties(const am_sourceID_t sourceID, std::vector<am_MainSoundProperty_s> & listSourceProperties) const
+{
+    assert(sourceID!=0);
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_DATABASE_ERROR);
+
+    listSourceProperties = iter->second.source.listMainSoundProperties;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getListSystemProperties(std::vector<am_SystemProperty_s> & listSystemProperties) const
+{
+    listSystemProperties = mListSystemProperties;
+    return (E_OK);
+}
+
+am_Error_e am::CAmDatabaseHandler::getListSinkConnectionFormats(const am_sinkID_t sinkID, std::vector<am_ConnectionFormat_e> & listConnectionFormats) const
+{
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_DATABASE_ERROR);
+
+    listConnectionFormats = iter->second.sink.listConnectionFormats;
+    return (E_OK);
+}
+
+am_Error_e am::CAmDatabaseHandler::getListSourceConnectionFormats(const am_sourceID_t sourceID, std::vector<am_ConnectionFormat_e> & listConnectionFormats) const
+{
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_DATABASE_ERROR);
+
+    listConnectionFormats = iter->second.source.listConnectionFormats;
+    return (E_OK);
+}
+
+am_Error_e am::CAmDatabaseHandler::getListGatewayConnectionFormats(const am_gatewayID_t gatewayID, std::vector<bool> & listConnectionFormat) const
+{
+    MapGateway::const_iterator iter = mMapGateway.find(gatewayID);
+    if (iter == mMapGateway.end())
+    {
+        logError("DatabaseHandler::getListGatewayConnectionFormats database error with convertionFormat");
+        return (E_DATABASE_ERROR);
+    }
+
+    listConnectionFormat = iter->second.convertionMatrix;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getTimingInformation(const am_mainConnectionID_t mainConnectionID, am_timeSync_t & delay) const
+{
+    assert(mainConnectionID!=0);
+    delay = -1;
+
+    MapMainConnection::const_iterator iter = mMapMainConnection.find(mainConnectionID);
+    if (iter != mMapMainConnection.end())
+        delay = iter->second.delay;
+
+    if (delay == -1)
+        return (E_NOT_POSSIBLE);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeDelayMainConnection(const am_timeSync_t & delay, const am_mainConnectionID_t & connectionID)
+{
+    assert(connectionID!=0);
+
+    MapMainConnection::iterator iter = mMapMainConnection.find(connectionID);
+    if (iter == mMapMainConnection.end())
+        return (E_NON_EXISTENT);
+
+    //only notify if the delay changed
+    if (iter->second.delay == delay)
+        return (E_OK);
+
+    iter->second.delay = delay;
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->timingInformationChanged(connectionID, delay);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterConnectionDB(const am_Connection_s& connection, am_connectionID_t& connectionID)
+{
+    assert(connection.connectionID==0);
+    assert(connection.sinkID!=0);
+    assert(connection.sourceID!=0);
+    //connection format is not checked, because it's project specific
+
+    if (!nextID(mLastConnectionID, connectionID))
+    {
+        logError("DatabaseHandler::enterConnectionDB no more connectionIDs available");
+        return (E_DATABASE_ERROR);
+    }
+
+    //the connection is reserved until it is made final
+    am_ConnectionEntry_s& entry = mMapConnection[connectionID];
+    entry.connection = connection;
+    entry.connection.connectionID = connectionID;
+    entry.reserved = true;
+
+    logInfo("DatabaseHandler::enterConnectionDB entered new connection sinkID=", connection.sinkID, "sourceID=", connection.sourceID, "connectionFormat=", connection.connectionFormat, "assigned ID=", connectionID);
+    mConnectionRevision++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterSinkClassDB(const am_SinkClass_s & sinkClass, am_sinkClass_t & sinkClassID)
+{
+    assert(sinkClass.sinkClassID<DYNAMIC_ID_BOUNDARY);
+    assert(!sinkClass.name.empty());
+
+    if (sinkClass.sinkClassID == 0 && !mFirstStaticSinkClass)
+    {
+        if (!nextID(mLastSinkClassID, sinkClassID))
+        {
+            logError("DatabaseHandler::enterSinkClassDB no more sinkClassIDs available");
+            return (E_DATABASE_ERROR);
+        }
+    }
+    else
+    {
+        //check if the ID already exists
+        if (existSinkClass(sinkClass.sinkClassID))
+            return (E_ALREADY_EXISTS);
+
+        //the first dynamic sink class starts at the boundary
+        if (sinkClass.sinkClassID != 0)
+        {
+            sinkClassID = sinkClass.sinkClassID;
+        }
+        else
+        {
+            sinkClassID = DYNAMIC_ID_BOUNDARY;
+            mFirstStaticSinkClass = false;
+        }
+        useID(mLastSinkClassID, sinkClassID);
+    }
+
+    am_SinkClass_s& entry = mMapSinkClass[sinkClassID];
+    entry = sinkClass;
+    entry.sinkClassID = sinkClassID;
+
+    logInfo("DatabaseHandler::enterSinkClassDB entered new sinkClass");
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->numberOfSinkClassesChanged();
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterSourceClassDB(am_sourceClass_t & sourceClassID, const am_SourceClass_s & sourceClass)
+{
+    assert(sourceClass.sourceClassID<DYNAMIC_ID_BOUNDARY);
+    assert(!sourceClass.name.empty());
+
+    if (sourceClass.sourceClassID == 0 && !mFirstStaticSourceClass)
+    {
+        if (!nextID(mLastSourceClassID, sourceClassID))
+        {
+            logError("DatabaseHandler::enterSourceClassDB no more sourceClassIDs available");
+            return (E_DATABASE_ERROR);
+        }
+    }
+    else
+    {
+        //check if the ID already exists
+        if (existSourceClass(sourceClass.sourceClassID))
+            return (E_ALREADY_EXISTS);
+
+        //the first dynamic source class starts at the boundary
+        if (sourceClass.sourceClassID != 0)
+        {
+            sourceClassID = sourceClass.sourceClassID;
+        }
+        else
+        {
+            sourceClassID = DYNAMIC_ID_BOUNDARY;
+            mFirstStaticSourceClass = false;
+        }
+        useID(mLastSourceClassID, sourceClassID);
+    }
+
+    am_SourceClass_s& entry = mMapSourceClass[sourceClassID];
+    entry = sourceClass;
+    entry.sourceClassID = sourceClassID;
+
+    logInfo("DatabaseHandler::enterSourceClassDB entered new sourceClass");
+
+    if (mpDatabaseObserver)
+        mpDatabaseObserver->numberOfSourceClassesChanged();
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::enterSystemProperties(const std::vector<am_SystemProperty_s> & listSystemProperties)
+{
+    assert(!listSystemProperties.empty());
+
+    mListSystemProperties = listSystemProperties;
+
+    logInfo("DatabaseHandler::enterSystemProperties entered system properties");
+    return (E_OK);
+}
+
+bool CAmDatabaseHandler::existMainConnection(const am_mainConnectionID_t mainConnectionID) const
+{
+    return (mMapMainConnection.find(mainConnectionID) != mMapMainConnection.end());
+}
+
+bool CAmDatabaseHandler::existSource(const am_sourceID_t sourceID) const
+{
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    return (iter != mMapSource.end() && !iter->second.reserved);
+}
+
+bool CAmDatabaseHandler::existSourceNameOrID(const am_sourceID_t sourceID, const std::string & name) const
+{
+    return (existSource(sourceID) || existSourceName(name));
+}
+
+bool CAmDatabaseHandler::existSourceName(const std::string & name) const
+{
+    MapSource::const_iterator iter = mMapSource.begin();
+    for (; iter != mMapSource.end(); ++iter)
+    {
+        if (!iter->second.reserved && iter->second.source.name == name)
+            return (true);
+    }
+    return (false);
+}
+
+bool CAmDatabaseHandler::existSink(const am_sinkID_t sinkID) const
+{
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    return (iter != mMapSink.end() && !iter->second.reserved);
+}
+
+bool CAmDatabaseHandler::existSinkNameOrID(const am_sinkID_t sinkID, const std::string & name) const
+{
+    return (existSink(sinkID) || existSinkName(name));
+}
+
+bool CAmDatabaseHandler::existSinkName(const std::string & name) const
+{
+    MapSink::const_iterator iter = mMapSink.begin();
+    for (; iter != mMapSink.end(); ++iter)
+    {
+        if (!iter->second.reserved && iter->second.sink.name == name)
+            return (true);
+    }
+    return (false);
+}
+
+bool CAmDatabaseHandler::existDomain(const am_domainID_t domainID) const
+{
+    MapDomain::const_iterator iter = mMapDomain.find(domainID);
+    return (iter != mMapDomain.end() && !iter->second.reserved);
+}
+
+bool CAmDatabaseHandler::existGateway(const am_gatewayID_t gatewayID) const
+{
+    return (mMapGateway.find(gatewayID) != mMapGateway.end());
+}
+
+am_Error_e CAmDatabaseHandler::getDomainOfSource(const am_sourceID_t sourceID, am_domainID_t & domainID) const
+{
+    assert(sourceID!=0);
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end())
+    {
+        logError("DatabaseHandler::getDomainOfSource source not found:", sourceID);
+        return (E_DATABASE_ERROR);
+    }
+
+    domainID = iter->second.source.domainID;
+    return (E_OK);
+}
+
+am_Error_e am::CAmDatabaseHandler::getDomainOfSink(const am_sinkID_t sinkID, am_domainID_t & domainID) const
+{
+    assert(sinkID!=0);
+
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end())
+    {
+        logError("DatabaseHandler::getDomainOfSink sink not found:", sinkID);
+        return (E_DATABASE_ERROR);
+    }
+
+    domainID = iter->second.sink.domainID;
+    return (E_OK);
+}
+
+bool CAmDatabaseHandler::existSinkClass(const am_sinkClass_t sinkClassID) const
+{
+    return (mMapSinkClass.find(sinkClassID) != mMapSinkClass.end());
+}
+
+bool CAmDatabaseHandler::existSourceClass(const am_sourceClass_t sourceClassID) const
+{
+    return (mMapSourceClass.find(sourceClassID) != mMapSourceClass.end());
+}
+
+am_Error_e CAmDatabaseHandler::changeConnectionTimingInformation(const am_connectionID_t connectionID, const am_timeSync_t delay)
+{
+    assert(connectionID!=0);
+
+    MapConnection::iterator iter = mMapConnection.find(connectionID);
+    if (iter != mMapConnection.end())
+        iter->second.connection.delay = delay;
+
+    //now we need to find all mainConnections that use the changed connection and update their timing
+    MapMainConnection::const_iterator mainIterator = mMapMainConnection.begin();
+    for (; mainIterator != mMapMainConnection.end(); ++mainIterator)
+    {
+        const std::vector<am_connectionID_t>& route = mainIterator->second.listConnectionID;
+        std::vector<am_connectionID_t>::const_iterator routeIterator = route.begin();
+        for (; routeIterator != route.end(); ++routeIterator)
+        {
+            if (*routeIterator == connectionID)
+                break;
+        }
+        if (routeIterator != route.end())
+            changeDelayMainConnection(calculateMainConnectionDelay(mainIterator->first), mainIterator->first);
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeConnectionFinal(const am_connectionID_t connectionID)
+{
+    assert(connectionID!=0);
+
+    MapConnection::iterator iter = mMapConnection.find(connectionID);
+    if (iter != mMapConnection.end())
+        iter->second.reserved = false;
+    return (E_OK);
+}
+
+am_timeSync_t CAmDatabaseHandler::calculateMainConnectionDelay(const am_mainConnectionID_t mainConnectionID) const
+{
+    assert(mainConnectionID!=0);
+
+    MapMainConnection::const_iterator iter = mMapMainConnection.find(mainConnectionID);
+    if (iter == mMapMainConnection.end())
+        return (-1);
+
+    int16_t delay = 0;
+    int16_t min = 0;
+    std::vector<am_connectionID_t>::const_iterator routeIterator = iter->second.listConnectionID.begin();
+    for (; routeIterator != iter->second.listConnectionID.end(); ++routeIterator)
+    {
+        MapConnection::const_iterator connection = mMapConnection.find(*routeIterator);
+        if (connection == mMapConnection.end())
+            continue;
+        if (routeIterator == iter->second.listConnectionID.begin() || connection->second.connection.delay < min)
+            min = connection->second.connection.delay;
+        delay += connection->second.connection.delay;
+    }
+
+    if (min < 0)
+        delay = -1;
+    return (delay);
+}
+
+void CAmDatabaseHandler::registerObserver(CAmDatabaseObserver *iObserver)
+{
+    assert(iObserver!=NULL);
+    mpDatabaseObserver = iObserver;
+}
+
+/**
+ * the object model does not use SQL statements, so there are no statistics to log
+ */
+void CAmDatabaseHandler::logStatementStatistics() const
+{
+    logInfo("DatabaseHandler::logStatementStatistics no statements, the database is kept in the object model");
+}
+
+/**
+ * the object model changes in place, so a batch only collects the observer notifications
+ */
+am_Error_e CAmDatabaseHandler::beginTransaction()
+{
+    if (mTransactionDepth == 0 && mpDatabaseObserver)
+        mpDatabaseObserver->beginBatch();
+    mTransactionDepth++;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::commitTransaction()
+{
+    if (mTransactionDepth == 0)
+    {
+        logError("DatabaseHandler::commitTransaction no transaction open");
+        return (E_NOT_POSSIBLE);
+    }
+
+    if (--mTransactionDepth == 0 && mpDatabaseObserver)
+        mpDatabaseObserver->commitBatch();
+    return (E_OK);
+}
+
+uint32_t CAmDatabaseHandler::getTopologyRevision() const
+{
+    return (mTopologyRevision);
+}
+
+uint32_t CAmDatabaseHandler::getConnectionRevision() const
+{
+    return (mConnectionRevision);
+}
+
+bool CAmDatabaseHandler::sourceVisible(const am_sourceID_t sourceID) const
+{
+    assert(sourceID!=0);
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    return (iter != mMapSource.end() && iter->second.source.visible);
+}
+
+bool CAmDatabaseHandler::sinkVisible(const am_sinkID_t sinkID) const
+{
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    return (iter != mMapSink.end() && !iter->second.reserved && iter->second.sink.visible);
+}
+
+bool CAmDatabaseHandler::existConnection(const am_Connection_s connection)
+{
+    MapConnection::const_iterator iter = mMapConnection.begin();
+    for (; iter != mMapConnection.end(); ++iter)
+    {
+        if (!iter->second.reserved && iter->second.connection.sinkID == connection.sinkID && iter->second.connection.sourceID == connection.sourceID && iter->second.connection.connectionFormat == connection.connectionFormat)
+            return (true);
+    }
+    return (false);
+}
+
+bool CAmDatabaseHandler::existConnectionID(const am_connectionID_t connectionID)
+{
+    MapConnection::const_iterator iter = mMapConnection.find(connectionID);
+    return (iter != mMapConnection.end() && !iter->second.reserved);
+}
+
+bool CAmDatabaseHandler::existcrossFader(const am_crossfaderID_t crossfaderID) const
+{
+    return (mMapCrossfader.find(crossfaderID) != mMapCrossfader.end());
+}
+
+am_Error_e CAmDatabaseHandler::getSoureState(const am_sourceID_t sourceID, am_SourceState_e & sourceState) const
+{
+    assert(sourceID!=0);
+    sourceState = SS_UNKNNOWN;
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end())
+        logError("DatabaseHandler::getSoureState source not found:", sourceID);
+    else
+        sourceState = iter->second.source.sourceState;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSourceState(const am_sourceID_t sourceID, const am_SourceState_e sourceState)
+{
+    assert(sourceID!=0);
+    assert(sourceState>=SS_UNKNNOWN && sourceState<=SS_MAX);
+
+    MapSource::iterator iter = mMapSource.find(sourceID);
+    if (iter != mMapSource.end())
+        iter->second.source.sourceState = sourceState;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSinkVolume(const am_sinkID_t sinkID, am_volume_t & volume) const
+{
+    assert(sinkID!=0);
+    volume = -1;
+
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end())
+        logError("DatabaseHandler::getSinkVolume sink not found:", sinkID);
+    else
+        volume = iter->second.sink.volume;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSourceVolume(const am_sourceID_t sourceID, am_volume_t & volume) const
+{
+    assert(sourceID!=0);
+    volume = -1;
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end())
+        logError("DatabaseHandler::getSourceVolume source not found:", sourceID);
+    else
+        volume = iter->second.source.volume;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSinkSoundPropertyValue(const am_sinkID_t sinkID, const am_SoundPropertyType_e propertyType, int16_t & value) const
+{
+    assert(sinkID!=0);
+
+    MapSink::const_iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_DATABASE_ERROR);
+
+    std::vector<am_SoundProperty_s>::const_iterator propertyIterator = iter->second.sink.listSoundProperties.begin();
+    for (; propertyIterator != iter->second.sink.listSoundProperties.end(); ++propertyIterator)
+    {
+        if (propertyIterator->type == propertyType)
+            value = propertyIterator->value;
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getSourceSoundPropertyValue(const am_sourceID_t sourceID, const am_SoundPropertyType_e propertyType, int16_t & value) const
+{
+    assert(sourceID!=0);
+
+    MapSource::const_iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_DATABASE_ERROR);
+
+    std::vector<am_SoundProperty_s>::const_iterator propertyIterator = iter->second.source.listSoundProperties.begin();
+    for (; propertyIterator != iter->second.source.listSoundProperties.end(); ++propertyIterator)
+    {
+        if (propertyIterator->type == propertyType)
+            value = propertyIterator->value;
+    }
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getDomainState(const am_domainID_t domainID, am_DomainState_e& state) const
+{
+    assert(domainID!=0);
+    state = DS_UNKNOWN;
+
+    MapDomain::const_iterator iter = mMapDomain.find(domainID);
+    if (iter == mMapDomain.end())
+        logError("DatabaseHandler::getDomainState domain not found:", domainID);
+    else
+        state = iter->second.domain.state;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::peekDomain(const std::string & name, am_domainID_t & domainID)
+{
+    MapDomain::const_iterator iter = mMapDomain.begin();
+    for (; iter != mMapDomain.end(); ++iter)
+    {
+        if (iter->second.domain.name == name)
+        {
+            domainID = iter->first;
+            return (E_OK);
+        }
+    }
+
+    if (!nextID(mLastDomainID, domainID))
+    {
+        logError("DatabaseHandler::peekDomain no more domainIDs available");
+        return (E_DATABASE_ERROR);
+    }
+
+    //reserve the ID for the name, the domain is entered later
+    am_DomainEntry_s& entry = mMapDomain[domainID];
+    entry.domain.domainID = domainID;
+    entry.domain.name = name;
+    entry.domain.early = false;
+    entry.domain.complete = false;
+    entry.domain.state = DS_UNKNOWN;
+    entry.reserved = true;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::peekSink(const std::string & name, am_sinkID_t & sinkID)
+{
+    MapSink::const_iterator iter = mMapSink.begin();
+    for (; iter != mMapSink.end(); ++iter)
+    {
+        if (iter->second.sink.name == name)
+        {
+            sinkID = iter->first;
+            return (E_OK);
+        }
+    }
+
+    if (mFirstStaticSink)
+    {
+        sinkID = DYNAMIC_ID_BOUNDARY;
+        mFirstStaticSink = false;
+        useID(mLastSinkID, sinkID);
+    }
+    else if (!nextID(mLastSinkID, sinkID))
+    {
+        logError("DatabaseHandler::peekSink no more sinkIDs available");
+        return (E_DATABASE_ERROR);
+    }
+
+    //reserve the ID for the name, the sink is entered later
+    am_SinkEntry_s& entry = mMapSink[sinkID];
+    entry.sink.sinkID = sinkID;
+    entry.sink.name = name;
+    entry.sink.domainID = 0;
+    entry.sink.sinkClassID = 0;
+    entry.sink.volume = 0;
+    entry.sink.visible = false;
+    entry.sink.available.availability = A_UNKNOWN;
+    entry.sink.available.availabilityReason = AR_UNKNOWN;
+    entry.sink.muteState = MS_UNKNOWN;
+    entry.sink.mainVolume = 0;
+    entry.reserved = true;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::peekSource(const std::string & name, am_sourceID_t & sourceID)
+{
+    MapSource::const_iterator iter = mMapSource.begin();
+    for (; iter != mMapSource.end(); ++iter)
+    {
+        if (iter->second.source.name == name)
+        {
+            sourceID = iter->first;
+            return (E_OK);
+        }
+    }
+
+    if (mFirstStaticSource)
+    {
+        sourceID = DYNAMIC_ID_BOUNDARY;
+        mFirstStaticSource = false;
+        useID(mLastSourceID, sourceID);
+    }
+    else if (!nextID(mLastSourceID, sourceID))
+    {
+        logError("DatabaseHandler::peekSource no more sourceIDs available");
+        return (E_DATABASE_ERROR);
+    }
+
+    //reserve the ID for the name, the source is entered later
+    am_SourceEntry_s& entry = mMapSource[sourceID];
+    entry.source.sourceID = sourceID;
+    entry.source.domainID = 0;
+    entry.source.name = name;
+    entry.source.sourceClassID = 0;
+    entry.source.sourceState = SS_UNKNNOWN;
+    entry.source.volume = 0;
+    entry.source.visible = false;
+    entry.source.available.availability = A_UNKNOWN;
+    entry.source.available.availabilityReason = AR_UNKNOWN;
+    entry.source.interruptState = IS_UNKNOWN;
+    entry.reserved = true;
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSinkVolume(const am_sinkID_t sinkID, const am_volume_t volume)
+{
+    assert(sinkID!=0);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.sink.volume = volume;
+
+    logInfo("DatabaseHandler::changeSinkVolume changed volume of sink:", sinkID, "to:", volume);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSourceVolume(const am_sourceID_t sourceID, const am_volume_t volume)
+{
+    assert(sourceID!=0);
+
+    MapSource::iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    iter->second.source.volume = volume;
+
+    logInfo("DatabaseHandler::changeSourceVolume changed volume of source=:", sourceID, "to:", volume);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSourceSoundPropertyDB(const am_SoundProperty_s & soundProperty, const am_sourceID_t sourceID)
+{
+    assert(soundProperty.type>=SP_UNKNOWN && soundProperty.type<=SP_MAX);
+    assert(sourceID!=0);
+
+    MapSource::iterator iter = mMapSource.find(sourceID);
+    if (iter == mMapSource.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    std::vector<am_SoundProperty_s>::iterator propertyIterator = iter->second.source.listSoundProperties.begin();
+    for (; propertyIterator != iter->second.source.listSoundProperties.end(); ++propertyIterator)
+    {
+        if (propertyIterator->type == soundProperty.type)
+            propertyIterator->value = soundProperty.value;
+    }
+
+    logInfo("DatabaseHandler::changeSourceSoundPropertyDB changed SourceSoundProperty of source:", sourceID, "type:", soundProperty.type, "to:", soundProperty.value);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeSinkSoundPropertyDB(const am_SoundProperty_s & soundProperty, const am_sinkID_t sinkID)
+{
+    assert(soundProperty.type>=SP_UNKNOWN && soundProperty.type<=SP_MAX);
+    assert(sinkID!=0);
+
+    MapSink::iterator iter = mMapSink.find(sinkID);
+    if (iter == mMapSink.end() || iter->second.reserved)
+        return (E_NON_EXISTENT);
+
+    std::vector<am_SoundProperty_s>::iterator propertyIterator = iter->second.sink.listSoundProperties.begin();
+    for (; propertyIterator != iter->second.sink.listSoundProperties.end(); ++propertyIterator)
+    {
+        if (propertyIterator->type == soundProperty.type)
+            propertyIterator->value = soundProperty.value;
+    }
+
+    logInfo("DatabaseHandler::changeSinkSoundPropertyDB changed MainSinkSoundProperty of sink:", sinkID, "type:", soundProperty.type, "to:", soundProperty.value);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::changeCrossFaderHotSink(const am_crossfaderID_t crossfaderID, const am_HotSink_e hotsink)
+{
+    assert(crossfaderID!=0);
+    assert(hotsink>=HS_UNKNOWN && hotsink<=HS_MAX);
+
+    MapCrossfader::iterator iter = mMapCrossfader.find(crossfaderID);
+    if (iter == mMapCrossfader.end())
+        return (E_NON_EXISTENT);
+
+    iter->second.hotSink = hotsink;
+
+    logInfo("DatabaseHandler::changeCrossFaderHotSink changed hotsink of crossfader=", crossfaderID, "to:", hotsink);
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::getRoutingTree(bool onlyfree, CAmRoutingTree& tree, std::vector<CAmRoutingTreeItem*>& flatTree)
+{
+    size_t i = 0;
+    am_domainID_t rootID = tree.returnRootDomainID();
+    CAmRoutingTreeItem *parent = tree.returnRootItem();
+
+    do
+    {
+        if (i != 0)
+        {
+            parent = flatTree.at(i - 1);
+            rootID = parent->returnDomainID();
+        }
+
+        MapGateway::const_iterator iter = mMapGateway.begin();
+        for (; iter != mMapGateway.end(); ++iter)
+        {
+            if (iter->second.domainSinkID != rootID)
+                continue;
+
+            //a gateway is only free if neither its sink nor its source is connected
+            bool isFree = true;
+            if (onlyfree)
+            {
+                MapConnection::const_iterator connection = mMapConnection.begin();
+                for (; connection != mMapConnection.end() && isFree; ++connection)
+                {
+                    if (connection->second.connection.sinkID == iter->second.sinkID || connection->second.connection.sourceID == iter->second.sourceID)
+                        isFree = false;
+                }
+            }
+
+            if (isFree)
+                flatTree.push_back(tree.insertItem(iter->second.domainSourceID, iter->first, parent));
+        }
+        i++;
+    } while (flatTree.size() > (i - 1));
+
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandler::peekSinkClassID(const std::string & name, am_sinkClass_t & sinkClassID)
+{
+    if (name.empty())
+        return (E_NON_EXISTENT);
+
+    MapSinkClass::const_iterator iter = mMapSinkClass.begin();
+    for (; iter != mMapSinkClass.end(); ++iter)
+    {
+        if (iter->second.name == name)
+        {
+            sinkClassID = iter->first;
+            return (E_OK);
+        }
+    }
+    return (E_NON_EXISTENT);
+}
+
+am_Error_e CAmDatabaseHandler::peekSourceClassID(const std::string & name, am_sourceClass_t & sourceClassID)
+{
+    if (name.empty())
+        return (E_NON_EXISTENT);
+
+    MapSourceClass::const_iterator iter = mMapSourceClass.begin();
+    for (; iter != mMapSourceClass.end(); ++iter)
+    {
+        if (iter->second.name == name)
+        {
+            sourceClassID = iter->first;
+            return (E_OK);
+        }
+    }
+    return (E_NON_EXISTENT);
+}
+
+}
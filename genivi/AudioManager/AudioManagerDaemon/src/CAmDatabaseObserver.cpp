@@ -25,6 +25,7 @@
 #include <errno.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include "config.h"
 #include "CAmCommandSender.h"
 #include "CAmRoutingSender.h"
 #include "CAmTelnetServer.h"
@@ -37,27 +38,53 @@ CAmDatabaseObserver::CAmDatabaseObserver(CAmCommandSender *iCommandSender, CAmRo
         mCommandSender(iCommandSender), //
         mRoutingSender(iRoutingSender), //
         mTelnetServer(NULL), //
-        mSerializer(iSocketHandler) //
+        mSerializer(iSocketHandler), //
+        mBatch(false), //
+        mPendingBatch(), //
+        mSocketHandler(iSocketHandler), //
+        mFrameCallback(this, &CAmDatabaseObserver::frameUp), //
+        mFrame(), //
+        mFrameHandle(0), //
+        mFrameRunning(false), //
+        mPendingFrame()
 {
     assert(mCommandSender!=0);
     assert(mRoutingSender!=0);
     assert(iSocketHandler!=0);
+    mPendingBatch.sinkClassesChanged = false;
+    mPendingBatch.sourceClassesChanged = false;
+    mFrame.tv_sec = NOTIFICATION_FRAME / 1000;
+    mFrame.tv_nsec = (NOTIFICATION_FRAME % 1000) * 1000000;
 }
 
 CAmDatabaseObserver::CAmDatabaseObserver(CAmCommandSender *iCommandSender, CAmRoutingSender *iRoutingSender, CAmSocketHandler *iSocketHandler, CAmTelnetServer *iTelnetServer) :
         mCommandSender(iCommandSender), //
         mRoutingSender(iRoutingSender), //
         mTelnetServer(iTelnetServer), //
-        mSerializer(iSocketHandler) //
+        mSerializer(iSocketHandler), //
+        mBatch(false), //
+        mPendingBatch(), //
+        mSocketHandler(iSocketHandler), //
+        mFrameCallback(this, &CAmDatabaseObserver::frameUp), //
+        mFrame(), //
+        mFrameHandle(0), //
+        mFrameRunning(false), //
+        mPendingFrame()
 {
     assert(mTelnetServer!=0);
     assert(mCommandSender!=0);
     assert(mRoutingSender!=0);
     assert(iSocketHandler!=0);
+    mPendingBatch.sinkClassesChanged = false;
+    mPendingBatch.sourceClassesChanged = false;
+    mFrame.tv_sec = NOTIFICATION_FRAME / 1000;
+    mFrame.tv_nsec = (NOTIFICATION_FRAME % 1000) * 1000000;
 }
 
 CAmDatabaseObserver::~CAmDatabaseObserver()
 {
+    if (mFrameHandle)
+        mSocketHandler->removeTimer(mFrameHandle);
 }
 
 void CAmDatabaseObserver::newMainConnection(const am_MainConnectionType_s& mainConnection)
@@ -82,7 +109,10 @@ void CAmDatabaseObserver::newSink(const am_Sink_s& sink)
         s.sinkClassID = sink.sinkClassID;
         s.sinkID = sink.sinkID;
         s.volume = sink.mainVolume;
-        mSerializer.asyncCall<CAmCommandSender, const am_SinkType_s>(mCommandSender, &CAmCommandSender::cbNewSink, s);
+        if (mBatch)
+            mPendingBatch.listNewSinks.push_back(s);
+        else
+            mSerializer.asyncCall<CAmCommandSender, const am_SinkType_s>(mCommandSender, &CAmCommandSender::cbNewSink, s);
     }
 }
 
@@ -96,7 +126,10 @@ void CAmDatabaseObserver::newSource(const am_Source_s& source)
         s.name = source.name;
         s.sourceClassID = source.sourceClassID;
         s.sourceID = source.sourceID;
-        mSerializer.asyncCall<CAmCommandSender, const am_SourceType_s>(mCommandSender, &CAmCommandSender::cbNewSource, s);
+        if (mBatch)
+            mPendingBatch.listNewSources.push_back(s);
+        else
+            mSerializer.asyncCall<CAmCommandSender, const am_SourceType_s>(mCommandSender, &CAmCommandSender::cbNewSource, s);
     }
 }
 
@@ -120,6 +153,28 @@ void CAmDatabaseObserver::removedSink(const am_sinkID_t sinkID, const bool visib
 {
     mRoutingSender->removeSinkLookup(sinkID);
 
+    //changes collected for the sink in the running frame must not arrive after the removal
+    mPendingFrame.mapVolume.erase(sinkID);
+    std::map<std::pair<am_sinkID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s>::iterator sinkPropertyIterator = mPendingFrame.mapSinkSoundProperty.begin();
+    while (sinkPropertyIterator != mPendingFrame.mapSinkSoundProperty.end())
+    {
+        if (sinkPropertyIterator->first.first == sinkID)
+            mPendingFrame.mapSinkSoundProperty.erase(sinkPropertyIterator++);
+        else
+            ++sinkPropertyIterator;
+    }
+
+    //a sink that was entered in the open batch was never announced, so it is just dropped
+    std::vector<am_SinkType_s>::iterator sinkIterator = mPendingBatch.listNewSinks.begin();
+    for (; sinkIterator != mPendingBatch.listNewSinks.end(); ++sinkIterator)
+    {
+        if (sinkIterator->sinkID == sinkID)
+        {
+            mPendingBatch.listNewSinks.erase(sinkIterator);
+            return;
+        }
+    }
+
     if (visible)
         mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t>(mCommandSender, &CAmCommandSender::cbRemovedSink, sinkID);
 }
@@ -128,6 +183,27 @@ void CAmDatabaseObserver::removedSource(const am_sourceID_t sourceID, const bool
 {
     mRoutingSender->removeSourceLookup(sourceID);
 
+    //changes collected for the source in the running frame must not arrive after the removal
+    std::map<std::pair<am_sourceID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s>::iterator sourcePropertyIterator = mPendingFrame.mapSourceSoundProperty.begin();
+    while (sourcePropertyIterator != mPendingFrame.mapSourceSoundProperty.end())
+    {
+        if (sourcePropertyIterator->first.first == sourceID)
+            mPendingFrame.mapSourceSoundProperty.erase(sourcePropertyIterator++);
+        else
+            ++sourcePropertyIterator;
+    }
+
+    //a source that was entered in the open batch was never announced, so it is just dropped
+    std::vector<am_SourceType_s>::iterator sourceIterator = mPendingBatch.listNewSources.begin();
+    for (; sourceIterator != mPendingBatch.listNewSources.end(); ++sourceIterator)
+    {
+        if (sourceIterator->sourceID == sourceID)
+        {
+            mPendingBatch.listNewSources.erase(sourceIterator);
+            return;
+        }
+    }
+
     if (visible)
         mSerializer.asyncCall<CAmCommandSender, const am_sourceID_t>(mCommandSender, &CAmCommandSender::cbRemovedSource, sourceID);
 }
@@ -150,11 +226,21 @@ void CAmDatabaseObserver::removeCrossfader(const am_crossfaderID_t crossfaderID)
 
 void CAmDatabaseObserver::numberOfSinkClassesChanged()
 {
+    if (mBatch)
+    {
+        mPendingBatch.sinkClassesChanged = true;
+        return;
+    }
     mSerializer.asyncCall<CAmCommandSender>(mCommandSender, &CAmCommandSender::cbNumberOfSinkClassesChanged);
 }
 
 void CAmDatabaseObserver::numberOfSourceClassesChanged()
 {
+    if (mBatch)
+    {
+        mPendingBatch.sourceClassesChanged = true;
+        return;
+    }
     mSerializer.asyncCall<CAmCommandSender>(mCommandSender, &CAmCommandSender::cbNumberOfSourceClassesChanged);
 }
 
@@ -165,36 +251,93 @@ void CAmDatabaseObserver::mainConnectionStateChanged(const am_mainConnectionID_t
 
 void CAmDatabaseObserver::mainSinkSoundPropertyChanged(const am_sinkID_t sinkID, const am_MainSoundProperty_s& SoundProperty)
 {
+    //a sink of the open batch is announced with the commit, clients read its properties after cbNewSink
+    if (batchSink(sinkID))
+        return;
+    if (coalescing())
+    {
+        mPendingFrame.mapSinkSoundProperty[std::make_pair(sinkID, SoundProperty.type)] = SoundProperty;
+        startFrame();
+        return;
+    }
     mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t, const am_MainSoundProperty_s>(mCommandSender, &CAmCommandSender::cbMainSinkSoundPropertyChanged, sinkID, SoundProperty);
 }
 
 void CAmDatabaseObserver::mainSourceSoundPropertyChanged(const am_sourceID_t sourceID, const am_MainSoundProperty_s & SoundProperty)
 {
+    //a source of the open batch is announced with the commit, clients read its properties after cbNewSource
+    if (batchSource(sourceID))
+        return;
+    if (coalescing())
+    {
+        mPendingFrame.mapSourceSoundProperty[std::make_pair(sourceID, SoundProperty.type)] = SoundProperty;
+        startFrame();
+        return;
+    }
     mSerializer.asyncCall<CAmCommandSender, const am_sourceID_t, const am_MainSoundProperty_s>(mCommandSender, &CAmCommandSender::cbMainSourceSoundPropertyChanged, sourceID, SoundProperty);
 }
 
 void CAmDatabaseObserver::sinkAvailabilityChanged(const am_sinkID_t sinkID, const am_Availability_s & availability)
 {
+    am_SinkType_s* sink = batchSink(sinkID);
+    if (sink)
+    {
+        sink->availability = availability;
+        return;
+    }
+    flushSink(sinkID);
     mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t, const am_Availability_s>(mCommandSender, &CAmCommandSender::cbSinkAvailabilityChanged, sinkID, availability);
 }
 
 void CAmDatabaseObserver::sourceAvailabilityChanged(const am_sourceID_t sourceID, const am_Availability_s & availability)
 {
+    am_SourceType_s* source = batchSource(sourceID);
+    if (source)
+    {
+        source->availability = availability;
+        return;
+    }
+    flushSource(sourceID);
     mSerializer.asyncCall<CAmCommandSender, const am_sourceID_t, const am_Availability_s>(mCommandSender, &CAmCommandSender::cbSourceAvailabilityChanged, sourceID, availability);
 }
 
 void CAmDatabaseObserver::volumeChanged(const am_sinkID_t sinkID, const am_mainVolume_t volume)
 {
+    am_SinkType_s* sink = batchSink(sinkID);
+    if (sink)
+    {
+        sink->volume = volume;
+        return;
+    }
+    if (coalescing())
+    {
+        mPendingFrame.mapVolume[sinkID] = volume;
+        startFrame();
+        return;
+    }
     mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t, const am_mainVolume_t>(mCommandSender, &CAmCommandSender::cbVolumeChanged, sinkID, volume);
 }
 
 void CAmDatabaseObserver::sinkMuteStateChanged(const am_sinkID_t sinkID, const am_MuteState_e muteState)
 {
+    am_SinkType_s* sink = batchSink(sinkID);
+    if (sink)
+    {
+        sink->muteState = muteState;
+        return;
+    }
+    flushSink(sinkID);
     mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t, const am_MuteState_e>(mCommandSender, &CAmCommandSender::cbSinkMuteStateChanged, sinkID, muteState);
 }
 
 void CAmDatabaseObserver::systemPropertyChanged(const am_SystemProperty_s& SystemProperty)
 {
+    if (coalescing())
+    {
+        mPendingFrame.mapSystemProperty[SystemProperty.type] = SystemProperty;
+        startFrame();
+        return;
+    }
     mSerializer.asyncCall<CAmCommandSender, const am_SystemProperty_s>(mCommandSender, &CAmCommandSender::cbSystemPropertyChanged, SystemProperty);
 }
 
@@ -202,4 +345,179 @@ void CAmDatabaseObserver::timingInformationChanged(const am_mainConnectionID_t m
 {
     mSerializer.asyncCall<CAmCommandSender, const am_mainConnectionID_t, const am_timeSync_t>(mCommandSender, &CAmCommandSender::cbTimingInformationChanged, mainConnection, time);
 }
+
+/**
+ * opens a registration batch. Until commitBatch, new visible sinks and sources and class changes are
+ * collected instead of being sent one by one; the routing lookups are still updated immediately.
+ */
+void CAmDatabaseObserver::beginBatch()
+{
+    assert(!mBatch);
+    mBatch = true;
+}
+
+/**
+ * closes the registration batch and hands all collected notifications to the mainloop in one call
+ */
+void CAmDatabaseObserver::commitBatch()
+{
+    assert(mBatch);
+    mBatch = false;
+    if (mPendingBatch.listNewSinks.empty() && mPendingBatch.listNewSources.empty() && !mPendingBatch.sinkClassesChanged && !mPendingBatch.sourceClassesChanged)
+        return;
+
+    logInfo("DatabaseObserver::commitBatch sinks:", mPendingBatch.listNewSinks.size(), "sources:", mPendingBatch.listNewSources.size());
+    mSerializer.asyncCall<CAmDatabaseObserver, const am_Batch_s>(this, &CAmDatabaseObserver::sendBatch, mPendingBatch);
+    mPendingBatch.listNewSinks.clear();
+    mPendingBatch.listNewSources.clear();
+    mPendingBatch.sinkClassesChanged = false;
+    mPendingBatch.sourceClassesChanged = false;
+}
+
+/**
+ * drops the registration batch without sending it, the changes of the batch did not make it into the database
+ */
+void CAmDatabaseObserver::rollbackBatch()
+{
+    assert(mBatch);
+    mBatch = false;
+    logError("DatabaseObserver::rollbackBatch dropped sinks:", mPendingBatch.listNewSinks.size(), "sources:", mPendingBatch.listNewSources.size());
+    mPendingBatch.listNewSinks.clear();
+    mPendingBatch.listNewSources.clear();
+    mPendingBatch.sinkClassesChanged = false;
+    mPendingBatch.sourceClassesChanged = false;
+}
+
+am_SinkType_s* CAmDatabaseObserver::batchSink(const am_sinkID_t sinkID)
+{
+    std::vector<am_SinkType_s>::iterator sinkIterator = mPendingBatch.listNewSinks.begin();
+    for (; sinkIterator != mPendingBatch.listNewSinks.end(); ++sinkIterator)
+    {
+        if (sinkIterator->sinkID == sinkID)
+            return (&(*sinkIterator));
+    }
+    return (NULL);
+}
+
+am_SourceType_s* CAmDatabaseObserver::batchSource(const am_sourceID_t sourceID)
+{
+    std::vector<am_SourceType_s>::iterator sourceIterator = mPendingBatch.listNewSources.begin();
+    for (; sourceIterator != mPendingBatch.listNewSources.end(); ++sourceIterator)
+    {
+        if (sourceIterator->sourceID == sourceID)
+            return (&(*sourceIterator));
+    }
+    return (NULL);
+}
+
+void CAmDatabaseObserver::sendBatch(const am_Batch_s batch)
+{
+    std::vector<am_SinkType_s>::const_iterator sinkIterator = batch.listNewSinks.begin();
+    for (; sinkIterator != batch.listNewSinks.end(); ++sinkIterator)
+        mCommandSender->cbNewSink(*sinkIterator);
+
+    std::vector<am_SourceType_s>::const_iterator sourceIterator = batch.listNewSources.begin();
+    for (; sourceIterator != batch.listNewSources.end(); ++sourceIterator)
+        mCommandSender->cbNewSource(*sourceIterator);
+
+    if (batch.sinkClassesChanged)
+        mCommandSender->cbNumberOfSinkClassesChanged();
+    if (batch.sourceClassesChanged)
+        mCommandSender->cbNumberOfSourceClassesChanged();
+}
+
+/**
+ * sets the length of the coalescing frame. Volume, main sound property and system property changes that
+ * arrive within one frame are collected and only the latest value per object is sent when the frame is over.
+ * The daemon runs with NOTIFICATION_FRAME, this overrides it for the tests. The new length applies from the next frame on.
+ * @param frame the length of a frame, zero sends each change on its own
+ */
+void CAmDatabaseObserver::setCoalescingFrame(const timespec frame)
+{
+    mFrame = frame;
+}
+
+bool CAmDatabaseObserver::coalescing() const
+{
+    return (mFrame.tv_sec != 0 || mFrame.tv_nsec != 0);
+}
+
+void CAmDatabaseObserver::startFrame()
+{
+    if (mFrameRunning)
+        return;
+
+    mFrameRunning = true;
+    if (mFrameHandle)
+        mSocketHandler->updateTimer(mFrameHandle, mFrame);
+    else
+        mSocketHandler->addTimer(mFrame, &mFrameCallback, mFrameHandle, NULL);
+}
+
+void CAmDatabaseObserver::flushSink(const am_sinkID_t sinkID)
+{
+    //the serializer keeps the order, so the collected changes arrive before the change that follows
+    std::map<am_sinkID_t, am_mainVolume_t>::iterator volumeIterator = mPendingFrame.mapVolume.find(sinkID);
+    if (volumeIterator != mPendingFrame.mapVolume.end())
+    {
+        mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t, const am_mainVolume_t>(mCommandSender, &CAmCommandSender::cbVolumeChanged, sinkID, volumeIterator->second);
+        mPendingFrame.mapVolume.erase(volumeIterator);
+    }
+    std::map<std::pair<am_sinkID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s>::iterator sinkPropertyIterator = mPendingFrame.mapSinkSoundProperty.begin();
+    while (sinkPropertyIterator != mPendingFrame.mapSinkSoundProperty.end())
+    {
+        if (sinkPropertyIterator->first.first == sinkID)
+        {
+            mSerializer.asyncCall<CAmCommandSender, const am_sinkID_t, const am_MainSoundProperty_s>(mCommandSender, &CAmCommandSender::cbMainSinkSoundPropertyChanged, sinkID, sinkPropertyIterator->second);
+            mPendingFrame.mapSinkSoundProperty.erase(sinkPropertyIterator++);
+        }
+        else
+            ++sinkPropertyIterator;
+    }
+}
+
+void CAmDatabaseObserver::flushSource(const am_sourceID_t sourceID)
+{
+    std::map<std::pair<am_sourceID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s>::iterator sourcePropertyIterator = mPendingFrame.mapSourceSoundProperty.begin();
+    while (sourcePropertyIterator != mPendingFrame.mapSourceSoundProperty.end())
+    {
+        if (sourcePropertyIterator->first.first == sourceID)
+        {
+            mSerializer.asyncCall<CAmCommandSender, const am_sourceID_t, const am_MainSoundProperty_s>(mCommandSender, &CAmCommandSender::cbMainSourceSoundPropertyChanged, sourceID, sourcePropertyIterator->second);
+            mPendingFrame.mapSourceSoundProperty.erase(sourcePropertyIterator++);
+        }
+        else
+            ++sourcePropertyIterator;
+    }
+}
+
+void CAmDatabaseObserver::frameUp(sh_timerHandle_t handle, void* userData)
+{
+    (void) handle;
+    (void) userData;
+    mFrameRunning = false;
+
+    //take the frame out first, the commandsender may cause new changes that belong to the next frame
+    am_Frame_s frame;
+    std::swap(frame.mapVolume, mPendingFrame.mapVolume);
+    std::swap(frame.mapSinkSoundProperty, mPendingFrame.mapSinkSoundProperty);
+    std::swap(frame.mapSourceSoundProperty, mPendingFrame.mapSourceSoundProperty);
+    std::swap(frame.mapSystemProperty, mPendingFrame.mapSystemProperty);
+
+    std::map<am_sinkID_t, am_mainVolume_t>::const_iterator volumeIterator = frame.mapVolume.begin();
+    for (; volumeIterator != frame.mapVolume.end(); ++volumeIterator)
+        mCommandSender->cbVolumeChanged(volumeIterator->first, volumeIterator->second);
+
+    std::map<std::pair<am_sinkID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s>::const_iterator sinkPropertyIterator = frame.mapSinkSoundProperty.begin();
+    for (; sinkPropertyIterator != frame.mapSinkSoundProperty.end(); ++sinkPropertyIterator)
+        mCommandSender->cbMainSinkSoundPropertyChanged(sinkPropertyIterator->first.first, sinkPropertyIterator->second);
+
+    std::map<std::pair<am_sourceID_t, am_MainSoundPropertyType_e>, am_MainSoundProperty_s>::const_iterator sourcePropertyIterator = frame.mapSourceSoundProperty.begin();
+    for (; sourcePropertyIterator != frame.mapSourceSoundProperty.end(); ++sourcePropertyIterator)
+        mCommandSender->cbMainSourceSoundPropertyChanged(sourcePropertyIterator->first.first, sourcePropertyIterator->second);
+
+    std::map<am_SystemPropertyType_e, am_SystemProperty_s>::const_iterator systemPropertyIterator = frame.mapSystemProperty.begin();
+    for (; systemPropertyIterator != frame.mapSystemProperty.end(); ++systemPropertyIterator)
+        mCommandSender->cbSystemPropertyChanged(systemPropertyIterator->second);
+}
 }
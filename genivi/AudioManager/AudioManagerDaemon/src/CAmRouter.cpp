@@ -24,6 +24,8 @@
 #include <algorithm>
 #include <vector>
 #include <iterator>
+#include <queue>
+#include "config.h"
 #include "CAmDatabaseHandler.h"
 #include "CAmControlSender.h"
 
@@ -31,7 +33,17 @@ namespace am {
 
 CAmRouter::CAmRouter(CAmDatabaseHandler* iDatabaseHandler, CAmControlSender* iSender) :
         mpDatabaseHandler(iDatabaseHandler), //
-        mpControlSender(iSender)
+        mpControlSender(iSender), //
+        mGraphValid(false), //
+        mTopologyRevision(0), //
+        mConnectionRevision(0), //
+        mMapGateway(), //
+        mMapDomainGateways(), //
+        mSetBusyGateways(), //
+        mMapSinkConnectionFormats(), //
+        mMapSourceConnectionFormats(), //
+        mMapRoutes(), //
+        mMapFreeRoutes()
 {
     assert(mpDatabaseHandler);
     assert(mpControlSender);
@@ -48,135 +60,342 @@ CAmRouter::CAmRouter(CAmDatabaseHandler* iDatabaseHandler, CAmControlSender* iSe
 am_Error_e CAmRouter::getRoute(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> & returnList)
 {
     returnList.clear();
-    //first find out in which domains the source and sink are
-    am_domainID_t sourceDomainID;
-    am_domainID_t sinkDomainID;
-    if (mpDatabaseHandler->getDomainOfSource(sourceID, sourceDomainID) != E_OK)
-        return (E_NON_EXISTENT);
-    if (mpDatabaseHandler->getDomainOfSink(sinkID, sinkDomainID) != E_OK)
-        return (E_NON_EXISTENT);
+    updateGraph();
+
+    //look up the routes in the cache, free routes are only valid as long as the connections did not change
+    MapRouteCache& mapRoutes = onlyfree ? mMapFreeRoutes : mMapRoutes;
+    RouteKey key(sourceID, sinkID);
+    MapRouteCache::iterator cacheIterator = mapRoutes.find(key);
+    bool dependsOnConnections = onlyfree || BUSY_GATEWAY_COST != 0;
+    if (cacheIterator == mapRoutes.end() || (dependsOnConnections && cacheIterator->second.connectionRevision != mConnectionRevision))
+    {
+        am_RouteCacheEntry_s entry;
+        entry.connectionRevision = mConnectionRevision;
+        am_Error_e error = findRouteCandidates(onlyfree, sourceID, sinkID, entry.listCandidates);
+        if (error != E_OK)
+            return (error);
+        cacheIterator = mapRoutes.insert(cacheIterator, std::make_pair(key, entry));
+        cacheIterator->second = entry;
+    }
 
-    if (sourceDomainID == sinkDomainID) //shortcut if the domains are the same...
+    am_Route_s actualRoute; //holds the actual Route
+    actualRoute.sourceID = sourceID;
+    actualRoute.sinkID = sinkID;
+
+    std::vector<am_RouteCandidate_s>::const_iterator candidateIterator = cacheIterator->second.listCandidates.begin();
+    for (; candidateIterator != cacheIterator->second.listCandidates.end(); ++candidateIterator)
     {
-        //first get the list of possible connection formats
-        std::vector<am_ConnectionFormat_e> listFormats, listPriorityConnectionFormats;
-        listPossibleConnectionFormats(sourceID, sinkID, listFormats);
+        std::vector<am_RoutingElement_s> actualRoutingElement(candidateIterator->listRoutingElements);
 
-        //dummy route
-        am_Route_s route;
-        route.sinkID = sinkID;
-        route.sourceID = sourceID;
-        route.route.clear();
+        if (candidateIterator->listGatewayIDs.empty()) //source and sink are in the same domain
+        {
+            //first get the list of possible connection formats
+            std::vector<am_ConnectionFormat_e> listFormats, listPriorityConnectionFormats;
+            listPossibleConnectionFormats(sourceID, sinkID, listFormats);
 
-        //get the prio of the Controller:
-        mpControlSender->getConnectionFormatChoice(sourceID, sinkID, route, listFormats, listPriorityConnectionFormats);
+            //dummy route
+            am_Route_s route;
+            route.sinkID = sinkID;
+            route.sourceID = sourceID;
+            route.route.clear();
 
-        //no possible connection, so no route ! But we report OK since there is no fault ...
-        if (listPriorityConnectionFormats.empty())
-            return (E_OK);
+            //get the prio of the Controller:
+            mpControlSender->getConnectionFormatChoice(sourceID, sinkID, route, listFormats, listPriorityConnectionFormats);
 
-        //return the first item as route:
-        am_RoutingElement_s routingElement;
-        routingElement.sourceID = sourceID;
-        routingElement.sinkID = sinkID;
-        routingElement.connectionFormat = listPriorityConnectionFormats[0];
-        routingElement.domainID = sourceDomainID;
+            //no possible connection, so no route ! But we report OK since there is no fault ...
+            if (listPriorityConnectionFormats.empty())
+                continue;
 
-        //Now get a route:
-        am_Route_s actualRoute;
-        actualRoute.route.push_back(routingElement);
-        actualRoute.sourceID = sourceID;
-        actualRoute.sinkID = sinkID;
+            //return the first item as route:
+            actualRoutingElement.front().connectionFormat = listPriorityConnectionFormats[0];
+        }
+        else
+        {
+            //Step through the routes and try to use always the best connectionFormat
+            std::vector<am_gatewayID_t> listGatewayID(candidateIterator->listGatewayIDs);
+            if (findBestWay(sinkID, sourceID, actualRoutingElement, actualRoutingElement.begin(), listGatewayID.begin()) != E_OK)
+            {
+                continue;
+            }
+        }
 
-        //push it to the return list - we are done here ...
+        //add the route to the list of routes...
+        actualRoute.route = actualRoutingElement;
         returnList.push_back(actualRoute);
-        return (E_OK);
-
     }
-    CAmRoutingTree routingtree(sourceDomainID); //Build up a Tree from the Source_Domain to every other domain.
-    std::vector<CAmRoutingTreeItem*> flattree; //This list is the flat tree
-    std::vector<CAmRoutingTreeItem*> matchtree;
-    std::vector<am_gatewayID_t> listGatewayID; //holds all gateway ids of the route
-    am_RoutingElement_s routingElement;
-    am_Route_s actualRoute; //holds the actual Route
-    am_sourceID_t lastSource = 0;
+    return (E_OK);
+}
 
-    mpDatabaseHandler->getRoutingTree(onlyfree, routingtree, flattree); //Build up the tree out of the database as
+/**
+ * every gateway costs 1, so that routes with less gateways are preferred. Gateways that are used by a connection
+ * cost BUSY_GATEWAY_COST more, so that routes over unloaded gateways are preferred.
+ */
+uint32_t CAmRouter::gatewayCost(const bool onlyfree, const am_gatewayID_t gatewayID) const
+{
+    uint32_t cost = 1;
+    if (!onlyfree && mSetBusyGateways.count(gatewayID))
+        cost += BUSY_GATEWAY_COST;
+    return (cost);
+}
+
+/**
+ * rebuilds the graph from the gateways of the database when the topology revision changed and the list of
+ * busy gateways when the connection revision changed. A changed topology invalidates all cached routes.
+ */
+void CAmRouter::updateGraph()
+{
+    uint32_t topologyRevision = mpDatabaseHandler->getTopologyRevision();
+    uint32_t connectionRevision = mpDatabaseHandler->getConnectionRevision();
 
-    //we go through the returned flattree and look for our sink, after that flattree holds only treeItems that match
-    std::vector<CAmRoutingTreeItem*>::iterator iterator = flattree.begin();
-    for (; iterator != flattree.end(); ++iterator)
+    if (!mGraphValid || topologyRevision != mTopologyRevision)
     {
-        if ((*iterator)->returnDomainID() == sinkDomainID)
+        std::vector<am_Gateway_s> listGateways;
+        mpDatabaseHandler->getListGateways(listGateways);
+        mMapGateway.clear();
+        mMapDomainGateways.clear();
+        std::vector<am_Gateway_s>::const_iterator gatewayIterator = listGateways.begin();
+        for (; gatewayIterator != listGateways.end(); ++gatewayIterator)
         {
-            matchtree.push_back(*iterator);
+            mMapGateway[gatewayIterator->gatewayID] = *gatewayIterator;
+            mMapDomainGateways[gatewayIterator->domainSinkID].push_back(gatewayIterator->gatewayID);
         }
+        mMapSinkConnectionFormats.clear();
+        mMapSourceConnectionFormats.clear();
+        mMapRoutes.clear();
+        mMapFreeRoutes.clear();
+        mTopologyRevision = topologyRevision;
     }
 
-    //No we need to trace back the routes for each entry in matchtree
-    iterator = matchtree.begin();
-    for (; iterator != matchtree.end(); ++iterator)
+    if (!mGraphValid || topologyRevision != mTopologyRevision || connectionRevision != mConnectionRevision)
     {
-        std::vector<am_RoutingElement_s> actualRoutingElement; //intermediate list of current routing pairs
-        //getting the route for the actual item
-        routingtree.getRoute(*iterator, listGatewayID); //This gives only the Gateway IDs we need more
-
-        //go throught the gatewayids and get more information
-        std::vector<am_gatewayID_t>::iterator gatewayIterator = listGatewayID.begin();
-        for (; gatewayIterator != listGatewayID.end(); ++gatewayIterator)
+        //a gateway is only free if neither its sink nor its source is connected, reserved connections count as well
+        std::vector<am_Connection_s> listConnections, listReservedConnections;
+        mpDatabaseHandler->getListConnections(listConnections);
+        mpDatabaseHandler->getListConnectionsReserved(listReservedConnections);
+        listConnections.insert(listConnections.end(), listReservedConnections.begin(), listReservedConnections.end());
+
+        std::set<am_sinkID_t> setConnectedSinks;
+        std::set<am_sourceID_t> setConnectedSources;
+        std::vector<am_Connection_s>::const_iterator connectionIterator = listConnections.begin();
+        for (; connectionIterator != listConnections.end(); ++connectionIterator)
         {
-            am_Gateway_s gatewayData;
-            if (mpDatabaseHandler->getGatewayInfoDB(*gatewayIterator, gatewayData) != E_OK)
-                return (E_UNKNOWN);
+            setConnectedSinks.insert(connectionIterator->sinkID);
+            setConnectedSources.insert(connectionIterator->sourceID);
+        }
 
-            //at the beginning of the route, we connect first the source to the first gateway
-            if (gatewayIterator == listGatewayID.begin())
-            {
-                routingElement.sourceID = sourceID;
-                routingElement.domainID = sourceDomainID;
-            }
-            else
-            {
-                routingElement.sourceID = lastSource;
-                routingElement.domainID = gatewayData.domainSinkID;
-            }
-            routingElement.sinkID = gatewayData.sinkID;
-            actualRoutingElement.push_back(routingElement);
-            lastSource = gatewayData.sourceID;
+        mSetBusyGateways.clear();
+        MapGateway::const_iterator gatewayIterator = mMapGateway.begin();
+        for (; gatewayIterator != mMapGateway.end(); ++gatewayIterator)
+        {
+            if (setConnectedSinks.count(gatewayIterator->second.sinkID) || setConnectedSources.count(gatewayIterator->second.sourceID))
+                mSetBusyGateways.insert(gatewayIterator->first);
         }
-        //at the end of the route, connect to the sink !
-        routingElement.sourceID = lastSource;
+        mConnectionRevision = connectionRevision;
+    }
+    mGraphValid = true;
+}
+
+/**
+ * searches the graph for the cheapest routes. A partial route is extended cheapest first, routes with the
+ * same cost in the order the gateways were registered. Every partial route carries the formats that can
+ * leave its last domain, so a gateway is only taken if it can accept one of them and convert it into a
+ * format of its source. Domains are not visited twice and every state of domain and formats is extended
+ * at most MAX_ROUTES times, which bounds the search on large topologies.
+ * The bound is a heuristic: the MAX_ROUTES labels that extended a state may all run into domains they
+ * already visited further on, while a dropped label of the same state with another history would have
+ * reached the sink. On such topologies less than MAX_ROUTES routes or not the cheapest ones are returned.
+ * @param onlyfree if true only free gateways are used
+ * @param sourceID
+ * @param sinkID
+ * @param listCandidates the routes without connection formats, cheapest first
+ * @return E_OK on success, E_NON_EXISTENT if the source or the sink does not exist
+ */
+am_Error_e CAmRouter::findRouteCandidates(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_RouteCandidate_s>& listCandidates)
+{
+    listCandidates.clear();
+    //first find out in which domains the source and sink are
+    am_domainID_t sourceDomainID;
+    am_domainID_t sinkDomainID;
+    if (mpDatabaseHandler->getDomainOfSource(sourceID, sourceDomainID) != E_OK)
+        return (E_NON_EXISTENT);
+    if (mpDatabaseHandler->getDomainOfSink(sinkID, sinkDomainID) != E_OK)
+        return (E_NON_EXISTENT);
+
+    am_RoutingElement_s routingElement;
+    am_RouteCandidate_s candidate;
+
+    if (sourceDomainID == sinkDomainID) //shortcut if the domains are the same...
+    {
+        routingElement.sourceID = sourceID;
         routingElement.sinkID = sinkID;
-        routingElement.domainID = sinkDomainID;
-        actualRoutingElement.push_back(routingElement);
+        routingElement.domainID = sourceDomainID;
+        routingElement.connectionFormat = CF_UNKNOWN;
+        candidate.listRoutingElements.push_back(routingElement);
+        listCandidates.push_back(candidate);
+        return (E_OK);
+    }
 
-        //So now we got the route, what is missing are the connectionFormats...
+    const std::vector<am_ConnectionFormat_e>& listSinkFormats = getSinkConnectionFormats(sinkID);
 
-        //Step through the routes and try to use always the best connectionFormat
-        std::vector<am_RoutingElement_s>::iterator routingInterator = actualRoutingElement.begin();
-        gatewayIterator = listGatewayID.begin();
-        if (findBestWay(sinkID, sourceID, actualRoutingElement, routingInterator, gatewayIterator) != E_OK)
+    //the labels are never removed, so the index of a label is also its sequence number for equal costs
+    std::vector<am_RouteLabel_s> listLabels;
+    std::priority_queue<std::pair<uint32_t, int>, std::vector<std::pair<uint32_t, int> >, std::greater<std::pair<uint32_t, int> > > queue;
+    std::map<RouteState, uint16_t> mapStateCount;
+
+    am_RouteLabel_s label;
+    label.cost = 0;
+    label.parent = -1;
+    label.gatewayID = 0;
+    label.domainID = sourceDomainID;
+    label.listFormats = getSourceConnectionFormats(sourceID);
+    listLabels.push_back(label);
+    queue.push(std::make_pair(0, 0));
+
+    std::vector<am_ConnectionFormat_e> listInFormats, listOutFormats, listConvertedFormats, listGatewayFormats;
+    while (!queue.empty() && listCandidates.size() < MAX_ROUTES)
+    {
+        int current = queue.top().second;
+        queue.pop();
+
+        //only labels that complete or extend a route are counted, a label that is stuck because of the
+        //no-revisit rule does not take the place of a later one of the same state
+        uint16_t& count = mapStateCount[RouteState(listLabels[current].domainID, listLabels[current].listFormats)];
+        if (count >= MAX_ROUTES)
+            continue;
+
+        if (listLabels[current].domainID == sinkDomainID)
         {
+            //the route is only complete if the sink can take one of the formats
+            listInFormats.clear();
+            std::set_intersection(listLabels[current].listFormats.begin(), listLabels[current].listFormats.end(), listSinkFormats.begin(), listSinkFormats.end(), std::back_inserter(listInFormats));
+            if (listInFormats.empty())
+                continue;
+
+            candidate.listGatewayIDs.clear();
+            for (int labelIndex = current; listLabels[labelIndex].parent >= 0; labelIndex = listLabels[labelIndex].parent)
+                candidate.listGatewayIDs.push_back(listLabels[labelIndex].gatewayID);
+            std::reverse(candidate.listGatewayIDs.begin(), candidate.listGatewayIDs.end());
+
+            //go throught the gatewayids and get more information
+            candidate.listRoutingElements.clear();
+            am_sourceID_t lastSource = 0;
+            std::vector<am_gatewayID_t>::const_iterator gatewayIterator = candidate.listGatewayIDs.begin();
+            for (; gatewayIterator != candidate.listGatewayIDs.end(); ++gatewayIterator)
+            {
+                const am_Gateway_s& gatewayData = mMapGateway.find(*gatewayIterator)->second;
+
+                //at the beginning of the route, we connect first the source to the first gateway
+                if (gatewayIterator == candidate.listGatewayIDs.begin())
+                {
+                    routingElement.sourceID = sourceID;
+                    routingElement.domainID = sourceDomainID;
+                }
+                else
+                {
+                    routingElement.sourceID = lastSource;
+                    routingElement.domainID = gatewayData.domainSinkID;
+                }
+                routingElement.sinkID = gatewayData.sinkID;
+                routingElement.connectionFormat = CF_UNKNOWN;
+                candidate.listRoutingElements.push_back(routingElement);
+                lastSource = gatewayData.sourceID;
+            }
+            //at the end of the route, connect to the sink !
+            routingElement.sourceID = lastSource;
+            routingElement.sinkID = sinkID;
+            routingElement.domainID = sinkDomainID;
+            candidate.listRoutingElements.push_back(routingElement);
+            listCandidates.push_back(candidate);
+            count++;
             continue;
         }
 
-        //add the route to the list of routes...
-        actualRoute.sourceID = sourceID;
-        actualRoute.sinkID = sinkID;
-        actualRoute.route = actualRoutingElement;
-        returnList.push_back(actualRoute);
+        MapDomainGateways::const_iterator domainIterator = mMapDomainGateways.find(listLabels[current].domainID);
+        if (domainIterator == mMapDomainGateways.end())
+            continue;
+
+        bool extended = false;
+        std::vector<am_gatewayID_t>::const_iterator gatewayIterator = domainIterator->second.begin();
+        for (; gatewayIterator != domainIterator->second.end(); ++gatewayIterator)
+        {
+            if (onlyfree && mSetBusyGateways.count(*gatewayIterator))
+                continue;
+            const am_Gateway_s& gatewayData = mMapGateway.find(*gatewayIterator)->second;
+
+            //a route never enters a domain twice
+            bool visited = false;
+            for (int labelIndex = current; labelIndex >= 0 && !visited; labelIndex = listLabels[labelIndex].parent)
+                visited = (listLabels[labelIndex].domainID == gatewayData.domainSourceID);
+            if (visited)
+                continue;
+
+            //formats the gateway sink can take on this route
+            const std::vector<am_ConnectionFormat_e>& listGatewaySinkFormats = getSinkConnectionFormats(gatewayData.sinkID);
+            listInFormats.clear();
+            std::set_intersection(listLabels[current].listFormats.begin(), listLabels[current].listFormats.end(), listGatewaySinkFormats.begin(), listGatewaySinkFormats.end(), std::back_inserter(listInFormats));
+            if (listInFormats.empty())
+                continue;
+
+            //formats the gateway can convert them into
+            listConvertedFormats.clear();
+            std::vector<am_ConnectionFormat_e>::const_iterator formatIterator = listInFormats.begin();
+            for (; formatIterator != listInFormats.end(); ++formatIterator)
+            {
+                listRestrictedOutputFormatsGateways(*gatewayIterator, *formatIterator, listGatewayFormats);
+                listConvertedFormats.insert(listConvertedFormats.end(), listGatewayFormats.begin(), listGatewayFormats.end());
+            }
+            std::sort(listConvertedFormats.begin(), listConvertedFormats.end());
+            listConvertedFormats.erase(std::unique(listConvertedFormats.begin(), listConvertedFormats.end()), listConvertedFormats.end());
+
+            const std::vector<am_ConnectionFormat_e>& listGatewaySourceFormats = getSourceConnectionFormats(gatewayData.sourceID);
+            listOutFormats.clear();
+            std::set_intersection(listConvertedFormats.begin(), listConvertedFormats.end(), listGatewaySourceFormats.begin(), listGatewaySourceFormats.end(), std::back_inserter(listOutFormats));
+            if (listOutFormats.empty())
+                continue;
+
+            label.cost = listLabels[current].cost + gatewayCost(onlyfree, *gatewayIterator);
+            label.parent = current;
+            label.gatewayID = *gatewayIterator;
+            label.domainID = gatewayData.domainSourceID;
+            label.listFormats = listOutFormats;
+            listLabels.push_back(label);
+            queue.push(std::make_pair(label.cost, (int) listLabels.size() - 1));
+            extended = true;
+        }
+        if (extended)
+            count++;
     }
     return (E_OK);
 }
 
-void CAmRouter::listPossibleConnectionFormats(const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_ConnectionFormat_e>& listFormats) const
+const std::vector<am_ConnectionFormat_e>& CAmRouter::getSinkConnectionFormats(const am_sinkID_t sinkID)
+{
+    MapConnectionFormats::iterator iter = mMapSinkConnectionFormats.find(sinkID);
+    if (iter == mMapSinkConnectionFormats.end())
+    {
+        iter = mMapSinkConnectionFormats.insert(std::make_pair(sinkID, std::vector<am_ConnectionFormat_e>())).first;
+        mpDatabaseHandler->getListSinkConnectionFormats(sinkID, iter->second);
+        std::sort(iter->second.begin(), iter->second.end());
+    }
+    return (iter->second);
+}
+
+const std::vector<am_ConnectionFormat_e>& CAmRouter::getSourceConnectionFormats(const am_sourceID_t sourceID)
+{
+    MapConnectionFormats::iterator iter = mMapSourceConnectionFormats.find(sourceID);
+    if (iter == mMapSourceConnectionFormats.end())
+    {
+        iter = mMapSourceConnectionFormats.insert(std::make_pair(sourceID, std::vector<am_ConnectionFormat_e>())).first;
+        mpDatabaseHandler->getListSourceConnectionFormats(sourceID, iter->second);
+        std::sort(iter->second.begin(), iter->second.end());
+    }
+    return (iter->second);
+}
+
+void CAmRouter::listPossibleConnectionFormats(const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_ConnectionFormat_e>& listFormats)
 {
-    std::vector<am_ConnectionFormat_e> listSourceFormats;
-    std::vector<am_ConnectionFormat_e> listSinkFormats;
-    mpDatabaseHandler->getListSinkConnectionFormats(sinkID, listSinkFormats);
-    mpDatabaseHandler->getListSourceConnectionFormats(sourceID, listSourceFormats);
-    std::sort(listSinkFormats.begin(), listSinkFormats.end()); //todo: this might be not needed if we use strictly sorted input
-    std::sort(listSourceFormats.begin(), listSourceFormats.end()); //todo: this might be not needed if we use strictly sorted input
+    const std::vector<am_ConnectionFormat_e>& listSourceFormats = getSourceConnectionFormats(sourceID);
+    const std::vector<am_ConnectionFormat_e>& listSinkFormats = getSinkConnectionFormats(sinkID);
     std::insert_iterator<std::vector<am_ConnectionFormat_e> > inserter(listFormats, listFormats.begin());
     set_intersection(listSourceFormats.begin(), listSourceFormats.end(), listSinkFormats.begin(), listSinkFormats.end(), inserter);
 }
@@ -247,13 +466,17 @@ am_Error_e CAmRouter::findBestWay(am_sinkID_t sinkID, am_sourceID_t sourceID, st
 void CAmRouter::listRestrictedOutputFormatsGateways(const am_gatewayID_t gatewayID, const am_ConnectionFormat_e sinkConnectionFormat, std::vector<am_ConnectionFormat_e> & listFormats) const
 {
     listFormats.clear();
-    am_Gateway_s gatewayData;
-    mpDatabaseHandler->getGatewayInfoDB(gatewayID, gatewayData);
+    MapGateway::const_iterator gatewayIterator = mMapGateway.find(gatewayID);
+    if (gatewayIterator == mMapGateway.end())
+        return;
+    const am_Gateway_s& gatewayData = gatewayIterator->second;
     std::vector<am_ConnectionFormat_e>::const_iterator rowSinkIterator = gatewayData.listSinkFormats.begin();
     std::vector<bool>::const_iterator matrixIterator = gatewayData.convertionMatrix.begin();
 
     //find the row number of the sink
     rowSinkIterator = find(gatewayData.listSinkFormats.begin(), gatewayData.listSinkFormats.end(), sinkConnectionFormat);
+    if (rowSinkIterator == gatewayData.listSinkFormats.end())
+        return;
     int rowNumberSink = rowSinkIterator - gatewayData.listSinkFormats.begin();
 
     //go through the convertionMatrix and find out if the conversion is possible, if yes, add connectionFormat ...
@@ -20,6 +20,7 @@
  */
 
 #include "CAmRoutingReceiver.h"
+#include "config.h"
 #include <cassert>
 #include <algorithm>
 #include "CAmDatabaseHandler.h"
@@ -41,7 +42,10 @@ CAmRoutingReceiver::CAmRoutingReceiver(CAmDatabaseHandler *iDatabaseHandler, CAm
         mListRundownHandles(), //
         handleCount(0), //
         mWaitStartup(false), //
-        mWaitRundown(false)
+        mWaitRundown(false), //
+        mStartupBatchCallback(this, &CAmRoutingReceiver::startupBatchUp), //
+        mStartupBatchHandle(0), //
+        mStartupBatch(false)
 {
     assert(mpDatabaseHandler!=NULL);
     assert(mpRoutingSender!=NULL);
@@ -59,7 +63,10 @@ CAmRoutingReceiver::CAmRoutingReceiver(CAmDatabaseHandler *iDatabaseHandler, CAm
         mListRundownHandles(), //
         handleCount(0), //
         mWaitStartup(false), //
-        mWaitRundown(false)
+        mWaitRundown(false), //
+        mStartupBatchCallback(this, &CAmRoutingReceiver::startupBatchUp), //
+        mStartupBatchHandle(0), //
+        mStartupBatch(false)
 {
     assert(mpDatabaseHandler!=NULL);
     assert(mpRoutingSender!=NULL);
@@ -70,6 +77,8 @@ CAmRoutingReceiver::CAmRoutingReceiver(CAmDatabaseHandler *iDatabaseHandler, CAm
 
 CAmRoutingReceiver::~CAmRoutingReceiver()
 {
+    if (mStartupBatchHandle)
+        mpSocketHandler->removeTimer(mStartupBatchHandle);
 }
 
 void CAmRoutingReceiver::ackConnect(const am_Handle_s handle, const am_connectionID_t connectionID, const am_Error_e error)
@@ -217,6 +226,7 @@ am_Error_e CAmRoutingReceiver::peekDomain(const std::string & name, am_domainID_
 
 am_Error_e CAmRoutingReceiver::registerDomain(const am_Domain_s & domainData, am_domainID_t & domainID)
 {
+    openStartupBatch();
     return (mpControlSender->hookSystemRegisterDomain(domainData, domainID));
 }
 
@@ -227,6 +237,7 @@ am_Error_e CAmRoutingReceiver::deregisterDomain(const am_domainID_t domainID)
 
 am_Error_e CAmRoutingReceiver::registerGateway(const am_Gateway_s & gatewayData, am_gatewayID_t & gatewayID)
 {
+    openStartupBatch();
     return (mpControlSender->hookSystemRegisterGateway(gatewayData, gatewayID));
 }
 
@@ -242,6 +253,7 @@ am_Error_e CAmRoutingReceiver::peekSink(const std::string& name, am_sinkID_t & s
 
 am_Error_e CAmRoutingReceiver::registerSink(const am_Sink_s & sinkData, am_sinkID_t & sinkID)
 {
+    openStartupBatch();
     return (mpControlSender->hookSystemRegisterSink(sinkData, sinkID));
 }
 
@@ -257,6 +269,7 @@ am_Error_e CAmRoutingReceiver::peekSource(const std::string & name, am_sourceID_
 
 am_Error_e CAmRoutingReceiver::registerSource(const am_Source_s & sourceData, am_sourceID_t & sourceID)
 {
+    openStartupBatch();
     return (mpControlSender->hookSystemRegisterSource(sourceData, sourceID));
 }
 
@@ -267,6 +280,7 @@ am_Error_e CAmRoutingReceiver::deregisterSource(const am_sourceID_t sourceID)
 
 am_Error_e CAmRoutingReceiver::registerCrossfader(const am_Crossfader_s & crossfaderData, am_crossfaderID_t & crossfaderID)
 {
+    openStartupBatch();
     return (mpControlSender->hookSystemRegisterCrossfader(crossfaderData, crossfaderID));
 }
 
@@ -345,7 +359,11 @@ void CAmRoutingReceiver::confirmRoutingReady(const uint16_t handle)
 {
     mListStartupHandles.erase(std::remove(mListStartupHandles.begin(), mListStartupHandles.end(), handle), mListStartupHandles.end());
     if (mWaitStartup && mListStartupHandles.empty())
+    {
+        //the controller sees the complete topology when it is told that routing is ready
+        commitStartupBatch();
         mpControlSender->confirmRoutingReady();
+    }
 }
 
 void CAmRoutingReceiver::confirmRoutingRundown(const uint16_t handle)
@@ -355,6 +373,52 @@ void CAmRoutingReceiver::confirmRoutingRundown(const uint16_t handle)
         mpControlSender->confirmRoutingRundown();
 }
 
+/**
+ * opens the registration batch of the startup. While the routing plugins have not confirmed setRoutingReady,
+ * their registrations are written in one database transaction and the command side is told about them at once.
+ * The batch is committed when the last plugin confirms, at the latest REGISTRATION_BATCH_TIMEOUT ms after it was
+ * opened, so a plugin that takes long to confirm does not hold back the registrations of the others.
+ */
+void CAmRoutingReceiver::openStartupBatch()
+{
+    if (mStartupBatch || !mWaitStartup || mListStartupHandles.empty())
+        return;
+
+    if (mpDatabaseHandler->beginTransaction() != E_OK)
+    {
+        logError("RoutingReceiver::openStartupBatch could not open the batch, registrations are written one by one");
+        return;
+    }
+    mStartupBatch = true;
+
+    timespec timeout;
+    timeout.tv_sec = REGISTRATION_BATCH_TIMEOUT / 1000;
+    timeout.tv_nsec = (REGISTRATION_BATCH_TIMEOUT % 1000) * 1000000;
+    if (mStartupBatchHandle)
+        mpSocketHandler->updateTimer(mStartupBatchHandle, timeout);
+    else
+        mpSocketHandler->addTimer(timeout, &mStartupBatchCallback, mStartupBatchHandle, NULL);
+}
+
+void CAmRoutingReceiver::commitStartupBatch()
+{
+    if (!mStartupBatch)
+        return;
+
+    mStartupBatch = false;
+    mpSocketHandler->stopTimer(mStartupBatchHandle);
+    if (mpDatabaseHandler->commitTransaction() != E_OK)
+        logError("RoutingReceiver::commitStartupBatch could not commit the registrations");
+}
+
+void CAmRoutingReceiver::startupBatchUp(sh_timerHandle_t handle, void* userData)
+{
+    (void) handle;
+    (void) userData;
+    logInfo("RoutingReceiver::startupBatchUp routing is not ready yet, committing the registrations so far");
+    commitStartupBatch();
+}
+
 uint16_t am::CAmRoutingReceiver::getStartupHandle()
 {
     uint16_t handle = ++handleCount; //todo: handle overflow
@@ -22,6 +22,7 @@
 #include "shared/CAmSocketHandler.h"
 #include <config.h>
 #include <cassert>
+#include <climits>
 #include <sys/fcntl.h>
 #include <sys/errno.h>
 #include <sys/poll.h>
@@ -29,8 +30,14 @@
 #include <algorithm>
 #include <features.h>
 #include <csignal>
+#ifdef WITH_TIMERFD
+#include <sys/timerfd.h>
+#endif
 #include "shared/CAmDltWrapper.h"
 
+#define SH_TIMER_INACTIVE ((size_t)-1) //!<heapIndex of a timer that is not running
+#define SH_MAX_POLL_HANDLE 0xFFFF //!<the highest handle a poll can get
+
 namespace am
 {
 
@@ -38,33 +45,65 @@ CAmSocketHandler* CAmSocketHandler::mInstance=NULL;
 
 CAmSocketHandler::CAmSocketHandler() :
         mPipe(),
-        mListPoll(), //
-        mListTimer(), //
-        mListActiveTimer(), //
+        mEpollFd(-1), //
+        mListPoll(1), //
+        mMapFdHandle(), //
+        mListFreePollHandles(), //
+        mListPrepareHandles(), //
+        mListFiredPoll(), //
+        mListEpollEvent(), //
+        mMapTimer(), //
+        mTimerHeap(), //
         mLastInsertedHandle(0), //
-        mLastInsertedPollHandle(0), //
-        mRecreatePollfds(true), //
-        mStartTime(), //
+        mAbsoluteDeadlines(false), //
+        mTimerFd(-1), //
+        mTimerFdDeadline(), //
         receiverCallbackT(this, &CAmSocketHandler::receiverCallback),//
-        checkerCallbackT(this, &CAmSocketHandler::checkerCallback)//
+        checkerCallbackT(this, &CAmSocketHandler::checkerCallback),//
+        timerFdCallbackT(this, &CAmSocketHandler::timerFdCallback)//
 {
     gDispatchDone = 1;
     mInstance=this;
 
+    //slot 0 of mListPoll stays free, 0 is not a valid handle
+    mListPoll[0].handle = 0;
+
+    if ((mEpollFd = epoll_create1(EPOLL_CLOEXEC)) == -1)
+    {
+        logError("CAmSocketHandler could not create epoll instance", errno);
+    }
+
     if (pipe(mPipe) == -1)
     {
         logError("CAmSerializer could not create pipe!");
     }
 
-    //add the pipe to the poll - nothing needs to be proccessed here we just need the pipe to trigger the ppoll
+    //add the pipe to the poll - nothing needs to be proccessed here we just need the pipe to trigger the epoll
     short event = 0;
     sh_pollHandle_t handle;
     event |= POLLIN;
     addFDPoll(mPipe[0], event, NULL, &receiverCallbackT, &checkerCallbackT, NULL, NULL, handle);
+
+#ifdef WITH_TIMERFD
+    //the timers wake up the mainloop via a timerfd that is armed with the earliest deadline
+    if ((mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) == -1)
+    {
+        logError("CAmSocketHandler could not create timerfd, using the epoll timeout", errno);
+    }
+    else if (addFDPoll(mTimerFd, POLLIN, NULL, &timerFdCallbackT, NULL, NULL, NULL, handle) != E_OK)
+    {
+        close(mTimerFd);
+        mTimerFd = -1;
+    }
+#endif
 }
 
 CAmSocketHandler::~CAmSocketHandler()
 {
+    if (mTimerFd != -1)
+        close(mTimerFd);
+    if (mEpollFd != -1)
+        close(mEpollFd);
 }
 
 //todo: maybe have some: give me more time returned?
@@ -74,7 +113,7 @@ CAmSocketHandler::~CAmSocketHandler()
 void CAmSocketHandler::start_listenting()
 {
     gDispatchDone = 0;
-    int16_t pollStatus;
+    int pollStatus;
 
     //prepare the signalmask
     sigset_t sigmask;
@@ -85,26 +124,20 @@ void CAmSocketHandler::start_listenting()
     sigaddset(&sigmask, SIGHUP);
     sigaddset(&sigmask, SIGQUIT);
 
-    clock_gettime(CLOCK_MONOTONIC, &mStartTime);
+    //timers that were started before the mainloop run from now on
+    timerRebase(true);
+
     while (!gDispatchDone)
     {
         //first we go through the registered filedescriptors and check if someone needs preparation:
-        std::for_each(mListPoll.begin(), mListPoll.end(), CAmShCallPrep());
-
-        if (mRecreatePollfds)
+        for (size_t i = 0; i < mListPrepareHandles.size(); i++)
         {
-            mfdPollingArray.clear();
-            //there was a change in the setup, so we need to recreate the fdarray from the list
-            std::for_each(mListPoll.begin(), mListPoll.end(), CAmShCopyPollfd(mfdPollingArray));
-            mRecreatePollfds = false;
+            sh_poll_s& pollData = mListPoll[mListPrepareHandles[i]];
+            pollData.prepareCB->Call(pollData.handle, pollData.userData);
         }
 
-        timerCorrection();
-
         //block until something is on a filedescriptor
-
-        timespec buffertime;
-        if ((pollStatus = ppoll(&mfdPollingArray[0], mfdPollingArray.size(), insertTime(buffertime), &sigmask)) < 0)
+        if ((pollStatus = epoll_pwait(mEpollFd, &mListEpollEvent[0], mListEpollEvent.size(), insertTime(), &sigmask)) < 0)
         {
             if (errno == EINTR)
             {
@@ -113,7 +146,7 @@ void CAmSocketHandler::start_listenting()
             }
             else
             {
-                logError("SocketHandler::start_listenting ppoll returned with error", errno);
+                logError("SocketHandler::start_listenting epoll_pwait returned with error", errno);
                 exit(0);
             }
         }
@@ -122,44 +155,41 @@ void CAmSocketHandler::start_listenting()
         {
             //todo: here could be a timer that makes sure naughty plugins return!
 
-            //freeze mListPoll by copying it - otherwise we get problems when we want to manipulate it during the next lines
-            std::list<sh_poll_s> listPoll;
-            mListPoll_t::iterator listmPollIt;
-
-            //remove all filedescriptors who did not fire
-            std::vector<pollfd>::iterator it = mfdPollingArray.begin();
-            do
+            //freeze the polls that fired by copying them - otherwise we get problems when the callbacks manipulate mListPoll
+            mListFiredPoll.clear();
+            for (int i = 0; i < pollStatus; i++)
             {
-                it = std::find_if(it, mfdPollingArray.end(), eventFired);
-                if (it != mfdPollingArray.end())
+                //all polls on the filedescriptor are chained, the epoll data is the handle of the first one
+                for (sh_pollHandle_t handle = mListEpollEvent[i].data.u32; handle != 0; handle = mListPoll[handle].nextHandle)
                 {
-                    listmPollIt = mListPoll.begin();
-                    std::advance(listmPollIt, std::distance(mfdPollingArray.begin(), it));
-                    listPoll.push_back(*listmPollIt);
-                    listPoll.back().pollfdValue = *it;
-                    it++;
+                    short revents = mListEpollEvent[i].events & (mListPoll[handle].pollfdValue.events | POLLERR | POLLHUP);
+                    if (revents != 0)
+                    {
+                        mListFiredPoll.push_back(mListPoll[handle]);
+                        mListFiredPoll.back().pollfdValue.revents = revents;
+                    }
                 }
-            } while (it != mfdPollingArray.end());
+            }
 
             //stage 1, call firedCB
-            std::for_each(listPoll.begin(), listPoll.end(), CAmShCallFire());
+            std::for_each(mListFiredPoll.begin(), mListFiredPoll.end(), CAmShCallFire());
 
             //stage 2, lets ask around if some dispatching is necessary, the ones who need stay on the list
-            listPoll.remove_if(noDispatching);
+            mListFiredPoll.erase(std::remove_if(mListFiredPoll.begin(), mListFiredPoll.end(), noDispatching), mListFiredPoll.end());
 
             //stage 3, the ones left need to dispatch, we do this as long as there is something to dispatch..
-            do
+            while (!mListFiredPoll.empty())
             {
-                listPoll.remove_if(dispatchingFinished);
-            } while (!listPoll.empty());
-
-        }
-        else //Timerevent
-        {
-            //this was a timer event, we need to take care about the timers
-            timerUp();
+                mListFiredPoll.erase(std::remove_if(mListFiredPoll.begin(), mListFiredPoll.end(), dispatchingFinished), mListFiredPoll.end());
+            }
         }
+
+        //fire the timers that are up
+        timerUp();
     }
+
+    //the remaining time of the running timers is kept until the mainloop is started again
+    timerRebase(false);
 }
 
 /**
@@ -168,16 +198,6 @@ void CAmSocketHandler::start_listenting()
 void CAmSocketHandler::stop_listening()
 {
     gDispatchDone = 1;
-
-    //this is for all running timers only - we need to handle the additional offset here
-    if (!mListActiveTimer.empty())
-    {
-        timespec currentTime, correctionTime;
-        clock_gettime(CLOCK_MONOTONIC, &currentTime);
-        correctionTime = timespecSub(currentTime, mStartTime);
-        std::for_each(mListActiveTimer.begin(), mListActiveTimer.end(), CAmShSubstractTime(correctionTime));
-    }
-
 }
 
 /**
@@ -190,16 +210,33 @@ void CAmSocketHandler::stop_listening()
  * @param dispatch a callback that is called to dispatch the received data
  * @param userData a pointer to userdata that is always passed around
  * @param handle the handle of this poll
- * @return E_OK if the descriptor was added, E_NON_EXISTENT if the fd is not valid
+ * @return E_OK if the descriptor was added, E_NON_EXISTENT if the fd is not valid, E_NOT_POSSIBLE if epoll does not accept it
  */
 am_Error_e CAmSocketHandler::addFDPoll(const int fd, const short event, IAmShPollPrepare *prepare, IAmShPollFired *fired, IAmShPollCheck *check, IAmShPollDispatch *dispatch, void *userData, sh_pollHandle_t & handle)
 {
     if (!fdIsValid(fd))
         return (E_NON_EXISTENT);
 
-    sh_poll_s pollData;
+    //take the slot that is free for the longest time, or a new one
+    if (!mListFreePollHandles.empty())
+    {
+        handle = mListFreePollHandles.front();
+        mListFreePollHandles.pop_front();
+    }
+    else if (mListPoll.size() <= SH_MAX_POLL_HANDLE)
+    {
+        handle = mListPoll.size();
+        mListPoll.push_back(sh_poll_s());
+    }
+    else
+    {
+        logError("CAmSocketHandler::addFDPoll no free handle left");
+        return (E_NOT_POSSIBLE);
+    }
+
+    sh_poll_s& pollData = mListPoll[handle];
     pollData.pollfdValue.fd = fd;
-    pollData.handle = ++mLastInsertedPollHandle;
+    pollData.handle = handle;
     pollData.pollfdValue.events = event;
     pollData.pollfdValue.revents = 0;
     pollData.userData = userData;
@@ -207,13 +244,38 @@ am_Error_e CAmSocketHandler::addFDPoll(const int fd, const short event, IAmShPol
     pollData.firedCB = fired;
     pollData.checkCB = check;
     pollData.dispatchCB = dispatch;
+    pollData.nextHandle = 0;
 
-    //add new data to the list
-    mListPoll.push_back(pollData);
+    //a filedescriptor can only be registered once with epoll, further polls on it are chained behind the first one
+    mMapFdHandle_t::iterator it(mMapFdHandle.find(fd));
+    bool registered;
+    if (it != mMapFdHandle.end())
+    {
+        pollData.nextHandle = mListPoll[it->second].nextHandle;
+        mListPoll[it->second].nextHandle = handle;
+        if (!(registered = epollUpdate(fd, EPOLL_CTL_MOD)))
+            mListPoll[it->second].nextHandle = pollData.nextHandle;
+    }
+    else
+    {
+        mMapFdHandle.insert(std::make_pair(fd, handle));
+        if (!(registered = epollUpdate(fd, EPOLL_CTL_ADD)))
+            mMapFdHandle.erase(fd);
+        else if (mListEpollEvent.size() < mMapFdHandle.size())
+            mListEpollEvent.resize(mMapFdHandle.size());
+    }
 
-    mRecreatePollfds = true;
+    //for example regular files cannot be polled with epoll
+    if (!registered)
+    {
+        pollData.handle = 0;
+        mListFreePollHandles.push_front(handle);
+        return (E_NOT_POSSIBLE);
+    }
+
+    if (prepare)
+        mListPrepareHandles.push_back(handle);
 
-    handle = pollData.handle;
     return (E_OK);
 }
 
@@ -224,18 +286,43 @@ am_Error_e CAmSocketHandler::addFDPoll(const int fd, const short event, IAmShPol
  */
 am_Error_e CAmSocketHandler::removeFDPoll(const sh_pollHandle_t handle)
 {
-    mListPoll_t::iterator iterator = mListPoll.begin();
+    if (handle == 0 || handle >= mListPoll.size() || mListPoll[handle].handle != handle)
+        return (E_UNKNOWN);
 
-    for (; iterator != mListPoll.end(); ++iterator)
+    sh_poll_s& pollData = mListPoll[handle];
+    int fd = pollData.pollfdValue.fd;
+
+    //unlink the poll from the polls on its filedescriptor
+    mMapFdHandle_t::iterator it(mMapFdHandle.find(fd));
+    assert(it != mMapFdHandle.end());
+    if (it->second == handle)
     {
-        if (iterator->handle == handle)
+        if (pollData.nextHandle != 0)
         {
-            iterator = mListPoll.erase(iterator);
-            mRecreatePollfds = true;
-            return (E_OK);
+            it->second = pollData.nextHandle;
+            epollUpdate(fd, EPOLL_CTL_MOD);
         }
+        else
+        {
+            mMapFdHandle.erase(it);
+            epollUpdate(fd, EPOLL_CTL_DEL);
+        }
+    }
+    else
+    {
+        sh_pollHandle_t previous = it->second;
+        while (mListPoll[previous].nextHandle != handle)
+            previous = mListPoll[previous].nextHandle;
+        mListPoll[previous].nextHandle = pollData.nextHandle;
+        epollUpdate(fd, EPOLL_CTL_MOD);
     }
-    return (E_UNKNOWN);
+
+    if (pollData.prepareCB)
+        mListPrepareHandles.erase(std::find(mListPrepareHandles.begin(), mListPrepareHandles.end(), handle));
+
+    pollData.handle = 0;
+    mListFreePollHandles.push_back(handle);
+    return (E_OK);
 }
 
 /**
@@ -254,25 +341,20 @@ am_Error_e CAmSocketHandler::addTimer(const timespec timeouts, IAmShTimerCallBac
     assert(!((timeouts.tv_sec==0) && (timeouts.tv_nsec==0)));
     assert(callback!=NULL);
 
-    sh_timer_s timerItem;
+    //create a new handle for the timer, skipping the ones still in use after an overflow
+    do
+    {
+        handle = ++mLastInsertedHandle;
+    } while (handle == 0 || mMapTimer.find(handle) != mMapTimer.end());
 
-    //create a new handle for the timer
-    handle = ++mLastInsertedHandle; //todo: overflow ruling !o
+    sh_timer_s& timerItem = mMapTimer[handle];
     timerItem.handle = handle;
-    timerItem.countdown = timeouts;
+    timerItem.timeout = timeouts;
     timerItem.callback = callback;
     timerItem.userData = userData;
+    timerItem.heapIndex = SH_TIMER_INACTIVE;
 
-    mListTimer.push_back(timerItem);
-
-    //we add here the time difference between startTime and currenttime, because this time will be substracted later on in timecorrection
-    timespec currentTime;
-    clock_gettime(CLOCK_MONOTONIC, &currentTime);
-    if (!gDispatchDone) //the mainloop is started
-        timerItem.countdown = timespecAdd(timeouts, timespecSub(currentTime, mStartTime));
-
-    mListActiveTimer.push_back(timerItem);
-    mListActiveTimer.sort(compareCountdown);
+    timerStart(timerItem);
     return (E_OK);
 }
 
@@ -285,19 +367,14 @@ am_Error_e CAmSocketHandler::removeTimer(const sh_timerHandle_t handle)
 {
     assert(handle!=0);
 
-    //stop the current timer
-    stopTimer(handle);
+    mMapTimer_t::iterator it(mMapTimer.find(handle));
+    if (it == mMapTimer.end())
+        return (E_UNKNOWN);
 
-    std::list<sh_timer_s>::iterator it(mListTimer.begin());
-    for (; it != mListTimer.end(); ++it)
-    {
-        if (it->handle == handle)
-        {
-            it = mListTimer.erase(it);
-            return (E_OK);
-        }
-    }
-    return (E_UNKNOWN);
+    if (it->second.heapIndex != SH_TIMER_INACTIVE)
+        heapRemove(it->second.heapIndex);
+    mMapTimer.erase(it);
+    return (E_OK);
 }
 
 /**
@@ -308,48 +385,12 @@ am_Error_e CAmSocketHandler::removeTimer(const sh_timerHandle_t handle)
  */
 am_Error_e CAmSocketHandler::updateTimer(const sh_timerHandle_t handle, const timespec timeouts)
 {
-    //update the mList ....
-    sh_timer_s timerItem;
-    std::list<sh_timer_s>::iterator it(mListTimer.begin()), activeIt(mListActiveTimer.begin());
-    bool found(false);
-    for (; it != mListTimer.end(); ++it)
-    {
-        if (it->handle == handle)
-        {
-            it->countdown = timeouts;
-            timerItem = *it;
-            found = true;
-            break;
-        }
-    }
-    if (!found)
+    mMapTimer_t::iterator it(mMapTimer.find(handle));
+    if (it == mMapTimer.end())
         return (E_NON_EXISTENT);
 
-    found = false;
-
-    //we add here the time difference between startTime and currenttime, because this time will be substracted later on in timecorrection
-    timespec currentTime, timeoutsCorrected;
-    currentTime.tv_nsec=timeoutsCorrected.tv_nsec=0;
-    currentTime.tv_sec=timeoutsCorrected.tv_sec=0;
-    clock_gettime(CLOCK_MONOTONIC, &currentTime);
-    if (!gDispatchDone) //the mainloop is started
-        timeoutsCorrected = timespecAdd(timeouts, timespecSub(currentTime, mStartTime));
-
-    for (; activeIt != mListActiveTimer.end(); ++activeIt)
-    {
-        if (activeIt->handle == handle)
-        {
-            activeIt->countdown = timeoutsCorrected;
-            found = true;
-            break;
-        }
-    }
-
-    if (!found)
-        timerItem.countdown = timeoutsCorrected;
-    mListActiveTimer.push_back(timerItem);
-
-    mListActiveTimer.sort(compareCountdown);
+    it->second.timeout = timeouts;
+    timerStart(it->second);
     return (E_OK);
 }
 
@@ -360,48 +401,11 @@ am_Error_e CAmSocketHandler::updateTimer(const sh_timerHandle_t handle, const ti
  */
 am_Error_e CAmSocketHandler::restartTimer(const sh_timerHandle_t handle)
 {
-    sh_timer_s timerItem; //!<the original timer value
-    //find the original value
-    std::list<sh_timer_s>::iterator it(mListTimer.begin()), activeIt(mListActiveTimer.begin());
-    bool found(false);
-    for (; it != mListTimer.end(); ++it)
-    {
-        if (it->handle == handle)
-        {
-            timerItem = *it;
-            found = true;
-            break;
-        }
-    }
-    if (!found)
+    mMapTimer_t::iterator it(mMapTimer.find(handle));
+    if (it == mMapTimer.end())
         return (E_NON_EXISTENT);
 
-    found = false;
-
-    //we add here the time difference between startTime and currenttime, because this time will be substracted later on in timecorrection
-    timespec currentTime, timeoutsCorrected;
-    clock_gettime(CLOCK_MONOTONIC, &currentTime);
-    if (!gDispatchDone) //the mainloop is started
-    {
-        timeoutsCorrected = timespecAdd(timerItem.countdown, timespecSub(currentTime, mStartTime));
-        timerItem.countdown = timeoutsCorrected;
-    }
-
-    for (; activeIt != mListActiveTimer.end(); ++activeIt)
-    {
-        if (activeIt->handle == handle)
-        {
-            activeIt->countdown = timerItem.countdown;
-            found = true;
-            break;
-        }
-    }
-
-    if (!found)
-        mListActiveTimer.push_back(timerItem);
-
-    mListActiveTimer.sort(compareCountdown);
-
+    timerStart(it->second);
     return (E_OK);
 }
 
@@ -412,43 +416,37 @@ am_Error_e CAmSocketHandler::restartTimer(const sh_timerHandle_t handle)
  */
 am_Error_e CAmSocketHandler::stopTimer(const sh_timerHandle_t handle)
 {
-    //go through the list and remove the timer with the handle
-    std::list<sh_timer_s>::iterator it(mListActiveTimer.begin());
-    for (; it != mListActiveTimer.end(); ++it)
-    {
-        if (it->handle == handle)
-        {
-            it = mListActiveTimer.erase(it);
-            return (E_OK);
-        }
-    }
-    return (E_NON_EXISTENT);
+    mMapTimer_t::iterator it(mMapTimer.find(handle));
+    if (it == mMapTimer.end() || it->second.heapIndex == SH_TIMER_INACTIVE)
+        return (E_NON_EXISTENT);
+
+    heapRemove(it->second.heapIndex);
+    return (E_OK);
 }
 
 /**
  * updates the eventFlags of a poll
  * @param handle
  * @param events
- * @return @return E_OK on succsess, E_NON_EXISTENT if fd was not found
+ * @return @return E_OK on succsess, E_NON_EXISTENT if fd was not found, E_NOT_POSSIBLE if epoll does not accept the flags
  */
 am_Error_e CAmSocketHandler::updateEventFlags(const sh_pollHandle_t handle, const short events)
 {
-    mListPoll_t::iterator iterator = mListPoll.begin();
+    if (handle == 0 || handle >= mListPoll.size() || mListPoll[handle].handle != handle)
+        return (E_UNKNOWN);
 
-    for (; iterator != mListPoll.end(); ++iterator)
+    short oldEvents = mListPoll[handle].pollfdValue.events;
+    mListPoll[handle].pollfdValue.events = events;
+    if (!epollUpdate(mListPoll[handle].pollfdValue.fd, EPOLL_CTL_MOD))
     {
-        if (iterator->handle == handle)
-        {
-            iterator->pollfdValue.events = events;
-            mRecreatePollfds = true;
-            return (E_OK);
-        }
+        mListPoll[handle].pollfdValue.events = oldEvents;
+        return (E_NOT_POSSIBLE);
     }
-    return (E_UNKNOWN);
+    return (E_OK);
 }
 
 /**
- * checks if a filedescriptor is validCAmShSubstractTime
+ * checks if a filedescriptor is valid
  * @param fd the filedescriptor
  * @return true if the fd is valid
  */
@@ -458,63 +456,204 @@ bool CAmSocketHandler::fdIsValid(const int fd) const
 }
 
 /**
- * timer is up.
+ * registers a filedescriptor with epoll, the events are the union of the events of all polls on the filedescriptor
+ * @param fd the filedescriptor
+ * @param operation EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ * @return true if epoll accepted the filedescriptor
+ */
+bool CAmSocketHandler::epollUpdate(const int fd, const int operation)
+{
+    epoll_event event;
+    event.events = 0;
+    event.data.u64 = 0;
+
+    if (operation != EPOLL_CTL_DEL)
+    {
+        mMapFdHandle_t::const_iterator it(mMapFdHandle.find(fd));
+        assert(it != mMapFdHandle.end());
+        event.data.u32 = it->second;
+        for (sh_pollHandle_t handle = it->second; handle != 0; handle = mListPoll[handle].nextHandle)
+            event.events |= mListPoll[handle].pollfdValue.events;
+    }
+
+    if (epoll_ctl(mEpollFd, operation, fd, &event) == -1)
+    {
+        //a filedescriptor that was closed before it was removed is already gone from epoll
+        if (operation == EPOLL_CTL_DEL && (errno == EBADF || errno == ENOENT))
+            return (true);
+        //the filedescriptor was closed while it was polled and its number was reused, register it again
+        if (operation == EPOLL_CTL_MOD && errno == ENOENT && epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &event) == 0)
+            return (true);
+        logError("CAmSocketHandler::epollUpdate epoll_ctl failed for fd", fd, "error", errno);
+        return (false);
+    }
+    return (true);
+}
+
+/**
+ * fires all timers that are up
  */
 void CAmSocketHandler::timerUp()
 {
-    //find out the timedifference to starttime
-    timespec currentTime, diffTime;
+    if (mTimerHeap.empty())
+        return;
+
+    timespec currentTime;
     clock_gettime(CLOCK_MONOTONIC, &currentTime);
-    diffTime = timespecSub(currentTime, mStartTime);
 
-    //now we need to substract the diffTime from all timers and see if they are up
-    std::list<sh_timer_s>::reverse_iterator overflowIter = std::find_if(mListActiveTimer.rbegin(), mListActiveTimer.rend(), CAmShCountdownUp(diffTime));
+    //take the fired timers off the heap first, the callbacks are free to restart them
+    std::vector<sh_timerHandle_t> listFired;
+    while (!mTimerHeap.empty() && timespecCompare(mTimerHeap.front()->deadline, currentTime) <= 0)
+    {
+        listFired.push_back(mTimerHeap.front()->handle);
+        heapRemove(0);
+    }
 
-    //copy all fired timers into a list
-    std::vector<sh_timer_s> tempList(overflowIter, mListActiveTimer.rend());
+    //call the callbacks for the timers, unless an earlier callback removed them
+    std::vector<sh_timerHandle_t>::const_iterator it(listFired.begin());
+    for (; it != listFired.end(); ++it)
+    {
+        mMapTimer_t::iterator timerIt(mMapTimer.find(*it));
+        if (timerIt != mMapTimer.end())
+            timerIt->second.callback->Call(timerIt->second.handle, timerIt->second.userData);
+    }
+}
 
-    //erase all fired timers
-    std::list<sh_timer_s>::iterator it(overflowIter.base());
-    mListActiveTimer.erase(mListActiveTimer.begin(), it);
+/**
+ * (re)starts a timer with its timeout
+ * @param timer the timer
+ */
+void CAmSocketHandler::timerStart(sh_timer_s& timer)
+{
+    timer.deadline = timer.timeout;
+    if (mAbsoluteDeadlines)
+    {
+        timespec currentTime;
+        clock_gettime(CLOCK_MONOTONIC, &currentTime);
+        timer.deadline = timespecAdd(currentTime, timer.timeout);
+    }
 
-    //call the callbacks for the timers
-    std::for_each(tempList.begin(), tempList.end(), CAmShCallTimer());
+    if (timer.heapIndex == SH_TIMER_INACTIVE)
+    {
+        heapInsert(&timer);
+    }
+    else
+    {
+        heapSiftUp(timer.heapIndex);
+        heapSiftDown(timer.heapIndex);
+    }
 }
 
 /**
- * correct timers and fire the ones who are up
+ * converts the deadlines of the running timers between absolute times and times relative to the start of the mainloop.
+ * The same offset is applied to all timers, so the heap order is kept.
+ * @param absolute true to convert to absolute times
  */
-void CAmSocketHandler::timerCorrection()
+void CAmSocketHandler::timerRebase(const bool absolute)
 {
-    //get the current time and calculate the correction value
-    timespec currentTime, correctionTime;
+    if (mAbsoluteDeadlines == absolute)
+        return;
+
+    timespec currentTime;
     clock_gettime(CLOCK_MONOTONIC, &currentTime);
-    correctionTime = timespecSub(currentTime, mStartTime);
-    mStartTime = currentTime;
+    mTimerHeap_t::iterator it(mTimerHeap.begin());
+    for (; it != mTimerHeap.end(); ++it)
+    {
+        (*it)->deadline = absolute ? timespecAdd((*it)->deadline, currentTime) : timespecSub((*it)->deadline, currentTime);
+    }
+    mAbsoluteDeadlines = absolute;
+    mTimerFdDeadline.tv_sec = mTimerFdDeadline.tv_nsec = 0;
+}
 
-    if (!mListActiveTimer.empty())
+/**
+ * drains the timerfd, the timers that are up are fired after the dispatching
+ */
+void CAmSocketHandler::timerFdCallback(const pollfd pollfd, const sh_pollHandle_t handle, void* userData)
+{
+    (void) handle;
+    (void) userData;
+    uint64_t expirations;
+    if (read(pollfd.fd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
     {
+        logError("CAmSocketHandler::timerFdCallback could not read timerfd", errno);
+    }
+}
 
-        //subtract the correction value from all items in the list
-        std::for_each(mListActiveTimer.begin(), mListActiveTimer.end(), CAmShSubstractTime(correctionTime));
+/**
+ * adds a timer to the heap
+ * @param timer the timer
+ */
+void CAmSocketHandler::heapInsert(sh_timer_s* timer)
+{
+    timer->heapIndex = mTimerHeap.size();
+    mTimerHeap.push_back(timer);
+    heapSiftUp(timer->heapIndex);
+}
 
-        //find the last occurrence of zero -> timer overflowed
-        std::list<sh_timer_s>::reverse_iterator overflowIter = std::find_if(mListActiveTimer.rbegin(), mListActiveTimer.rend(), CAmShCountdownZero());
+/**
+ * removes a timer from the heap
+ * @param index the position of the timer in the heap
+ */
+void CAmSocketHandler::heapRemove(const size_t index)
+{
+    assert(index < mTimerHeap.size());
 
-        //only if a timer overflowed
-        if (overflowIter != mListActiveTimer.rend())
-        {
-            //copy all timers that need to be called to a new list
-            std::vector<sh_timer_s> tempList(overflowIter, mListActiveTimer.rend());
+    mTimerHeap[index]->heapIndex = SH_TIMER_INACTIVE;
+    sh_timer_s* last = mTimerHeap.back();
+    mTimerHeap.pop_back();
+    if (index < mTimerHeap.size())
+    {
+        //the last timer fills the gap and moves to its place
+        mTimerHeap[index] = last;
+        last->heapIndex = index;
+        heapSiftUp(index);
+        heapSiftDown(last->heapIndex);
+    }
+}
 
-            //erase all fired timers
-            std::list<sh_timer_s>::iterator it(overflowIter.base());
-            mListActiveTimer.erase(mListActiveTimer.begin(), it);
+/**
+ * moves a timer towards the top of the heap until its parent is not later
+ * @param index the position of the timer in the heap
+ */
+void CAmSocketHandler::heapSiftUp(size_t index)
+{
+    sh_timer_s* timer = mTimerHeap[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (timespecCompare(mTimerHeap[parent]->deadline, timer->deadline) <= 0)
+            break;
+        mTimerHeap[index] = mTimerHeap[parent];
+        mTimerHeap[index]->heapIndex = index;
+        index = parent;
+    }
+    mTimerHeap[index] = timer;
+    timer->heapIndex = index;
+}
 
-            //call the callbacks for the timers
-            std::for_each(tempList.begin(), tempList.end(), CAmShCallTimer());
-        }
+/**
+ * moves a timer towards the bottom of the heap until its children are not earlier
+ * @param index the position of the timer in the heap
+ */
+void CAmSocketHandler::heapSiftDown(size_t index)
+{
+    sh_timer_s* timer = mTimerHeap[index];
+    size_t size = mTimerHeap.size();
+    for (;;)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && timespecCompare(mTimerHeap[child + 1]->deadline, mTimerHeap[child]->deadline) < 0)
+            child++;
+        if (timespecCompare(timer->deadline, mTimerHeap[child]->deadline) <= 0)
+            break;
+        mTimerHeap[index] = mTimerHeap[child];
+        mTimerHeap[index]->heapIndex = index;
+        index = child;
     }
+    mTimerHeap[index] = timer;
+    timer->heapIndex = index;
 }
 
 void CAmSocketHandler::exit_mainloop()
@@ -536,20 +675,47 @@ void CAmSocketHandler::static_exit_mainloop()
 }
 
 /**
- * is used to set the pointer for the ppoll command
- * @param buffertime
- * @return
+ * calculates the timeout for epoll_pwait
+ * @return the time until the next timer is up in ms, rounded up and at most INT_MAX. -1 if there is no timer or the timerfd is used
  */
-inline timespec* CAmSocketHandler::insertTime(timespec& buffertime)
+inline int CAmSocketHandler::insertTime()
 {
-    if (!mListActiveTimer.empty())
+    if (mTimerFd != -1)
     {
-        buffertime = mListActiveTimer.front().countdown;
-        return (&buffertime);
+#ifdef WITH_TIMERFD
+        //the timerfd wakes up the epoll, it only needs to be rearmed when the earliest deadline changed
+        timespec deadline;
+        deadline.tv_sec = deadline.tv_nsec = 0;
+        if (!mTimerHeap.empty())
+            deadline = mTimerHeap.front()->deadline;
+        if (timespecCompare(deadline, mTimerFdDeadline) != 0)
+        {
+            itimerspec timerValue;
+            timerValue.it_interval.tv_sec = timerValue.it_interval.tv_nsec = 0;
+            timerValue.it_value = deadline;
+            if (timerfd_settime(mTimerFd, TFD_TIMER_ABSTIME, &timerValue, NULL) == -1)
+            {
+                logError("CAmSocketHandler::insertTime could not arm timerfd", errno);
+            }
+            mTimerFdDeadline = deadline;
+        }
+#endif
+        return (-1);
+    }
+    else if (!mTimerHeap.empty())
+    {
+        timespec currentTime, buffertime;
+        clock_gettime(CLOCK_MONOTONIC, &currentTime);
+        buffertime = timespecSub(mTimerHeap.front()->deadline, currentTime);
+        //a timer further away than INT_MAX ms (about 24.8 days) wakes the loop up early, the timeout is calculated again then
+        if (buffertime.tv_sec >= INT_MAX / 1000)
+            return (INT_MAX);
+        //round up, otherwise the loop spins until the timer is up
+        return (buffertime.tv_sec * 1000 + (buffertime.tv_nsec + 999999) / 1000000);
     }
     else
     {
-        return (NULL);
+        return (-1);
     }
 }
 
@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <time.h>
 #include "shared/CAmDltWrapper.h"
 
 using namespace am;
@@ -45,6 +46,7 @@ CAmDatabaseHandlerTest::CAmDatabaseHandlerTest() :
         pMockInterface(), //
         pRoutingInterfaceBackdoor(), //
         pCommandInterfaceBackdoor(), //
+        pDatabaseBackdoor(), //
         pControlSender(""), //
         pRouter(&pDatabaseHandler, &pControlSender), //
         pControlReceiver(&pDatabaseHandler, &pRoutingSender, &pCommandSender,  &pSocketHandler, &pRouter), //
@@ -58,6 +60,19 @@ CAmDatabaseHandlerTest::~CAmDatabaseHandlerTest()
 {
 }
 
+CAmStopListeningCb::CAmStopListeningCb(CAmSocketHandler *SocketHandler) :
+        pTimerCallback(this, &CAmStopListeningCb::timerCallback), //
+        mSocketHandler(SocketHandler)
+{
+}
+
+void CAmStopListeningCb::timerCallback(sh_timerHandle_t handle, void* userData)
+{
+    (void) handle;
+    (void) userData;
+    mSocketHandler->stop_listening();
+}
+
 void CAmDatabaseHandlerTest::createMainConnectionSetup()
 {
     //fill the connection database
@@ -1915,6 +1930,343 @@ TEST_F(CAmDatabaseHandlerTest,enterSinksCorrect)
     ASSERT_EQ(true, equal);
 }
 
+TEST_F(CAmDatabaseHandlerTest,registerTopologyStartupTime)
+{
+    //a topology of 500 objects as the routing plugins register it at startup. The time is logged, the bound is
+    //generous because test machines differ
+    const uint16_t numberDomains = 10;
+    const uint16_t numberSinks = 200;
+    const uint16_t numberSources = 200;
+    const uint16_t numberGateways = 90;
+    am_Domain_s domain;
+    am_Sink_s sink;
+    am_Source_s source;
+    am_Gateway_s gateway;
+    am_domainID_t domainID;
+    am_sinkID_t sinkID;
+    am_sourceID_t sourceID;
+    am_gatewayID_t gatewayID;
+    std::vector<am_sinkID_t> listSinkIDs;
+    std::vector<am_sourceID_t> listSourceIDs;
+    timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint16_t i = 0; i < numberDomains; i++)
+    {
+        pCF.createDomain(domain);
+        domain.name = "domain" + int2string(i);
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterDomainDB(domain,domainID));
+    }
+    for (uint16_t i = 0; i < numberSinks; i++)
+    {
+        pCF.createSink(sink);
+        sink.sinkID = 0;
+        sink.name = "sink" + int2string(i);
+        sink.domainID = 1 + i % numberDomains;
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+        listSinkIDs.push_back(sinkID);
+    }
+    for (uint16_t i = 0; i < numberSources; i++)
+    {
+        pCF.createSource(source);
+        source.sourceID = 0;
+        source.name = "source" + int2string(i);
+        source.domainID = 1 + i % numberDomains;
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(source,sourceID));
+        listSourceIDs.push_back(sourceID);
+    }
+    for (uint16_t i = 0; i < numberGateways; i++)
+    {
+        pCF.createGateway(gateway);
+        gateway.name = "gateway" + int2string(i);
+        gateway.sinkID = listSinkIDs[i];
+        gateway.sourceID = listSourceIDs[i];
+        gateway.controlDomainID = 1 + i % numberDomains;
+        gateway.domainSinkID = 1 + i % numberDomains;
+        gateway.domainSourceID = 1 + (i + 1) % numberDomains;
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterGatewayDB(gateway,gatewayID));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    uint64_t registration = (end.tv_sec - start.tv_sec) * 1000000ULL + (end.tv_nsec - start.tv_nsec) / 1000;
+    logInfo("DatabaseHandlerTest::registerTopologyStartupTime registration took [us]:", registration);
+    ASSERT_LT(registration, 1000000u);
+
+    std::vector<am_Sink_s> listSinks;
+    std::vector<am_Source_s> listSources;
+    std::vector<am_Gateway_s> listGateways;
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinks(listSinks));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSources(listSources));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListGateways(listGateways));
+    ASSERT_EQ(numberSinks, listSinks.size());
+    ASSERT_EQ(numberSources, listSources.size());
+    ASSERT_EQ(numberGateways, listGateways.size());
+    std::vector<am_Sink_s>::iterator listIterator = listSinks.begin();
+    for (; listIterator < listSinks.end(); ++listIterator)
+    {
+        if (listIterator->sinkID == sinkID)
+        {
+            ASSERT_TRUE(pCF.compareSink(listIterator, sink));
+        }
+    }
+}
+
+TEST_F(CAmDatabaseHandlerTest,registrationBatch)
+{
+    am_Sink_s sink;
+    am_Source_s source;
+    am_sinkID_t sinkID, removedSinkID;
+    am_sourceID_t sourceID;
+    am_MainSoundProperty_s soundProperty;
+    std::vector<am_Sink_s> listSinks;
+    std::vector<am_Source_s> listSources;
+    CAmStopListeningCb stopCallback(&pSocketHandler);
+    sh_timerHandle_t handle;
+    timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+
+    //no batch open
+    ASSERT_EQ(E_NOT_POSSIBLE, pDatabaseHandler.commitTransaction());
+
+    //the command side hears about the batch once it is committed, with the values of the end of the batch
+    EXPECT_CALL(pMockInterface,cbNewSink(AllOf(Field(&am_SinkType_s::name,"sink"),Field(&am_SinkType_s::muteState,MS_MUTED),Field(&am_SinkType_s::volume,30)))).Times(1);
+    EXPECT_CALL(pMockInterface,cbNewSource(Field(&am_SourceType_s::name,"source"))).Times(1);
+    EXPECT_CALL(pMockInterface,cbRemovedSink(_)).Times(0);
+    EXPECT_CALL(pMockInterface,cbSinkMuteStateChanged(_,_)).Times(0);
+    EXPECT_CALL(pMockInterface,cbVolumeChanged(_,_)).Times(0);
+    EXPECT_CALL(pMockInterface,cbMainSinkSoundPropertyChanged(_,_)).Times(0);
+
+    //batches nest, only the outer commit applies the batch
+    ASSERT_EQ(E_OK, pDatabaseHandler.beginTransaction());
+    ASSERT_EQ(E_OK, pDatabaseHandler.beginTransaction());
+    pCF.createSink(sink);
+    sink.name = "sink";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+    sink.sinkID = 0;
+    sink.name = "removedSink";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,removedSinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(removedSinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.commitTransaction());
+    pCF.createSource(source);
+    source.name = "source";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(source,sourceID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMuteStateDB(MS_MUTED,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(30,sinkID));
+    soundProperty = sink.listMainSoundProperties[0];
+    soundProperty.value = 7;
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSinkSoundPropertyDB(soundProperty,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.commitTransaction());
+    ASSERT_EQ(E_NOT_POSSIBLE, pDatabaseHandler.commitTransaction());
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinks(listSinks));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSources(listSources));
+    ASSERT_EQ(1u, listSinks.size());
+    ASSERT_EQ(1u, listSources.size());
+    ASSERT_EQ(sinkID, listSinks[0].sinkID);
+    ASSERT_EQ(MS_MUTED, listSinks[0].muteState);
+    ASSERT_EQ(sourceID, listSources[0].sourceID);
+
+    ASSERT_EQ(E_OK, pSocketHandler.addTimer(timeout,&stopCallback.pTimerCallback,handle,NULL));
+    pSocketHandler.start_listenting();
+}
+
+TEST_F(CAmDatabaseHandlerTest,coalescedNotifications)
+{
+    am_Sink_s sink;
+    am_Source_s source;
+    am_sinkID_t sinkID, secondSinkID, removedSinkID;
+    am_sourceID_t sourceID;
+    am_MainSoundProperty_s soundProperty;
+    CAmStopListeningCb stopCallback(&pSocketHandler);
+    sh_timerHandle_t handle;
+    timespec frame, timeout;
+    frame.tv_sec = 0;
+    frame.tv_nsec = 5000000;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+    pObserver.setCoalescingFrame(frame);
+
+    pCF.createSink(sink);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+    sink.sinkID = 0;
+    sink.name = "secondSink";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,secondSinkID));
+    sink.sinkID = 0;
+    sink.name = "removedSink";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,removedSinkID));
+    pCF.createSource(source);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(source,sourceID));
+
+    //only the latest value per object is sent, changes of removed objects are dropped
+    EXPECT_CALL(pMockInterface,cbNewSink(_)).Times(3);
+    EXPECT_CALL(pMockInterface,cbNewSource(_)).Times(1);
+    EXPECT_CALL(pMockInterface,cbVolumeChanged(sinkID,30)).Times(1);
+    EXPECT_CALL(pMockInterface,cbVolumeChanged(secondSinkID,40)).Times(1);
+    EXPECT_CALL(pMockInterface,cbMainSinkSoundPropertyChanged(sinkID,Field(&am_MainSoundProperty_s::value,7))).Times(1);
+    EXPECT_CALL(pMockInterface,cbMainSourceSoundPropertyChanged(sourceID,Field(&am_MainSoundProperty_s::value,9))).Times(1);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(10,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(40,secondSinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(20,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(50,removedSinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(30,sinkID));
+    soundProperty = sink.listMainSoundProperties[0];
+    for (int16_t value = 1; value <= 7; value++)
+    {
+        soundProperty.value = value;
+        ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSinkSoundPropertyDB(soundProperty,sinkID));
+        ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSinkSoundPropertyDB(soundProperty,removedSinkID));
+    }
+    soundProperty = source.listMainSoundProperties[0];
+    soundProperty.value = 8;
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSourceSoundPropertyDB(soundProperty,sourceID));
+    soundProperty.value = 9;
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSourceSoundPropertyDB(soundProperty,sourceID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(removedSinkID));
+
+    ASSERT_EQ(E_OK, pSocketHandler.addTimer(timeout,&stopCallback.pTimerCallback,handle,NULL));
+    pSocketHandler.start_listenting();
+}
+
+TEST_F(CAmDatabaseHandlerTest,coalescedNotificationsKeepOrder)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    am_MainSoundProperty_s soundProperty;
+    CAmStopListeningCb stopCallback(&pSocketHandler);
+    sh_timerHandle_t handle;
+    timespec frame, timeout;
+    frame.tv_sec = 0;
+    frame.tv_nsec = 5000000;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+    pObserver.setCoalescingFrame(frame);
+
+    pCF.createSink(sink);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+
+    //changes collected in the frame are sent before a change of the same object that is not coalesced
+    EXPECT_CALL(pMockInterface,cbNewSink(_)).Times(1);
+    {
+        InSequence sequence;
+        EXPECT_CALL(pMockInterface,cbVolumeChanged(sinkID,10)).Times(1);
+        EXPECT_CALL(pMockInterface,cbMainSinkSoundPropertyChanged(sinkID,Field(&am_MainSoundProperty_s::value,5))).Times(1);
+        EXPECT_CALL(pMockInterface,cbSinkMuteStateChanged(sinkID,MS_MUTED)).Times(1);
+        EXPECT_CALL(pMockInterface,cbVolumeChanged(sinkID,20)).Times(1);
+    }
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(10,sinkID));
+    soundProperty = sink.listMainSoundProperties[0];
+    soundProperty.value = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSinkSoundPropertyDB(soundProperty,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMuteStateDB(MS_MUTED,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(20,sinkID));
+
+    ASSERT_EQ(E_OK, pSocketHandler.addTimer(timeout,&stopCallback.pTimerCallback,handle,NULL));
+    pSocketHandler.start_listenting();
+}
+
+TEST_F(CAmDatabaseHandlerTest,uncoalescedNotificationsAfterBatch)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    CAmStopListeningCb stopCallback(&pSocketHandler);
+    sh_timerHandle_t handle;
+    timespec frame, timeout;
+    frame.tv_sec = 0;
+    frame.tv_nsec = 0;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+    pObserver.setCoalescingFrame(frame);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.beginTransaction());
+    pCF.createSink(sink);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.commitTransaction());
+
+    //committing a batch keeps the frame length, every change is still sent on its own
+    EXPECT_CALL(pMockInterface,cbNewSink(_)).Times(1);
+    EXPECT_CALL(pMockInterface,cbVolumeChanged(sinkID,10)).Times(1);
+    EXPECT_CALL(pMockInterface,cbVolumeChanged(sinkID,20)).Times(1);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(10,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(20,sinkID));
+
+    ASSERT_EQ(E_OK, pSocketHandler.addTimer(timeout,&stopCallback.pTimerCallback,handle,NULL));
+    pSocketHandler.start_listenting();
+}
+
+#ifndef WITH_DATABASE_MAP
+TEST_F(CAmDatabaseHandlerTest,statementCache)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    sqlite3_stmt* statement = NULL;
+    std::string command = "UPDATE Sinks SET mainVolume=? WHERE sinkID=?";
+    std::string connectionCommand = "SELECT connectionID FROM Connections";
+    std::string mainConnectionCommand = "SELECT mainConnectionID FROM MainConnections";
+    pCF.createSink(sink);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+
+    //each statement is prepared once and counted on every use
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(10,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(20,sinkID));
+    ASSERT_TRUE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,command));
+    ASSERT_EQ(2u, pDatabaseBackdoor.statementCalls(&pDatabaseHandler,command));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.prepareStatement(&pDatabaseHandler,connectionCommand,&statement));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.finalizeStatement(&pDatabaseHandler,statement));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.prepareStatement(&pDatabaseHandler,mainConnectionCommand,&statement));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.finalizeStatement(&pDatabaseHandler,statement));
+
+    //only whole table names match, Connections is part of MainConnections
+    pDatabaseBackdoor.invalidateStatements(&pDatabaseHandler,"Connections");
+    ASSERT_FALSE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,connectionCommand));
+    ASSERT_TRUE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,mainConnectionCommand));
+    ASSERT_TRUE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,command));
+    ASSERT_EQ(1u, pDatabaseBackdoor.statementCalls(&pDatabaseHandler,connectionCommand));
+
+    //the statistics are kept when all statements are finalized
+    pDatabaseBackdoor.invalidateStatements(&pDatabaseHandler,"");
+    ASSERT_FALSE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,mainConnectionCommand));
+    ASSERT_FALSE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,command));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(30,sinkID));
+    ASSERT_TRUE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,command));
+    ASSERT_EQ(3u, pDatabaseBackdoor.statementCalls(&pDatabaseHandler,command));
+}
+
+TEST_F(CAmDatabaseHandlerTest,statementCacheInUse)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    sqlite3_stmt *statement = NULL, *nestedStatement = NULL;
+    std::string command = "SELECT sinkID FROM Sinks";
+    pCF.createSink(sink);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+
+    //a statement used further up the call stack is not handed out twice
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.prepareStatement(&pDatabaseHandler,command,&statement));
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(statement));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.prepareStatement(&pDatabaseHandler,command,&nestedStatement));
+    ASSERT_NE(statement, nestedStatement);
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.finalizeStatement(&pDatabaseHandler,nestedStatement));
+
+    //invalidating keeps the statement in use valid until it is handed back
+    pDatabaseBackdoor.invalidateStatements(&pDatabaseHandler,"Sinks");
+    ASSERT_FALSE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,command));
+    ASSERT_EQ(sinkID, sqlite3_column_int(statement, 0));
+    ASSERT_EQ(SQLITE_DONE, sqlite3_step(statement));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.finalizeStatement(&pDatabaseHandler,statement));
+
+    //the next use prepares the statement again
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.prepareStatement(&pDatabaseHandler,command,&statement));
+    ASSERT_TRUE(pDatabaseBackdoor.statementCached(&pDatabaseHandler,command));
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(statement));
+    ASSERT_EQ(SQLITE_OK, pDatabaseBackdoor.finalizeStatement(&pDatabaseHandler,statement));
+    ASSERT_EQ(3u, pDatabaseBackdoor.statementCalls(&pDatabaseHandler,command));
+}
+#endif
+
 //Commented out - gives always a warning..
 //TEST_F(databaseTest,registerDomainFailonID0)
 //{
@@ -35,6 +35,7 @@
 #include "CAmControlSender.h"
 #include "../IAmControlBackdoor.h"
 #include "../IAmCommandBackdoor.h"
+#include "../IAmDatabaseBackdoor.h"
 #include "../CAmCommonFunctions.h"
 #include "../MockIAmControlSend.h"
 #include "../MockIAmCommandSend.h"
@@ -43,6 +44,15 @@
 namespace am
 {
 
+class CAmStopListeningCb
+{
+public:
+    CAmStopListeningCb(CAmSocketHandler *SocketHandler);
+    void timerCallback(sh_timerHandle_t handle, void * userData);
+    TAmShTimerCallBack<CAmStopListeningCb> pTimerCallback;
+    CAmSocketHandler *mSocketHandler;
+};
+
 class CAmDatabaseHandlerTest: public ::testing::Test
 {
 public:
@@ -57,6 +67,7 @@ public:
     MockIAmCommandSend pMockInterface;
     IAmRoutingBackdoor pRoutingInterfaceBackdoor;
     IAmCommandBackdoor pCommandInterfaceBackdoor;
+    IAmDatabaseBackdoor pDatabaseBackdoor;
     CAmControlSender pControlSender;
     CAmRouter pRouter;
     CAmControlReceiver pControlReceiver;
@@ -20,11 +20,15 @@
 
 #include "CAmRouterTest.h"
 #include <string.h>
+#include <time.h>
+#include "config.h"
 #include "shared/CAmDltWrapper.h"
 
 using namespace am;
 using namespace testing;
 
+extern std::string int2string(int i);
+
 CAmRouterTest::CAmRouterTest() :
         plistRoutingPluginDirs(), //
         plistCommandPluginDirs(), //
@@ -1805,6 +1809,368 @@ TEST_F(CAmRouterTest,simpleRoute4Domains)
     ASSERT_TRUE(pCF.compareRoute(compareRoute,listRoutes[0]));
 }
 
+//test that the cached routes follow changes of the connections and gateways
+TEST_F(CAmRouterTest,cachedRouteInvalidation)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    //initialize 2 domains
+    am_Domain_s domain1, domain2;
+    am_domainID_t domainID1, domainID2;
+
+    domain1.domainID = 0;
+    domain1.name = "domain1";
+    domain1.busname = "domain1bus";
+    domain1.state = DS_CONTROLLED;
+    domain2.domainID = 0;
+    domain2.name = "domain2";
+    domain2.busname = "domain2bus";
+    domain2.state = DS_CONTROLLED;
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterDomainDB(domain1,domainID1));
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterDomainDB(domain2,domainID2));
+
+    am_Source_s source, gwSource;
+    am_sourceID_t sourceID, gwSourceID;
+
+    source.domainID = domainID1;
+    source.name = "source1";
+    source.sourceState = SS_ON;
+    source.sourceID = 0;
+    source.sourceClassID = 5;
+    source.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+
+    gwSource.domainID = domainID2;
+    gwSource.name = "gwsource1";
+    gwSource.sourceState = SS_ON;
+    gwSource.sourceID = 0;
+    gwSource.sourceClassID = 5;
+    gwSource.listConnectionFormats.push_back(CF_GENIVI_MONO);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(source,sourceID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(gwSource,gwSourceID));
+
+    am_Sink_s sink, gwSink;
+    am_sinkID_t sinkID, gwSinkID;
+
+    sink.domainID = domainID2;
+    sink.name = "sink1";
+    sink.sinkID = 0;
+    sink.sinkClassID = 5;
+    sink.muteState = MS_MUTED;
+    sink.listConnectionFormats.push_back(CF_GENIVI_MONO);
+
+    gwSink.domainID = domainID1;
+    gwSink.name = "gwSink";
+    gwSink.sinkID = 0;
+    gwSink.sinkClassID = 5;
+    gwSink.muteState = MS_MUTED;
+    gwSink.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(gwSink,gwSinkID));
+
+    std::vector<am_Route_s> listRoutes;
+
+    //no gateway yet, so there is no route
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(0, listRoutes.size());
+
+    am_Gateway_s gateway;
+    am_gatewayID_t gatewayID;
+
+    gateway.controlDomainID = domainID1;
+    gateway.gatewayID = 0;
+    gateway.sinkID = gwSinkID;
+    gateway.sourceID = gwSourceID;
+    gateway.domainSourceID = domainID2;
+    gateway.domainSinkID = domainID1;
+    gateway.listSinkFormats = gwSink.listConnectionFormats;
+    gateway.listSourceFormats = gwSource.listConnectionFormats;
+    gateway.convertionMatrix.push_back(true);
+    gateway.name = "gateway";
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterGatewayDB(gateway,gatewayID));
+
+    std::vector<am_RoutingElement_s> listRoutingElements;
+    am_RoutingElement_s hopp1;
+    am_RoutingElement_s hopp2;
+
+    hopp1.sinkID = gwSinkID;
+    hopp1.sourceID = sourceID;
+    hopp1.domainID = domainID1;
+    hopp1.connectionFormat = source.listConnectionFormats[0];
+
+    hopp2.sinkID = sinkID;
+    hopp2.sourceID = gwSourceID;
+    hopp2.domainID = domainID2;
+    hopp2.connectionFormat = sink.listConnectionFormats[0];
+
+    listRoutingElements.push_back(hopp1);
+    listRoutingElements.push_back(hopp2);
+
+    am_Route_s compareRoute;
+    compareRoute.route = listRoutingElements;
+    compareRoute.sinkID = sinkID;
+    compareRoute.sourceID = sourceID;
+
+    //the new gateway is found and repeated requests are answered from the cache
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(E_OK, pRouter.getRoute(true,sourceID,sinkID,listRoutes));
+        ASSERT_EQ(1, listRoutes.size());
+        ASSERT_TRUE(pCF.compareRoute(compareRoute,listRoutes[0]));
+    }
+
+    //a connection on the gateway makes it busy
+    am_Connection_s connection;
+    am_connectionID_t connectionID;
+    connection.sourceID = sourceID;
+    connection.sinkID = gwSinkID;
+    connection.connectionFormat = CF_GENIVI_ANALOG;
+    connection.connectionID = 0;
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterConnectionDB(connection,connectionID));
+    ASSERT_EQ(E_OK, pRouter.getRoute(true,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(0, listRoutes.size());
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(1, listRoutes.size());
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeConnection(connectionID));
+    ASSERT_EQ(E_OK, pRouter.getRoute(true,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(1, listRoutes.size());
+    ASSERT_TRUE(pCF.compareRoute(compareRoute,listRoutes[0]));
+
+    //without the gateway the route is gone again
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeGatewayDB(gatewayID));
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(0, listRoutes.size());
+}
+
+//test that the routes are returned cheapest first and that busy gateways cost BUSY_GATEWAY_COST more
+TEST_F(CAmRouterTest,routeGatewayCost)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    //initialize 2 domains
+    am_Domain_s domain1, domain2;
+    am_domainID_t domainID1, domainID2;
+
+    domain1.domainID = 0;
+    domain1.name = "domain1";
+    domain1.busname = "domain1bus";
+    domain1.state = DS_CONTROLLED;
+    domain2.domainID = 0;
+    domain2.name = "domain2";
+    domain2.busname = "domain2bus";
+    domain2.state = DS_CONTROLLED;
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterDomainDB(domain1,domainID1));
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterDomainDB(domain2,domainID2));
+
+    am_Source_s source;
+    am_sourceID_t sourceID;
+
+    source.domainID = domainID1;
+    source.name = "source1";
+    source.sourceState = SS_ON;
+    source.sourceID = 0;
+    source.sourceClassID = 5;
+    source.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(source,sourceID));
+
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+
+    sink.domainID = domainID2;
+    sink.name = "sink1";
+    sink.sinkID = 0;
+    sink.sinkClassID = 5;
+    sink.muteState = MS_MUTED;
+    sink.listConnectionFormats.push_back(CF_GENIVI_MONO);
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+
+    //three parallel gateways, the last one cannot convert into a format the sink takes
+    am_gatewayID_t listGatewayIDs[3];
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        am_Source_s gwSource;
+        am_sourceID_t gwSourceID;
+        gwSource.domainID = domainID2;
+        gwSource.name = "gwsource" + int2string(i);
+        gwSource.sourceState = SS_ON;
+        gwSource.sourceID = 0;
+        gwSource.sourceClassID = 5;
+        gwSource.listConnectionFormats.push_back(i < 2 ? CF_GENIVI_MONO : CF_GENIVI_STEREO);
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(gwSource,gwSourceID));
+
+        am_Sink_s gwSink;
+        am_sinkID_t gwSinkID;
+        gwSink.domainID = domainID1;
+        gwSink.name = "gwSink" + int2string(i);
+        gwSink.sinkID = 0;
+        gwSink.sinkClassID = 5;
+        gwSink.muteState = MS_MUTED;
+        gwSink.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(gwSink,gwSinkID));
+
+        am_Gateway_s gateway;
+        gateway.controlDomainID = domainID1;
+        gateway.gatewayID = 0;
+        gateway.sinkID = gwSinkID;
+        gateway.sourceID = gwSourceID;
+        gateway.domainSourceID = domainID2;
+        gateway.domainSinkID = domainID1;
+        gateway.listSinkFormats = gwSink.listConnectionFormats;
+        gateway.listSourceFormats = gwSource.listConnectionFormats;
+        gateway.convertionMatrix.push_back(true);
+        gateway.name = "gateway" + int2string(i);
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterGatewayDB(gateway,listGatewayIDs[i]));
+    }
+
+    std::vector<am_Route_s> listRoutes;
+    am_Gateway_s gatewayData;
+
+    //equal costs keep the order of registration
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(2, listRoutes.size());
+    ASSERT_EQ(E_OK, pDatabaseHandler.getGatewayInfoDB(listGatewayIDs[0],gatewayData));
+    ASSERT_EQ(gatewayData.sinkID, listRoutes[0].route[0].sinkID);
+    ASSERT_EQ(E_OK, pDatabaseHandler.getGatewayInfoDB(listGatewayIDs[1],gatewayData));
+    ASSERT_EQ(gatewayData.sinkID, listRoutes[1].route[0].sinkID);
+
+    //a connection on the first gateway makes it more expensive than the other one
+    ASSERT_EQ(E_OK, pDatabaseHandler.getGatewayInfoDB(listGatewayIDs[0],gatewayData));
+    am_Connection_s connection;
+    am_connectionID_t connectionID;
+    connection.sourceID = sourceID;
+    connection.sinkID = gatewayData.sinkID;
+    connection.connectionFormat = CF_GENIVI_ANALOG;
+    connection.connectionID = 0;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterConnectionDB(connection,connectionID));
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(2, listRoutes.size());
+#if BUSY_GATEWAY_COST
+    ASSERT_EQ(gatewayData.sinkID, listRoutes[1].route[0].sinkID);
+#else
+    ASSERT_EQ(gatewayData.sinkID, listRoutes[0].route[0].sinkID);
+#endif
+
+    //only free gateways
+    ASSERT_EQ(E_OK, pRouter.getRoute(true,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(1, listRoutes.size());
+    ASSERT_NE(gatewayData.sinkID, listRoutes[0].route[0].sinkID);
+
+    //once the connection is gone, the gateway is cheap again
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeConnection(connectionID));
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    ASSERT_EQ(2, listRoutes.size());
+    ASSERT_EQ(gatewayData.sinkID, listRoutes[0].route[0].sinkID);
+}
+
+//scaling benchmark: a chain of domains with parallel gateways has exponentially many routes
+TEST_F(CAmRouterTest,routeScaling)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    const uint16_t numberDomains = 16;
+    const uint16_t numberParallelGateways = 4;
+    std::vector<am_domainID_t> listDomainIDs;
+
+    for (uint16_t i = 0; i < numberDomains; i++)
+    {
+        am_Domain_s domain;
+        am_domainID_t domainID;
+        domain.domainID = 0;
+        domain.name = "domain" + int2string(i);
+        domain.busname = "domainbus";
+        domain.state = DS_CONTROLLED;
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterDomainDB(domain,domainID));
+        listDomainIDs.push_back(domainID);
+    }
+
+    for (uint16_t i = 0; i + 1 < numberDomains; i++)
+    {
+        for (uint16_t j = 0; j < numberParallelGateways; j++)
+        {
+            am_Source_s gwSource;
+            am_sourceID_t gwSourceID;
+            gwSource.domainID = listDomainIDs[i + 1];
+            gwSource.name = "gwsource" + int2string(i) + "_" + int2string(j);
+            gwSource.sourceState = SS_ON;
+            gwSource.sourceID = 0;
+            gwSource.sourceClassID = 5;
+            gwSource.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+            ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(gwSource,gwSourceID));
+
+            am_Sink_s gwSink;
+            am_sinkID_t gwSinkID;
+            gwSink.domainID = listDomainIDs[i];
+            gwSink.name = "gwSink" + int2string(i) + "_" + int2string(j);
+            gwSink.sinkID = 0;
+            gwSink.sinkClassID = 5;
+            gwSink.muteState = MS_MUTED;
+            gwSink.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+            ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(gwSink,gwSinkID));
+
+            am_Gateway_s gateway;
+            am_gatewayID_t gatewayID;
+            gateway.controlDomainID = listDomainIDs[i];
+            gateway.gatewayID = 0;
+            gateway.sinkID = gwSinkID;
+            gateway.sourceID = gwSourceID;
+            gateway.domainSourceID = listDomainIDs[i + 1];
+            gateway.domainSinkID = listDomainIDs[i];
+            gateway.listSinkFormats = gwSink.listConnectionFormats;
+            gateway.listSourceFormats = gwSource.listConnectionFormats;
+            gateway.convertionMatrix.push_back(true);
+            gateway.name = "gateway" + int2string(i) + "_" + int2string(j);
+            ASSERT_EQ(E_OK, pDatabaseHandler.enterGatewayDB(gateway,gatewayID));
+        }
+    }
+
+    am_Source_s source;
+    am_sourceID_t sourceID;
+    source.domainID = listDomainIDs.front();
+    source.name = "source";
+    source.sourceState = SS_ON;
+    source.sourceID = 0;
+    source.sourceClassID = 5;
+    source.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceDB(source,sourceID));
+
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    sink.domainID = listDomainIDs.back();
+    sink.name = "sink";
+    sink.sinkID = 0;
+    sink.sinkClassID = 5;
+    sink.muteState = MS_MUTED;
+    sink.listConnectionFormats.push_back(CF_GENIVI_ANALOG);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+
+    std::vector<am_Route_s> listRoutes;
+    timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ASSERT_EQ(E_OK, pRouter.getRoute(false,sourceID,sinkID,listRoutes));
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    uint64_t search = (end.tv_sec - start.tv_sec) * 1000000ULL + (end.tv_nsec - start.tv_nsec) / 1000;
+    logInfo("RouterTest::routeScaling search took [us]:", search);
+    ASSERT_LT(search, 1000000u);
+
+    ASSERT_EQ(MAX_ROUTES, listRoutes.size());
+    std::vector<am_Route_s>::iterator routeIterator = listRoutes.begin();
+    for (; routeIterator != listRoutes.end(); ++routeIterator)
+    {
+        ASSERT_EQ(numberDomains, routeIterator->route.size());
+        ASSERT_EQ(sourceID, routeIterator->route.front().sourceID);
+        ASSERT_EQ(sinkID, routeIterator->route.back().sinkID);
+    }
+}
+
 int main(int argc, char **argv)
 {
     CAmDltWrapper::instance()->registerApp("routing", "CAmRouterTest");
@@ -95,6 +95,93 @@ void am::CAmTimerCb::timer4Callback(sh_timerHandle_t, void* userData)
     mSocketHandler->stop_listening();
 }
 
+CAmTimerSequenceCb::CAmTimerSequenceCb(CAmSocketHandler *myHandler) :
+        pTimerCallback(this, &CAmTimerSequenceCb::timerCallback), //
+        pLastTimerCallback(this, &CAmTimerSequenceCb::lastTimerCallback), //
+        mSocketHandler(myHandler), //
+        mListFired()
+{
+}
+
+void am::CAmTimerSequenceCb::timerCallback(sh_timerHandle_t handle, void* userData)
+{
+    (void) handle;
+    mListFired.push_back((long) userData);
+}
+
+void am::CAmTimerSequenceCb::lastTimerCallback(sh_timerHandle_t handle, void* userData)
+{
+    (void) handle;
+    (void) userData;
+    mSocketHandler->stop_listening();
+}
+
+CAmPollFiredCb::CAmPollFiredCb(CAmSocketHandler *myHandler) :
+        pFiredCallback(this, &CAmPollFiredCb::firedCallback), //
+        mSocketHandler(myHandler), //
+        mMapFired()
+{
+}
+
+void am::CAmPollFiredCb::firedCallback(const pollfd pollfd, const sh_pollHandle_t handle, void* userData)
+{
+    (void) userData;
+    if (pollfd.revents & POLLIN)
+        mMapFired[handle]++;
+    //one shot, the pipe stays readable
+    mSocketHandler->removeFDPoll(handle);
+}
+
+CAmSerializerReceiver::CAmSerializerReceiver(CAmSocketHandler *myHandler, int numberProducers) :
+        mSocketHandler(myHandler), //
+        mListReceived(numberProducers, 0), //
+        mNumberFinished(0), //
+        mErrors(0)
+{
+}
+
+void am::CAmSerializerReceiver::count(int producer, int value)
+{
+    //the calls of one producer arrive in the order they were sent
+    if (mListReceived[producer] != value)
+        mErrors++;
+    mListReceived[producer] = value + 1;
+}
+
+int am::CAmSerializerReceiver::received(int producer)
+{
+    return (mListReceived[producer]);
+}
+
+void am::CAmSerializerReceiver::finished()
+{
+    if (++mNumberFinished == (int) mListReceived.size())
+        mSocketHandler->stop_listening();
+}
+
+struct serializerProducer_s
+{
+    CAmSerializer* serializer;
+    CAmSerializerReceiver* receiver;
+    int producer;
+    int numberCalls;
+    int received;
+};
+
+void* serializerProducer(void* data)
+{
+    serializerProducer_s* producerData = (serializerProducer_s*) data;
+    for (int i = 0; i < producerData->numberCalls; i++)
+    {
+        producerData->serializer->asyncCall<CAmSerializerReceiver, int, int>(producerData->receiver, &CAmSerializerReceiver::count, producerData->producer, i);
+    }
+    //all producers wait for a synchronous call at the same time, each one must get its own result
+    int producer(producerData->producer);
+    producerData->serializer->syncCall<CAmSerializerReceiver, int, int, int>(producerData->receiver, &CAmSerializerReceiver::received, producerData->received, producer);
+    producerData->serializer->asyncCall<CAmSerializerReceiver>(producerData->receiver, &CAmSerializerReceiver::finished);
+    return (NULL);
+}
+
 void* playWithSocketServer(void* data)
 {
     (void) data;
@@ -137,6 +224,166 @@ TEST(CAmSocketHandlerTest,playWithTimers)
 
 }
 
+TEST(CAmSocketHandlerTest,timerSequence)
+{
+    CAmSocketHandler myHandler;
+    CAmTimerSequenceCb testCallback(&myHandler);
+    const long numberTimers = 500;
+    std::vector<sh_timerHandle_t> listHandles;
+    timespec timeout;
+    sh_timerHandle_t handle;
+
+    //the timers are added out of order, timer i is up after (i*37%500+1) * 100us
+    for (long i = 0; i < numberTimers; i++)
+    {
+        long slot = (i * 37) % numberTimers;
+        timeout.tv_sec = 0;
+        timeout.tv_nsec = (slot + 1) * 100000;
+        ASSERT_EQ(E_OK, myHandler.addTimer(timeout, &testCallback.pTimerCallback, handle, (void*) slot));
+        listHandles.push_back(handle);
+    }
+
+    //every fifth timer is stopped, every seventh one is removed
+    long numberStopped = 0;
+    for (long i = 0; i < numberTimers; i++)
+    {
+        if (i % 5 == 0)
+        {
+            ASSERT_EQ(E_OK, myHandler.stopTimer(listHandles[i]));
+            ASSERT_EQ(E_NON_EXISTENT, myHandler.stopTimer(listHandles[i]));
+            numberStopped++;
+        }
+        else if (i % 7 == 0)
+        {
+            ASSERT_EQ(E_OK, myHandler.removeTimer(listHandles[i]));
+            ASSERT_EQ(E_UNKNOWN, myHandler.removeTimer(listHandles[i]));
+            ASSERT_EQ(E_NON_EXISTENT, myHandler.restartTimer(listHandles[i]));
+            numberStopped++;
+        }
+    }
+
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 100000000;
+    myHandler.addTimer(timeout, &testCallback.pLastTimerCallback, handle, NULL);
+    myHandler.start_listenting();
+
+    //all running timers fired once, in the order of their timeouts
+    ASSERT_EQ((size_t) (numberTimers - numberStopped), testCallback.mListFired.size());
+    for (size_t i = 1; i < testCallback.mListFired.size(); i++)
+    {
+        ASSERT_LT(testCallback.mListFired[i - 1], testCallback.mListFired[i]);
+    }
+}
+
+TEST(CAmSocketHandlerTest,pollSameFiledescriptor)
+{
+    CAmSocketHandler myHandler;
+    CAmPollFiredCb testCallback(&myHandler);
+    CAmTimerSequenceCb timerCallback(&myHandler);
+    int pipeFd[2];
+    ASSERT_EQ(0, pipe(pipeFd));
+
+    //three polls on the same filedescriptor, the one that only waits for POLLOUT never fires
+    sh_pollHandle_t handle1, handle2, handle3, handleOut;
+    ASSERT_EQ(E_OK, myHandler.addFDPoll(pipeFd[0], POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handle1));
+    ASSERT_EQ(E_OK, myHandler.addFDPoll(pipeFd[0], POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handle2));
+    ASSERT_EQ(E_OK, myHandler.addFDPoll(pipeFd[0], POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handle3));
+    ASSERT_EQ(E_OK, myHandler.addFDPoll(pipeFd[0], 0, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handleOut));
+    ASSERT_EQ(E_OK, myHandler.updateEventFlags(handleOut, POLLOUT));
+    ASSERT_EQ(E_OK, myHandler.removeFDPoll(handle2));
+    ASSERT_EQ(E_UNKNOWN, myHandler.removeFDPoll(handle2));
+    ASSERT_EQ(E_UNKNOWN, myHandler.updateEventFlags(handle2, POLLIN));
+    ASSERT_EQ(E_NON_EXISTENT, myHandler.addFDPoll(-1, POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handle2));
+
+    int p(1);
+    ASSERT_EQ((ssize_t) sizeof(p), write(pipeFd[1], &p, sizeof(p)));
+
+    timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 50000000;
+    sh_timerHandle_t timerHandle;
+    myHandler.addTimer(timeout, &timerCallback.pLastTimerCallback, timerHandle, NULL);
+    myHandler.start_listenting();
+
+    ASSERT_EQ(2u, testCallback.mMapFired.size());
+    ASSERT_EQ(1, testCallback.mMapFired[handle1]);
+    ASSERT_EQ(1, testCallback.mMapFired[handle3]);
+    ASSERT_EQ(E_UNKNOWN, myHandler.removeFDPoll(handle1));
+    ASSERT_EQ(E_OK, myHandler.removeFDPoll(handleOut));
+    close(pipeFd[0]);
+    close(pipeFd[1]);
+}
+
+TEST(CAmSocketHandlerTest,pollRejectedAndReusedFiledescriptor)
+{
+    CAmSocketHandler myHandler;
+    CAmPollFiredCb testCallback(&myHandler);
+    CAmTimerSequenceCb timerCallback(&myHandler);
+    sh_pollHandle_t handle, handleStale, handleNew;
+
+    //epoll does not accept regular files
+    FILE* file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+    ASSERT_EQ(E_NOT_POSSIBLE, myHandler.addFDPoll(fileno(file), POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handle));
+    fclose(file);
+
+    //the pipe is closed while it is polled, the next pipe gets the same filedescriptor
+    int pipeFd[2];
+    ASSERT_EQ(0, pipe(pipeFd));
+    int staleFd(pipeFd[0]);
+    ASSERT_EQ(E_OK, myHandler.addFDPoll(pipeFd[0], POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handleStale));
+    close(pipeFd[0]);
+    close(pipeFd[1]);
+    ASSERT_EQ(0, pipe(pipeFd));
+    ASSERT_EQ(staleFd, pipeFd[0]);
+    ASSERT_EQ(E_OK, myHandler.addFDPoll(pipeFd[0], POLLIN, NULL, &testCallback.pFiredCallback, NULL, NULL, NULL, handleNew));
+
+    int p(1);
+    ASSERT_EQ((ssize_t) sizeof(p), write(pipeFd[1], &p, sizeof(p)));
+
+    timespec timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 50000000;
+    sh_timerHandle_t timerHandle;
+    myHandler.addTimer(timeout, &timerCallback.pLastTimerCallback, timerHandle, NULL);
+    myHandler.start_listenting();
+
+    ASSERT_EQ(1, testCallback.mMapFired[handleNew]);
+    close(pipeFd[0]);
+    close(pipeFd[1]);
+}
+
+TEST(CAmSocketHandlerTest,serializerProducers)
+{
+    CAmSocketHandler myHandler;
+    CAmSerializer serializer(&myHandler);
+    const int numberProducers = 4;
+    const int numberCalls = 20000;
+    CAmSerializerReceiver receiver(&myHandler, numberProducers);
+    pthread_t listThreads[numberProducers];
+    serializerProducer_s listProducers[numberProducers];
+
+    for (int i = 0; i < numberProducers; i++)
+    {
+        serializerProducer_s producer = { &serializer, &receiver, i, numberCalls, -1 };
+        listProducers[i] = producer;
+        pthread_create(&listThreads[i], NULL, serializerProducer, &listProducers[i]);
+    }
+    myHandler.start_listenting();
+    for (int i = 0; i < numberProducers; i++)
+    {
+        pthread_join(listThreads[i], NULL);
+    }
+
+    //the synchronous calls return after all asynchronous calls of their producer were dispatched
+    ASSERT_EQ(0, receiver.mErrors);
+    for (int i = 0; i < numberProducers; i++)
+    {
+        ASSERT_EQ(numberCalls, listProducers[i].received);
+        ASSERT_EQ(numberCalls, receiver.mListReceived[i]);
+    }
+}
+
 
 TEST(CAmSocketHandlerTest,playWithUNIXSockets)
 {
@@ -23,7 +23,10 @@
 
 #include "gtest/gtest.h"
 #include <queue>
+#include <vector>
+#include <map>
 #include "shared/CAmSocketHandler.h"
+#include "shared/CAmSerializer.h"
 
 namespace am
 {
@@ -70,6 +73,41 @@ public:
     CAmSocketHandler *mSocketHandler;
 };
 
+class CAmTimerSequenceCb
+{
+public:
+    CAmTimerSequenceCb(CAmSocketHandler *SocketHandler);
+    void timerCallback(sh_timerHandle_t handle, void * userData);
+    void lastTimerCallback(sh_timerHandle_t handle, void * userData);
+    TAmShTimerCallBack<CAmTimerSequenceCb> pTimerCallback;
+    TAmShTimerCallBack<CAmTimerSequenceCb> pLastTimerCallback;
+    CAmSocketHandler *mSocketHandler;
+    std::vector<long> mListFired;
+};
+
+class CAmPollFiredCb
+{
+public:
+    CAmPollFiredCb(CAmSocketHandler *SocketHandler);
+    void firedCallback(const pollfd pollfd, const sh_pollHandle_t handle, void* userData);
+    TAmShPollFired<CAmPollFiredCb> pFiredCallback;
+    CAmSocketHandler *mSocketHandler;
+    std::map<sh_pollHandle_t, int> mMapFired;
+};
+
+class CAmSerializerReceiver
+{
+public:
+    CAmSerializerReceiver(CAmSocketHandler *SocketHandler, int numberProducers);
+    void count(int producer, int value);
+    int received(int producer);
+    void finished();
+    CAmSocketHandler *mSocketHandler;
+    std::vector<int> mListReceived;
+    int mNumberFinished;
+    int mErrors;
+};
+
 class CAmSocketHandlerTest: public ::testing::Test
 {
 public:
@@ -22,6 +22,7 @@
 #include "IAmCommandBackdoor.h"
 #include "IAmRoutingBackdoor.h"
 #include "IAmControlBackdoor.h"
+#include "IAmDatabaseBackdoor.h"
 #include <cassert>
 #include <sstream>
 
@@ -95,6 +96,45 @@ bool IAmControlBackdoor::replaceController(CAmControlSender *controlSender, IAmC
     return true;
 }
 
+IAmDatabaseBackdoor::IAmDatabaseBackdoor()
+{
+}
+
+IAmDatabaseBackdoor::~IAmDatabaseBackdoor()
+{
+}
+
+#ifndef WITH_DATABASE_MAP
+bool IAmDatabaseBackdoor::statementCached(CAmDatabaseHandler *databaseHandler, const std::string& command)
+{
+    CAmDatabaseHandler::MapStatement::const_iterator iter = databaseHandler->mMapStatement.find(command);
+    return (iter != databaseHandler->mMapStatement.end() && iter->second.statement != NULL);
+}
+
+uint32_t IAmDatabaseBackdoor::statementCalls(CAmDatabaseHandler *databaseHandler, const std::string& command)
+{
+    CAmDatabaseHandler::MapStatement::const_iterator iter = databaseHandler->mMapStatement.find(command);
+    if (iter == databaseHandler->mMapStatement.end())
+        return 0;
+    return iter->second.calls;
+}
+
+int IAmDatabaseBackdoor::prepareStatement(CAmDatabaseHandler *databaseHandler, const std::string& command, sqlite3_stmt** statement)
+{
+    return databaseHandler->prepareStatement(command, statement);
+}
+
+int IAmDatabaseBackdoor::finalizeStatement(CAmDatabaseHandler *databaseHandler, sqlite3_stmt* statement)
+{
+    return databaseHandler->finalizeStatement(statement);
+}
+
+void IAmDatabaseBackdoor::invalidateStatements(CAmDatabaseHandler *databaseHandler, const std::string& table)
+{
+    databaseHandler->invalidateStatements(table);
+}
+#endif
+
 //int GetRandomNumber(int nLow, int nHigh) {
 //	return (rand() % (nHigh - nLow + 1)) + nLow;
 //}
@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2026, AudioManager contributors
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author AudioManager contributors 2026
+ *
+ * \file IAmDatabaseBackdoor.h
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#ifndef DATABASEBACKDOOR_H_
+#define DATABASEBACKDOOR_H_
+
+#include "CAmDatabaseHandler.h"
+
+namespace am
+{
+
+class CAmDatabaseHandler;
+
+class IAmDatabaseBackdoor
+{
+public:
+    IAmDatabaseBackdoor();
+    virtual ~IAmDatabaseBackdoor();
+#ifndef WITH_DATABASE_MAP
+    bool statementCached(CAmDatabaseHandler *databaseHandler, const std::string& command);
+    uint32_t statementCalls(CAmDatabaseHandler *databaseHandler, const std::string& command);
+    int prepareStatement(CAmDatabaseHandler *databaseHandler, const std::string& command, sqlite3_stmt** statement);
+    int finalizeStatement(CAmDatabaseHandler *databaseHandler, sqlite3_stmt* statement);
+    void invalidateStatements(CAmDatabaseHandler *databaseHandler, const std::string& table);
+#endif
+};
+
+}
+
+//definitions are in CAmCommonFunctions.cpp!
+
+#endif /* DATABASEBACKDOOR_H_ */
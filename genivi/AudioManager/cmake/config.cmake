@@ -6,8 +6,10 @@
 #cmakedefine WITH_DBUS_WRAPPER
 #cmakedefine WITH_DLT
 #cmakedefine WITH_TELNET
+#cmakedefine WITH_DATABASE_MAP
 #cmakedefine GLIB_DBUS_TYPES_TOLERANT
 #cmakedefine WITH_SYSTEMD_WATCHDOG
+#cmakedefine WITH_TIMERFD
 #cmakedefine SYSTEMD_FOUND
 
 #cmakedefine DEFAULT_PLUGIN_COMMAND_DIR "@DEFAULT_PLUGIN_COMMAND_DIR@"
@@ -16,6 +18,10 @@
 
 #cmakedefine DEFAULT_TELNETPORT @DEFAULT_TELNETPORT@
 #cmakedefine MAX_TELNETCONNECTIONS @MAX_TELNETCONNECTIONS@
+#cmakedefine MAX_ROUTES @MAX_ROUTES@
+#define BUSY_GATEWAY_COST @BUSY_GATEWAY_COST@
+#define NOTIFICATION_FRAME @NOTIFICATION_FRAME@
+#define REGISTRATION_BATCH_TIMEOUT @REGISTRATION_BATCH_TIMEOUT@
 
 #cmakedefine DBUS_SERVICE_PREFIX "@DBUS_SERVICE_PREFIX@"
 #cmakedefine DBUS_SERVICE_OBJECT_PATH "@DBUS_SERVICE_OBJECT_PATH@"
@@ -20,21 +20,27 @@
 #define CAMSERIALIZER_H_
 
 #include <pthread.h>
-#include <deque>
 #include <cassert>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <unistd.h>
+#include <errno.h>
+#include <sys/eventfd.h>
 #include "CAmDltWrapper.h"
 #include "CAmSocketHandler.h"
 
-/**
- * todo: performance improvement we could implement a memory pool that is more efficient here and avoids
- * allocation and deallocation times.
- */
-
 namespace am
 {
+
+#ifndef SERIALIZER_DELEGATE_SIZE
+#define SERIALIZER_DELEGATE_SIZE 96 //!< delegates up to this size are stored in the queue nodes, bigger ones are allocated
+#endif
+
+#ifndef SERIALIZER_POOL_SIZE
+#define SERIALIZER_POOL_SIZE 64 //!< number of preallocated queue nodes per serializer, more nodes are allocated when they are used up
+#endif
+
 /**
  * magic class that does the serialization of functions calls
  * The constructor must be called within the main threadcontext, after that using the
@@ -59,8 +65,21 @@ private:
     public:
         virtual ~CAmDelegate()
         {};
-        virtual bool call(int* pipe)=0;
+        virtual bool call(const int returnFd)=0;
 
+    protected:
+        /**
+         * wakes up the thread that waits for the result of a synchronous call
+         * @param returnFd the eventfd the caller waits on
+         */
+        static void ringReturn(const int returnFd)
+        {
+            uint64_t ring(1);
+            if (write(returnFd, &ring, sizeof(ring)) == -1)
+            {
+                logError("CAmSerializer::ringReturn could not write eventfd!");
+            }
+        }
     };
 
     typedef CAmDelegate* CAmDelegagePtr; //!< pointer to a delegate
@@ -80,9 +99,9 @@ private:
                 mFunction(function)
         {};
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)();
             return (true);
         };
@@ -105,9 +124,9 @@ private:
                 mArgument(argument)
         {};
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument);
             return (true);
         };
@@ -132,9 +151,9 @@ private:
                 mArgument1(argument1)
         { };
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument, mArgument1);
             return (true);
         };
@@ -159,9 +178,9 @@ private:
                 mArgument1(argument1)
         { };
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument, mArgument1);
             return (true);
         };
@@ -184,9 +203,9 @@ private:
                 mArgument1(argument1)
         {};
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument, mArgument1);
             return (true);
         };
@@ -211,9 +230,9 @@ private:
                 mArgument1(argument1)
         { };
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument, mArgument1);
             return (true);
         };
@@ -243,9 +262,9 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
             return (true);
         }
@@ -273,9 +292,9 @@ private:
                  mArgument2(argument2)
          {};
 
-         bool call(int* pipe)
+         bool call(const int returnFd)
          {
-             (void) pipe;
+             (void) returnFd;
              (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
              return (true);
          };
@@ -302,9 +321,9 @@ private:
                   mArgument2(argument2)
           {};
 
-          bool call(int* pipe)
+          bool call(const int returnFd)
           {
-              (void) pipe;
+              (void) returnFd;
               (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
               return (true);
           };
@@ -331,9 +350,9 @@ private:
                    mArgument2(argument2)
            {};
 
-           bool call(int* pipe)
+           bool call(const int returnFd)
            {
-               (void) pipe;
+               (void) returnFd;
                (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
                return (true);
            };
@@ -360,9 +379,9 @@ private:
                     mArgument2(argument2)
             {};
 
-            bool call(int* pipe)
+            bool call(const int returnFd)
             {
-                (void) pipe;
+                (void) returnFd;
                 (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
                 return (true);
             };
@@ -389,9 +408,9 @@ private:
                      mArgument2(argument2)
              {};
 
-             bool call(int* pipe)
+             bool call(const int returnFd)
              {
-                 (void) pipe;
+                 (void) returnFd;
                  (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
                  return (true);
              };
@@ -418,9 +437,9 @@ private:
                       mArgument2(argument2)
               {};
 
-              bool call(int* pipe)
+              bool call(const int returnFd)
               {
-                  (void) pipe;
+                  (void) returnFd;
                   (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
                   return (true);
               };
@@ -447,9 +466,9 @@ private:
                        mArgument2(argument2)
                {};
 
-               bool call(int* pipe)
+               bool call(const int returnFd)
                {
-                   (void) pipe;
+                   (void) returnFd;
                    (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
                    return (true);
                };
@@ -480,9 +499,9 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
-            (void) pipe;
+            (void) returnFd;
             (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2, mArgument3);
             return (true);
         }
@@ -509,10 +528,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)();
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -545,10 +564,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -582,10 +601,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -621,10 +640,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument, mArgument1);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -661,10 +680,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument, mArgument1);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -702,10 +721,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -745,10 +764,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2, mArgument3);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -792,10 +811,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2, mArgument3, mArgument4);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -841,10 +860,10 @@ private:
         }
         ;
 
-        bool call(int* pipe)
+        bool call(const int returnFd)
         {
             mRetval = (*mInstance.*mFunction)(mArgument, mArgument1, mArgument2, mArgument3, mArgument4, mArgument5);
-            write(pipe[1], this, sizeof(this));
+            ringReturn(returnFd);
             return (false);
         }
         ;
@@ -861,21 +880,212 @@ private:
         }
     };
 
+    enum sh_ownership_e //!< tells who destroys the delegate of a node
+    {
+        SH_DELEGATE_INPLACE, //!< the delegate was constructed in the storage of the node
+        SH_DELEGATE_ALLOCATED, //!< the delegate was allocated because it did not fit into the node
+        SH_DELEGATE_CALLER //!< the delegate belongs to the caller of a synchronous call
+    };
+
+    struct sh_node_s //!< node of the call queue
+    {
+        sh_node_s* volatile next; //!< the next node in the queue
+        volatile uint32_t nextFree; //!< index of the next free pool node, only used while the node is free
+        uint32_t index; //!< index of the node in mPool counted from 1, 0 if the node was allocated
+        CAmDelegagePtr delegate; //!< the delegate to be called
+        sh_ownership_e ownership; //!< who destroys the delegate
+        int returnFd; //!< eventfd the caller of a synchronous call waits on, -1 for asynchronous calls
+        union
+        {
+            char buffer[SERIALIZER_DELEGATE_SIZE];
+            long double alignLongDouble;
+            uint64_t alignInteger;
+            void* alignPointer;
+        } storage; //!< storage for delegates up to SERIALIZER_DELEGATE_SIZE
+    };
+
+    /**
+     * takes a node from the pool. The head of the free list carries a tag in the upper 32 bits that is
+     * incremented with every change, so a thread that was preempted during the compare and swap cannot
+     * take a node twice.
+     * @return the node, allocated if the pool is used up
+     */
+    sh_node_s* allocateNode()
+    {
+        uint64_t head, newHead;
+        do
+        {
+            head = mFreeHead;
+            uint32_t index = static_cast<uint32_t>(head);
+            if (index == 0)
+                return (new sh_node_s());
+            newHead = (((head >> 32) + 1) << 32) | mPool[index - 1].nextFree;
+        } while (!__sync_bool_compare_and_swap(&mFreeHead, head, newHead));
+        return (&mPool[static_cast<uint32_t>(head) - 1]);
+    }
+
+    /**
+     * gives a node back to the pool, called in the mainloop only
+     * @param node the node
+     */
+    void releaseNode(sh_node_s* node)
+    {
+        if (node->index == 0)
+        {
+            delete node;
+            return;
+        }
+        uint64_t head, newHead;
+        do
+        {
+            head = mFreeHead;
+            node->nextFree = static_cast<uint32_t>(head);
+            newHead = (((head >> 32) + 1) << 32) | node->index;
+        } while (!__sync_bool_compare_and_swap(&mFreeHead, head, newHead));
+    }
+
     /**
-     * rings the line of the pipe and adds the delegate pointer to the queue
-     * @param p delegate pointer
+     * appends a node to the queue, can be called from any thread
+     * @param node the node
      */
-    inline void send(CAmDelegagePtr p)
+    void push(sh_node_s* node)
     {
-        if (write(mPipe[1], &p, sizeof(p)) == -1)
+        node->next = NULL;
+        __sync_synchronize();
+        sh_node_s* previous = __sync_lock_test_and_set(&mQueueBack, node);
+        previous->next = node;
+    }
+
+    /**
+     * takes the next node from the queue, called in the mainloop only
+     * @return the node, NULL if the queue is empty or the next call is just being appended
+     */
+    sh_node_s* pop()
+    {
+        sh_node_s* front = mQueueFront;
+        sh_node_s* next = front->next;
+        if (front == &mStub)
+        {
+            if (next == NULL)
+                return (NULL);
+            mQueueFront = next;
+            front = next;
+            next = next->next;
+        }
+        if (next == NULL)
         {
-            throw std::runtime_error("could not write to pipe !");
+            if (front != mQueueBack)
+                return (NULL);
+            //front is the last node, the stub takes its place so that it can be taken
+            push(&mStub);
+            next = front->next;
+            if (next == NULL)
+                return (NULL);
         }
+        mQueueFront = next;
+        __sync_synchronize();
+        return (front);
     }
 
-    int mPipe[2]; //!< the pipe
-    int mReturnPipe[2]; //!< pipe handling returns
-    std::deque<CAmDelegagePtr> mListDelegatePoiters; //!< intermediate queue to store the pipe results
+    /**
+     * appends a node to the queue and wakes up the mainloop if the queue was empty.
+     * The mainloop dispatches all calls per wakeup, so the calls that follow need no wakeup.
+     * @param node the node
+     */
+    void enqueue(sh_node_s* node)
+    {
+        bool wakeup = (__sync_fetch_and_add(&mPending, 1) == 0);
+        push(node);
+        if (wakeup)
+            ring();
+    }
+
+    /**
+     * rings the eventfd of the mainloop
+     */
+    void ring()
+    {
+        uint64_t ring(1);
+        if (write(mEventFd, &ring, sizeof(ring)) == -1)
+        {
+            throw std::runtime_error("could not write to eventfd !");
+        }
+    }
+
+    /**
+     * adds a copy of the delegate to the queue
+     * @param delegate the delegate
+     */
+    template<class TDelegate> void send(const TDelegate& delegate)
+    {
+        sh_node_s* node = allocateNode();
+        if (sizeof(TDelegate) <= sizeof(node->storage))
+        {
+            node->delegate = new (node->storage.buffer) TDelegate(delegate);
+            node->ownership = SH_DELEGATE_INPLACE;
+        }
+        else
+        {
+            node->delegate = new TDelegate(delegate);
+            node->ownership = SH_DELEGATE_ALLOCATED;
+        }
+        node->returnFd = -1;
+        enqueue(node);
+    }
+
+    /**
+     * adds the delegate of a synchronous call to the queue and waits until it was called.
+     * Every call waits on its own eventfd, so with several threads calling at the same time each one
+     * only wakes up when its own delegate was called.
+     * @param delegate the delegate, it stays owned by the caller
+     */
+    void sendSync(CAmDelegagePtr delegate)
+    {
+        int returnFd;
+        if ((returnFd = eventfd(0, EFD_CLOEXEC)) == -1)
+        {
+            logError("CAmSerializer::sendSync could not create eventfd!");
+            throw std::runtime_error("CAmSerializer Could not open eventfd!");
+        }
+
+        sh_node_s* node = allocateNode();
+        node->delegate = delegate;
+        node->ownership = SH_DELEGATE_CALLER;
+        node->returnFd = returnFd;
+        enqueue(node);
+
+        uint64_t ring;
+        ssize_t numReads = read(returnFd, &ring, sizeof(ring));
+        close(returnFd);
+        if (numReads == -1)
+        {
+            logError("CAmSerializer::sendSync could not read eventfd!");
+            throw std::runtime_error("CAmSerializer Could not read eventfd!");
+        }
+    }
+
+    /**
+     * destroys the delegate of a node and gives the node back to the pool
+     * @param node the node
+     */
+    void destroyNode(sh_node_s* node)
+    {
+        if (node->ownership == SH_DELEGATE_INPLACE)
+            node->delegate->~CAmDelegate();
+        else if (node->ownership == SH_DELEGATE_ALLOCATED)
+            delete node->delegate;
+        releaseNode(node);
+    }
+
+    CAmSocketHandler* mpSocketHandler; //!< the sockethandler the eventfd is polled with
+    sh_pollHandle_t mHandle; //!< the poll handle of the eventfd
+    int mEventFd; //!< eventfd that wakes up the mainloop
+    volatile int32_t mPending; //!< number of calls that were sent and not yet dispatched
+    sh_node_s* volatile mQueueBack; //!< the last node of the queue, calls are appended here by all threads
+    sh_node_s* mQueueFront; //!< the first node of the queue, only used by the mainloop
+    sh_node_s mStub; //!< empty node that keeps the queue linked when all calls are taken
+    volatile uint64_t mFreeHead; //!< tag and index of the first free node of mPool
+    sh_node_s mPool[SERIALIZER_POOL_SIZE]; //!< the preallocated queue nodes
 
 public:
 
@@ -899,8 +1109,7 @@ public:
     template<class TClass>
     void asyncCall(TClass* instance, void (TClass::*function)())
     {
-        CAmDelegagePtr p(new CAmNoArgDelegate<TClass>(instance, function));
-        send(p);
+        send(CAmNoArgDelegate<TClass>(instance, function));
     }
 
     /**
@@ -926,8 +1135,7 @@ public:
     template<class TClass1, class Targ>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ), Targ argument)
     {
-        CAmDelegagePtr p(new CAmOneArgDelegate<TClass1, Targ>(instance, function, argument));
-        send(p);
+        send(CAmOneArgDelegate<TClass1, Targ>(instance, function, argument));
     }
 
     /**
@@ -953,8 +1161,7 @@ public:
     template<class TClass1, class Targ>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ&), Targ& argument)
     {
-        CAmDelegagePtr p(new CAmOneArgDelegate<TClass1, Targ&>(instance, function, argument));
-        send(p);
+        send(CAmOneArgDelegate<TClass1, Targ&>(instance, function, argument));
     }
 
     /**
@@ -970,9 +1177,7 @@ public:
     template<class TClass1, class Targ, class Targ1>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1 argument1), Targ argument, Targ1 argument1)
     {
-        logInfo("took without ref");
-        CAmDelegagePtr p(new CAmTwoArgDelegate<TClass1, Targ, Targ1>(instance, function, argument, argument1));
-        send(p);
+        send(CAmTwoArgDelegate<TClass1, Targ, Targ1>(instance, function, argument, argument1));
     }
 
     /**
@@ -988,8 +1193,7 @@ public:
     template<class TClass1, class Targ, class Targ1>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ& argument, Targ1 argument1), Targ& argument, Targ1 argument1)
     {
-        CAmDelegagePtr p(new CAmTwoArgDelegateFirstRef<TClass1, Targ, Targ1>(instance, function, argument, argument1));
-        send(p);
+        send(CAmTwoArgDelegateFirstRef<TClass1, Targ, Targ1>(instance, function, argument, argument1));
     }
 
     /**
@@ -1005,9 +1209,7 @@ public:
     template<class TClass1, class Targ, class Targ1>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1& argument1), Targ argument, Targ1& argument1)
     {
-        logInfo("took ref");
-        CAmDelegagePtr p(new CAmTwoArgDelegateSecondRef<TClass1, Targ, Targ1>(instance, function, argument, argument1));
-        send(p);
+        send(CAmTwoArgDelegateSecondRef<TClass1, Targ, Targ1>(instance, function, argument, argument1));
     }
 
     /**
@@ -1023,8 +1225,7 @@ public:
     template<class TClass1, class Targ, class Targ1>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ& argument, Targ1& argument1), Targ& argument, Targ1& argument1)
     {
-        CAmDelegagePtr p(new CAmTwoArgDelegateAllRef<TClass1, Targ, Targ1>(instance, function, argument, argument1));
-        send(p);
+        send(CAmTwoArgDelegateAllRef<TClass1, Targ, Targ1>(instance, function, argument, argument1));
     }
 
     /**
@@ -1033,8 +1234,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1 argument1, Targ2 argument2), Targ argument, Targ1 argument1, Targ2 argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegate<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegate<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1043,8 +1243,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ& argument, Targ1 argument1, Targ2 argument2), Targ& argument, Targ1 argument1, Targ2 argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateFirstRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateFirstRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
 
@@ -1054,8 +1253,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1& argument1, Targ2 argument2), Targ argument, Targ1& argument1, Targ2 argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateSecondRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateSecondRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1064,8 +1262,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1 argument1, Targ2& argument2), Targ argument, Targ1 argument1, Targ2& argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateThirdRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateThirdRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1074,8 +1271,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1& argument1, Targ2& argument2), Targ argument, Targ1& argument1, Targ2& argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateSecondThirdRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateSecondThirdRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1084,8 +1280,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ& argument, Targ1& argument1, Targ2& argument2), Targ& argument, Targ1& argument1, Targ2& argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateAllRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateAllRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1094,8 +1289,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ& argument, Targ1& argument1, Targ2 argument2), Targ& argument, Targ1& argument1, Targ2 argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateFirstSecondRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateFirstSecondRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1104,8 +1298,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ& argument, Targ1 argument1, Targ2& argument2), Targ& argument, Targ1 argument1, Targ2& argument2)
     {
-        CAmDelegagePtr p(new CAmThreeArgDelegateFirstThirdRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(p);
+        send(CAmThreeArgDelegateFirstThirdRef<TClass1, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
     }
 
     /**
@@ -1114,8 +1307,7 @@ public:
     template<class TClass1, class Targ, class Targ1, class Targ2, class Targ3>
     void asyncCall(TClass1* instance, void (TClass1::*function)(Targ argument, Targ1 argument1, Targ2 argument2, Targ3 argument3), Targ argument, Targ1 argument1, Targ2 argument2, Targ3 argument3)
     {
-        CAmDelegagePtr p(new CAmFourArgDelegate<TClass1, Targ, Targ1, Targ2, Targ3>(instance, function, argument, argument1, argument2, argument3));
-        send(p);
+        send(CAmFourArgDelegate<TClass1, Targ, Targ1, Targ2, Targ3>(instance, function, argument, argument1, argument2, argument3));
     }
 
     /**
@@ -1143,18 +1335,10 @@ public:
     template<class TClass1, class TretVal>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(), TretVal& retVal)
     {
-        CAmSyncNoArgDelegate<TClass1, TretVal>* p(new CAmSyncNoArgDelegate<TClass1, TretVal>(instance, function));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncNoArgDelegate<TClass1, TretVal> delegate(instance, function);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it works...
-        retVal = p->returnResults();
-        delete p;
+        retVal = delegate.returnResults();
     }
 
     /**
@@ -1186,18 +1370,10 @@ public:
     template<class TClass1, class TretVal, class TargCall, class Targ>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall), TretVal& retVal, Targ& argument)
     {
-        CAmSyncOneArgDelegate<TClass1, TretVal, TargCall, Targ>* p(new CAmSyncOneArgDelegate<TClass1, TretVal, TargCall, Targ>(instance, function, argument));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncOneArgDelegate<TClass1, TretVal, TargCall, Targ> delegate(instance, function, argument);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it works...
-        retVal = p->returnResults(argument);
-        delete p;
+        retVal = delegate.returnResults(argument);
     }
 
     /**
@@ -1206,18 +1382,10 @@ public:
     template<class TClass1, class TretVal, class TargCall, class Targ>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall) const, TretVal& retVal, Targ& argument)
     {
-        CAmSyncOneArgConstDelegate<TClass1, TretVal, TargCall, Targ>* p(new CAmSyncOneArgConstDelegate<TClass1, TretVal, TargCall, Targ>(instance, function, argument));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncOneArgConstDelegate<TClass1, TretVal, TargCall, Targ> delegate(instance, function, argument);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it works...
-        retVal = p->returnResults(argument);
-        delete p;
+        retVal = delegate.returnResults(argument);
     }
 
     /**
@@ -1226,17 +1394,9 @@ public:
     template<class TClass1, class TretVal, class TargCall, class Targ1Call, class Targ, class Targ1>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall, Targ1Call), TretVal& retVal, Targ& argument, Targ1& argument1)
     {
-        CAmSyncTwoArgDelegate<TClass1, TretVal, TargCall, Targ1Call, Targ, Targ1>* p(new CAmSyncTwoArgDelegate<TClass1, TretVal, TargCall, Targ1Call, Targ, Targ1>(instance, function, argument, argument1));
-        send(dynamic_cast<CAmDelegagePtr>(p));
-
-        CAmDelegagePtr ptr;
-        if (read(mReturnPipe[0], &ptr, sizeof(ptr)) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
-        retVal = p->returnResults(argument, argument1);
-        delete p;
+        CAmSyncTwoArgDelegate<TClass1, TretVal, TargCall, Targ1Call, Targ, Targ1> delegate(instance, function, argument, argument1);
+        sendSync(&delegate);
+        retVal = delegate.returnResults(argument, argument1);
     }
     /**
      * calls a function with two arguments synchronously threadsafe const. For more see syncCall with one argument
@@ -1244,17 +1404,9 @@ public:
     template<class TClass1, class TretVal, class TargCall, class Targ1Call, class Targ, class Targ1>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall, Targ1Call) const, TretVal& retVal, Targ& argument, Targ1& argument1)
     {
-        CAmSyncTwoArgConstDelegate<TClass1, TretVal, TargCall, Targ1Call, Targ, Targ1>* p(new CAmSyncTwoArgConstDelegate<TClass1, TretVal, TargCall, Targ1Call, Targ, Targ1>(instance, function, argument, argument1));
-        send(dynamic_cast<CAmDelegagePtr>(p));
-
-        CAmDelegagePtr ptr;
-        if (read(mReturnPipe[0], &ptr, sizeof(ptr)) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
-        retVal = p->returnResults(argument, argument1);
-        delete p;
+        CAmSyncTwoArgConstDelegate<TClass1, TretVal, TargCall, Targ1Call, Targ, Targ1> delegate(instance, function, argument, argument1);
+        sendSync(&delegate);
+        retVal = delegate.returnResults(argument, argument1);
     }
 
     /**
@@ -1263,18 +1415,10 @@ public:
     template<class TClass1, class TretVal, class TargCall, class TargCall1, class TargCall2, class Targ, class Targ1, class Targ2>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall, TargCall1, TargCall2), TretVal& retVal, Targ& argument, Targ1& argument1, Targ2& argument2)
     {
-        CAmSyncThreeArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, Targ, Targ1, Targ2>* p(new CAmSyncThreeArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, Targ, Targ1, Targ2>(instance, function, argument, argument1, argument2));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncThreeArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, Targ, Targ1, Targ2> delegate(instance, function, argument, argument1, argument2);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it worCAmTwoArgDelegateks...
-        retVal = p->returnResults(argument, argument1, argument2);
-        delete p;
+        retVal = delegate.returnResults(argument, argument1, argument2);
     }
 
     /**
@@ -1283,18 +1427,10 @@ public:
     template<class TClass1, class TretVal, class TargCall, class TargCall1, class TargCall2, class TargCall3, class Targ, class Targ1, class Targ2, class Targ3>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall, TargCall1, TargCall2, TargCall3), TretVal& retVal, Targ& argument, Targ1& argument1, Targ2& argument2, Targ3& argument3)
     {
-        CAmSyncFourArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, Targ, Targ1, Targ2, Targ3>* p(new CAmSyncFourArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, Targ, Targ1, Targ2, Targ3>(instance, function, argument, argument1, argument2, argument3));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncFourArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, Targ, Targ1, Targ2, Targ3> delegate(instance, function, argument, argument1, argument2, argument3);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it works...
-        retVal = p->returnResults(argument, argument1, argument2, argument3);
-        delete p;
+        retVal = delegate.returnResults(argument, argument1, argument2, argument3);
     }
 
     /**
@@ -1303,18 +1439,10 @@ public:
     template<class TClass1, class TretVal, class TargCall, class TargCall1, class TargCall2, class TargCall3, class TargCall4, class Targ, class Targ1, class Targ2, class Targ3, class Targ4>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall, TargCall1, TargCall2, TargCall3, TargCall4), TretVal& retVal, Targ& argument, Targ1& argument1, Targ2& argument2, Targ3& argument3, Targ4& argument4)
     {
-        CAmSyncFiveArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, TargCall4, Targ, Targ1, Targ2, Targ3, Targ4>* p(new CAmSyncFiveArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, TargCall4, Targ, Targ1, Targ2, Targ3, Targ4>(instance, function, argument, argument1, argument2, argument3, argument4));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncFiveArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, TargCall4, Targ, Targ1, Targ2, Targ3, Targ4> delegate(instance, function, argument, argument1, argument2, argument3, argument4);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it works...
-        retVal = p->returnResults(argument, argument1, argument2, argument3, argument4);
-        delete p;
+        retVal = delegate.returnResults(argument, argument1, argument2, argument3, argument4);
     }
 
     /**
@@ -1323,18 +1451,10 @@ public:
     template<class TClass1, class TretVal, class TargCall, class TargCall1, class TargCall2, class TargCall3, class TargCall4, class TargCall5, class Targ, class Targ1, class Targ2, class Targ3, class Targ4, class Targ5>
     void syncCall(TClass1* instance, TretVal (TClass1::*function)(TargCall, TargCall1, TargCall2, TargCall3, TargCall4, TargCall5), TretVal& retVal, Targ& argument, Targ1& argument1, Targ2& argument2, Targ3& argument3, Targ4& argument4, Targ5& argument5)
     {
-        CAmSyncSixArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, TargCall4, TargCall5, Targ, Targ1, Targ2, Targ3, Targ4, Targ5>* p(new CAmSyncSixArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, TargCall4, TargCall5, Targ, Targ1, Targ2, Targ3, Targ4, Targ5>(instance, function, argument, argument1, argument2, argument3, argument4, argument5));
-        send(static_cast<CAmDelegagePtr>(p));
-        int numReads;
-        CAmDelegagePtr ptr;
-        if ((numReads = read(mReturnPipe[0], &ptr, sizeof(ptr))) == -1)
-        {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
-        }
+        CAmSyncSixArgDelegate<TClass1, TretVal, TargCall, TargCall1, TargCall2, TargCall3, TargCall4, TargCall5, Targ, Targ1, Targ2, Targ3, Targ4, Targ5> delegate(instance, function, argument, argument1, argument2, argument3, argument4, argument5);
+        sendSync(&delegate);
         //working with friend class here is not the finest of all programming stiles but it works...
-        retVal = p->returnResults(argument, argument1, argument2, argument3, argument4, argument5);
-        delete p;
+        retVal = delegate.returnResults(argument, argument1, argument2, argument3, argument4, argument5);
     }
 
     /**
@@ -1344,14 +1464,13 @@ public:
     {
         (void) handle;
         (void) userData;
-        int numReads;
-        CAmDelegagePtr listPointers[3];
-        if ((numReads = read(pollfd.fd, &listPointers, sizeof(listPointers))) == -1)
+        //the eventfd is only reset here, the calls are taken from the queue by the dispatcher
+        uint64_t ring;
+        if (read(pollfd.fd, &ring, sizeof(ring)) == -1 && errno != EAGAIN)
         {
-            logError("CAmSerializer::receiverCallback could not read pipe!");
-            throw std::runtime_error("CAmSerializer Could not read pipe!");
+            logError("CAmSerializer::receiverCallback could not read eventfd!");
+            throw std::runtime_error("CAmSerializer Could not read eventfd!");
         }
-        mListDelegatePoiters.assign(listPointers, listPointers + (numReads / sizeof(CAmDelegagePtr)));
     }
 
     /**
@@ -1361,25 +1480,32 @@ public:
     {
         (void) handle;
         (void) userData;
-        if (mListDelegatePoiters.empty())
-            return (false);
-        return (true);
+        return (mPending > 0);
     }
 
     /**
      * dispatcher callback for sockethandling, for more, see CAmSocketHandler
+     * Dispatches all calls that are in the queue. Calls that are sent while dispatching are left for the next loop.
      */
     bool dispatcherCallback(const sh_pollHandle_t handle, void* userData)
     {
         (void) handle;
         (void) userData;
-        CAmDelegagePtr delegatePoiter = mListDelegatePoiters.front();
-        mListDelegatePoiters.pop_front();
-        if (delegatePoiter->call(mReturnPipe))
-            delete delegatePoiter;
-        if (mListDelegatePoiters.empty())
-            return (false);
-        return (true);
+        sh_node_s* node;
+        for (int32_t numberCalls = mPending; numberCalls > 0 && (node = pop()) != NULL; numberCalls--)
+        {
+            //the delegate of a synchronous call may be gone as soon as it was called
+            if (node->delegate->call(node->returnFd))
+                destroyNode(node);
+            else
+                releaseNode(node);
+            __sync_fetch_and_sub(&mPending, 1);
+        }
+
+        //the calls sent meanwhile did not ring because the queue was not empty
+        if (mPending > 0)
+            ring();
+        return (false);
     }
 
     TAmShPollFired<CAmSerializer> receiverCallbackT;
@@ -1391,32 +1517,45 @@ public:
      * @param iSocketHandler pointer to the CAmSocketHandler
      */
     CAmSerializer(CAmSocketHandler *iSocketHandler) :
-            mPipe(), //
-            mListDelegatePoiters(), //
+            mpSocketHandler(iSocketHandler), //
+            mHandle(0), //
+            mEventFd(-1), //
+            mPending(0), //
+            mQueueBack(&mStub), //
+            mQueueFront(&mStub), //
+            mStub(), //
+            mFreeHead(0), //
             receiverCallbackT(this, &CAmSerializer::receiverCallback), //
             dispatcherCallbackT(this, &CAmSerializer::dispatcherCallback), //
             checkerCallbackT(this, &CAmSerializer::checkerCallback)
     {
-        if (pipe(mPipe) == -1)
+        if ((mEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1)
         {
-            logError("CAmSerializer could not create pipe!");
-            throw std::runtime_error("CAmSerializer Could not open pipe!");
+            logError("CAmSerializer could not create eventfd!");
+            throw std::runtime_error("CAmSerializer Could not open eventfd!");
         }
 
-        if (pipe(mReturnPipe) == -1)
+        //chain all nodes of the pool into the free list
+        for (uint32_t i = 0; i < SERIALIZER_POOL_SIZE; i++)
         {
-            logError("CAmSerializer could not create mReturnPipe!");
-            throw std::runtime_error("CAmSerializer Could not open mReturnPipe!");
+            mPool[i].index = i + 1;
+            mPool[i].nextFree = (i + 1 < SERIALIZER_POOL_SIZE) ? i + 2 : 0;
         }
+        mFreeHead = 1;
 
-        short event = 0;
-        sh_pollHandle_t handle;
-        event |= POLLIN;
-        iSocketHandler->addFDPoll(mPipe[0], event, NULL, &receiverCallbackT, &checkerCallbackT, &dispatcherCallbackT, NULL, handle);
+        mpSocketHandler->addFDPoll(mEventFd, POLLIN, NULL, &receiverCallbackT, &checkerCallbackT, &dispatcherCallbackT, NULL, mHandle);
     }
 
     ~CAmSerializer()
     {
+        mpSocketHandler->removeFDPoll(mHandle);
+
+        //calls that were not dispatched anymore are dropped
+        sh_node_s* node;
+        while ((node = pop()) != NULL)
+            destroyNode(node);
+
+        close(mEventFd);
     }
 };
 } /* namespace am */
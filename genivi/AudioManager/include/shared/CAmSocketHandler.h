@@ -23,8 +23,11 @@
 #include <sys/socket.h>
 #include <stdint.h>
 #include <sys/poll.h>
+#include <sys/epoll.h>
 #include <list>
 #include <map>
+#include <vector>
+#include <deque>
 #include <signal.h>
 
 #include <iostream> //todo: remove me
@@ -173,53 +176,57 @@ public:
             return (false);
         };
 
+    void timerFdCallback(const pollfd pollfd, const sh_pollHandle_t handle, void* userData);
+
     TAmShPollFired<CAmSocketHandler> receiverCallbackT;
     TAmShPollCheck<CAmSocketHandler> checkerCallbackT;
+    TAmShPollFired<CAmSocketHandler> timerFdCallbackT;
 
 private:
 
     static CAmSocketHandler* mInstance;
     int mPipe[2];
+    int mEpollFd; //!<the epoll instance all filedescriptors are registered with
 
     struct sh_timer_s //!<struct that holds information of timers
     {
         sh_timerHandle_t handle; //!<the handle of the timer
-        timespec countdown; //!<the countdown, this value is decreased every time the timer is up
+        timespec timeout; //!<the interval of the timer, used when the timer is (re)started
+        timespec deadline; //!<the CLOCK_MONOTONIC time the timer is up. Relative to the start of the mainloop as long as the mainloop is not running
         IAmShTimerCallBack* callback; //!<the callbackfunction
         void * userData; //!<saves a void pointer together with the rest.
+        size_t heapIndex; //!<position of the timer in mTimerHeap, SH_TIMER_INACTIVE if the timer is not running
     };
 
-    typedef std::reverse_iterator<sh_timer_s> rListTimerIter; //!<typedef for reverseiterator on timer lists
+    typedef std::map<sh_timerHandle_t, sh_timer_s> mMapTimer_t; //!<all timers, by handle
+    typedef std::vector<sh_timer_s*> mTimerHeap_t; //!<binary min-heap of the running timers, ordered by deadline
 
     struct sh_poll_s //!<struct that holds information about polls
     {
-        sh_pollHandle_t handle; //!<handle to uniquely adress a filedesriptor
+        sh_pollHandle_t handle; //!<handle to uniquely adress a filedesriptor, 0 if the slot is free
         IAmShPollPrepare *prepareCB; //!<pointer to preperation callback
         IAmShPollFired *firedCB; //!<pointer to fired callback
         IAmShPollCheck *checkCB; //!< pointer to check callback
         IAmShPollDispatch *dispatchCB; //!<pointer to dispatch callback
-        pollfd pollfdValue; //!<the array for polling the filedescriptors
+        pollfd pollfdValue; //!<the filedescriptor and its events
         void *userData; //!<userdata saved together with the callback.
+        sh_pollHandle_t nextHandle; //!<the next poll on the same filedescriptor, 0 if there is none
     };
 
-    typedef std::vector<pollfd> mListPollfd_t; //!<vector of filedescriptors
-    typedef std::vector<sh_poll_s> mListPoll_t; //!<list for the callbacks
+    typedef std::vector<sh_poll_s> mListPoll_t; //!<slot table of the polls, indexed by handle
+    typedef std::map<int, sh_pollHandle_t> mMapFdHandle_t; //!<first poll of each filedescriptor
+    typedef std::vector<epoll_event> mListEpollEvent_t; //!<buffer for the ready events of epoll
 
     bool fdIsValid(const int fd) const;
+    bool epollUpdate(const int fd, const int operation);
     void timerUp();
-    void timerCorrection();
-    timespec* insertTime(timespec& buffertime);
-
-    /**
-     * compares countdown values
-     * @param a
-     * @param b
-     * @return true if b greater a
-     */
-    inline static bool compareCountdown(const sh_timer_s& a, const sh_timer_s& b)
-    {
-        return ((a.countdown.tv_sec == b.countdown.tv_sec) ? (a.countdown.tv_nsec < b.countdown.tv_nsec) : (a.countdown.tv_sec < b.countdown.tv_sec));
-    }
+    void timerStart(sh_timer_s& timer);
+    void timerRebase(const bool absolute);
+    int insertTime();
+    void heapInsert(sh_timer_s* timer);
+    void heapRemove(const size_t index);
+    void heapSiftUp(size_t index);
+    void heapSiftDown(size_t index);
 
     /**
      * Subtracts b from a
@@ -295,16 +302,6 @@ private:
             return (0);
     }
 
-    /**
-     * functor to return all fired events
-     * @param a
-     * @return
-     */
-    inline static bool eventFired(const pollfd& a)
-    {
-        return (a.revents == 0 ? false : true);
-    }
-
     /**
      * functor to help find the items that do not need dispatching
      * @param a
@@ -331,23 +328,6 @@ private:
         return (!a.dispatchCB->Call(a.handle, a.userData));
     }
 
-    class CAmShCopyPollfd //!< functor to copy filedescriptors into the poll array
-    {
-    private:
-        mListPollfd_t& mArray;
-    public:
-        CAmShCopyPollfd(mListPollfd_t& dest) :
-                mArray(dest)
-        {
-        }
-        void operator()(const sh_poll_s& row)
-        {
-            pollfd temp = row.pollfdValue;
-            temp.revents = 0;
-            mArray.push_back(temp);
-        }
-    };
-
     class CAmShCallFire //!< functor to call the firecallbacks
     {
     public:
@@ -361,99 +341,18 @@ private:
         }
     };
 
-    class CAmShCallPrep //!< functor to call the preparation callbacks
-    {
-    public:
-        CAmShCallPrep()
-        {
-        }
-        ;
-        void operator()(sh_poll_s& row)
-        {
-            if (row.prepareCB)
-                row.prepareCB->Call(row.handle, row.userData);
-        }
-    };
-
-    class CAmShCallTimer //!<functor to call a timer
-    {
-    public:
-        CAmShCallTimer()
-        {
-        }
-        ;
-        void operator()(sh_timer_s& row)
-        {
-            row.callback->Call(row.handle, row.userData);
-        }
-    };
-
-    class CAmShCountdownUp //!<functor that checks if a timer is up
-    {
-    private:
-        timespec mDiffTime;
-    public:
-        CAmShCountdownUp(const timespec& differenceTime) :
-                mDiffTime(differenceTime)
-        {
-        }
-        ;
-        bool operator()(const sh_timer_s& row)
-        {
-            timespec sub = timespecSub(row.countdown, mDiffTime);
-            if (sub.tv_nsec == 0 && sub.tv_sec == 0)
-                return (true);
-            return (false);
-        }
-    };
-
-    class CAmShCountdownZero //!<functor that checks if a timer is zero
-    {
-    public:
-        CAmShCountdownZero()
-        {
-        }
-        ;
-        bool operator()(const sh_timer_s& row)
-        {
-            if (row.countdown.tv_nsec == 0 && row.countdown.tv_sec == 0)
-                return (true);
-            return (false);
-        }
-    };
-
-    class CAmShSubstractTime //!<functor to easy substract from each countdown value
-    {
-    private:
-        timespec param;
-    public:
-        CAmShSubstractTime(timespec param) :
-                param(param)
-        {
-        }
-        inline void operator()(sh_timer_s& t)
-        {
-            t.countdown = timespecSub(t.countdown, param);
-        }
-    };
-
-    mListPollfd_t mfdPollingArray; //!<the polling array for ppoll
-    mListPoll_t mListPoll; //!<list that holds all information for the ppoll
-    std::list<sh_timer_s> mListTimer; //!<list of all timers
-    std::list<sh_timer_s> mListActiveTimer; //!<list of all currently active timers
+    mListPoll_t mListPoll; //!<slot table that holds all information for the polls
+    mMapFdHandle_t mMapFdHandle; //!<the first poll of each registered filedescriptor, its handle is the epoll data
+    std::deque<sh_pollHandle_t> mListFreePollHandles; //!<handles of free slots in mListPoll, reused in the order they were freed
+    std::vector<sh_pollHandle_t> mListPrepareHandles; //!<handles of the polls that have a preparation callback
+    mListPoll_t mListFiredPoll; //!<the polls that fired in the current iteration
+    mListEpollEvent_t mListEpollEvent; //!<the events returned by epoll
+    mMapTimer_t mMapTimer; //!<map of all timers
+    mTimerHeap_t mTimerHeap; //!<heap of all currently active timers, the next one to be up is on top
     sh_timerHandle_t mLastInsertedHandle; //!<keeps track of the last inserted timer handle
-    sh_pollHandle_t mLastInsertedPollHandle; //!<keeps track of the last inserted poll handle
-    bool mRecreatePollfds; //!<when this is true, the poll list needs to be recreated
-    timespec mStartTime; //!<here the actual time is saved for timecorrection
-
-//    void debugPrintTimerList ()
-//    {
-//        std::list<sh_timer_s>::iterator it(mListActiveTimer.begin());
-//        for(;it!=mListActiveTimer.end();++it)
-//        {
-//            std::cout<< "Handle " << it->handle << "sec " << it->countdown.tv_sec << "nsec " << it->countdown.tv_nsec<<std::endl;
-//        }
-//    }
+    bool mAbsoluteDeadlines; //!<true while the mainloop runs, the timer deadlines are absolute CLOCK_MONOTONIC times then
+    int mTimerFd; //!<the timerfd that wakes up the mainloop for the timers, -1 if the epoll timeout is used
+    timespec mTimerFdDeadline; //!<the deadline the timerfd is armed with
 }
 ;
 
@@ -84,6 +84,65 @@ typedef struct
     int serial_mode;       /**< serial_mode Serial mode enabled =1, disabled =0 */
 } DltClient;
 
+#if !defined (__WIN32__)
+
+/**
+ * View on one message within the receive buffer of a connection.
+ * Header and payload are not copied, the view is only valid during the message callback.
+ */
+typedef struct
+{
+    const uint8_t *data;                      /**< start of message at standard header, without serial header */
+    int32_t size;                             /**< size of complete message */
+    const DltStandardHeader *standardheader;  /**< pointer to standard header */
+    DltStandardHeaderExtra headerextra;       /**< extra parameters, converted to host byte order */
+    const DltExtendedHeader *extendedheader;  /**< pointer to extended header, 0 if not used */
+    const uint8_t *payload;                   /**< pointer to payload */
+    int32_t headersize;                       /**< size of complete header without storage header */
+    int32_t datasize;                         /**< size of payload */
+    int8_t found_serialheader;                /**< message was preceded by serial header */
+} DltMessageView;
+
+struct sDltClientConnection;
+
+/**
+ * Callback of one connection of a client loop.
+ * All complete messages received at once are delivered in one call.
+ * count is zero if the connection was closed; it is removed from the loop afterwards.
+ * @param client pointer to dlt client structure of the connection
+ * @param messages array of message views, only valid during the call
+ * @param count number of messages
+ * @param data user data given when the connection was added
+ * @return negative value to close the connection
+ */
+typedef int (*DltClientMessageCallback)(DltClient *client, const DltMessageView *messages, int count, void *data);
+
+/**
+ * One connection handled by a client loop.
+ */
+typedef struct sDltClientConnection
+{
+    DltClient *client;                   /**< connected dlt client */
+    DltClientMessageCallback callback;   /**< callback for received messages */
+    void *data;                          /**< user data passed to callback */
+    struct sDltClientConnection *next;   /**< next connection of the loop */
+} DltClientConnection;
+
+/**
+ * Event loop handling several dlt client connections with epoll.
+ */
+typedef struct
+{
+    int epfd;                          /**< epoll handle */
+    DltClientConnection *connections;  /**< list of connections */
+    int count;                         /**< number of connections */
+    DltMessageView *views;             /**< message views for batch delivery */
+    int batch_size;                    /**< maximum number of messages per callback */
+    int stop;                          /**< set to leave dlt_client_loop_run() */
+} DltClientLoop;
+
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -138,6 +197,61 @@ int dlt_client_send_inject_msg(DltClient *client, char *apid, char *ctid, uint32
  */
 int dlt_client_setbaudrate(DltClient *client, int baudrate);
 
+#if !defined (__WIN32__)
+
+/**
+ * Initialise client loop for several connections
+ * @param loop pointer to dlt client loop structure
+ * @param batch_size maximum number of messages delivered with one callback
+ * @param verbose if set to true verbose information is printed out.
+ * @return negative value if there was an error
+ */
+int dlt_client_loop_init(DltClientLoop *loop, int batch_size, int verbose);
+/**
+ * Add a connected dlt client to the client loop
+ * In serial mode each message must start with a serial header, data in front of it is skipped.
+ * @param loop pointer to dlt client loop structure
+ * @param client pointer to dlt client structure, already connected with dlt_client_connect()
+ * @param callback function called with received messages of this connection
+ * @param data user data passed to callback
+ * @return negative value if there was an error
+ */
+int dlt_client_loop_add(DltClientLoop *loop, DltClient *client, DltClientMessageCallback callback, void *data);
+/**
+ * Remove a dlt client from the client loop, the connection is not closed.
+ * Must not be called from a callback, return a negative value from the callback instead.
+ * @param loop pointer to dlt client loop structure
+ * @param client pointer to dlt client structure
+ * @return negative value if there was an error
+ */
+int dlt_client_loop_remove(DltClientLoop *loop, DltClient *client);
+/**
+ * Wait once for data on all connections and deliver received messages
+ * @param loop pointer to dlt client loop structure
+ * @param timeout maximum time to wait in milliseconds, -1 waits forever
+ * @return number of handled connections, negative value if there was an error
+ */
+int dlt_client_loop_dispatch(DltClientLoop *loop, int timeout);
+/**
+ * Run client loop until all connections are closed or dlt_client_loop_stop() is called
+ * @param loop pointer to dlt client loop structure
+ * @return negative value if there was an error
+ */
+int dlt_client_loop_run(DltClientLoop *loop);
+/**
+ * Leave dlt_client_loop_run(), can be called from a callback
+ * @param loop pointer to dlt client loop structure
+ */
+void dlt_client_loop_stop(DltClientLoop *loop);
+/**
+ * Cleanup client loop, the connections are not closed
+ * @param loop pointer to dlt client loop structure
+ * @return negative value if there was an error
+ */
+int dlt_client_loop_free(DltClientLoop *loop);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
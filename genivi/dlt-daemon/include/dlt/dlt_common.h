@@ -80,6 +80,7 @@
 
 #if !defined (__WIN32__) && !defined(_MSC_VER)
 #include <termios.h>
+#include <sys/uio.h>
 #endif
 
 #include "dlt_types.h"
@@ -484,6 +485,91 @@ typedef struct
     /*char [] payload;*/
 } PACKED DltServiceGetSoftwareVersionResponse;
 
+#define DLT_STATISTICS_HISTOGRAM_SIZE 16 /**< Number of histogram buckets, bucket n counts values smaller than 2^n */
+
+#define DLT_STATISTICS_OPTION_APPLICATIONS 1 /**< Get statistics: add one entry per application */
+#define DLT_STATISTICS_OPTION_CONTEXTS     2 /**< Get statistics: add one entry per application and per context */
+
+/**
+ * Message counters of the daemon statistics.
+ */
+typedef struct
+{
+    uint32_t received;              /**< number of messages received from applications */
+    uint32_t received_bytes;        /**< number of bytes received from applications */
+    uint32_t forwarded;             /**< number of messages sent to clients or offline trace */
+    uint32_t buffered;              /**< number of messages stored in client ring buffer */
+    uint32_t dropped;               /**< number of messages discarded by the daemon */
+} PACKED DltServiceStatisticsCounter;
+
+/**
+ * The structure of the DLT Service Get Statistics.
+ */
+typedef struct
+{
+    uint32_t service_id;            /**< service ID */
+    uint8_t options;                /**< type of request */
+    char apid[DLT_ID_SIZE];         /**< application id, empty for all applications */
+} PACKED DltServiceGetStatisticsRequest;
+
+typedef struct
+{
+    uint32_t service_id;            /**< service ID */
+    uint8_t status;                 /**< reponse status */
+    uint32_t fifo_used;             /**< bytes waiting in daemon fifo */
+    uint32_t fifo_size;             /**< size of daemon fifo */
+    uint32_t buffer_used;           /**< bytes stored in client ring buffer */
+    uint32_t buffer_size;           /**< maximum size of client ring buffer */
+    uint32_t buffer_messages;       /**< messages stored in client ring buffer */
+    uint32_t user_overflows;        /**< buffer overflows reported by applications */
+    DltServiceStatisticsCounter total; /**< counters of all messages */
+    uint32_t processing_time[DLT_STATISTICS_HISTOGRAM_SIZE]; /**< histogram of processing time per message in microseconds */
+    uint32_t latency[DLT_STATISTICS_HISTOGRAM_SIZE]; /**< histogram of message age at reception in 0.1 milliseconds */
+    uint16_t count_entries;         /**< number of following DltServiceStatisticsEntry */
+    /* DltServiceStatisticsEntry entries[]; */
+} PACKED DltServiceGetStatisticsResponse;
+
+typedef struct
+{
+    char apid[DLT_ID_SIZE];         /**< application id */
+    char ctid[DLT_ID_SIZE];         /**< context id, empty for entry of application */
+    DltServiceStatisticsCounter counter; /**< counters of application or context */
+} PACKED DltServiceStatisticsEntry;
+
+/**
+ * The structure of the DLT Service Get Log Info Paged.
+ * The registry is returned in pages sorted by application and context id.
+ * A client requests the first page with empty cursor and continues with the
+ * cursor of each response, as long as more is set. For an update it passes the
+ * revision of the first page of the previous listing; then only contexts changed
+ * since that revision are returned, unless contexts were removed meanwhile.
+ */
+typedef struct
+{
+    uint32_t service_id;            /**< service ID */
+    uint8_t options;                /**< type of request, same as get log info (3..7) */
+    char apid[DLT_ID_SIZE];         /**< application id, empty for all applications */
+    uint32_t revision;              /**< only contexts changed after this revision, 0 for all */
+    char cursor_apid[DLT_ID_SIZE];  /**< return contexts after this one, empty for first page */
+    char cursor_ctid[DLT_ID_SIZE];  /**< return contexts after this one, empty for first page */
+    uint16_t max_contexts;          /**< maximum number of contexts in response, 0 for no limit */
+} PACKED DltServiceGetLogInfoPagedRequest;
+
+typedef struct
+{
+    uint32_t service_id;            /**< service ID */
+    uint8_t status;                 /**< options of request, 8 if application not found, or error */
+    uint32_t revision;              /**< current revision of registry */
+    uint8_t complete;               /**< 1 if all contexts are listed, contexts not listed were removed */
+    uint8_t more;                   /**< 1 if further pages are available */
+    char cursor_apid[DLT_ID_SIZE];  /**< cursor for request of next page */
+    char cursor_ctid[DLT_ID_SIZE];  /**< cursor for request of next page */
+    uint16_t count_con_ids;         /**< number of following contexts */
+    /* per context: apid[4], ctid[4], log level (options 4,6,7), trace status (options 5,6,7),
+       uint16 length and description (option 7) */
+    /* option 7: uint16 count_app_ids, per application: apid[4], uint16 length and description */
+} PACKED DltServiceGetLogInfoPagedResponse;
+
 /**
  * Structure to store filter parameters.
  * ID are maximal four characters. Unused values are filled with zeros.
@@ -541,6 +627,15 @@ typedef struct
     int32_t buffersize;       /**< size of receiver buffer */
 } DltReceiver;
 
+/**
+ * Cache of a pre-encoded storage header.
+ * The pattern and the ECU id are encoded once, the time is read once for a batch of messages.
+ */
+typedef struct
+{
+    DltStorageHeader header;   /**< pre-encoded storage header with time of current batch */
+} DltStorageHeaderCache;
+
 typedef struct
 {
 	unsigned char* shm;	/* pointer to beginning of shared memory */
@@ -568,6 +663,41 @@ typedef struct
 	int size;	
 } DltBufferBlockHead;
 
+/**
+ * One chunk of a segmented buffer.
+ * Entries are stored contiguously and never span two chunks.
+ */
+typedef struct sDltBufferChunk
+{
+    struct sDltBufferChunk *next; /**< next chunk in buffer or pool */
+    uint32_t write;               /**< offset of first free byte */
+    uint32_t read;                /**< offset of first unread entry */
+    uint32_t count;               /**< number of entries written to chunk */
+    uint32_t first;               /**< index of first unread entry */
+    uint16_t *ends;               /**< end offset of each entry */
+    unsigned char *data;          /**< entry data */
+} DltBufferChunk;
+
+/**
+ * Segmented buffer made of fixed size chunks.
+ * The buffer grows and shrinks by linking chunks, which are taken from and
+ * returned to a pool, so stored data is never copied.
+ */
+typedef struct
+{
+    DltBufferChunk *head;  /**< oldest chunk, entries are read from here */
+    DltBufferChunk *tail;  /**< newest chunk, entries are written here */
+    DltBufferChunk *pool;  /**< unused chunks */
+    uint32_t chunk_size;   /**< size of data area of one chunk in bytes */
+    uint32_t chunk_entries;/**< maximum number of entries per chunk */
+    uint32_t min_chunks;   /**< number of chunks kept allocated */
+    uint32_t max_chunks;   /**< maximum number of chunks */
+    uint32_t chunks;       /**< number of allocated chunks, including pool */
+    uint32_t pool_count;   /**< number of chunks in pool */
+    uint32_t used;         /**< number of bytes stored */
+    uint32_t count;        /**< number of entries stored */
+} DltSegmentedBuffer;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -946,6 +1076,27 @@ extern "C"
      * @return negative value if there was an error
      */
     int dlt_set_storageheader(DltStorageHeader *storageheader, const char *ecu);
+    /**
+     * Initialise cache of pre-encoded storage header
+     * @param cache pointer to storage header cache
+     * @param ecu name of ecu to be set in storage header
+     * @return negative value if there was an error
+     */
+    int dlt_storageheader_cache_init(DltStorageHeaderCache *cache, const char *ecu);
+    /**
+     * Read current time once for the following batch of messages
+     * @param cache pointer to storage header cache
+     * @return negative value if there was an error
+     */
+    int dlt_storageheader_cache_update(DltStorageHeaderCache *cache);
+    /**
+     * Fill out storage header of a dlt message from cache, with time of current batch
+     * @param storageheader pointer to storage header of a dlt message
+     * @param cache pointer to storage header cache
+     * @param ecu name of ecu to be set in storage header
+     * @return negative value if there was an error
+     */
+    int dlt_set_storageheader_cached(DltStorageHeader *storageheader, DltStorageHeaderCache *cache, const char *ecu);
     /**
      * Check if a storage header contains its marker
      * @param storageheader pointer to storage header of a dlt message
@@ -1088,6 +1239,90 @@ extern "C"
      */
 	int dlt_buffer_get_message_count(DltBuffer *buf);
 
+    /**
+     * Initialise segmented buffer.
+     * Chunks of chunk_size are allocated on demand up to max_size.
+     * Chunks for min_size are allocated at start and kept when the buffer shrinks.
+     * @param buf Pointer to segmented buffer structure
+     * @param min_size Minimum size of buffer in bytes
+     * @param max_size Maximum size of buffer in bytes
+     * @param chunk_size Size of one chunk in bytes, this is the maximum size of one entry
+     * @return negative value if there was an error
+     */
+    int dlt_segmented_buffer_init(DltSegmentedBuffer *buf, uint32_t min_size, uint32_t max_size, uint32_t chunk_size);
+
+    /**
+     * Release and free all memory used by segmented buffer
+     * @param buf Pointer to segmented buffer structure
+     * @return negative value if there was an error
+     */
+    int dlt_segmented_buffer_free(DltSegmentedBuffer *buf);
+
+    /**
+     * Write up to three entries to segmented buffer.
+     * Entries are joined to one block.
+     * @param buf Pointer to segmented buffer structure
+     * @param data1 Pointer to data to be written to buffer
+     * @param size1 Size of data in bytes to be written to buffer
+     * @param data2 Pointer to data to be written to buffer
+     * @param size2 Size of data in bytes to be written to buffer
+     * @param data3 Pointer to data to be written to buffer
+     * @param size3 Size of data in bytes to be written to buffer
+     * @return negative value if there was an error
+     */
+    int dlt_segmented_buffer_push3(DltSegmentedBuffer *buf,const unsigned char *data1,unsigned int size1,const unsigned char *data2,unsigned int size2,const unsigned char *data3,unsigned int size3);
+
+    /**
+     * Read one entry from segmented buffer and remove it.
+     * @param buf Pointer to segmented buffer structure
+     * @param data Pointer to data read from buffer
+     * @param max_size Max size of read data in bytes
+     * @return size of read data, zero if no data available, negative value if there was an error
+     */
+    int dlt_segmented_buffer_pull(DltSegmentedBuffer *buf,unsigned char *data, int max_size);
+
+    /**
+     * Remove the oldest entries from segmented buffer.
+     * Chunks which become empty are returned to the pool.
+     * @param buf Pointer to segmented buffer structure
+     * @param count Number of entries to be removed
+     * @return number of removed entries
+     */
+    int dlt_segmented_buffer_remove(DltSegmentedBuffer *buf, int count);
+
+    /**
+     * Get used size in bytes of segmented buffer.
+     * @param buf Pointer to segmented buffer structure
+     * @return used size of buffer
+     */
+    int dlt_segmented_buffer_get_used_size(DltSegmentedBuffer *buf);
+
+    /**
+     * Get number of entries in segmented buffer.
+     * @param buf Pointer to segmented buffer structure
+     * @return number of entries
+     */
+    int dlt_segmented_buffer_get_message_count(DltSegmentedBuffer *buf);
+
+#if !defined (__WIN32__)
+
+    /**
+     * Describe the oldest entries of segmented buffer as io vector, e.g. for writev().
+     * Entries are not removed, call dlt_segmented_buffer_remove() after sending.
+     * If prefix is set, it is inserted before each entry.
+     * Without prefix, all entries of one chunk are described by one vector element.
+     * @param buf Pointer to segmented buffer structure
+     * @param iov Array of io vector elements to be filled
+     * @param max_iov Number of elements in iov
+     * @param prefix Data to be inserted before each entry, or 0
+     * @param prefix_size Size of prefix in bytes
+     * @param count Returns number of described entries
+     * @return number of used io vector elements
+     */
+    int dlt_segmented_buffer_iov(DltSegmentedBuffer *buf, struct iovec *iov, int max_iov, const void *prefix, int prefix_size, int *count);
+
+#endif
+
 #if !defined (__WIN32__)
 
     /**
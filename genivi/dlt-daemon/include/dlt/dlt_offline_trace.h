@@ -59,6 +59,8 @@ typedef struct
     char filename[256]; /**< (String) Filename of currently used log file */
     int  fileSize;	/**< (int) Maximum size in bytes of one trace file (Default: 1000000) */
     int  maxSize;	/**< (int) Maximum size of all trace files (Default: 4000000) */
+    char timestamp[32]; /**< (String) Creation time of currently used log file */
+    int  index;	/**< (int) Index of currently used log file among files created in the same second */
     
     int ohandle;
 } DltOfflineTrace;
@@ -187,6 +187,8 @@
 #define DLT_SERVICE_ID_SET_DEFAULT_TRACE_STATUS        0x12 /**< Service ID: Set default trace status */
 #define DLT_SERVICE_ID_GET_SOFTWARE_VERSION            0x13 /**< Service ID: Get software version */
 #define DLT_SERVICE_ID_MESSAGE_BUFFER_OVERFLOW         0x14 /**< Service ID: Message buffer overflow */
+#define DLT_SERVICE_ID_GET_STATISTICS                 0xF01 /**< Service ID: Get daemon statistics */
+#define DLT_SERVICE_ID_GET_LOG_INFO_PAGED             0xF02 /**< Service ID: Get log info in pages */
 #define DLT_SERVICE_ID_CALLSW_CINJECTION              0xFFF /**< Service ID: Message Injection (minimal ID) */
 
 /*
@@ -79,6 +79,9 @@
 
 #define MAXSTRLEN             1024
 
+/* Maximum number of datagrams received with one system call */
+#define RCVBATCH              32
+
 #define PU_DLT_APP_DESC      "udp adaptor application"
 #define PU_DLT_CONTEXT_DESC  "udp adaptor context"
 
@@ -87,14 +90,107 @@
 
 DLT_DECLARE_CONTEXT(mycontext);
 
+/**
+ * Get DLT log level from syslog priority "<PRI>" at start of message.
+ * Messages without priority are logged with level info.
+ */
+static DltLogLevelType syslog_level(const char *msg)
+{
+    int pri = 0;
+    const char *ptr = msg + 1;
+
+    if (msg[0] != '<')
+    {
+        return DLT_LOG_INFO;
+    }
+    while (*ptr >= '0' && *ptr <= '9' && (ptr - msg) <= 3)
+    {
+        pri = pri * 10 + (*ptr - '0');
+        ptr++;
+    }
+    if (*ptr != '>' || ptr == msg + 1 || pri > 191)
+    {
+        return DLT_LOG_INFO;
+    }
+
+    switch (pri & 0x07)
+    {
+    case 0: /* emergency */
+    case 1: /* alert */
+    case 2: /* critical */
+        return DLT_LOG_FATAL;
+    case 3:
+        return DLT_LOG_ERROR;
+    case 4:
+        return DLT_LOG_WARN;
+    case 7:
+        return DLT_LOG_DEBUG;
+    default: /* notice, info */
+        return DLT_LOG_INFO;
+    }
+}
+
+/**
+ * Forward a batch of received messages.
+ * Consecutive messages with the same log level are combined into one
+ * DLT message, separated by newlines, as long as they fit into MAXSTRLEN.
+ */
+static void forward_batch(struct mmsghdr *msgs, char recv_data[][MAXSTRLEN], int count)
+{
+    char text[MAXSTRLEN];
+    int text_len = 0;
+    DltLogLevelType level = DLT_LOG_INFO, msg_level;
+    int num, len;
+
+    for (num = 0; num < count; num++)
+    {
+        len = msgs[num].msg_len;
+        if (len == 0)
+        {
+            continue;
+        }
+        if (len >= MAXSTRLEN)
+        {
+            len = MAXSTRLEN - 1;
+        }
+        /* syslog messages may be terminated by a newline already */
+        if (recv_data[num][len-1] == '\n')
+        {
+            len--;
+        }
+        recv_data[num][len] = '\0';
+        msg_level = syslog_level(recv_data[num]);
+
+        if (text_len > 0 && (msg_level != level || text_len + 1 + len >= MAXSTRLEN))
+        {
+            DLT_LOG(mycontext, level, DLT_STRING(text));
+            text_len = 0;
+        }
+        if (text_len > 0)
+        {
+            text[text_len++] = '\n';
+        }
+        memcpy(text + text_len, recv_data[num], len);
+        text_len += len;
+        text[text_len] = '\0';
+        level = msg_level;
+    }
+
+    if (text_len > 0)
+    {
+        DLT_LOG(mycontext, level, DLT_STRING(text));
+    }
+}
+
 int main(int argc, char* argv[])
 {
     int sock;
-    int bytes_read;
-    socklen_t addr_len;
+    int count, num;
     int opt, port;
-    char recv_data[MAXSTRLEN];
-    struct sockaddr_in client_addr, server_addr;
+    static char recv_data[RCVBATCH][MAXSTRLEN];
+    struct mmsghdr msgs[RCVBATCH];
+    struct iovec iov[RCVBATCH];
+    struct sockaddr_in server_addr;
 
     char apid[DLT_ID_SIZE];
     char ctid[DLT_ID_SIZE];
@@ -166,19 +262,24 @@ int main(int argc, char* argv[])
         return -1;
     }
 
-    addr_len = sizeof(struct sockaddr);
+    memset(msgs, 0, sizeof(msgs));
+    for (num = 0; num < RCVBATCH; num++)
+    {
+        iov[num].iov_base = recv_data[num];
+        iov[num].iov_len = MAXSTRLEN;
+        msgs[num].msg_hdr.msg_iov = &iov[num];
+        msgs[num].msg_hdr.msg_iovlen = 1;
+    }
 
     DLT_REGISTER_APP(apid,PU_DLT_APP_DESC);
     DLT_REGISTER_CONTEXT(mycontext,ctid,PU_DLT_CONTEXT_DESC);
 
     while (1)
     {
-        bytes_read = 0;
-
-        bytes_read = recvfrom(sock, recv_data, MAXSTRLEN, 0,
-                              (struct sockaddr *)&client_addr, &addr_len);
+        /* wait for the first message, then take all messages already queued */
+        count = recvmmsg(sock, msgs, RCVBATCH, MSG_WAITFORONE, NULL);
 
-        if (bytes_read == -1)
+        if (count == -1)
         {
             if (errno == EINTR)
             {
@@ -192,12 +293,7 @@ int main(int argc, char* argv[])
             }
         }
 
-        recv_data[bytes_read] = '\0';
-
-        if (bytes_read != 0)
-        {
-            DLT_LOG(mycontext, DLT_LOG_INFO, DLT_STRING(recv_data));
-        }
+        forward_batch(msgs, recv_data, count);
     }
 
     DLT_UNREGISTER_CONTEXT(mycontext);
@@ -87,6 +87,45 @@
 
 #define DLT_CONVERT_TEXTBUFSIZE  10024   /* Size of buffer for text output */
 
+#define DLT_CONVERT_COLUMNAR_MAGIC      "DLTC"  /* Pattern at start of columnar export file */
+#define DLT_CONVERT_COLUMNAR_CHUNK      "CHNK"  /* Pattern at start of each chunk */
+#define DLT_CONVERT_COLUMNAR_VERSION    1
+#define DLT_CONVERT_COLUMNAR_COLUMNS    7       /* time, tmsp, ecu, apid, ctid, level, payload */
+#define DLT_CONVERT_COLUMNAR_ROWS       65536   /* Maximum number of messages per chunk */
+#define DLT_CONVERT_COLUMNAR_PAYLOAD    (4*1024*1024) /* Payload bytes after which a chunk is flushed */
+#define DLT_CONVERT_COLUMNAR_DICTSIZE   65535   /* Maximum number of distinct ids (index is 16 bit) */
+#define DLT_CONVERT_COLUMNAR_HASHSIZE   131072  /* Hash buckets of id dictionary, power of two */
+
+/**
+ * State of a columnar export.
+ * Messages are collected column by column for one chunk and written out
+ * when the chunk is full, so memory usage is bounded by the chunk size.
+ * Ecu, application and context ids share one dictionary; each chunk carries
+ * only the dictionary entries added since the previous chunk.
+ */
+typedef struct
+{
+    int handle;                 /**< output file handle */
+
+    uint32_t rows;              /**< number of messages in current chunk */
+    uint64_t *time;             /**< storage header time in microseconds since 1.1.1970 */
+    uint32_t *tmsp;             /**< timestamp since system start in 0.1 milliseconds, 0 if not available */
+    uint16_t *ecu;              /**< dictionary index of ecu id */
+    uint16_t *apid;             /**< dictionary index of application id */
+    uint16_t *ctid;             /**< dictionary index of context id */
+    uint8_t *level;             /**< log level, 0 if message is not a log message */
+    uint32_t *offsets;          /**< offsets of payload strings, rows+1 entries */
+    char *payload;              /**< payload strings of current chunk */
+    uint32_t payload_size;      /**< allocated size of payload buffer */
+
+    uint32_t dict_keys[DLT_CONVERT_COLUMNAR_HASHSIZE];   /**< hash table of ids */
+    uint16_t dict_index[DLT_CONVERT_COLUMNAR_HASHSIZE];  /**< dictionary index of hashed id */
+    uint8_t dict_used[DLT_CONVERT_COLUMNAR_HASHSIZE];    /**< bucket in use */
+    uint32_t dict_count;        /**< number of ids in dictionary */
+    uint32_t dict_written;      /**< number of ids already written to file */
+    char *dict_ids;             /**< ids in order of dictionary index */
+} DltConvertColumnar;
+
 /**
  * Print usage information of tool.
  */
@@ -109,6 +148,7 @@ void usage()
     printf("  -m            Print DLT file; payload as hex and ASCII\n");
     printf("  -s            Print DLT file; only headers\n");
     printf("  -o filename   Output messages in new DLT file\n");
+    printf("  -t filename   Export messages in columnar format\n");
     printf("Options:\n");
     printf("  -v            Verbose mode\n");
     printf("  -c            Count number of messages\n");
@@ -118,6 +158,281 @@ void usage()
     printf("  -w            Follow dlt file while file is increasing\n");
 }
 
+/**
+ * Write complete buffer to file handle.
+ */
+static int dlt_convert_write(int handle, const void *data, size_t size)
+{
+    const char *ptr = (const char *) data;
+    ssize_t bytes_written;
+
+    while (size > 0)
+    {
+        bytes_written = write(handle, ptr, size);
+        if (bytes_written <= 0)
+        {
+            return -1;
+        }
+        ptr += bytes_written;
+        size -= bytes_written;
+    }
+
+    return 0;
+}
+
+/**
+ * Open columnar export file and allocate the column buffers of one chunk.
+ */
+static int dlt_convert_columnar_init(DltConvertColumnar *columnar, const char *filename)
+{
+    uint32_t header[3];
+
+    memset(columnar, 0, sizeof(DltConvertColumnar));
+
+    columnar->time = (uint64_t *) malloc(DLT_CONVERT_COLUMNAR_ROWS * sizeof(uint64_t));
+    columnar->tmsp = (uint32_t *) malloc(DLT_CONVERT_COLUMNAR_ROWS * sizeof(uint32_t));
+    columnar->ecu = (uint16_t *) malloc(DLT_CONVERT_COLUMNAR_ROWS * sizeof(uint16_t));
+    columnar->apid = (uint16_t *) malloc(DLT_CONVERT_COLUMNAR_ROWS * sizeof(uint16_t));
+    columnar->ctid = (uint16_t *) malloc(DLT_CONVERT_COLUMNAR_ROWS * sizeof(uint16_t));
+    columnar->level = (uint8_t *) malloc(DLT_CONVERT_COLUMNAR_ROWS * sizeof(uint8_t));
+    columnar->offsets = (uint32_t *) malloc((DLT_CONVERT_COLUMNAR_ROWS + 1) * sizeof(uint32_t));
+    columnar->payload_size = DLT_CONVERT_COLUMNAR_PAYLOAD + DLT_CONVERT_TEXTBUFSIZE;
+    columnar->payload = (char *) malloc(columnar->payload_size);
+    columnar->dict_ids = (char *) malloc(DLT_CONVERT_COLUMNAR_DICTSIZE * DLT_ID_SIZE);
+
+    if (!columnar->time || !columnar->tmsp || !columnar->ecu || !columnar->apid || !columnar->ctid ||
+        !columnar->level || !columnar->offsets || !columnar->payload || !columnar->dict_ids)
+    {
+        fprintf(stderr,"ERROR: Cannot allocate memory for columnar export!\n");
+        return -1;
+    }
+    columnar->offsets[0] = 0;
+
+    columnar->handle = open(filename,O_WRONLY|O_CREAT|O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH); /* mode: wb */
+    if (columnar->handle == -1)
+    {
+        fprintf(stderr,"ERROR: Output file %s cannot be opened!\n",filename);
+        return -1;
+    }
+
+    /* file header: pattern, version, byte order mark and number of columns */
+    header[0] = DLT_CONVERT_COLUMNAR_VERSION;
+    header[1] = 0x01020304;
+    header[2] = DLT_CONVERT_COLUMNAR_COLUMNS;
+    if (dlt_convert_write(columnar->handle, DLT_CONVERT_COLUMNAR_MAGIC, DLT_ID_SIZE) < 0 ||
+        dlt_convert_write(columnar->handle, header, sizeof(header)) < 0)
+    {
+        fprintf(stderr,"ERROR: Cannot write to output file %s!\n",filename);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Return dictionary index of an id, adding the id to the dictionary if it is new.
+ */
+static int dlt_convert_columnar_id(DltConvertColumnar *columnar, const char *id)
+{
+    uint32_t key;
+    uint32_t bucket;
+
+    memcpy(&key, id, DLT_ID_SIZE);
+
+    /* open addressing with linear probing, table is never more than half full */
+    bucket = (key * 2654435761U) & (DLT_CONVERT_COLUMNAR_HASHSIZE - 1);
+    while (columnar->dict_used[bucket])
+    {
+        if (columnar->dict_keys[bucket] == key)
+        {
+            return columnar->dict_index[bucket];
+        }
+        bucket = (bucket + 1) & (DLT_CONVERT_COLUMNAR_HASHSIZE - 1);
+    }
+
+    if (columnar->dict_count >= DLT_CONVERT_COLUMNAR_DICTSIZE)
+    {
+        fprintf(stderr,"ERROR: Too many different ids for columnar export!\n");
+        return -1;
+    }
+
+    columnar->dict_used[bucket] = 1;
+    columnar->dict_keys[bucket] = key;
+    columnar->dict_index[bucket] = columnar->dict_count;
+    memcpy(columnar->dict_ids + columnar->dict_count * DLT_ID_SIZE, id, DLT_ID_SIZE);
+
+    return columnar->dict_count++;
+}
+
+/**
+ * Write the current chunk to the export file.
+ * A chunk consists of the chunk pattern, the number of rows, the new dictionary
+ * entries, the size of each column in bytes and the columns one after another.
+ * Readers can use the column sizes to skip columns they are not interested in.
+ */
+static int dlt_convert_columnar_flush(DltConvertColumnar *columnar)
+{
+    uint32_t header[2];
+    uint32_t sizes[DLT_CONVERT_COLUMNAR_COLUMNS];
+    uint32_t rows = columnar->rows;
+
+    if (rows == 0)
+    {
+        return 0;
+    }
+
+    header[0] = rows;
+    header[1] = columnar->dict_count - columnar->dict_written;
+
+    sizes[0] = rows * sizeof(uint64_t);
+    sizes[1] = rows * sizeof(uint32_t);
+    sizes[2] = rows * sizeof(uint16_t);
+    sizes[3] = rows * sizeof(uint16_t);
+    sizes[4] = rows * sizeof(uint16_t);
+    sizes[5] = rows * sizeof(uint8_t);
+    sizes[6] = (rows + 1) * sizeof(uint32_t) + columnar->offsets[rows];
+
+    if (dlt_convert_write(columnar->handle, DLT_CONVERT_COLUMNAR_CHUNK, DLT_ID_SIZE) < 0 ||
+        dlt_convert_write(columnar->handle, header, sizeof(header)) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->dict_ids + columnar->dict_written * DLT_ID_SIZE, header[1] * DLT_ID_SIZE) < 0 ||
+        dlt_convert_write(columnar->handle, sizes, sizeof(sizes)) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->time, sizes[0]) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->tmsp, sizes[1]) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->ecu, sizes[2]) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->apid, sizes[3]) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->ctid, sizes[4]) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->level, sizes[5]) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->offsets, (rows + 1) * sizeof(uint32_t)) < 0 ||
+        dlt_convert_write(columnar->handle, columnar->payload, columnar->offsets[rows]) < 0)
+    {
+        fprintf(stderr,"ERROR: Cannot write chunk to output file!\n");
+        return -1;
+    }
+
+    columnar->dict_written = columnar->dict_count;
+    columnar->rows = 0;
+    columnar->offsets[0] = 0;
+
+    return 0;
+}
+
+/**
+ * Append the current message of a DLT file as one row to the columnar export.
+ */
+static int dlt_convert_columnar_add(DltConvertColumnar *columnar, DltMessage *msg, int verbose)
+{
+    uint32_t row = columnar->rows;
+    int ecu, apid, ctid;
+    int len;
+    char *text;
+
+    columnar->time[row] = (uint64_t)msg->storageheader->seconds * 1000000 + msg->storageheader->microseconds;
+    columnar->tmsp[row] = DLT_IS_HTYP_WTMS(msg->standardheader->htyp) ? msg->headerextra.tmsp : 0;
+
+    /* use ecu id of header extra if available, else storage header value */
+    ecu = dlt_convert_columnar_id(columnar, DLT_IS_HTYP_WEID(msg->standardheader->htyp) ? msg->headerextra.ecu : msg->storageheader->ecu);
+    if (DLT_IS_HTYP_UEH(msg->standardheader->htyp))
+    {
+        apid = dlt_convert_columnar_id(columnar, msg->extendedheader->apid);
+        ctid = dlt_convert_columnar_id(columnar, msg->extendedheader->ctid);
+        columnar->level[row] = (DLT_GET_MSIN_MSTP(msg->extendedheader->msin) == DLT_TYPE_LOG) ?
+                               DLT_GET_MSIN_MTIN(msg->extendedheader->msin) : 0;
+    }
+    else
+    {
+        apid = dlt_convert_columnar_id(columnar, "\0\0\0\0");
+        ctid = apid;
+        columnar->level[row] = 0;
+    }
+    if (ecu < 0 || apid < 0 || ctid < 0)
+    {
+        return -1;
+    }
+    columnar->ecu[row] = ecu;
+    columnar->apid[row] = apid;
+    columnar->ctid[row] = ctid;
+
+    /* payload is converted to the same text as printed with option -a */
+    text = columnar->payload + columnar->offsets[row];
+    text[0] = 0;
+    dlt_message_payload(msg,text,DLT_CONVERT_TEXTBUFSIZE,DLT_OUTPUT_ASCII,verbose);
+    len = strlen(text);
+    columnar->offsets[row+1] = columnar->offsets[row] + len;
+
+    columnar->rows++;
+
+    if (columnar->rows >= DLT_CONVERT_COLUMNAR_ROWS || columnar->offsets[columnar->rows] >= DLT_CONVERT_COLUMNAR_PAYLOAD)
+    {
+        return dlt_convert_columnar_flush(columnar);
+    }
+
+    return 0;
+}
+
+/**
+ * Flush the last chunk and free all resources of the columnar export.
+ */
+static int dlt_convert_columnar_free(DltConvertColumnar *columnar)
+{
+    int ret = 0;
+
+    if (columnar->handle > 0)
+    {
+        ret = dlt_convert_columnar_flush(columnar);
+        close(columnar->handle);
+    }
+
+    free(columnar->time);
+    free(columnar->tmsp);
+    free(columnar->ecu);
+    free(columnar->apid);
+    free(columnar->ctid);
+    free(columnar->level);
+    free(columnar->offsets);
+    free(columnar->payload);
+    free(columnar->dict_ids);
+
+    return ret;
+}
+
+/**
+ * Export all messages of an opened DLT file in columnar format.
+ * The file is read sequentially without building an index, so the memory
+ * usage does not depend on the size of the file.
+ */
+static int dlt_convert_columnar_export(DltConvertColumnar *columnar, DltFile *file, int begin, int end, int verbose)
+{
+    while (dlt_file_read_header(file,verbose)>=0)
+    {
+        if (dlt_file_read_header_extended(file,verbose)<0 || dlt_file_read_data(file,verbose)<0)
+        {
+            break;
+        }
+        if (!DLT_IS_HTYP_UEH(file->msg.standardheader->htyp))
+        {
+            file->msg.extendedheader = 0;
+        }
+
+        file->counter_total++;
+
+        if (file->filter && dlt_message_filter_check(&(file->msg),file->filter,verbose) != 1)
+        {
+            continue;
+        }
+
+        if (file->counter >= begin && (end < 0 || file->counter <= end))
+        {
+            if (dlt_convert_columnar_add(columnar, &(file->msg), verbose) < 0)
+            {
+                return -1;
+            }
+        }
+        file->counter++;
+    }
+
+    return 0;
+}
+
 /**
  * Main function of tool.
  */
@@ -134,12 +449,14 @@ int main(int argc, char* argv[])
     char *bvalue = 0;
     char *evalue = 0;
     char *ovalue = 0;
+    char *tvalue = 0;
 
     int index;
     int c;
 
 	DltFile file;
 	DltFilter filter;
+	DltConvertColumnar *columnar = 0;
 
 	int ohandle=-1;
 
@@ -152,7 +469,7 @@ int main(int argc, char* argv[])
 
     opterr = 0;
 
-    while ((c = getopt (argc, argv, "vcashxmwf:b:e:o:")) != -1)
+    while ((c = getopt (argc, argv, "vcashxmwf:b:e:o:t:")) != -1)
         switch (c)
         {
         case 'v':
@@ -215,9 +532,14 @@ int main(int argc, char* argv[])
             	ovalue = optarg;
             	break;
 			}
+        case 't':
+			{
+            	tvalue = optarg;
+            	break;
+			}
         case '?':
 			{
-		        if (optopt == 'f' || optopt == 'b' || optopt == 'e' || optopt == 'o')
+		        if (optopt == 'f' || optopt == 'b' || optopt == 'e' || optopt == 'o' || optopt == 't')
 				{
 		            fprintf (stderr, "Option -%c requires an argument.\n", optopt);
 				}
@@ -266,8 +588,45 @@ int main(int argc, char* argv[])
 
     }
 
+    if (tvalue)
+    {
+        columnar = (DltConvertColumnar *) malloc(sizeof(DltConvertColumnar));
+        if (columnar == 0 || dlt_convert_columnar_init(columnar,tvalue) < 0)
+        {
+            if (columnar)
+            {
+                dlt_convert_columnar_free(columnar);
+                free(columnar);
+            }
+            dlt_file_free(&file,vflag);
+            return -1;
+        }
+    }
+
     for (index = optind; index < argc; index++)
     {
+        if (columnar)
+        {
+            /* stream messages into columnar export, no index list is needed */
+            if (dlt_file_open(&file,argv[index],vflag)<0 ||
+                dlt_convert_columnar_export(columnar,&file,bvalue ? atoi(bvalue) : 0,evalue ? atoi(evalue) : -1,vflag)<0)
+            {
+                dlt_convert_columnar_free(columnar);
+                free(columnar);
+                dlt_file_free(&file,vflag);
+                return -1;
+            }
+            if (cflag)
+            {
+                printf("Total number of messages: %d\n",file.counter_total);
+                if (file.filter)
+                {
+                    printf("Filtered number of messages: %d\n",file.counter);
+                }
+            }
+            continue;
+        }
+
         /* load, analyse data file and create index list */
         if (dlt_file_open(&file,argv[index],vflag)>=0)
         {
@@ -388,6 +747,16 @@ int main(int argc, char* argv[])
     {
         close(ohandle);
     }
+    if (columnar)
+    {
+        if (dlt_convert_columnar_free(columnar) < 0)
+        {
+            free(columnar);
+            dlt_file_free(&file,vflag);
+            return -1;
+        }
+        free(columnar);
+    }
     if (index == optind)
     {
         /* no file selected, show usage and terminate */
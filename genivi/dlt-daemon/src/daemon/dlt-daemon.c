@@ -80,6 +80,7 @@
 #include <sys/timerfd.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <linux/stat.h>
 
 #include "dlt_types.h"
@@ -208,13 +209,26 @@ int option_file_parser(DltDaemonLocal *daemon_local)
 	char value[1024];
     char *pch;
     const char *filename;
+    int i;
 
 	/* set default values for configuration */
 	daemon_local->flags.sharedMemorySize = DLT_SHM_SIZE;
 	daemon_local->flags.sendMessageTime = 0;
+	daemon_local->flags.statisticsInterval = 0;
+	daemon_local->flags.repeatFilterWindow = 0;
+	daemon_local->flags.repeatFilterMaxCount = DLT_DAEMON_REPEAT_MAX_COUNT;
+	daemon_local->flags.serialFrameSize = DLT_DAEMON_SERIAL_FRAME_SIZE;
+	daemon_local->flags.serialQueueSize = DLT_DAEMON_SERIAL_QUEUE_SIZE;
+	daemon_local->flags.serialPriorityLevel = DLT_DAEMON_SERIAL_PRIORITY_LEVEL;
 	daemon_local->flags.offlineTraceDirectory[0] = 0;
 	daemon_local->flags.offlineTraceFileSize = 1000000;
 	daemon_local->flags.offlineTraceMaxSize = 0;
+	for (i = 0; i < DLT_DAEMON_OFFLINE_TRACE_SINKS; i++)
+	{
+		memset(&(daemon_local->flags.offlineTraceSinks[i]), 0, sizeof(DltDaemonOfflineTraceSinkConfig));
+		daemon_local->flags.offlineTraceSinks[i].fileSize = DLT_DAEMON_OFFLINE_TRACE_SINK_FILE_SIZE;
+		daemon_local->flags.offlineTraceSinks[i].maxSize = DLT_DAEMON_OFFLINE_TRACE_SINK_MAX_SIZE;
+	}
 	daemon_local->flags.loggingMode = 0;
 	daemon_local->flags.loggingLevel = 6;
 	strncpy(daemon_local->flags.loggingFilename, DLT_USER_DIR "/dlt.log",sizeof(daemon_local->flags.loggingFilename));
@@ -296,6 +310,21 @@ int option_file_parser(DltDaemonLocal *daemon_local)
 							daemon_local->flags.sendMessageTime = atoi(value);
 							//printf("Option: %s=%s\n",token,value);
 						}
+						else if(strcmp(token,"StatisticsInterval")==0)
+						{
+							daemon_local->flags.statisticsInterval = atoi(value);
+							//printf("Option: %s=%s\n",token,value);
+						}
+						else if(strcmp(token,"RepeatFilterWindow")==0)
+						{
+							daemon_local->flags.repeatFilterWindow = atoi(value);
+							//printf("Option: %s=%s\n",token,value);
+						}
+						else if(strcmp(token,"RepeatFilterMaxCount")==0)
+						{
+							daemon_local->flags.repeatFilterMaxCount = atoi(value);
+							//printf("Option: %s=%s\n",token,value);
+						}
 						else if(strcmp(token,"RS232SyncSerialHeader")==0)
 						{
 							daemon_local->flags.mflag = atoi(value);
@@ -316,6 +345,21 @@ int option_file_parser(DltDaemonLocal *daemon_local)
 							strncpy(daemon_local->flags.bvalue,value,sizeof(daemon_local->flags.bvalue));
 							//printf("Option: %s=%s\n",token,value);
 						}
+						else if(strcmp(token,"RS232FrameSize")==0)
+						{
+							daemon_local->flags.serialFrameSize = atoi(value);
+							//printf("Option: %s=%s\n",token,value);
+						}
+						else if(strcmp(token,"RS232QueueSize")==0)
+						{
+							daemon_local->flags.serialQueueSize = atoi(value);
+							//printf("Option: %s=%s\n",token,value);
+						}
+						else if(strcmp(token,"RS232PriorityLevel")==0)
+						{
+							daemon_local->flags.serialPriorityLevel = atoi(value);
+							//printf("Option: %s=%s\n",token,value);
+						}
 						else if(strcmp(token,"ECUId")==0)
 						{
 							strncpy(daemon_local->flags.evalue,value,sizeof(daemon_local->flags.evalue));
@@ -361,6 +405,13 @@ int option_file_parser(DltDaemonLocal *daemon_local)
 							daemon_local->flags.offlineTraceMaxSize = atoi(value);
 							//printf("Option: %s=%s\n",token,value);
 						}
+						else if(strncmp(token,"OfflineTraceSink",strlen("OfflineTraceSink"))==0)
+						{
+							if (dlt_daemon_offline_trace_sink_option(daemon_local,token+strlen("OfflineTraceSink"),value)==-1)
+							{
+								fprintf(stderr, "Unknown option: %s=%s\n",token,value);
+							}
+						}
 						else if(strcmp(token,"SendECUSoftwareVersion")==0)
 						{
 							daemon_local->flags.sendECUSoftwareVersion = atoi(value);
@@ -401,6 +452,10 @@ int main(int argc, char* argv[])
 	char version[DLT_DAEMON_TEXTBUFSIZE];
     DltDaemonLocal daemon_local;
     DltDaemon daemon;
+    struct timeval tv, *timeout;
+    fd_set write_fds;
+    uint32_t statistics_due, repeat_due;
+    int32_t period;
 
     int i,back;
 
@@ -459,11 +514,55 @@ int main(int argc, char* argv[])
     }
     /* --- Daemon init phase 2 end --- */
 
+    statistics_due = dlt_uptime();
+    repeat_due = dlt_uptime();
+
     while (1)
     {
-        /* wait for events form all FIFO and sockets */
+        /* wake up for periodic statistics and repeat summaries, if enabled */
+        timeout = NULL;
+        period = -1;
+        if (daemon_local.flags.statisticsInterval > 0)
+        {
+            if ((int32_t)(statistics_due - dlt_uptime()) <= 0)
+            {
+                dlt_daemon_send_statistics(&daemon, &daemon_local, daemon_local.flags.vflag);
+                dlt_daemon_serial_report(&daemon_local, daemon_local.flags.vflag);
+                statistics_due = dlt_uptime() + daemon_local.flags.statisticsInterval * 10000;
+            }
+            period = (int32_t)(statistics_due - dlt_uptime());
+        }
+        if (daemon_local.flags.repeatFilterWindow > 0)
+        {
+            if ((int32_t)(repeat_due - dlt_uptime()) <= 0)
+            {
+                dlt_daemon_repeat_flush(&daemon, &daemon_local, daemon_local.flags.vflag);
+                repeat_due = dlt_uptime() + daemon_local.flags.repeatFilterWindow * 10;
+            }
+            if ((period < 0) || ((int32_t)(repeat_due - dlt_uptime()) < period))
+            {
+                period = (int32_t)(repeat_due - dlt_uptime());
+            }
+        }
+        if (period != -1)
+        {
+            if (period < 0)
+            {
+                period = 0;
+            }
+            tv.tv_sec = period / 10000;
+            tv.tv_usec = (period % 10000) * 100;
+            timeout = &tv;
+        }
+
+        /* wait for events form all FIFO and sockets, and for the serial device accepting queued messages */
         daemon_local.read_fds = daemon_local.master;
-        if (select(daemon_local.fdmax+1, &(daemon_local.read_fds), NULL, NULL, NULL) == -1)
+        FD_ZERO(&write_fds);
+        if (dlt_daemon_serial_pending(&daemon, &daemon_local))
+        {
+            FD_SET(daemon_local.fdserial, &write_fds);
+        }
+        if (select(daemon_local.fdmax+1, &(daemon_local.read_fds), &write_fds, NULL, timeout) == -1)
         {
             dlt_log(LOG_CRIT, "select() failed!\n");
             return -1 ;
@@ -472,7 +571,8 @@ int main(int argc, char* argv[])
         /* run through the existing FIFO and sockets to check for events */
         for (i = 0; i <= daemon_local.fdmax; i++)
         {
-            if (FD_ISSET(i, &(daemon_local.read_fds)))
+            /* a client may have been closed while handling an earlier event */
+            if (FD_ISSET(i, &(daemon_local.read_fds)) && FD_ISSET(i, &(daemon_local.master)))
             {
                 if (i == daemon_local.sock && ((daemon.mode == DLT_USER_MODE_EXTERNAL) || (daemon.mode == DLT_USER_MODE_BOTH)))
                 {
@@ -513,6 +613,9 @@ int main(int argc, char* argv[])
                 } /* else */
             } /* if */
         } /* for */
+
+        /* write queued messages in frames to the serial device */
+        dlt_daemon_serial_flush(&daemon, &daemon_local, daemon_local.flags.vflag);
     } /* while */
 
     dlt_daemon_local_cleanup(&daemon, &daemon_local, daemon_local.flags.vflag);
@@ -601,9 +704,9 @@ int dlt_daemon_local_init_p2(DltDaemon *daemon, DltDaemonLocal *daemon_local, in
     }
 
 	/* init offline trace */
-	if(((daemon->mode == DLT_USER_MODE_INTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) && daemon_local->flags.offlineTraceDirectory[0])
+	if((daemon->mode == DLT_USER_MODE_INTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH))
 	{
-		if (dlt_offline_trace_init(&(daemon_local->offlineTrace),daemon_local->flags.offlineTraceDirectory,daemon_local->flags.offlineTraceFileSize,daemon_local->flags.offlineTraceMaxSize)==-1)
+		if (dlt_daemon_offline_trace_init(daemon_local,daemon_local->flags.vflag)==-1)
 		{
 			dlt_log(LOG_ERR,"Could not initialize offline trace\n");
 			return -1;
@@ -620,6 +723,9 @@ int dlt_daemon_local_init_p2(DltDaemon *daemon, DltDaemonLocal *daemon_local, in
         dlt_set_id(daemon->ecuid,DLT_DAEMON_ECU_ID);
     }
 
+    /* Storage header of received messages is encoded once */
+    dlt_storageheader_cache_init(&(daemon_local->storageHeaderCache),daemon->ecuid);
+
     /* Set flag for optional sending of serial header */
     daemon->sendserialheader = daemon_local->flags.lflag;
 
@@ -772,6 +878,7 @@ int dlt_daemon_local_connection_init(DltDaemon *daemon, DltDaemonLocal *daemon_l
         dlt_log(LOG_ERR, str);
         return -1;
     } /* if */
+    daemon->statistics.fifo = daemon_local->fp;
 
     /* create and open socket to receive incoming connections from client */
     if ((daemon_local->sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP)) < 0)
@@ -826,7 +933,8 @@ int dlt_daemon_local_connection_init(DltDaemon *daemon, DltDaemonLocal *daemon_l
     {
         /* create and open serial connection from/to client */
         /* open serial connection */
-        daemon_local->fdserial=open(daemon_local->flags.yvalue,O_RDWR);
+        /* non-blocking, a slow device must not stall the daemon, see dlt_daemon_serial_flush() */
+        daemon_local->fdserial=open(daemon_local->flags.yvalue,O_RDWR|O_NONBLOCK);
         if (daemon_local->fdserial<0)
         {
             sprintf(str,"Failed to open serial device %s\n", daemon_local->flags.yvalue);
@@ -855,6 +963,13 @@ int dlt_daemon_local_connection_init(DltDaemon *daemon, DltDaemonLocal *daemon_l
                 return -1;
             }
 
+            if (dlt_daemon_serial_init(daemon_local, verbose)==-1)
+            {
+                close(daemon_local->fdserial);
+                daemon_local->flags.yvalue[0] = 0;
+                return -1;
+            }
+
             FD_SET(daemon_local->fdserial, &(daemon_local->master));
 
             if (daemon_local->fdserial > daemon_local->fdmax)
@@ -900,8 +1015,7 @@ void dlt_daemon_local_cleanup(DltDaemon *daemon, DltDaemonLocal *daemon_local, i
     close(daemon_local->fp);
 
 	/* free shared memory */
-	if(daemon_local->flags.offlineTraceDirectory[0])
-		dlt_offline_trace_free(&(daemon_local->offlineTrace));
+	dlt_daemon_offline_trace_free(daemon_local,verbose);
 #if 0
     if (daemon_local->flags.ovalue[0])
     {
@@ -912,6 +1026,10 @@ void dlt_daemon_local_cleanup(DltDaemon *daemon, DltDaemonLocal *daemon_local, i
 	/* Ignore result */
     dlt_file_free(&(daemon_local->file),daemon_local->flags.vflag);
 
+    /* report and release queues of serial connection */
+    dlt_daemon_serial_report(daemon_local, verbose);
+    dlt_daemon_serial_free(daemon_local, verbose);
+
     /* Try to delete existing pipe, ignore result of unlink() */
     unlink(DLT_USER_FIFO);
 
@@ -1084,6 +1202,12 @@ int dlt_daemon_process_client_connect(DltDaemon *daemon, DltDaemonLocal *daemon_
         	dlt_log(LOG_ERR,"Can't send contents of ringbuffer to clients\n");
 			return -1;
         }
+
+        /* the client was closed again, if the ring-buffer could not be written */
+        if (daemon_local->client_connections==0)
+        {
+            return 0;
+        }
 		
 		/* send new log state to all applications */
 		daemon->state = 1;		
@@ -1093,6 +1217,40 @@ int dlt_daemon_process_client_connect(DltDaemon *daemon, DltDaemonLocal *daemon_
     return 0;
 }
 
+int dlt_daemon_close_client_connection(DltDaemon *daemon, DltDaemonLocal *daemon_local, int sock, int verbose)
+{
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0)  || (daemon_local==0))
+    {
+    	dlt_log(LOG_ERR, "Invalid function parameters used for function dlt_daemon_close_client_connection()\n");
+        return -1;
+    }
+
+    close(sock);
+    FD_CLR(sock, &(daemon_local->master));
+
+    if (daemon_local->client_connections)
+    {
+        daemon_local->client_connections--;
+    }
+
+	if(daemon_local->client_connections==0)
+	{
+		/* send new log state to all applications */
+		daemon->state = 0;		
+		dlt_daemon_user_send_all_log_state(daemon,verbose);
+	}
+			
+    if (daemon_local->flags.vflag)
+    {
+        sprintf(str, "Connection to client lost, #connections: %d\n",daemon_local->client_connections);
+        dlt_log(LOG_INFO, str);
+    }
+
+    return 0;
+}
+
 int dlt_daemon_process_client_messages(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
 {
     int bytes_to_be_removed=0;
@@ -1107,26 +1265,7 @@ int dlt_daemon_process_client_messages(DltDaemon *daemon, DltDaemonLocal *daemon
 
     if (dlt_receiver_receive_socket(&(daemon_local->receiverSock))<=0)
     {
-        close(daemon_local->receiverSock.fd);
-        FD_CLR(daemon_local->receiverSock.fd, &(daemon_local->master));
-
-        if (daemon_local->client_connections)
-        {
-            daemon_local->client_connections--;
-        }
-
-		if(daemon_local->client_connections==0)
-		{
-			/* send new log state to all applications */
-			daemon->state = 0;		
-			dlt_daemon_user_send_all_log_state(daemon,verbose);
-		}
-				
-        if (daemon_local->flags.vflag)
-        {
-            sprintf(str, "Connection to client lost, #connections: %d\n",daemon_local->client_connections);
-            dlt_log(LOG_INFO, str);
-        }
+        dlt_daemon_close_client_connection(daemon, daemon_local, daemon_local->receiverSock.fd, verbose);
 
         /* check: return 0; */
     }
@@ -1248,6 +1387,9 @@ int dlt_daemon_process_user_messages(DltDaemon *daemon, DltDaemonLocal *daemon_l
         return -1;
     }
 
+    /* time of storage header is read once for all messages received at once */
+    dlt_storageheader_cache_update(&(daemon_local->storageHeaderCache));
+
     /* look through buffer as long as data is in there */
     do
     {
@@ -1407,6 +1549,7 @@ int dlt_daemon_process_user_message_overflow(DltDaemon *daemon, DltDaemonLocal *
 
     /* Store in daemon, that a message buffer overflow has occured */
     daemon->message_buffer_overflow = DLT_MESSAGE_BUFFER_OVERFLOW;
+    daemon->statistics.user_overflows++;
 
     /* look if TCP connection to client is available */
     sent = 0;
@@ -1794,8 +1937,8 @@ int dlt_daemon_process_user_message_unregister_context(DltDaemon *daemon, DltDae
 int dlt_daemon_process_user_message_log(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
 {
     int bytes_to_be_removed;
-    int j,sent,third_value;
-    ssize_t ret;
+    struct timespec start;
+    DltDaemonStatisticsResult result;
 
     static char text[DLT_DAEMON_TEXTSIZE];
 
@@ -1807,6 +1950,8 @@ int dlt_daemon_process_user_message_log(DltDaemon *daemon, DltDaemonLocal *daemo
         return -1;
     }
 
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
     if (dlt_message_read(&(daemon_local->msg),(unsigned char*)daemon_local->receiver.buf+sizeof(DltUserHeader),daemon_local->receiver.bytesRcvd-sizeof(DltUserHeader),0,verbose)==0)
     {
         /* set overwrite ecu id */
@@ -1828,7 +1973,7 @@ int dlt_daemon_process_user_message_log(DltDaemon *daemon, DltDaemonLocal *daemo
         /* prepare storage header */
         if (DLT_IS_HTYP_WEID(daemon_local->msg.standardheader->htyp))
         {
-            if (dlt_set_storageheader(daemon_local->msg.storageheader,daemon_local->msg.headerextra.ecu)==-1)
+            if (dlt_set_storageheader_cached(daemon_local->msg.storageheader,&(daemon_local->storageHeaderCache),daemon_local->msg.headerextra.ecu)==-1)
             {
 				dlt_log(LOG_ERR,"Can't set storage header in process user message log\n");
 				return -1;
@@ -1836,7 +1981,7 @@ int dlt_daemon_process_user_message_log(DltDaemon *daemon, DltDaemonLocal *daemo
         }
         else
         {
-            if (dlt_set_storageheader(daemon_local->msg.storageheader,daemon->ecuid)==-1)
+            if (dlt_set_storageheader_cached(daemon_local->msg.storageheader,&(daemon_local->storageHeaderCache),daemon->ecuid)==-1)
             {
 				dlt_log(LOG_ERR,"Can't set storage header in process user message log\n");
 				return -1;
@@ -1868,82 +2013,18 @@ int dlt_daemon_process_user_message_log(DltDaemon *daemon, DltDaemonLocal *daemo
                 /* print message header only */
             } /* if */
 
-            sent=0;
-
-			/* write message to offline trace */
-			if(((daemon->mode == DLT_USER_MODE_INTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) && daemon_local->flags.offlineTraceDirectory[0])
-			{
-				dlt_offline_trace_write(&(daemon_local->offlineTrace),daemon_local->msg.headerbuffer,daemon_local->msg.headersize,
-										daemon_local->msg.databuffer,daemon_local->msg.datasize,0,0);
-				sent = 1;
-			}
-
-            /* look if TCP connection to client is available */
-            for (j = 0;((daemon->mode == DLT_USER_MODE_EXTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) &&  (j <= daemon_local->fdmax); j++)
+            /* identical messages may be replaced by a summary */
+            if (dlt_daemon_repeat_check(daemon, daemon_local, verbose))
             {
-                /* send to everyone! */
-                if (FD_ISSET(j, &(daemon_local->master)))
-                {
-                    /* except the listener and ourselves */
-                    if (daemon_local->flags.yvalue[0])
-                    {
-                        third_value = daemon_local->fdserial;
-                    }
-                    else
-                    {
-                        third_value = daemon_local->sock;
-                    }
-
-                    if ((j != daemon_local->fp) && (j != daemon_local->sock) && (j != third_value))
-                    {
-                        DLT_DAEMON_SEM_LOCK();
-
-                        if (daemon_local->flags.lflag)
-                        {
-                            send(j,dltSerialHeader,sizeof(dltSerialHeader),0);
-                        }
-
-                        send(j,daemon_local->msg.headerbuffer+sizeof(DltStorageHeader),daemon_local->msg.headersize-sizeof(DltStorageHeader),0);
-                        send(j,daemon_local->msg.databuffer,daemon_local->msg.datasize,0);
-
-                        DLT_DAEMON_SEM_FREE();
-
-                        sent=1;
-                    } /* if */
-                    else if ((j == daemon_local->fdserial) && (daemon_local->flags.yvalue!=0))
-                    {
-                        DLT_DAEMON_SEM_LOCK();
-
-                        if (daemon_local->flags.lflag)
-                        {
-                            ret=write(j,dltSerialHeader,sizeof(dltSerialHeader));
-                        }
-
-                        ret=write(j,daemon_local->msg.headerbuffer+sizeof(DltStorageHeader),daemon_local->msg.headersize-sizeof(DltStorageHeader));
-                        ret=write(j,daemon_local->msg.databuffer,daemon_local->msg.datasize);
-
-                        DLT_DAEMON_SEM_FREE();
-
-                        sent=1;
-                    }
-                } /* if */
-            } /* for */
-
-            /* Message was not sent to client, so store it in client ringbuffer */
-            if (sent==0)
+                result = DLT_DAEMON_STATISTICS_SUPPRESSED;
+            }
+            else
             {
-            	DLT_DAEMON_SEM_LOCK();
-                if (dlt_buffer_push3(&(daemon->client_ringbuffer),
-                                    daemon_local->msg.headerbuffer+sizeof(DltStorageHeader),daemon_local->msg.headersize-sizeof(DltStorageHeader),
-                                    daemon_local->msg.databuffer,daemon_local->msg.datasize,
-                                    0, 0
-                                   )<0)
-				{
-					dlt_log(LOG_ERR,"Storage of message in history buffer failed! Message discarded.\n");
-				}
-                DLT_DAEMON_SEM_FREE();
+                result = dlt_daemon_forward_message(daemon, daemon_local, &(daemon_local->msg), verbose);
             }
 
+            dlt_daemon_statistics_message(daemon, &(daemon_local->msg), result, &start);
+
         }
         /* keep not read data in buffer */
         bytes_to_be_removed = daemon_local->msg.headersize+daemon_local->msg.datasize-sizeof(DltStorageHeader)+sizeof(DltUserHeader);
@@ -1972,10 +2053,10 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 {
     int bytes_to_be_removed=0;
     int j,sent,third_value;
-    ssize_t ret;
     uint8_t rcv_buffer[10000];
     int size;
     DltUserHeader *userheader;
+    struct timespec start;
 
     static char text[DLT_DAEMON_TEXTSIZE];
 
@@ -1992,6 +2073,8 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 	//dlt_shm_status(&(daemon_local->dlt_shm));
 	while (1)
     {		
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
 		/* log message in SHM */
 		if((size = dlt_shm_copy(&(daemon_local->dlt_shm),rcv_buffer,10000)) <= 0)
 			break;
@@ -2026,7 +2109,7 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 		/* prepare storage header */
 		if (DLT_IS_HTYP_WEID(daemon_local->msg.standardheader->htyp))
 		{
-			if (dlt_set_storageheader(daemon_local->msg.storageheader,daemon_local->msg.headerextra.ecu)==-1)
+			if (dlt_set_storageheader_cached(daemon_local->msg.storageheader,&(daemon_local->storageHeaderCache),daemon_local->msg.headerextra.ecu)==-1)
 			{
 				dlt_log(LOG_ERR,"Can't set storage header in process user message log\n");
 				dlt_shm_remove(&(daemon_local->dlt_shm));
@@ -2035,7 +2118,7 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 		}
 		else
 		{
-			if (dlt_set_storageheader(daemon_local->msg.storageheader,daemon->ecuid)==-1)
+			if (dlt_set_storageheader_cached(daemon_local->msg.storageheader,&(daemon_local->storageHeaderCache),daemon->ecuid)==-1)
 			{
 				dlt_log(LOG_ERR,"Can't set storage header in process user message log\n");
 				dlt_shm_remove(&(daemon_local->dlt_shm));
@@ -2067,14 +2150,25 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 			/* print message header only */
 		} /* if */
 
+		/* identical messages may be replaced by a summary */
+		if (dlt_daemon_repeat_check(daemon, daemon_local, verbose))
+		{
+			dlt_daemon_statistics_message(daemon, &(daemon_local->msg), DLT_DAEMON_STATISTICS_SUPPRESSED, &start);
+			if(userheader->message == DLT_USER_MESSAGE_LOG_SHM) {
+				dlt_shm_remove(&(daemon_local->dlt_shm));
+			}
+			continue;
+		}
+
 		sent=0;
 
 		/* write message to offline trace */
-		if(((daemon->mode == DLT_USER_MODE_INTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) && daemon_local->flags.offlineTraceDirectory[0])
+		if(((daemon->mode == DLT_USER_MODE_INTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) && dlt_daemon_offline_trace_enabled(daemon_local))
 		{
-			dlt_offline_trace_write(&(daemon_local->offlineTrace),daemon_local->msg.headerbuffer,daemon_local->msg.headersize,
-									daemon_local->msg.databuffer,daemon_local->msg.datasize,0,0);
-			sent = 1;
+			if (dlt_daemon_offline_trace_write(daemon_local,&(daemon_local->msg),verbose))
+			{
+				sent = 1;
+			}
 		}
 
 		/* look if TCP connection to client is available */
@@ -2111,17 +2205,8 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 				} /* if */
 				else if ((j == daemon_local->fdserial) && (daemon_local->flags.yvalue[0]))
 				{
-					DLT_DAEMON_SEM_LOCK();
-
-					if (daemon_local->flags.lflag)
-					{
-						ret=write(j,dltSerialHeader,sizeof(dltSerialHeader));
-					}
-
-					ret=write(j,daemon_local->msg.headerbuffer+sizeof(DltStorageHeader),daemon_local->msg.headersize-sizeof(DltStorageHeader));
-					ret=write(j,daemon_local->msg.databuffer,daemon_local->msg.datasize);
-
-					DLT_DAEMON_SEM_FREE();
+					/* queued and written in frames, dropped if the serial link is saturated */
+					dlt_daemon_serial_push(daemon, daemon_local, &(daemon_local->msg), verbose);
 
 					sent=1;
 				}
@@ -2131,6 +2216,9 @@ int dlt_daemon_process_user_message_log_shm(DltDaemon *daemon, DltDaemonLocal *d
 		/* Message was not sent to client, so store it in client ringbuffer */
 		if (sent==1 || (daemon->mode == DLT_USER_MODE_OFF))
 		{
+			/* messages kept in shared memory are counted when they are sent */
+			dlt_daemon_statistics_message(daemon, &(daemon_local->msg),
+				sent ? DLT_DAEMON_STATISTICS_FORWARDED : DLT_DAEMON_STATISTICS_DROPPED, &start);
 			if(userheader->message == DLT_USER_MESSAGE_LOG_SHM) {
 				/* dlt message was sent, remove from buffer if log message from shm */
 				dlt_shm_remove(&(daemon_local->dlt_shm));
@@ -2260,13 +2348,46 @@ int dlt_daemon_process_user_message_log_mode(DltDaemon *daemon, DltDaemonLocal *
     return 0;
 }
 
-int dlt_daemon_send_ringbuffer_to_client(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
+static int dlt_daemon_writev_all(int fd, struct iovec *iov, int iovcnt)
 {
-    static uint8_t data[DLT_DAEMON_RCVBUFSIZE];
-    int length;
-    int j, third_value;
     ssize_t ret;
 
+    while (iovcnt > 0)
+    {
+        ret = writev(fd, iov, iovcnt);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+
+        /* skip the elements written completely, continue a partial one */
+        while (iovcnt > 0 && (size_t)ret >= iov->iov_len)
+        {
+            ret -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0)
+        {
+            iov->iov_base = (uint8_t *)iov->iov_base + ret;
+            iov->iov_len -= ret;
+        }
+    }
+
+    return 0;
+}
+
+int dlt_daemon_send_ringbuffer_to_client(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
+{
+    static struct iovec iov[DLT_DAEMON_SEND_IOV_MAX];
+    static struct iovec iov_fd[DLT_DAEMON_SEND_IOV_MAX];
+    int j, k, third_value;
+    int iovcnt, count;
+
     PRINT_FUNCTION_VERBOSE(verbose);
 
     if ((daemon==0)  || (daemon_local==0))
@@ -2275,58 +2396,846 @@ int dlt_daemon_send_ringbuffer_to_client(DltDaemon *daemon, DltDaemonLocal *daem
         return -1;
     }
 
+    /* except the listener and ourselves */
+    if (daemon_local->flags.yvalue[0])
+    {
+        third_value = daemon_local->fdserial;
+    }
+    else
+    {
+        third_value = daemon_local->sock;
+    }
+
 	/* Attention: If the message can't be send at this time, it will be silently discarded. */
-    while ((length = dlt_buffer_pull(&(daemon->client_ringbuffer), data, sizeof(data) )) > 0)
+    while (1)
     {
-        /* look if TCP connection to client is available */
+        /* Describe the buffered messages under the lock, but write them after releasing it,
+           so a slow client does not block the threads storing messages meanwhile.
+           Entries are only removed here, so the described data stays valid;
+           new messages are appended behind it. */
+        DLT_DAEMON_SEM_LOCK();
+        iovcnt = dlt_segmented_buffer_iov(&(daemon->client_ringbuffer), iov, DLT_DAEMON_SEND_IOV_MAX,
+                                          daemon_local->flags.lflag ? dltSerialHeader : 0, sizeof(dltSerialHeader), &count);
+        DLT_DAEMON_SEM_FREE();
+
+        if (iovcnt <= 0)
+        {
+            break;
+        }
+
+        /* send the whole batch to everyone with one system call */
         for (j = 0; j <= daemon_local->fdmax; j++)
         {
-            /* send to everyone! */
             if (FD_ISSET(j, &(daemon_local->master)))
             {
-                /* except the listener and ourselves */
-                if (daemon_local->flags.yvalue[0])
-                {
-                    third_value = daemon_local->fdserial;
-                }
-                else
-                {
-                    third_value = daemon_local->sock;
-                }
-
                 if ((j != daemon_local->fp) && (j != daemon_local->sock) && (j != third_value))
                 {
-                    DLT_DAEMON_SEM_LOCK();
-
-                    if (daemon_local->flags.lflag)
+                    /* vector is modified on partial writes */
+                    memcpy(iov_fd, iov, iovcnt * sizeof(struct iovec));
+                    if (dlt_daemon_writev_all(j, iov_fd, iovcnt) < 0)
                     {
-                        send(j,dltSerialHeader,sizeof(dltSerialHeader),0);
+                        /* part of the batch may be written already, the client cannot find the next message anymore */
+                        sprintf(str,"Writing to client failed: %s\n", strerror(errno));
+                        dlt_log(LOG_ERR, str);
+                        dlt_daemon_close_client_connection(daemon, daemon_local, j, verbose);
                     }
-                    send(j,data,length,0);
-
-                    DLT_DAEMON_SEM_FREE();
-
-                } /* if */
+                }
                 else if ((j == daemon_local->fdserial) && (daemon_local->flags.yvalue[0]))
                 {
-                    DLT_DAEMON_SEM_LOCK();
-
-                    if (daemon_local->flags.lflag)
+                    /* queued and written in frames like forwarded messages, the queue adds the serial header itself */
+                    for (k = 0; k < iovcnt; k++)
                     {
-                        ret=write(j,dltSerialHeader,sizeof(dltSerialHeader));
+                        if (iov[k].iov_base != dltSerialHeader)
+                        {
+                            dlt_daemon_serial_push_buffer(daemon, daemon_local, iov[k].iov_base, iov[k].iov_len, verbose);
+                        }
                     }
-                    ret=write(j,data,length);
-
-                    DLT_DAEMON_SEM_FREE();
                 }
             } /* if */
         } /* for */
-        length = sizeof(data);
+
+        DLT_DAEMON_SEM_LOCK();
+        dlt_segmented_buffer_remove(&(daemon->client_ringbuffer), count);
+        DLT_DAEMON_SEM_FREE();
+    }
+
+    return 0;
+}
+
+int dlt_daemon_send_statistics(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
+{
+    int j, third_value;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0)  || (daemon_local==0))
+    {
+    	dlt_log(LOG_ERR, "Invalid function parameters used for function dlt_daemon_send_statistics()\n");
+        return -1;
+    }
+
+    /* except the listener and ourselves, and the serial device */
+    if (daemon_local->flags.yvalue[0])
+    {
+        third_value = daemon_local->fdserial;
+    }
+    else
+    {
+        third_value = daemon_local->sock;
+    }
+
+    /* statistics are only sent to connected clients, they are not buffered */
+    for (j = 0; j <= daemon_local->fdmax; j++)
+    {
+        /* send to everyone! */
+        if (FD_ISSET(j, &(daemon_local->master)))
+        {
+            if ((j != daemon_local->fp) && (j != daemon_local->sock) && (j != third_value))
+            {
+                dlt_daemon_control_send_statistics(j, daemon, DLT_STATISTICS_OPTION_APPLICATIONS, "", DLT_DAEMON_STAT_CTID, verbose);
+            }
+        }
     }
 
     return 0;
 }
 
+DltDaemonStatisticsResult dlt_daemon_forward_message(DltDaemon *daemon, DltDaemonLocal *daemon_local, DltMessage *msg, int verbose)
+{
+    int j,sent,third_value;
+    DltDaemonStatisticsResult result;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    sent=0;
+
+    /* write message to offline trace */
+    if(((daemon->mode == DLT_USER_MODE_INTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) && dlt_daemon_offline_trace_enabled(daemon_local))
+    {
+        if (dlt_daemon_offline_trace_write(daemon_local,msg,verbose))
+        {
+            sent = 1;
+        }
+    }
+
+    /* look if TCP connection to client is available */
+    for (j = 0;((daemon->mode == DLT_USER_MODE_EXTERNAL) || (daemon->mode == DLT_USER_MODE_BOTH)) &&  (j <= daemon_local->fdmax); j++)
+    {
+        /* send to everyone! */
+        if (FD_ISSET(j, &(daemon_local->master)))
+        {
+            /* except the listener and ourselves */
+            if (daemon_local->flags.yvalue[0])
+            {
+                third_value = daemon_local->fdserial;
+            }
+            else
+            {
+                third_value = daemon_local->sock;
+            }
+
+            if ((j != daemon_local->fp) && (j != daemon_local->sock) && (j != third_value))
+            {
+                DLT_DAEMON_SEM_LOCK();
+
+                if (daemon_local->flags.lflag)
+                {
+                    send(j,dltSerialHeader,sizeof(dltSerialHeader),0);
+                }
+
+                send(j,msg->headerbuffer+sizeof(DltStorageHeader),msg->headersize-sizeof(DltStorageHeader),0);
+                send(j,msg->databuffer,msg->datasize,0);
+
+                DLT_DAEMON_SEM_FREE();
+
+                sent=1;
+            } /* if */
+            else if ((j == daemon_local->fdserial) && (daemon_local->flags.yvalue!=0))
+            {
+                /* queued and written in frames, dropped if the serial link is saturated */
+                dlt_daemon_serial_push(daemon, daemon_local, msg, verbose);
+
+                sent=1;
+            }
+        } /* if */
+    } /* for */
+
+    result = DLT_DAEMON_STATISTICS_FORWARDED;
+
+    /* Message was not sent to client, so store it in client ringbuffer */
+    if (sent==0)
+    {
+        result = DLT_DAEMON_STATISTICS_BUFFERED;
+        DLT_DAEMON_SEM_LOCK();
+        if (dlt_segmented_buffer_push3(&(daemon->client_ringbuffer),
+                            msg->headerbuffer+sizeof(DltStorageHeader),msg->headersize-sizeof(DltStorageHeader),
+                            msg->databuffer,msg->datasize,
+                            0, 0
+                           )<0)
+        {
+            dlt_log(LOG_ERR,"Storage of message in history buffer failed! Message discarded.\n");
+            result = DLT_DAEMON_STATISTICS_DROPPED;
+        }
+        DLT_DAEMON_SEM_FREE();
+    }
+
+    return result;
+}
+
+int dlt_daemon_repeat_check(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
+{
+    DltDaemonContext *context;
+    uint32_t repeated;
+    uint8_t msin;
+    int ret;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (daemon_local==0) || (daemon_local->flags.repeatFilterWindow <= 0) ||
+        (daemon_local->msg.extendedheader==0))
+    {
+        return 0;
+    }
+
+    context = dlt_daemon_context_find(daemon, daemon_local->msg.extendedheader->apid, daemon_local->msg.extendedheader->ctid, verbose);
+    if (context==0)
+    {
+        return 0;
+    }
+
+    /* message info of repeated message is replaced, if a different message is received */
+    msin = context->repeat.msin;
+
+    ret = dlt_daemon_repeat_filter(context, &(daemon_local->msg), daemon_local->flags.repeatFilterWindow * 10,
+                                   daemon_local->flags.repeatFilterMaxCount, &repeated);
+    if (repeated > 0)
+    {
+        dlt_daemon_send_repeat_summary(daemon, daemon_local, context, ret==1 ? context->repeat.msin : msin, repeated, verbose);
+    }
+
+    return (ret==1);
+}
+
+int dlt_daemon_repeat_flush(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
+{
+    uint32_t repeated;
+    int i;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0)  || (daemon_local==0))
+    {
+    	dlt_log(LOG_ERR, "Invalid function parameters used for function dlt_daemon_repeat_flush()\n");
+        return -1;
+    }
+
+    for (i = 0; i < daemon->num_contexts; i++)
+    {
+        repeated = dlt_daemon_repeat_expired(&(daemon->contexts[i]), daemon_local->flags.repeatFilterWindow * 10);
+        if (repeated > 0)
+        {
+            dlt_daemon_send_repeat_summary(daemon, daemon_local, &(daemon->contexts[i]), daemon->contexts[i].repeat.msin, repeated, verbose);
+        }
+    }
+
+    return 0;
+}
+
+int dlt_daemon_send_repeat_summary(DltDaemon *daemon, DltDaemonLocal *daemon_local, DltDaemonContext *context, uint8_t msin, uint32_t repeated, int verbose)
+{
+    DltMessage msg;
+    uint32_t type_info;
+    uint16_t len;
+    int offset;
+    static const char text[] = DLT_DAEMON_REPEAT_TEXT;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (daemon_local==0) || (context==0))
+    {
+    	dlt_log(LOG_ERR, "Invalid function parameters used for function dlt_daemon_send_repeat_summary()\n");
+        return -1;
+    }
+
+    if (dlt_message_init(&msg,verbose)==-1)
+    {
+    	return -1;
+    }
+
+    /* prepare payload: string and number of repetitions */
+    msg.datasize = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(text) + sizeof(uint32_t) + sizeof(uint32_t);
+    msg.databuffer = (uint8_t *) malloc(msg.datasize);
+    if (msg.databuffer==0)
+    {
+    	dlt_log(LOG_ERR,"Can't allocate buffer for repeat summary\n");
+    	return -1;
+    }
+
+    offset = 0;
+    type_info = DLT_TYPE_INFO_STRG | DLT_SCOD_ASCII;
+    memcpy(msg.databuffer+offset, &type_info, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    len = sizeof(text);
+    memcpy(msg.databuffer+offset, &len, sizeof(uint16_t));
+    offset += sizeof(uint16_t);
+    memcpy(msg.databuffer+offset, text, sizeof(text));
+    offset += sizeof(text);
+    type_info = DLT_TYPE_INFO_UINT | DLT_TYLE_32BIT;
+    memcpy(msg.databuffer+offset, &type_info, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    memcpy(msg.databuffer+offset, &repeated, sizeof(uint32_t));
+
+    /* prepare storage header */
+    msg.storageheader = (DltStorageHeader*)msg.headerbuffer;
+    dlt_set_storageheader(msg.storageheader,daemon->ecuid);
+
+    /* prepare standard header */
+    msg.standardheader = (DltStandardHeader*)(msg.headerbuffer + sizeof(DltStorageHeader));
+    msg.standardheader->htyp = DLT_HTYP_WEID | DLT_HTYP_WTMS | DLT_HTYP_UEH | DLT_HTYP_PROTOCOL_VERSION1 ;
+
+#if (BYTE_ORDER==BIG_ENDIAN)
+    msg.standardheader->htyp = ( msg.standardheader->htyp | DLT_HTYP_MSBF);
+#endif
+
+    msg.standardheader->mcnt = 0;
+
+    /* Set header extra parameters */
+    dlt_set_id(msg.headerextra.ecu,daemon->ecuid);
+    msg.headerextra.tmsp = dlt_uptime();
+
+    dlt_message_set_extraparameters(&msg, verbose);
+
+    /* prepare extended header, same message type and context as repeated message */
+    msg.extendedheader = (DltExtendedHeader*)(msg.headerbuffer + sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(msg.standardheader->htyp));
+    msg.extendedheader->msin = (msin & (DLT_MSIN_MSTP | DLT_MSIN_MTIN)) | DLT_MSIN_VERB;
+    msg.extendedheader->noar = 2;
+    dlt_set_id(msg.extendedheader->apid, context->apid);
+    dlt_set_id(msg.extendedheader->ctid, context->ctid);
+
+    /* prepare length information */
+    msg.headersize = sizeof(DltStorageHeader) + sizeof(DltStandardHeader) + sizeof(DltExtendedHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(msg.standardheader->htyp);
+    msg.standardheader->len = DLT_HTOBE_16(((uint16_t)(msg.headersize - sizeof(DltStorageHeader) + msg.datasize)));
+
+    dlt_daemon_forward_message(daemon, daemon_local, &msg, verbose);
+
+    dlt_message_free(&msg,verbose);
+
+    return 0;
+}
+
+int dlt_daemon_serial_init(DltDaemonLocal *daemon_local, int verbose)
+{
+    DltDaemonSerialEgress *serial;
+    unsigned char *ptr;
+    int size, prio;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if (daemon_local==0)
+    {
+    	dlt_log(LOG_ERR, "Invalid function parameters used for function dlt_daemon_serial_init()\n");
+        return -1;
+    }
+
+    serial = &(daemon_local->serial);
+    memset(serial, 0, sizeof(DltDaemonSerialEgress));
+
+    serial->frame_size = daemon_local->flags.serialFrameSize;
+    if (serial->frame_size <= 0)
+    {
+        serial->frame_size = DLT_DAEMON_SERIAL_FRAME_SIZE;
+    }
+
+    /* the frame buffer must hold at least one message of maximum size */
+    size = sizeof(dltSerialHeader) + UINT16_MAX;
+    if (serial->frame_size > size)
+    {
+        size = serial->frame_size;
+    }
+    serial->frame = malloc(size);
+    if (serial->frame==0)
+    {
+        dlt_log(LOG_ERR, "Cannot allocate frame buffer for serial device\n");
+        return -1;
+    }
+
+    /* each queue must hold at least one message of maximum size */
+    size = daemon_local->flags.serialQueueSize;
+    if (size < (int)(sizeof(DltBufferHead) + sizeof(DltBufferBlockHead) + sizeof(dltSerialHeader) + UINT16_MAX))
+    {
+        size = sizeof(DltBufferHead) + sizeof(DltBufferBlockHead) + sizeof(dltSerialHeader) + UINT16_MAX;
+    }
+    for (prio = 0; prio < 2; prio++)
+    {
+        ptr = malloc(size);
+        if (ptr==0)
+        {
+            dlt_log(LOG_ERR, "Cannot allocate queue for serial device\n");
+            dlt_daemon_serial_free(daemon_local, verbose);
+            return -1;
+        }
+        dlt_buffer_init_static_server(&(serial->queue[prio]), ptr, size);
+    }
+
+    if (daemon_local->flags.bvalue[0])
+    {
+        serial->bits_per_second = atoi(daemon_local->flags.bvalue);
+    }
+    else
+    {
+        serial->bits_per_second = DLT_DAEMON_SERIAL_DEFAULT_BAUDRATE;
+    }
+    serial->report_time = dlt_uptime();
+
+    return 0;
+}
+
+void dlt_daemon_serial_free(DltDaemonLocal *daemon_local, int verbose)
+{
+    DltDaemonSerialEgress *serial;
+    int prio;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if (daemon_local==0)
+    {
+        return;
+    }
+
+    serial = &(daemon_local->serial);
+    for (prio = 0; prio < 2; prio++)
+    {
+        if (serial->queue[prio].shm)
+        {
+            dlt_buffer_free_static(&(serial->queue[prio]));
+            free(serial->queue[prio].shm);
+            serial->queue[prio].shm = 0;
+            serial->queue[prio].mem = 0;
+        }
+    }
+    free(serial->frame);
+    serial->frame = 0;
+}
+
+/* header points to the standard header, header and data together form one message */
+static int dlt_daemon_serial_queue(DltDaemon *daemon, DltDaemonLocal *daemon_local, const unsigned char *header, int headersize,
+                                   const unsigned char *data, int datasize, int verbose)
+{
+    DltDaemonSerialEgress *serial;
+    DltBuffer *queue;
+    DltStandardHeader *standardheader;
+    DltExtendedHeader *extendedheader;
+    int prio, size;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    serial = &(daemon_local->serial);
+    standardheader = (DltStandardHeader *)header;
+
+    /* log messages above the priority level are sent with low priority, all other messages with high priority */
+    prio = 0;
+    if (DLT_IS_HTYP_UEH(standardheader->htyp) &&
+        (headersize >= (int)(sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp) + sizeof(DltExtendedHeader))))
+    {
+        extendedheader = (DltExtendedHeader *)(header + sizeof(DltStandardHeader) + DLT_STANDARD_HEADER_EXTRA_SIZE(standardheader->htyp));
+        if ((DLT_GET_MSIN_MSTP(extendedheader->msin) == DLT_TYPE_LOG) &&
+            ((int)DLT_GET_MSIN_MTIN(extendedheader->msin) > daemon_local->flags.serialPriorityLevel))
+        {
+            prio = 1;
+        }
+    }
+    queue = &(serial->queue[prio]);
+
+    size = sizeof(DltBufferBlockHead) + (daemon_local->flags.lflag ? sizeof(dltSerialHeader) : 0) +
+           headersize + datasize;
+
+    /* write out queued messages, if the queue is filled up faster than frames are written */
+    if ((queue->size - dlt_buffer_get_used_size(queue) < size) ||
+        (dlt_buffer_get_used_size(queue) >= serial->frame_size))
+    {
+        dlt_daemon_serial_flush(daemon, daemon_local, verbose);
+    }
+
+    /* the serial link is saturated, drop message */
+    if (queue->size - dlt_buffer_get_used_size(queue) < size)
+    {
+        serial->dropped[prio]++;
+        return -1;
+    }
+
+    return dlt_buffer_push3(queue,
+                            daemon_local->flags.lflag ? (const unsigned char *)dltSerialHeader : 0,
+                            daemon_local->flags.lflag ? sizeof(dltSerialHeader) : 0,
+                            header, headersize,
+                            data, datasize);
+}
+
+int dlt_daemon_serial_push(DltDaemon *daemon, DltDaemonLocal *daemon_local, DltMessage *msg, int verbose)
+{
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (daemon_local==0) || (msg==0) || (daemon_local->serial.frame==0))
+    {
+        return -1;
+    }
+
+    return dlt_daemon_serial_queue(daemon, daemon_local,
+                                   msg->headerbuffer+sizeof(DltStorageHeader), msg->headersize-sizeof(DltStorageHeader),
+                                   msg->databuffer, msg->datasize, verbose);
+}
+
+int dlt_daemon_serial_push_buffer(DltDaemon *daemon, DltDaemonLocal *daemon_local, const unsigned char *buffer, int size, int verbose)
+{
+    int length, ret;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (daemon_local==0) || (buffer==0) || (daemon_local->serial.frame==0))
+    {
+        return -1;
+    }
+
+    ret = 0;
+
+    /* messages without storage header follow each other, each one starts with its standard header */
+    while (size >= (int)sizeof(DltStandardHeader))
+    {
+        length = DLT_BETOH_16(((DltStandardHeader *)buffer)->len);
+        if ((length < (int)sizeof(DltStandardHeader)) || (length > size))
+        {
+            return -1;
+        }
+        if (dlt_daemon_serial_queue(daemon, daemon_local, buffer, length, 0, 0, verbose) < 0)
+        {
+            ret = -1;
+        }
+        buffer += length;
+        size -= length;
+    }
+
+    return ret;
+}
+
+int dlt_daemon_serial_pending(DltDaemon *daemon, DltDaemonLocal *daemon_local)
+{
+    if ((daemon==0) || (daemon_local==0) || (daemon_local->serial.frame==0))
+    {
+        return 0;
+    }
+
+    return (daemon->serial_pending_size > 0) ||
+           (dlt_buffer_get_message_count(&(daemon_local->serial.queue[0])) > 0) ||
+           (dlt_buffer_get_message_count(&(daemon_local->serial.queue[1])) > 0);
+}
+
+int dlt_daemon_serial_flush(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose)
+{
+    DltDaemonSerialEgress *serial;
+    ssize_t ret;
+    int prio, size, length, count, full;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (daemon_local==0))
+    {
+        return -1;
+    }
+
+    serial = &(daemon_local->serial);
+
+    /* the device is opened non-blocking, the daemon never waits for it;
+       control messages written meanwhile complete a partly written frame first */
+    DLT_DAEMON_SEM_LOCK();
+    while (1)
+    {
+        if (daemon->serial_pending_size == 0)
+        {
+            if ((dlt_buffer_get_message_count(&(serial->queue[0])) == 0) &&
+                (dlt_buffer_get_message_count(&(serial->queue[1])) == 0))
+            {
+                break;
+            }
+
+            /* fill frame with complete messages, high priority first */
+            length = 0;
+            count = 0;
+            full = 0;
+            for (prio = 0; (prio < 2) && !full; prio++)
+            {
+                while (dlt_buffer_get_message_count(&(serial->queue[prio])) > 0)
+                {
+                    size = dlt_buffer_copy(&(serial->queue[prio]), 0, 0);
+                    if ((size <= 0) || ((length > 0) && (length + size > serial->frame_size)))
+                    {
+                        full = 1;
+                        break;
+                    }
+                    dlt_buffer_pull(&(serial->queue[prio]), serial->frame + length, size);
+                    length += size;
+                    count++;
+                }
+            }
+
+            daemon->serial_pending = serial->frame;
+            daemon->serial_pending_size = length;
+            serial->bytes += length;
+            serial->frames++;
+            serial->messages += count;
+        }
+
+        /* write the frame with one system call */
+        ret = write(daemon_local->fdserial, daemon->serial_pending, daemon->serial_pending_size);
+        if (ret < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                /* the rest of the frame is written when the device accepts data again */
+                break;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            daemon->serial_pending_size = 0;
+            DLT_DAEMON_SEM_FREE();
+            sprintf(str,"Writing to serial device failed: %s\n", strerror(errno));
+            dlt_log(LOG_ERR, str);
+
+            /* discard queued messages, the device does not accept data anymore */
+            for (prio = 0; prio < 2; prio++)
+            {
+                while (dlt_buffer_remove(&(serial->queue[prio])) >= 0)
+                {
+                    serial->dropped[prio]++;
+                }
+            }
+            return -1;
+        }
+        daemon->serial_pending += ret;
+        daemon->serial_pending_size -= ret;
+    }
+    DLT_DAEMON_SEM_FREE();
+
+    return 0;
+}
+
+void dlt_daemon_serial_report(DltDaemonLocal *daemon_local, int verbose)
+{
+    DltDaemonSerialEgress *serial;
+    uint32_t now, elapsed;
+    uint64_t capacity;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon_local==0) || (daemon_local->serial.frame==0))
+    {
+        return;
+    }
+
+    serial = &(daemon_local->serial);
+    now = dlt_uptime();
+    elapsed = now - serial->report_time;
+
+    /* one byte takes ten bits on the line, uptime is counted in 0.1 milliseconds */
+    capacity = (uint64_t)serial->bits_per_second * elapsed / 100000;
+
+    snprintf(str, DLT_DAEMON_TEXTBUFSIZE,
+             "Serial device: utilisation %u%%, %u bytes, %u frames, %u messages, dropped %u high and %u low priority, queued %d bytes\n",
+             capacity ? (unsigned int)((uint64_t)serial->bytes * 100 / capacity) : 0,
+             serial->bytes, serial->frames, serial->messages, serial->dropped[0], serial->dropped[1],
+             dlt_buffer_get_used_size(&(serial->queue[0])) + dlt_buffer_get_used_size(&(serial->queue[1])));
+    dlt_log(LOG_INFO, str);
+
+    serial->bytes = 0;
+    serial->frames = 0;
+    serial->messages = 0;
+    serial->dropped[0] = 0;
+    serial->dropped[1] = 0;
+    serial->report_time = now;
+}
+
+int dlt_daemon_offline_trace_sink_option(DltDaemonLocal *daemon_local, const char *token, const char *value)
+{
+    DltDaemonOfflineTraceSinkConfig *config;
+    char *key;
+    long index;
+
+    /* option name is OfflineTraceSink<n><Key>, n starts with 1 */
+    index = strtol(token, &key, 10);
+    if ((key == token) || (index < 1) || (index > DLT_DAEMON_OFFLINE_TRACE_SINKS))
+    {
+        return -1;
+    }
+    config = &(daemon_local->flags.offlineTraceSinks[index - 1]);
+
+    if (strcmp(key, "Directory")==0)
+    {
+        strncpy(config->directory, value, sizeof(config->directory) - 1);
+    }
+    else if (strcmp(key, "FileSize")==0)
+    {
+        config->fileSize = atoi(value);
+    }
+    else if (strcmp(key, "MaxSize")==0)
+    {
+        config->maxSize = atoi(value);
+    }
+    else if (strcmp(key, "LogLevel")==0)
+    {
+        config->logLevel = atoi(value);
+    }
+    else if (strcmp(key, "ApplicationId")==0)
+    {
+        dlt_set_id(config->apid, value);
+    }
+    else if (strcmp(key, "ContextId")==0)
+    {
+        dlt_set_id(config->ctid, value);
+    }
+    else
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+int dlt_daemon_offline_trace_init(DltDaemonLocal *daemon_local, int verbose)
+{
+    DltDaemonOfflineTraceSinkConfig *config;
+    DltDaemonOfflineTraceSink *sink;
+    int i, level;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if (daemon_local==0)
+    {
+    	dlt_log(LOG_ERR, "Invalid function parameters used for function dlt_daemon_offline_trace_init()\n");
+        return -1;
+    }
+
+    if (daemon_local->flags.offlineTraceDirectory[0])
+    {
+        if (dlt_offline_trace_init(&(daemon_local->offlineTrace),daemon_local->flags.offlineTraceDirectory,daemon_local->flags.offlineTraceFileSize,daemon_local->flags.offlineTraceMaxSize)==-1)
+        {
+            return -1;
+        }
+    }
+
+    /* compile filters, so routing of a message is decided by comparing integers only */
+    daemon_local->offlineTraceSinkCount = 0;
+    for (i = 0; i < DLT_DAEMON_OFFLINE_TRACE_SINKS; i++)
+    {
+        config = &(daemon_local->flags.offlineTraceSinks[i]);
+        if (config->directory[0] == 0)
+        {
+            continue;
+        }
+
+        sink = &(daemon_local->offlineTraceSinks[daemon_local->offlineTraceSinkCount]);
+        memset(sink, 0, sizeof(DltDaemonOfflineTraceSink));
+
+        if (config->logLevel > 0)
+        {
+            for (level = 1; (level <= config->logLevel) && (level < 32); level++)
+            {
+                sink->types |= (1 << level);
+            }
+        }
+        else
+        {
+            sink->types = 0xffffffff;
+        }
+        memcpy(&(sink->apid), config->apid, DLT_ID_SIZE);
+        memcpy(&(sink->ctid), config->ctid, DLT_ID_SIZE);
+
+        if (dlt_offline_trace_init(&(sink->trace), config->directory, config->fileSize, config->maxSize)==-1)
+        {
+            sprintf(str,"Could not initialize offline trace in %s\n", config->directory);
+            dlt_log(LOG_ERR, str);
+            return -1;
+        }
+        daemon_local->offlineTraceSinkCount++;
+    }
+
+    return 0;
+}
+
+void dlt_daemon_offline_trace_free(DltDaemonLocal *daemon_local, int verbose)
+{
+    int i;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if (daemon_local==0)
+    {
+        return;
+    }
+
+    if (daemon_local->flags.offlineTraceDirectory[0])
+    {
+        dlt_offline_trace_free(&(daemon_local->offlineTrace));
+    }
+
+    for (i = 0; i < daemon_local->offlineTraceSinkCount; i++)
+    {
+        dlt_offline_trace_free(&(daemon_local->offlineTraceSinks[i].trace));
+    }
+    daemon_local->offlineTraceSinkCount = 0;
+}
+
+int dlt_daemon_offline_trace_enabled(DltDaemonLocal *daemon_local)
+{
+    return (daemon_local->flags.offlineTraceDirectory[0] || (daemon_local->offlineTraceSinkCount > 0));
+}
+
+int dlt_daemon_offline_trace_write(DltDaemonLocal *daemon_local, DltMessage *msg, int verbose)
+{
+    DltDaemonOfflineTraceSink *sink;
+    uint32_t type = 1, apid = 0, ctid = 0;
+    int i, written = 0;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    /* the unfiltered offline trace stores all messages */
+    if (daemon_local->flags.offlineTraceDirectory[0])
+    {
+        dlt_offline_trace_write(&(daemon_local->offlineTrace),msg->headerbuffer,msg->headersize,
+                                msg->databuffer,msg->datasize,0,0);
+        written = 1;
+    }
+
+    if (daemon_local->offlineTraceSinkCount == 0)
+    {
+        return written;
+    }
+
+    /* key of message for all filters */
+    if (DLT_IS_HTYP_UEH(msg->standardheader->htyp) && msg->extendedheader)
+    {
+        if (DLT_GET_MSIN_MSTP(msg->extendedheader->msin) == DLT_TYPE_LOG)
+        {
+            type = 1 << DLT_GET_MSIN_MTIN(msg->extendedheader->msin);
+        }
+        memcpy(&apid, msg->extendedheader->apid, DLT_ID_SIZE);
+        memcpy(&ctid, msg->extendedheader->ctid, DLT_ID_SIZE);
+    }
+
+    for (i = 0; i < daemon_local->offlineTraceSinkCount; i++)
+    {
+        sink = &(daemon_local->offlineTraceSinks[i]);
+        if ((sink->types & type) && ((sink->apid == 0) || (sink->apid == apid)) &&
+            ((sink->ctid == 0) || (sink->ctid == ctid)))
+        {
+            dlt_offline_trace_write(&(sink->trace),msg->headerbuffer,msg->headersize,
+                                    msg->databuffer,msg->datasize,0,0);
+            written = 1;
+        }
+    }
+
+    return written;
+}
+
 void dlt_daemon_timingpacket_thread(void *ptr)
 {
     DltDaemonPeriodicData info;
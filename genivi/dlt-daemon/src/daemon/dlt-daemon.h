@@ -71,6 +71,21 @@
 
 #include <dlt_offline_trace.h>
 
+#include "dlt-daemon_cfg.h"
+
+/**
+ * The configuration of an additional offline trace, which stores filtered messages only.
+ */
+typedef struct
+{
+    char directory[256];     /**< (String: Directory) Store matching DLT messages to local directory (Default: off) */
+    int  fileSize;           /**< (int) Maximum size in bytes of one trace file (Default: 1000000) */
+    int  maxSize;            /**< (int) Maximum size of all trace files (Default: 4000000) */
+    int  logLevel;           /**< (int) Store only log messages up to this log level, 0 stores all messages (Default: 0) */
+    char apid[DLT_ID_SIZE];  /**< (String: Application ID) Store only messages of this application (Default: all) */
+    char ctid[DLT_ID_SIZE];  /**< (String: Context ID) Store only messages of this context (Default: all) */
+} DltDaemonOfflineTraceSinkConfig;
+
 /**
  * The flags of a dlt daemon.
  */
@@ -92,9 +107,16 @@ typedef struct
     char cvalue[256];   /**< (String: Directory) Filename of DLT configuration file (Default: /etc/dlt.conf) */
     int  sharedMemorySize;	   /**< (int) Size of shared memory (Default: 100000) */
     int  sendMessageTime;	   /**< (Boolean) Send periodic Message Time if client is connected (Default: 0) */
+    int  statisticsInterval;	/**< (int) Interval in seconds of periodic statistics message if client is connected, 0 is off (Default: 0) */
+    int  repeatFilterWindow;	/**< (int) Time in milliseconds in which identical messages of a context are counted instead of forwarded, 0 is off (Default: 0) */
+    int  repeatFilterMaxCount;	/**< (int) Maximum number of repetitions reported by one message (Default: 1000) */
+    int  serialFrameSize;	/**< (int) Maximum size in bytes of one frame written to serial device (Default: 1024) */
+    int  serialQueueSize;	/**< (int) Maximum size in bytes of each priority queue of serial device (Default: 65536) */
+    int  serialPriorityLevel;	/**< (int) Highest log level sent with high priority to serial device (Default: 3) */
     char offlineTraceDirectory[256]; /**< (String: Directory) Store DLT messages to local directory (Default: /etc/dlt.conf) */
     int  offlineTraceFileSize;	/**< (int) Maximum size in bytes of one trace file (Default: 1000000) */
     int  offlineTraceMaxSize;	/**< (int) Maximum size of all trace files (Default: 4000000) */
+    DltDaemonOfflineTraceSinkConfig offlineTraceSinks[DLT_DAEMON_OFFLINE_TRACE_SINKS]; /**< Additional offline traces with filter */
     int  loggingMode;	/**< (int) The logging console for internal logging of dlt-daemon (Default: 0) */
     int  loggingLevel;	/**< (int) The logging level for internal logging of dlt-daemon (Default: 6) */
     char loggingFilename[256]; /**< (String: Filename) The logging filename if internal logging mode is log to file (Default: /tmp/log) */
@@ -102,6 +124,34 @@ typedef struct
     char pathToECUSoftwareVersion[256];
 } DltDaemonFlags;
 
+/**
+ * The egress of log messages to the serial device.
+ * Messages are queued by priority and written in frames of several messages.
+ */
+typedef struct
+{
+    DltBuffer queue[2];          /**< queued messages, high and low priority */
+    unsigned char *frame;        /**< buffer for one frame, a partly written frame is kept in DltDaemon.serial_pending */
+    int frame_size;              /**< maximum size of one frame */
+    uint32_t bits_per_second;    /**< baudrate of serial device */
+    uint32_t bytes;              /**< bytes written since last report */
+    uint32_t frames;             /**< frames written since last report */
+    uint32_t messages;           /**< messages written since last report */
+    uint32_t dropped[2];         /**< messages dropped since last report, high and low priority */
+    uint32_t report_time;        /**< time of last report */
+} DltDaemonSerialEgress;
+
+/**
+ * An additional offline trace with its compiled filter.
+ */
+typedef struct
+{
+    DltOfflineTrace trace;   /**< offline trace handling */
+    uint32_t types;          /**< accepted messages, bit n for log level n, bit 0 for all other messages */
+    uint32_t apid;           /**< accepted application id, 0 accepts all */
+    uint32_t ctid;           /**< accepted context id, 0 accepts all */
+} DltDaemonOfflineTraceSink;
+
 /**
  * The global parameters of a dlt daemon.
  */
@@ -122,10 +172,14 @@ typedef struct
     DltReceiver receiverSerial; /**< receiver for serial connection */
     int client_connections;    /**< counter for nr. of client connections */
     size_t baudrate;          /**< Baudrate of serial connection */
+    DltDaemonSerialEgress serial; /**< Egress queues of serial connection */
 #ifdef DLT_SHM_ENABLE
     DltShm dlt_shm;				/**< Shared memory handling */
 #endif
     DltOfflineTrace offlineTrace; /**< Offline trace handling */
+    DltStorageHeaderCache storageHeaderCache; /**< Pre-encoded storage header of received messages */
+    DltDaemonOfflineTraceSink offlineTraceSinks[DLT_DAEMON_OFFLINE_TRACE_SINKS]; /**< Additional offline traces with filter */
+    int offlineTraceSinkCount;    /**< Number of used additional offline traces */
 } DltDaemonLocal;
 
 typedef struct
@@ -152,6 +206,7 @@ void dlt_daemon_daemonize(int verbose);
 void dlt_daemon_signal_handler(int sig);
 
 int dlt_daemon_process_client_connect(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_close_client_connection(DltDaemon *daemon, DltDaemonLocal *daemon_local, int sock, int verbose);
 int dlt_daemon_process_client_messages(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
 int dlt_daemon_process_client_messages_serial(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
 int dlt_daemon_process_user_messages(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
@@ -169,6 +224,23 @@ int dlt_daemon_process_user_message_set_app_ll_ts(DltDaemon *daemon, DltDaemonLo
 int dlt_daemon_process_user_message_log_mode(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
 
 int dlt_daemon_send_ringbuffer_to_client(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_send_statistics(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
+DltDaemonStatisticsResult dlt_daemon_forward_message(DltDaemon *daemon, DltDaemonLocal *daemon_local, DltMessage *msg, int verbose);
+int dlt_daemon_repeat_check(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_repeat_flush(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_send_repeat_summary(DltDaemon *daemon, DltDaemonLocal *daemon_local, DltDaemonContext *context, uint8_t msin, uint32_t repeated, int verbose);
+int dlt_daemon_serial_init(DltDaemonLocal *daemon_local, int verbose);
+void dlt_daemon_serial_free(DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_serial_push(DltDaemon *daemon, DltDaemonLocal *daemon_local, DltMessage *msg, int verbose);
+int dlt_daemon_serial_push_buffer(DltDaemon *daemon, DltDaemonLocal *daemon_local, const unsigned char *buffer, int size, int verbose);
+int dlt_daemon_serial_pending(DltDaemon *daemon, DltDaemonLocal *daemon_local);
+int dlt_daemon_serial_flush(DltDaemon *daemon, DltDaemonLocal *daemon_local, int verbose);
+void dlt_daemon_serial_report(DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_offline_trace_sink_option(DltDaemonLocal *daemon_local, const char *token, const char *value);
+int dlt_daemon_offline_trace_init(DltDaemonLocal *daemon_local, int verbose);
+void dlt_daemon_offline_trace_free(DltDaemonLocal *daemon_local, int verbose);
+int dlt_daemon_offline_trace_enabled(DltDaemonLocal *daemon_local);
+int dlt_daemon_offline_trace_write(DltDaemonLocal *daemon_local, DltMessage *msg, int verbose);
 void dlt_daemon_timingpacket_thread(void *ptr);
 void dlt_daemon_ecu_version_thread(void *ptr);
 #if defined(DLT_SYSTEMD_WATCHDOG_ENABLE)
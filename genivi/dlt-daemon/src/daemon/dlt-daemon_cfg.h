@@ -82,6 +82,18 @@
 /* Size of receive buffer for serial connection (from dlt client) */
 #define DLT_DAEMON_RCVBUFSIZESERIAL 10024 
 
+/* Context ID used when the dlt daemon sends periodic statistics */
+#define DLT_DAEMON_STAT_CTID        "DST"
+
+/* Text of message sent instead of suppressed repetitions of a message */
+#define DLT_DAEMON_REPEAT_TEXT      "Last message repeated"
+
+/* Default maximum number of repetitions reported by one message */
+#define DLT_DAEMON_REPEAT_MAX_COUNT 1000
+
+/* Maximum number of io vector elements sent with one call when flushing the client ring buffer */
+#define DLT_DAEMON_SEND_IOV_MAX       256
+
 /* Size of buffer for text output */
 #define DLT_DAEMON_TEXTSIZE         10024
 
@@ -105,6 +117,24 @@
 /* Default baudrate for serial interface */
 #define DLT_DAEMON_SERIAL_DEFAULT_BAUDRATE 115200
 
+/* Default maximum size of one frame written to serial interface */
+#define DLT_DAEMON_SERIAL_FRAME_SIZE 1024
+
+/* Default size of each priority queue for serial interface */
+#define DLT_DAEMON_SERIAL_QUEUE_SIZE 65536
+
+/* Default highest log level sent with high priority on serial interface */
+#define DLT_DAEMON_SERIAL_PRIORITY_LEVEL 3
+
+/* Maximum number of additional offline traces with filter */
+#define DLT_DAEMON_OFFLINE_TRACE_SINKS 8
+
+/* Default maximum size in bytes of one file of an additional offline trace */
+#define DLT_DAEMON_OFFLINE_TRACE_SINK_FILE_SIZE 1000000
+
+/* Default maximum size in bytes of all files of an additional offline trace */
+#define DLT_DAEMON_OFFLINE_TRACE_SINK_MAX_SIZE 4000000
+
 /************************/
 /* Don't change please! */
 /************************/
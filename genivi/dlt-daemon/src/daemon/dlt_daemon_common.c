@@ -73,6 +73,8 @@
 
 #include <sys/types.h>  /* send() */
 #include <sys/socket.h> /* send() */
+#include <sys/ioctl.h>  /* FIONREAD */
+#include <poll.h>
 
 #include "dlt_types.h"
 #include "dlt_daemon_common.h"
@@ -169,11 +171,19 @@ int dlt_daemon_init(DltDaemon *daemon,const char *runtime_directory, int verbose
     
     daemon->sendserialheader = 0;
     daemon->timingpackets = 0;
+    daemon->serial_pending = 0;
+    daemon->serial_pending_size = 0;
 
     dlt_set_id(daemon->ecuid,"");
 
+    memset(&(daemon->statistics),0,sizeof(DltDaemonStatistics));
+    daemon->statistics.fifo = -1;
+
+    daemon->revision = 0;
+    daemon->revision_removed = 0;
+
     /* initialize ring buffer for client connection */
-    if (dlt_buffer_init_dynamic(&(daemon->client_ringbuffer), DLT_DAEMON_RINGBUFFER_MIN_SIZE,DLT_DAEMON_RINGBUFFER_MAX_SIZE,DLT_DAEMON_RINGBUFFER_STEP_SIZE)==-1)
+    if (dlt_segmented_buffer_init(&(daemon->client_ringbuffer), DLT_DAEMON_RINGBUFFER_MIN_SIZE,DLT_DAEMON_RINGBUFFER_MAX_SIZE,DLT_DAEMON_RINGBUFFER_CHUNK_SIZE)==-1)
     {
     	return -1;
     }
@@ -203,7 +213,7 @@ int dlt_daemon_free(DltDaemon *daemon,int verbose)
     }
 
 	/* free ringbuffer */
-	dlt_buffer_free_dynamic(&(daemon->client_ringbuffer));
+	dlt_segmented_buffer_free(&(daemon->client_ringbuffer));
 
     return 0;
 }
@@ -257,6 +267,7 @@ int dlt_daemon_applications_clear(DltDaemon *daemon,int verbose)
 
     daemon->applications = 0;
     daemon->num_applications = 0;
+    daemon->revision_removed = ++daemon->revision;
 
     return 0;
 }
@@ -317,6 +328,7 @@ DltDaemonApplication* dlt_daemon_application_add(DltDaemon *daemon,char *apid,pi
         application->application_description = 0;
         application->num_contexts = 0;
         application->user_handle = DLT_FD_INIT;
+        memset(&(application->statistics),0,sizeof(DltServiceStatisticsCounter));
 
         new_application = 1;
 
@@ -380,6 +392,8 @@ DltDaemonApplication* dlt_daemon_application_add(DltDaemon *daemon,char *apid,pi
         application->user_handle = dlt_user_handle;
     }
 
+    application->revision = ++daemon->revision;
+
     /* Sort */
     if (new_application)
     {
@@ -428,6 +442,7 @@ int dlt_daemon_application_del(DltDaemon *daemon, DltDaemonApplication *applicat
         memset(&(daemon->applications[daemon->num_applications-1]),0,sizeof(DltDaemonApplication));
 
         daemon->num_applications--;
+        daemon->revision_removed = ++daemon->revision;
 
     }
 
@@ -619,6 +634,9 @@ DltDaemonContext* dlt_daemon_context_add(DltDaemon *daemon,char *apid,char *ctid
         dlt_set_id(context->apid,apid);
         dlt_set_id(context->ctid,ctid);
         context->context_description = 0;
+        memset(&(context->statistics),0,sizeof(DltServiceStatisticsCounter));
+        memset(&(context->repeat),0,sizeof(DltDaemonRepeatFilter));
+        context->repeat.datasize = -1;
 
         application->num_contexts++;
         new_context =1;
@@ -655,6 +673,7 @@ DltDaemonContext* dlt_daemon_context_add(DltDaemon *daemon,char *apid,char *ctid
 
     context->log_level_pos = log_level_pos;
     context->user_handle = user_handle;
+    context->revision = ++daemon->revision;
 
     /* Sort */
     if (new_context)
@@ -691,6 +710,12 @@ int dlt_daemon_context_del(DltDaemon *daemon, DltDaemonContext* context, int ver
             context->context_description = 0;
         }
 
+        if (context->repeat.data)
+        {
+            free(context->repeat.data);
+            context->repeat.data = 0;
+        }
+
         pos = context-(daemon->contexts);
 
         /* move all contexts above pos to pos */
@@ -700,6 +725,7 @@ int dlt_daemon_context_del(DltDaemon *daemon, DltDaemonContext* context, int ver
         memset(&(daemon->contexts[daemon->num_contexts-1]),0,sizeof(DltDaemonContext));
 
         daemon->num_contexts--;
+        daemon->revision_removed = ++daemon->revision;
 
         /* Check if application [apid] is available */
         if (application)
@@ -775,6 +801,12 @@ int dlt_daemon_contexts_clear(DltDaemon *daemon,int verbose)
             free(daemon->contexts[i].context_description);
             daemon->contexts[i].context_description = 0;
         }
+
+        if (daemon->contexts[i].repeat.data!=0)
+        {
+            free(daemon->contexts[i].repeat.data);
+            daemon->contexts[i].repeat.data = 0;
+        }
     }
 
     if (daemon->contexts)
@@ -790,6 +822,7 @@ int dlt_daemon_contexts_clear(DltDaemon *daemon,int verbose)
     }
 
     daemon->num_contexts = 0;
+    daemon->revision_removed = ++daemon->revision;
 
     return 0;
 }
@@ -1010,6 +1043,9 @@ int dlt_daemon_user_send_log_level(DltDaemon *daemon,DltDaemonContext *context,i
         return -1;
     }
 
+    /* log level or trace status of context was changed */
+    context->revision = ++daemon->revision;
+
     if (dlt_user_set_userheader(&userheader, DLT_USER_MESSAGE_LOG_LEVEL)==-1)
     {
     	return -1;
@@ -1223,6 +1259,18 @@ int dlt_daemon_control_process_control(int sock, DltDaemon *daemon, DltMessage *
     }
     else
     {
+        if (id == DLT_SERVICE_ID_GET_STATISTICS)
+        {
+            dlt_daemon_control_get_statistics(sock, daemon, msg, verbose);
+            return 0;
+        }
+
+        if (id == DLT_SERVICE_ID_GET_LOG_INFO_PAGED)
+        {
+            dlt_daemon_control_get_log_info_paged(sock, daemon, msg, verbose);
+            return 0;
+        }
+
         /* Injection handling */
         dlt_daemon_control_callsw_cinjection(sock, daemon, msg,  verbose);
     }
@@ -2022,6 +2070,246 @@ void dlt_daemon_control_get_log_info(int sock, DltDaemon *daemon, DltMessage *ms
     dlt_message_free(&resp,0);
 }
 
+/* Index of first context after (apid, ctid) in sorted contexts */
+static int dlt_daemon_contexts_upper_bound(DltDaemon *daemon, char *apid, char *ctid)
+{
+    int low = 0, high = daemon->num_contexts, mid, cmp;
+
+    while (low < high)
+    {
+        mid = (low + high) / 2;
+        cmp = memcmp(daemon->contexts[mid].apid, apid, DLT_ID_SIZE);
+        if (cmp == 0)
+        {
+            cmp = memcmp(daemon->contexts[mid].ctid, ctid, DLT_ID_SIZE);
+        }
+        if (cmp <= 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/* Append length and description, limited to DLT_DAEMON_LOG_INFO_DESCRIPTION_MAX */
+static int dlt_daemon_log_info_description(uint8_t *buffer, const char *description)
+{
+    uint16_t len = 0;
+
+    if (description)
+    {
+        len = strlen(description) > DLT_DAEMON_LOG_INFO_DESCRIPTION_MAX ? DLT_DAEMON_LOG_INFO_DESCRIPTION_MAX : strlen(description);
+    }
+    if (buffer)
+    {
+        memcpy(buffer, &len, sizeof(uint16_t));
+        if (len > 0)
+        {
+            memcpy(buffer + sizeof(uint16_t), description, len);
+        }
+    }
+
+    return sizeof(uint16_t) + len;
+}
+
+void dlt_daemon_control_get_log_info_paged(int sock, DltDaemon *daemon, DltMessage *msg, int verbose)
+{
+    DltServiceGetLogInfoPagedRequest *req;
+    DltServiceGetLogInfoPagedResponse *resp;
+    DltMessage page;
+    DltDaemonContext *context;
+    DltDaemonApplication *application = 0, *listed = 0;
+    uint8_t *apps = 0;
+    int32_t offset, apps_offset = 0, size, app_size;
+    uint16_t count_app_ids = 0, max_contexts;
+    char apid[DLT_ID_SIZE], ctid[DLT_ID_SIZE];
+    int i, start, complete;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (msg==0))
+    {
+        return;
+    }
+
+    if (msg->datasize < (int32_t)sizeof(DltServiceGetLogInfoPagedRequest))
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_LOG_INFO_PAGED, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+
+    req = (DltServiceGetLogInfoPagedRequest*) (msg->databuffer);
+
+    if ((req->options < 3 ) || (req->options>7))
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_LOG_INFO_PAGED, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+
+    /* page is filled in one pass into a buffer of fixed size */
+    if (dlt_message_init(&page,0)==-1)
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_LOG_INFO_PAGED, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+    page.databuffer = (uint8_t *) malloc(DLT_DAEMON_LOG_INFO_PAGE_SIZE);
+    page.databuffersize = DLT_DAEMON_LOG_INFO_PAGE_SIZE;
+    if (req->options == 7)
+    {
+        /* application descriptions follow all contexts of page */
+        apps = (uint8_t *) malloc(DLT_DAEMON_LOG_INFO_PAGE_SIZE);
+    }
+    if ((page.databuffer==0) || ((req->options == 7) && (apps==0)))
+    {
+        free(apps);
+        dlt_message_free(&page,0);
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_LOG_INFO_PAGED, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+
+    resp = (DltServiceGetLogInfoPagedResponse*) page.databuffer;
+    memset(resp, 0, sizeof(DltServiceGetLogInfoPagedResponse));
+    resp->service_id = DLT_SERVICE_ID_GET_LOG_INFO_PAGED;
+    resp->status = req->options;
+    resp->revision = daemon->revision;
+    offset = sizeof(DltServiceGetLogInfoPagedResponse);
+
+    /* changes cannot be reported after removal of contexts, list all contexts instead */
+    complete = ((req->revision == 0) || ((int32_t)(req->revision - daemon->revision_removed) < 0));
+    resp->complete = complete;
+
+    max_contexts = req->max_contexts;
+
+    dlt_set_id(apid, req->apid);
+    if (req->cursor_apid[0]!='\0')
+    {
+        memcpy(apid, req->cursor_apid, DLT_ID_SIZE);
+        memcpy(ctid, req->cursor_ctid, DLT_ID_SIZE);
+        start = dlt_daemon_contexts_upper_bound(daemon, apid, ctid);
+    }
+    else if (req->apid[0]!='\0')
+    {
+        /* first context of application */
+        dlt_set_id(ctid, "");
+        start = dlt_daemon_contexts_upper_bound(daemon, apid, ctid);
+        while ((start > 0) && (memcmp(daemon->contexts[start-1].apid, apid, DLT_ID_SIZE)==0))
+        {
+            start--;
+        }
+    }
+    else
+    {
+        start = 0;
+    }
+
+    if ((req->apid[0]!='\0') && (dlt_daemon_application_find(daemon, req->apid, verbose)==0))
+    {
+        resp->status = 8; /* no matching context found */
+        start = daemon->num_contexts;
+    }
+
+    for (i = start; i < daemon->num_contexts; i++)
+    {
+        context = &(daemon->contexts[i]);
+
+        if ((req->apid[0]!='\0') && (memcmp(context->apid, req->apid, DLT_ID_SIZE)!=0))
+        {
+            break;
+        }
+
+        /* contexts are sorted by application */
+        if ((application==0) || (memcmp(application->apid, context->apid, DLT_ID_SIZE)!=0))
+        {
+            application = dlt_daemon_application_find(daemon, context->apid, verbose);
+        }
+
+        if (!complete && (context->revision <= req->revision) &&
+            ((application==0) || (application->revision <= req->revision)))
+        {
+            continue;
+        }
+
+        /* size of entry */
+        size = 2 * DLT_ID_SIZE;
+        if ((req->options==4) || (req->options==6) || (req->options==7))
+        {
+            size += sizeof(int8_t);
+        }
+        if ((req->options==5) || (req->options==6) || (req->options==7))
+        {
+            size += sizeof(int8_t);
+        }
+        app_size = 0;
+        if (req->options==7)
+        {
+            size += dlt_daemon_log_info_description(0, context->context_description);
+            if (application && (application != listed))
+            {
+                app_size = DLT_ID_SIZE + dlt_daemon_log_info_description(0, application->application_description);
+            }
+        }
+
+        if (((max_contexts > 0) && (resp->count_con_ids >= max_contexts)) ||
+            (offset + size + sizeof(uint16_t) + apps_offset + app_size > DLT_DAEMON_LOG_INFO_PAGE_SIZE))
+        {
+            resp->more = 1;
+            break;
+        }
+
+        memcpy(page.databuffer+offset, context->apid, DLT_ID_SIZE);
+        offset += DLT_ID_SIZE;
+        memcpy(page.databuffer+offset, context->ctid, DLT_ID_SIZE);
+        offset += DLT_ID_SIZE;
+        if ((req->options==4) || (req->options==6) || (req->options==7))
+        {
+            memcpy(page.databuffer+offset, &(context->log_level), sizeof(int8_t));
+            offset += sizeof(int8_t);
+        }
+        if ((req->options==5) || (req->options==6) || (req->options==7))
+        {
+            memcpy(page.databuffer+offset, &(context->trace_status), sizeof(int8_t));
+            offset += sizeof(int8_t);
+        }
+        if (req->options==7)
+        {
+            offset += dlt_daemon_log_info_description(page.databuffer+offset, context->context_description);
+            if (app_size > 0)
+            {
+                memcpy(apps+apps_offset, application->apid, DLT_ID_SIZE);
+                apps_offset += DLT_ID_SIZE;
+                apps_offset += dlt_daemon_log_info_description(apps+apps_offset, application->application_description);
+                count_app_ids++;
+                listed = application;
+            }
+        }
+
+        memcpy(resp->cursor_apid, context->apid, DLT_ID_SIZE);
+        memcpy(resp->cursor_ctid, context->ctid, DLT_ID_SIZE);
+        resp->count_con_ids++;
+    }
+
+    if (req->options==7)
+    {
+        memcpy(page.databuffer+offset, &count_app_ids, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        memcpy(page.databuffer+offset, apps, apps_offset);
+        offset += apps_offset;
+    }
+    page.datasize = offset;
+
+    /* send message */
+    dlt_daemon_control_send_control_message(sock,daemon,&page,"","",  verbose);
+
+    /* free message */
+    free(apps);
+    dlt_message_free(&page,0);
+}
+
 void dlt_daemon_control_message_buffer_overflow(int sock, DltDaemon *daemon, int verbose)
 {
     DltMessage msg;
@@ -2170,6 +2458,370 @@ void dlt_daemon_control_send_ecu_version(int sock, DltDaemon *daemon, const char
     dlt_message_free(&msg,0);
 }
 
+static void dlt_daemon_statistics_count(DltServiceStatisticsCounter *counter, uint32_t size, DltDaemonStatisticsResult result)
+{
+    counter->received++;
+    counter->received_bytes += size;
+
+    switch (result)
+    {
+    case DLT_DAEMON_STATISTICS_FORWARDED:
+        counter->forwarded++;
+        break;
+    case DLT_DAEMON_STATISTICS_BUFFERED:
+        counter->buffered++;
+        break;
+    case DLT_DAEMON_STATISTICS_SUPPRESSED:
+        break;
+    default:
+        counter->dropped++;
+        break;
+    }
+}
+
+static void dlt_daemon_statistics_histogram(uint32_t *histogram, uint32_t value)
+{
+    int bucket = 0;
+
+    /* bucket n counts values smaller than 2^n */
+    while (value && bucket < DLT_STATISTICS_HISTOGRAM_SIZE-1)
+    {
+        value >>= 1;
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+void dlt_daemon_statistics_message(DltDaemon *daemon, DltMessage *msg, DltDaemonStatisticsResult result, struct timespec *start)
+{
+    DltDaemonApplication *application;
+    DltDaemonContext *context;
+    struct timespec now;
+    uint32_t size;
+    int64_t elapsed;
+
+    if ((daemon==0) || (msg==0))
+    {
+        return;
+    }
+
+    size = msg->headersize - sizeof(DltStorageHeader) + msg->datasize;
+    dlt_daemon_statistics_count(&(daemon->statistics.total), size, result);
+
+    if (msg->extendedheader)
+    {
+        application = dlt_daemon_application_find(daemon, msg->extendedheader->apid, 0);
+        if (application)
+        {
+            dlt_daemon_statistics_count(&(application->statistics), size, result);
+
+            context = dlt_daemon_context_find(daemon, msg->extendedheader->apid, msg->extendedheader->ctid, 0);
+            if (context)
+            {
+                dlt_daemon_statistics_count(&(context->statistics), size, result);
+            }
+        }
+    }
+
+    if (start && clock_gettime(CLOCK_MONOTONIC, &now)==0)
+    {
+        elapsed = (int64_t)(now.tv_sec - start->tv_sec) * 1000000 + (now.tv_nsec - start->tv_nsec) / 1000;
+        dlt_daemon_statistics_histogram(daemon->statistics.processing_time, elapsed > 0 ? (uint32_t)elapsed : 0);
+
+        /* timestamp of message and dlt_uptime() use the same clock */
+        if (DLT_IS_HTYP_WTMS(msg->standardheader->htyp))
+        {
+            elapsed = (int32_t)(dlt_uptime() - msg->headerextra.tmsp);
+            dlt_daemon_statistics_histogram(daemon->statistics.latency, elapsed > 0 ? (uint32_t)elapsed : 0);
+        }
+    }
+}
+
+int dlt_daemon_repeat_filter(DltDaemonContext *context, DltMessage *msg, uint32_t window, uint32_t max_count, uint32_t *repeated)
+{
+    DltDaemonRepeatFilter *repeat;
+    uint32_t now;
+    uint8_t *data;
+
+    if ((context==0) || (msg==0) || (msg->extendedheader==0) || (repeated==0))
+    {
+        return -1;
+    }
+
+    repeat = &(context->repeat);
+    now = dlt_uptime();
+    *repeated = 0;
+
+    if ((repeat->datasize == msg->datasize) &&
+        (repeat->msin == msg->extendedheader->msin) &&
+        ((uint32_t)(now - repeat->last) <= window) &&
+        (memcmp(repeat->data, msg->databuffer, msg->datasize)==0))
+    {
+        if (repeat->count == 0)
+        {
+            repeat->first = now;
+        }
+        repeat->count++;
+        repeat->last = now;
+
+        /* report long sequences in parts */
+        if (max_count > 0 && repeat->count >= max_count)
+        {
+            *repeated = repeat->count;
+            repeat->count = 0;
+        }
+
+        return 1;
+    }
+
+    /* different message, report suppressed repetitions of previous one */
+    *repeated = repeat->count;
+    repeat->count = 0;
+
+    /* remember message for comparison with next messages */
+    if (repeat->allocated < msg->datasize)
+    {
+        data = realloc(repeat->data, msg->datasize);
+        if (data == 0)
+        {
+            repeat->datasize = -1;
+            return 0;
+        }
+        repeat->data = data;
+        repeat->allocated = msg->datasize;
+    }
+    memcpy(repeat->data, msg->databuffer, msg->datasize);
+    repeat->datasize = msg->datasize;
+    repeat->msin = msg->extendedheader->msin;
+    repeat->last = now;
+
+    return 0;
+}
+
+uint32_t dlt_daemon_repeat_expired(DltDaemonContext *context, uint32_t window)
+{
+    uint32_t repeated;
+
+    if ((context==0) || (context->repeat.count == 0) ||
+        ((uint32_t)(dlt_uptime() - context->repeat.first) < window))
+    {
+        return 0;
+    }
+
+    repeated = context->repeat.count;
+    context->repeat.count = 0;
+
+    return repeated;
+}
+
+void dlt_daemon_control_get_statistics(int sock, DltDaemon *daemon, DltMessage *msg, int verbose)
+{
+    DltServiceGetStatisticsRequest *req;
+    char apid[DLT_ID_SIZE+1];
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (msg==0))
+    {
+        return;
+    }
+
+    if (msg->datasize < (int32_t)sizeof(DltServiceGetStatisticsRequest))
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_STATISTICS, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+
+    req = (DltServiceGetStatisticsRequest*) (msg->databuffer);
+
+    if (req->options > DLT_STATISTICS_OPTION_CONTEXTS)
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_STATISTICS, DLT_SERVICE_RESPONSE_NOT_SUPPORTED,  verbose);
+        return;
+    }
+
+    memset(apid,0,sizeof(apid));
+    memcpy(apid,req->apid,DLT_ID_SIZE);
+
+    dlt_daemon_control_send_statistics(sock, daemon, req->options, apid, "", verbose);
+}
+
+void dlt_daemon_control_send_statistics(int sock, DltDaemon *daemon, uint8_t options, char *apid, char *ctid, int verbose)
+{
+    DltMessage msg;
+    DltServiceGetStatisticsResponse *resp;
+    DltServiceStatisticsEntry *entry;
+    int i, count, max_entries;
+    int value;
+
+    PRINT_FUNCTION_VERBOSE(verbose);
+
+    if ((daemon==0) || (apid==0) || (ctid==0))
+    {
+        return;
+    }
+
+    /* initialise new message */
+    if (dlt_message_init(&msg,0)==-1)
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_STATISTICS, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+
+    /* count entries, the response must fit into one message */
+    count = 0;
+    if (options >= DLT_STATISTICS_OPTION_APPLICATIONS)
+    {
+        count += daemon->num_applications;
+    }
+    if (options >= DLT_STATISTICS_OPTION_CONTEXTS)
+    {
+        count += daemon->num_contexts;
+    }
+    max_entries = (UINT16_MAX - sizeof(DltStandardHeader) - sizeof(DltStandardHeaderExtra) - sizeof(DltExtendedHeader) -
+                   sizeof(DltServiceGetStatisticsResponse)) / sizeof(DltServiceStatisticsEntry);
+    if (count > max_entries)
+    {
+        count = max_entries;
+    }
+
+    /* prepare payload of data */
+    msg.datasize = sizeof(DltServiceGetStatisticsResponse) + count * sizeof(DltServiceStatisticsEntry);
+    if (msg.databuffer && (msg.databuffersize < msg.datasize))
+    {
+        free(msg.databuffer);
+        msg.databuffer=0;
+    }
+    if (msg.databuffer == 0){
+    	msg.databuffer = (uint8_t *) malloc(msg.datasize);
+    	msg.databuffersize = msg.datasize;
+    }
+    if (msg.databuffer==0)
+    {
+        dlt_daemon_control_service_response(sock, daemon, DLT_SERVICE_ID_GET_STATISTICS, DLT_SERVICE_RESPONSE_ERROR,  verbose);
+        return;
+    }
+
+    resp = (DltServiceGetStatisticsResponse*) msg.databuffer;
+    memset(resp,0,sizeof(DltServiceGetStatisticsResponse));
+    resp->service_id = DLT_SERVICE_ID_GET_STATISTICS;
+    resp->status = DLT_SERVICE_RESPONSE_OK;
+
+    /* fill levels are sampled now */
+    if (daemon->statistics.fifo >= 0)
+    {
+        if (ioctl(daemon->statistics.fifo, FIONREAD, &value)==0)
+        {
+            resp->fifo_used = value;
+        }
+#ifdef F_GETPIPE_SZ
+        value = fcntl(daemon->statistics.fifo, F_GETPIPE_SZ);
+        if (value > 0)
+        {
+            resp->fifo_size = value;
+        }
+#endif
+    }
+    DLT_DAEMON_SEM_LOCK();
+    resp->buffer_used = dlt_segmented_buffer_get_used_size(&(daemon->client_ringbuffer));
+    resp->buffer_messages = dlt_segmented_buffer_get_message_count(&(daemon->client_ringbuffer));
+    DLT_DAEMON_SEM_FREE();
+    resp->buffer_size = DLT_DAEMON_RINGBUFFER_MAX_SIZE;
+
+    resp->user_overflows = daemon->statistics.user_overflows;
+    resp->total = daemon->statistics.total;
+    memcpy(resp->processing_time, daemon->statistics.processing_time, sizeof(resp->processing_time));
+    memcpy(resp->latency, daemon->statistics.latency, sizeof(resp->latency));
+
+    /* entries of applications first, then entries of contexts */
+    entry = (DltServiceStatisticsEntry*) (msg.databuffer + sizeof(DltServiceGetStatisticsResponse));
+    resp->count_entries = 0;
+    for (i = 0; i < daemon->num_applications && resp->count_entries < count; i++)
+    {
+        if (apid[0] && memcmp(daemon->applications[i].apid, apid, DLT_ID_SIZE)!=0)
+        {
+            continue;
+        }
+        memcpy(entry->apid, daemon->applications[i].apid, DLT_ID_SIZE);
+        memset(entry->ctid, 0, DLT_ID_SIZE);
+        entry->counter = daemon->applications[i].statistics;
+        entry++;
+        resp->count_entries++;
+    }
+    for (i = 0; options >= DLT_STATISTICS_OPTION_CONTEXTS && i < daemon->num_contexts && resp->count_entries < count; i++)
+    {
+        if (apid[0] && memcmp(daemon->contexts[i].apid, apid, DLT_ID_SIZE)!=0)
+        {
+            continue;
+        }
+        memcpy(entry->apid, daemon->contexts[i].apid, DLT_ID_SIZE);
+        memcpy(entry->ctid, daemon->contexts[i].ctid, DLT_ID_SIZE);
+        entry->counter = daemon->contexts[i].statistics;
+        entry++;
+        resp->count_entries++;
+    }
+    msg.datasize = sizeof(DltServiceGetStatisticsResponse) + resp->count_entries * sizeof(DltServiceStatisticsEntry);
+
+    /* send message */
+    dlt_daemon_control_send_control_message(sock, daemon, &msg, "", ctid,  verbose);
+
+    /* free message */
+    dlt_message_free(&msg,0);
+}
+
+static int dlt_daemon_serial_write_wait(int fd, const uint8_t *data, int size)
+{
+    struct pollfd pfd;
+    ssize_t ret;
+
+    while (size > 0)
+    {
+        ret = write(fd, data, size);
+        if (ret < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                pfd.fd = fd;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        data += ret;
+        size -= ret;
+    }
+
+    return 0;
+}
+
+int dlt_daemon_serial_write(DltDaemon *daemon, int fd, const void *data, int size)
+{
+    int ret;
+
+    if ((daemon==0) || (data==0))
+    {
+        return -1;
+    }
+
+    if (daemon->serial_pending_size > 0)
+    {
+        ret = dlt_daemon_serial_write_wait(fd, daemon->serial_pending, daemon->serial_pending_size);
+        daemon->serial_pending_size = 0;
+        if (ret < 0)
+        {
+            return -1;
+        }
+    }
+
+    return dlt_daemon_serial_write_wait(fd, (const uint8_t *)data, size);
+}
+
 void dlt_daemon_control_send_control_message( int sock, DltDaemon *daemon, DltMessage *msg, char* appid, char* ctid, int verbose)
 {
     ssize_t ret;
@@ -2253,12 +2905,12 @@ void dlt_daemon_control_send_control_message( int sock, DltDaemon *daemon, DltMe
             /* Optional: Send serial header, if requested */
             if (daemon->sendserialheader)
             {
-                ret=write(sock,dltSerialHeader,sizeof(dltSerialHeader));
+                ret=dlt_daemon_serial_write(daemon,sock,dltSerialHeader,sizeof(dltSerialHeader));
             }
 
             /* Send data */
-            ret=write(sock, msg->headerbuffer+sizeof(DltStorageHeader),msg->headersize-sizeof(DltStorageHeader));
-            ret=write(sock, msg->databuffer,msg->datasize);
+            ret=dlt_daemon_serial_write(daemon,sock, msg->headerbuffer+sizeof(DltStorageHeader),msg->headersize-sizeof(DltStorageHeader));
+            ret=dlt_daemon_serial_write(daemon,sock, msg->databuffer,msg->datasize);
 
             DLT_DAEMON_SEM_FREE();
         }
@@ -2283,7 +2935,7 @@ void dlt_daemon_control_send_control_message( int sock, DltDaemon *daemon, DltMe
     {
         DLT_DAEMON_SEM_LOCK();
         /* Store message in history buffer */
-        if (dlt_buffer_push3(&(daemon->client_ringbuffer),
+        if (dlt_segmented_buffer_push3(&(daemon->client_ringbuffer),
                             msg->headerbuffer+sizeof(DltStorageHeader),msg->headersize-sizeof(DltStorageHeader),
                             msg->databuffer,msg->datasize,
                             0, 0
@@ -2479,13 +3131,13 @@ void dlt_daemon_control_message_time(int sock, DltDaemon *daemon, int verbose)
         /* Optional: Send serial header, if requested */
         if (daemon->sendserialheader)
         {
-            ret=write(sock,dltSerialHeader,sizeof(dltSerialHeader));
+            ret=dlt_daemon_serial_write(daemon,sock,dltSerialHeader,sizeof(dltSerialHeader));
         }
 
         /* Send data */
-        ret=write(sock, msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
+        ret=dlt_daemon_serial_write(daemon,sock, msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader));
         if(msg.datasize > 0)
-        	ret=write(sock, msg.databuffer,msg.datasize);
+        	ret=dlt_daemon_serial_write(daemon,sock, msg.databuffer,msg.datasize);
 
         DLT_DAEMON_SEM_FREE();
     }
@@ -83,7 +83,7 @@ extern "C" {
 
 #define DLT_DAEMON_RINGBUFFER_MIN_SIZE    500000 /**< Ring buffer size for storing log messages while no client is connected */
 #define DLT_DAEMON_RINGBUFFER_MAX_SIZE  10000000 /**< Ring buffer size for storing log messages while no client is connected */
-#define DLT_DAEMON_RINGBUFFER_STEP_SIZE   500000 /**< Ring buffer size for storing log messages while no client is connected */
+#define DLT_DAEMON_RINGBUFFER_CHUNK_SIZE   65535 /**< Size of one ring buffer chunk, must hold the biggest DLT message */
 
 #define DLT_DAEMON_STORE_TO_BUFFER -2   /**< Constant value to identify the command "store to buffer" */
 
@@ -104,8 +104,24 @@ typedef struct
 	int user_handle;    /**< connection handle for connection to user application */
 	char *application_description; /**< context description */
 	int num_contexts; /**< number of contexts for this application */
+	uint32_t revision;  /**< revision of registry when application was changed last */
+	DltServiceStatisticsCounter statistics; /**< message counters of application */
 } DltDaemonApplication;
 
+/**
+ * State of repeat filter of one context.
+ */
+typedef struct
+{
+	uint8_t *data;      /**< payload of last forwarded message */
+	int32_t datasize;   /**< size of payload, -1 if no message was forwarded yet */
+	int32_t allocated;  /**< size of allocated payload buffer */
+	uint8_t msin;       /**< message info of last forwarded message */
+	uint32_t count;     /**< number of suppressed repetitions not yet reported */
+	uint32_t first;     /**< uptime of first suppressed repetition */
+	uint32_t last;      /**< uptime of last forwarded or suppressed message */
+} DltDaemonRepeatFilter;
+
 /**
  * The parameters of a daemon context.
  */
@@ -118,8 +134,34 @@ typedef struct
 	int log_level_pos;  /**< offset of context in context field on user application */
 	int user_handle;    /**< connection handle for connection to user application */
 	char *context_description; /**< context description */
+	DltServiceStatisticsCounter statistics; /**< message counters of context */
+	DltDaemonRepeatFilter repeat; /**< detection of repeated messages */
+	uint32_t revision;  /**< revision of registry when context was changed last */
 } DltDaemonContext;
 
+/**
+ * Result of processing one message, used for statistics.
+ */
+typedef enum
+{
+	DLT_DAEMON_STATISTICS_FORWARDED = 0, /**< message was sent to a client or offline trace */
+	DLT_DAEMON_STATISTICS_BUFFERED,      /**< message was stored in client ring buffer */
+	DLT_DAEMON_STATISTICS_DROPPED,       /**< message was discarded */
+	DLT_DAEMON_STATISTICS_SUPPRESSED     /**< message was replaced by repeat summary */
+} DltDaemonStatisticsResult;
+
+/**
+ * Statistics of the daemon.
+ */
+typedef struct
+{
+	DltServiceStatisticsCounter total; /**< counters of all messages */
+	uint32_t user_overflows;           /**< buffer overflows reported by applications */
+	uint32_t processing_time[DLT_STATISTICS_HISTOGRAM_SIZE]; /**< histogram of processing time per message in microseconds */
+	uint32_t latency[DLT_STATISTICS_HISTOGRAM_SIZE]; /**< histogram of message age at reception in 0.1 milliseconds */
+	int fifo;                          /**< handle of daemon fifo, sampled for fill level */
+} DltDaemonStatistics;
+
 /**
  * The parameters of a daemon.
  */
@@ -136,12 +178,17 @@ typedef struct
 	char ecuid[DLT_ID_SIZE];       /**< ECU ID of daemon */
 	int sendserialheader;          /**< 1: send serial header; 0 don't send serial header */
 	int timingpackets;              /**< 1: send continous timing packets; 0 don't send continous timing packets */
-	DltBuffer client_ringbuffer; /**< Ring-buffer for storing received logs while no client connection is available */
+	DltSegmentedBuffer client_ringbuffer; /**< Ring-buffer for storing received logs while no client connection is available */
 	char runtime_application_cfg[256]; /**< Path and filename of persistent application configuration */
 	char runtime_context_cfg[256]; /**< Path and filename of persistent context configuration */
 	char runtime_configuration[256]; /**< Path and filename of persistent configuration */
     DltUserLogMode mode;	/**< Mode used for tracing: off, external, internal, both */
     char state;				/**< state for tracing: 0 = no client connected, 1 = client connected */
+    DltDaemonStatistics statistics; /**< message statistics */
+	uint32_t revision;          /**< revision of registry, incremented on each change of an application or context */
+	uint32_t revision_removed;  /**< revision of registry when an application or context was removed last */
+	const uint8_t *serial_pending; /**< rest of a frame the serial device did not accept yet */
+	int serial_pending_size;       /**< size of serial_pending, 0 if no frame is pending */
 } DltDaemon;
 
 /**
@@ -361,6 +408,19 @@ void dlt_daemon_control_service_response(int sock, DltDaemon *daemon, uint32_t s
  */
 void dlt_daemon_control_send_control_message(int sock, DltDaemon *daemon, DltMessage *msg, char* appid, char* contid, int verbose);
 
+/**
+ * Write data to the serial device, waiting until the device accepted all of it.
+ * The device is opened non-blocking, so the rest of a frame the serial egress could not write yet
+ * is completed first; otherwise the data would end up in the middle of that frame.
+ * Must be called with DLT_DAEMON_SEM_LOCK held.
+ * @param daemon pointer to dlt daemon structure
+ * @param fd handle of serial device
+ * @param data pointer to data to be written
+ * @param size size of data
+ * @return negative value if there was an error
+ */
+int dlt_daemon_serial_write(DltDaemon *daemon, int fd, const void *data, int size);
+
 /**
  * Process and generate response to received sw injection control message
  * @param sock connection handle used for sending response
@@ -431,6 +491,14 @@ void dlt_daemon_control_get_default_log_level(int sock, DltDaemon *daemon, int v
  * @param verbose if set to true verbose information is printed out.
  */
 void dlt_daemon_control_get_log_info(int sock, DltDaemon *daemon, DltMessage *msg, int verbose);
+/**
+ * Process and generate response to received get log info paged control message
+ * @param sock connection handle used for sending response
+ * @param daemon pointer to dlt daemon structure
+ * @param msg pointer to received control message
+ * @param verbose if set to true verbose information is printed out.
+ */
+void dlt_daemon_control_get_log_info_paged(int sock, DltDaemon *daemon, DltMessage *msg, int verbose);
 /**
  * Process and generate response to message buffer overflow control message
  * @param sock connection handle used for sending response
@@ -462,6 +530,57 @@ void dlt_daemon_control_message_time(int sock, DltDaemon *daemon, int verbose);
  * @param verbose if set to true verbose information is printed out.
  */
 void dlt_daemon_control_send_ecu_version(int sock, DltDaemon *daemon, const char *version, int verbose);
+
+/**
+ * Update statistics for one message received from an application
+ * @param daemon pointer to dlt daemon structure
+ * @param msg pointer to received message
+ * @param result what happened to the message
+ * @param start time when processing of message started
+ */
+void dlt_daemon_statistics_message(DltDaemon *daemon, DltMessage *msg, DltDaemonStatisticsResult result, struct timespec *start);
+
+/**
+ * Check if a message repeats the last message of its context.
+ * A message is a repetition if message info and payload are identical to the
+ * last forwarded message and it is received within window after the previous one.
+ * @param context pointer to context of message
+ * @param msg pointer to received message
+ * @param window maximum time between repetitions in 0.1 milliseconds
+ * @param max_count maximum number of repetitions reported by one summary
+ * @param repeated returns number of suppressed repetitions to report now, 0 if none
+ * @return 1 if message should be suppressed, 0 if message should be forwarded, -1 on error
+ */
+int dlt_daemon_repeat_filter(DltDaemonContext *context, DltMessage *msg, uint32_t window, uint32_t max_count, uint32_t *repeated);
+
+/**
+ * Check if the suppressed repetitions of a context must be reported
+ * because the first repetition is older than window.
+ * @param context pointer to context
+ * @param window maximum delay of report in 0.1 milliseconds
+ * @return number of suppressed repetitions to report now, 0 if none
+ */
+uint32_t dlt_daemon_repeat_expired(DltDaemonContext *context, uint32_t window);
+
+/**
+ * Process and generate response to received get statistics control message
+ * @param sock connection handle used for sending response
+ * @param daemon pointer to dlt daemon structure
+ * @param msg pointer to received control message
+ * @param verbose if set to true verbose information is printed out.
+ */
+void dlt_daemon_control_get_statistics(int sock, DltDaemon *daemon, DltMessage *msg, int verbose);
+
+/**
+ * Send statistics control message
+ * @param sock connection handle used for sending response
+ * @param daemon pointer to dlt daemon structure
+ * @param options DLT_STATISTICS_OPTION_APPLICATIONS or DLT_STATISTICS_OPTION_CONTEXTS, zero for totals only
+ * @param apid application id to report, empty for all applications
+ * @param ctid context id used for the message, empty for default control context
+ * @param verbose if set to true verbose information is printed out.
+ */
+void dlt_daemon_control_send_statistics(int sock, DltDaemon *daemon, uint8_t options, char *apid, char *ctid, int verbose);
 #ifdef __cplusplus
 }
 #endif
@@ -99,6 +99,12 @@
    when no more entries are available */
 #define DLT_DAEMON_CONTEXT_ALLOC_SIZE  1000
 
+/* Maximum size of one page of a paged get log info response */
+#define DLT_DAEMON_LOG_INFO_PAGE_SIZE 8192
+
+/* Maximum length of descriptions in a paged get log info response */
+#define DLT_DAEMON_LOG_INFO_DESCRIPTION_MAX 1024
+
 /* Debug get log info function, 
    set to 1 to enable, 0 to disable debugging */
 #define DLT_DEBUG_GETLOGINFO 0
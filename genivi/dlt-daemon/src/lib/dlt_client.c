@@ -73,6 +73,7 @@
 #include <arpa/inet.h>  /* for sockaddr_in and inet_addr() */
 #include <netdb.h>
 #include <sys/stat.h>
+#include <sys/epoll.h>
 #endif
 
 #if defined(_MSC_VER)
@@ -454,3 +455,396 @@ int dlt_client_setbaudrate(DltClient *client, int baudrate)
 	return 0;
 }
 
+
+#if !defined (__WIN32__)
+
+/* Parse one message in buffer without copying it, returns number of bytes used or zero if incomplete.
+   Data in front of the message which could not be parsed is returned in skipped and is not part of
+   the bytes used. With resync set, the message must start with a serial header, which is searched
+   byte-wise like in dlt_message_read(). */
+static int dlt_client_parse_view(DltMessageView *view, uint8_t *buffer, int length, int resync, int *skipped)
+{
+    int offset, found;
+    int extra_size;
+    uint8_t *extra;
+
+    *skipped = 0;
+
+    while (1)
+    {
+        if (length < (int)sizeof(dltSerialHeader))
+        {
+            return 0;
+        }
+
+        offset = 0;
+        view->found_serialheader = 0;
+        if (memcmp(buffer,dltSerialHeader,sizeof(dltSerialHeader)) == 0)
+        {
+            view->found_serialheader = 1;
+            offset = sizeof(dltSerialHeader);
+        }
+        else if (resync)
+        {
+            /* resync to the next serial header */
+            for (found = 1; found + (int)sizeof(dltSerialHeader) <= length; found++)
+            {
+                if (memcmp(buffer + found,dltSerialHeader,sizeof(dltSerialHeader)) == 0)
+                {
+                    break;
+                }
+            }
+            if (found + (int)sizeof(dltSerialHeader) > length)
+            {
+                /* keep the end of the buffer, it could be the start of a serial header */
+                found = length - (sizeof(dltSerialHeader) - 1);
+            }
+            buffer += found;
+            length -= found;
+            *skipped += found;
+            continue;
+        }
+
+        if (length - offset < (int)sizeof(DltStandardHeader))
+        {
+            return 0;
+        }
+
+        view->data = buffer + offset;
+        view->standardheader = (DltStandardHeader *)view->data;
+        view->size = DLT_BETOH_16(view->standardheader->len);
+
+        extra_size = DLT_STANDARD_HEADER_EXTRA_SIZE(view->standardheader->htyp);
+        view->headersize = sizeof(DltStandardHeader) + extra_size +
+                           (DLT_IS_HTYP_UEH(view->standardheader->htyp) ? sizeof(DltExtendedHeader) : 0);
+        view->datasize = view->size - view->headersize;
+
+        if (view->datasize >= 0)
+        {
+            break;
+        }
+
+        /* Plausibility check failed, resync byte-wise */
+        buffer++;
+        length--;
+        (*skipped)++;
+    }
+
+    if (length - offset < view->size)
+    {
+        return 0;
+    }
+
+    extra = (uint8_t *)view->data + sizeof(DltStandardHeader);
+    memset(&(view->headerextra),0,sizeof(DltStandardHeaderExtra));
+    if (DLT_IS_HTYP_WEID(view->standardheader->htyp))
+    {
+        memcpy(view->headerextra.ecu,extra,DLT_ID_SIZE);
+        extra += DLT_SIZE_WEID;
+    }
+    if (DLT_IS_HTYP_WSID(view->standardheader->htyp))
+    {
+        memcpy(&(view->headerextra.seid),extra,DLT_SIZE_WSID);
+        view->headerextra.seid = DLT_BETOH_32(view->headerextra.seid);
+        extra += DLT_SIZE_WSID;
+    }
+    if (DLT_IS_HTYP_WTMS(view->standardheader->htyp))
+    {
+        memcpy(&(view->headerextra.tmsp),extra,DLT_SIZE_WTMS);
+        view->headerextra.tmsp = DLT_BETOH_32(view->headerextra.tmsp);
+    }
+
+    if (DLT_IS_HTYP_UEH(view->standardheader->htyp))
+    {
+        view->extendedheader = (DltExtendedHeader *)(view->data + sizeof(DltStandardHeader) + extra_size);
+    }
+    else
+    {
+        view->extendedheader = 0;
+    }
+    view->payload = view->data + view->headersize;
+
+    return offset + view->size;
+}
+
+static DltClientConnection *dlt_client_loop_find(DltClientLoop *loop, DltClient *client, DltClientConnection ***prev)
+{
+    DltClientConnection **con;
+
+    for (con = &(loop->connections); *con; con = &((*con)->next))
+    {
+        if ((*con)->client == client)
+        {
+            if (prev)
+            {
+                *prev = con;
+            }
+            return *con;
+        }
+    }
+
+    return 0;
+}
+
+/* Read available data of one connection and deliver all complete messages */
+static int dlt_client_loop_receive(DltClientLoop *loop, DltClientConnection *con)
+{
+    DltReceiver *receiver = &(con->client->receiver);
+    int space, ret, count, used, skipped;
+
+    /* move remaining data only if the end of the buffer is reached */
+    space = receiver->buffersize - (receiver->buf - receiver->buffer) - receiver->bytesRcvd;
+    if (space < DLT_CLIENT_LOOP_MINFREE)
+    {
+        dlt_receiver_move_to_begin(receiver);
+        receiver->buf = receiver->buffer;
+        space = receiver->buffersize - receiver->bytesRcvd;
+    }
+
+    ret = read(receiver->fd, receiver->buf + receiver->bytesRcvd, space);
+    if (ret <= 0)
+    {
+        if (ret < 0 && (errno == EINTR || errno == EAGAIN))
+        {
+            return 0;
+        }
+        return -1;
+    }
+    receiver->lastBytesRcvd = ret;
+    receiver->bytesRcvd += ret;
+    receiver->totalBytesRcvd += ret;
+
+    do
+    {
+        count = 0;
+        while (count < loop->batch_size)
+        {
+            used = dlt_client_parse_view(&(loop->views[count]),(uint8_t *)receiver->buf,receiver->bytesRcvd,
+                                         con->client->serial_mode,&skipped);
+
+            /* data which could not be parsed is dropped */
+            receiver->buf += skipped;
+            receiver->bytesRcvd -= skipped;
+
+            if (used == 0)
+            {
+                break;
+            }
+            receiver->buf += used;
+            receiver->bytesRcvd -= used;
+            count++;
+        }
+
+        if (count > 0 && con->callback && con->callback(con->client,loop->views,count,con->data) < 0)
+        {
+            return -1;
+        }
+    }
+    while (count == loop->batch_size);
+
+    if (receiver->bytesRcvd == 0)
+    {
+        receiver->buf = receiver->buffer;
+    }
+
+    return 0;
+}
+
+int dlt_client_loop_init(DltClientLoop *loop, int batch_size, int verbose)
+{
+    if (verbose)
+    {
+        printf("Init dlt client loop\n");
+    }
+
+    if (loop==0)
+    {
+        return -1;
+    }
+
+    loop->connections = 0;
+    loop->count = 0;
+    loop->stop = 0;
+    loop->batch_size = (batch_size > 0) ? batch_size : DLT_CLIENT_LOOP_BATCHSIZE;
+
+    loop->views = (DltMessageView *)malloc(loop->batch_size * sizeof(DltMessageView));
+    if (loop->views == 0)
+    {
+        return -1;
+    }
+
+    loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epfd < 0)
+    {
+        fprintf(stderr,"ERROR: epoll_create1() failed (%s)\n", strerror(errno));
+        free(loop->views);
+        loop->views = 0;
+        return -1;
+    }
+
+    return 0;
+}
+
+int dlt_client_loop_add(DltClientLoop *loop, DltClient *client, DltClientMessageCallback callback, void *data)
+{
+    DltClientConnection *con;
+    struct epoll_event ev;
+
+    if ((loop==0) || (client==0) || (client->sock<0) || dlt_client_loop_find(loop,client,0))
+    {
+        return -1;
+    }
+
+    con = (DltClientConnection *)malloc(sizeof(DltClientConnection));
+    if (con == 0)
+    {
+        return -1;
+    }
+
+    /* use a bigger receive buffer, so more messages are delivered at once */
+    if (client->receiver.buffersize < DLT_CLIENT_LOOP_RCVBUFSIZE)
+    {
+        dlt_receiver_free(&(client->receiver));
+        if (dlt_receiver_init(&(client->receiver),client->sock,DLT_CLIENT_LOOP_RCVBUFSIZE)!=0)
+        {
+            free(con);
+            return -1;
+        }
+    }
+
+    con->client = client;
+    con->callback = callback;
+    con->data = data;
+
+    memset(&ev,0,sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = con;
+    if (epoll_ctl(loop->epfd,EPOLL_CTL_ADD,client->sock,&ev) < 0)
+    {
+        fprintf(stderr,"ERROR: epoll_ctl() failed (%s)\n", strerror(errno));
+        free(con);
+        return -1;
+    }
+
+    con->next = loop->connections;
+    loop->connections = con;
+    loop->count++;
+
+    return 0;
+}
+
+int dlt_client_loop_remove(DltClientLoop *loop, DltClient *client)
+{
+    DltClientConnection *con, **prev;
+
+    if ((loop==0) || (client==0))
+    {
+        return -1;
+    }
+
+    con = dlt_client_loop_find(loop,client,&prev);
+    if (con == 0)
+    {
+        return -1;
+    }
+
+    epoll_ctl(loop->epfd,EPOLL_CTL_DEL,client->sock,0);
+    *prev = con->next;
+    loop->count--;
+    free(con);
+
+    return 0;
+}
+
+int dlt_client_loop_dispatch(DltClientLoop *loop, int timeout)
+{
+    struct epoll_event events[DLT_CLIENT_LOOP_EVENTS];
+    DltClientConnection *con;
+    int num, i;
+
+    if (loop==0)
+    {
+        return -1;
+    }
+
+    num = epoll_wait(loop->epfd,events,DLT_CLIENT_LOOP_EVENTS,timeout);
+    if (num < 0)
+    {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        con = (DltClientConnection *)events[i].data.ptr;
+
+        if (dlt_client_loop_receive(loop,con) < 0)
+        {
+            /* connection closed */
+            if (con->callback)
+            {
+                con->callback(con->client,0,0,con->data);
+            }
+            dlt_client_loop_remove(loop,con->client);
+        }
+    }
+
+    return num;
+}
+
+int dlt_client_loop_run(DltClientLoop *loop)
+{
+    if (loop==0)
+    {
+        return -1;
+    }
+
+    loop->stop = 0;
+    while (!loop->stop && loop->count > 0)
+    {
+        if (dlt_client_loop_dispatch(loop,-1) < 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+void dlt_client_loop_stop(DltClientLoop *loop)
+{
+    if (loop)
+    {
+        loop->stop = 1;
+    }
+}
+
+int dlt_client_loop_free(DltClientLoop *loop)
+{
+    DltClientConnection *con;
+
+    if (loop==0)
+    {
+        return -1;
+    }
+
+    while (loop->connections)
+    {
+        con = loop->connections;
+        loop->connections = con->next;
+        free(con);
+    }
+    loop->count = 0;
+
+    if (loop->epfd >= 0)
+    {
+        close(loop->epfd);
+        loop->epfd = -1;
+    }
+
+    free(loop->views);
+    loop->views = 0;
+
+    return 0;
+}
+
+#endif
@@ -81,6 +81,18 @@
 /* Size of receive buffer */
 #define DLT_CLIENT_RCVBUFSIZE         10024 
 
+/* Size of receive buffer of a connection in a client loop */
+#define DLT_CLIENT_LOOP_RCVBUFSIZE   262144
+
+/* Free space kept at end of receive buffer of a client loop, fits the biggest message */
+#define DLT_CLIENT_LOOP_MINFREE       65540
+
+/* Default number of messages delivered with one callback of a client loop */
+#define DLT_CLIENT_LOOP_BATCHSIZE       256
+
+/* Maximum number of events handled with one wait of a client loop */
+#define DLT_CLIENT_LOOP_EVENTS           16
+
 /* Initial baudrate */
 #if !defined (__WIN32__) && !defined(_MSC_VER)
 #define DLT_CLIENT_INITIAL_BAUDRATE B115200
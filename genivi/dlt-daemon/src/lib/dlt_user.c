@@ -98,6 +98,49 @@ static sem_t dlt_mutex;
 static pthread_t dlt_receiverthread_handle;
 static pthread_attr_t dlt_receiverthread_attr;
 
+/* Index of injection callbacks by context and service id.
+   Entries are only added under the DLT semaphore and never removed before dlt_free(),
+   so the receiver thread can look them up without locking. */
+typedef struct DltUserInjectionEntry
+{
+    struct DltUserInjectionEntry *next;
+    int32_t log_level_pos;
+    uint32_t service_id;
+    int (* volatile injection_callback)(uint32_t service_id, void *data, uint32_t length);
+} DltUserInjectionEntry;
+
+static DltUserInjectionEntry * volatile dlt_injection_hash[DLT_USER_INJECTION_HASH_SIZE];
+
+/* Injection callbacks are executed by worker threads, so that slow callbacks
+   do not block the receiver thread. All injections of one context are handled
+   by the same worker to keep their order. A job refers to the index entry, so
+   the callback registered when the job is executed is called. */
+typedef struct
+{
+    DltUserInjectionEntry *entry;
+    uint32_t length;
+    unsigned char *data;
+} DltUserInjectionJob;
+
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_cond_t done;            /* signalled when a job is finished */
+    DltUserInjectionJob jobs[DLT_USER_INJECTION_QUEUE_SIZE];
+    uint32_t read;
+    uint32_t count;
+    int32_t busy_pos;               /* context of the job in execution, -1 if idle */
+    int stop;
+    int running;
+} DltUserInjectionWorker;
+
+static DltUserInjectionWorker dlt_injection_workers[DLT_USER_INJECTION_WORKERS];
+/* Workers are published to the receiver thread under this mutex */
+static pthread_mutex_t dlt_injection_workers_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int dlt_injection_workers_started = 0;
+
 /* Segmented Network Trace */
 #define DLT_MAX_TRACE_SEGMENT_SIZE 1024
 #define DLT_MESSAGE_QUEUE_NAME "/dlt_message_queue"
@@ -132,6 +175,13 @@ static int dlt_user_log_send_log_mode(DltUserLogMode mode);
 static int dlt_user_print_msg(DltMessage *msg, DltContextData *log);
 static int dlt_user_log_check_user_message(void);
 static void dlt_user_log_reattach_to_daemon(void);
+static uint32_t dlt_user_injection_hash(int32_t log_level_pos, uint32_t service_id);
+static DltUserInjectionEntry *dlt_user_injection_find(int32_t log_level_pos, uint32_t service_id);
+static void dlt_user_injection_clear(int32_t log_level_pos);
+static void dlt_user_injection_start_workers(void);
+static void dlt_user_injection_stop_workers(void);
+static void dlt_user_injection_purge(int32_t log_level_pos);
+static void dlt_user_injection_dispatch(DltUserInjectionEntry *entry, unsigned char *data, uint32_t length);
 static int dlt_user_log_send_overflow(void);
 static void dlt_user_trace_network_segmented_thread(void *unused);
 static int dlt_user_queue_resend(void);
@@ -488,8 +538,17 @@ int dlt_free(void)
     {
     	/* Ignore return value */
         pthread_cancel(dlt_receiverthread_handle);
+        if (!pthread_equal(dlt_receiverthread_handle, pthread_self()))
+        {
+            pthread_join(dlt_receiverthread_handle, NULL);
+        }
+        dlt_receiverthread_handle = 0;
     }
 
+    /* Receiver thread is stopped, injection callbacks can be released */
+    dlt_user_injection_stop_workers();
+    dlt_user_injection_clear(-1);
+
     if (dlt_user.dlt_user_handle!=DLT_FD_INIT)
     {
         sprintf(filename,"%s/dlt%d",DLT_USER_DIR,getpid());
@@ -967,10 +1026,15 @@ int dlt_unregister_context(DltContext *handle)
         }
 
         dlt_user.dlt_ll_ts[handle->log_level_pos].nrcallbacks     = 0;
+
+        dlt_user_injection_clear(handle->log_level_pos);
     }
 
     DLT_SEM_FREE();
 
+    /* Callbacks may log, so pending injections are removed without the DLT semaphore */
+    dlt_user_injection_purge(handle->log_level_pos);
+
     /* Inform daemon to unregister context */
     ret = dlt_user_log_send_unregister_context(&log);
 
@@ -1781,6 +1845,8 @@ int dlt_register_injection_callback(DltContext *handle, uint32_t service_id,
     int found = 0;
 
 	DltUserInjectionCallback *old;
+    DltUserInjectionEntry *entry;
+    uint32_t hash;
 
     if (handle==0)
     {
@@ -1864,10 +1930,302 @@ int dlt_register_injection_callback(DltContext *handle, uint32_t service_id,
     dlt_user.dlt_ll_ts[i].injection_table[j].service_id = service_id;
     dlt_user.dlt_ll_ts[i].injection_table[j].injection_callback = dlt_injection_callback;
 
+    /* Update lookup index used by receiver thread */
+    entry = dlt_user_injection_find(i, service_id);
+    if (entry == 0)
+    {
+        entry = (DltUserInjectionEntry*) malloc(sizeof(DltUserInjectionEntry));
+        if (entry == 0)
+        {
+            DLT_SEM_FREE();
+            return -1;
+        }
+        hash = dlt_user_injection_hash(i, service_id);
+        entry->log_level_pos = i;
+        entry->service_id = service_id;
+        entry->injection_callback = dlt_injection_callback;
+        entry->next = dlt_injection_hash[hash];
+
+        /* Publish entry only after it is completely initialised */
+        __sync_synchronize();
+        dlt_injection_hash[hash] = entry;
+    }
+    else
+    {
+        entry->injection_callback = dlt_injection_callback;
+    }
+
+    dlt_user_injection_start_workers();
+
     DLT_SEM_FREE();
     return 0;
 }
 
+uint32_t dlt_user_injection_hash(int32_t log_level_pos, uint32_t service_id)
+{
+    uint32_t hash = (uint32_t)log_level_pos * 0x9E3779B1 + service_id;
+
+    hash ^= hash >> 15;
+
+    return hash & (DLT_USER_INJECTION_HASH_SIZE - 1);
+}
+
+DltUserInjectionEntry *dlt_user_injection_find(int32_t log_level_pos, uint32_t service_id)
+{
+    DltUserInjectionEntry *entry;
+
+    for (entry = dlt_injection_hash[dlt_user_injection_hash(log_level_pos, service_id)]; entry != 0; entry = entry->next)
+    {
+        if (entry->log_level_pos == log_level_pos && entry->service_id == service_id)
+        {
+            return entry;
+        }
+    }
+
+    return 0;
+}
+
+void dlt_user_injection_clear(int32_t log_level_pos)
+{
+    DltUserInjectionEntry *entry, *next;
+    uint32_t i;
+
+    for (i = 0; i < DLT_USER_INJECTION_HASH_SIZE; i++)
+    {
+        if (log_level_pos >= 0)
+        {
+            /* Entry may still be in use by receiver thread, only disable callback */
+            for (entry = dlt_injection_hash[i]; entry != 0; entry = entry->next)
+            {
+                if (entry->log_level_pos == log_level_pos)
+                {
+                    entry->injection_callback = 0;
+                }
+            }
+        }
+        else
+        {
+            for (entry = dlt_injection_hash[i]; entry != 0; entry = next)
+            {
+                next = entry->next;
+                free(entry);
+            }
+            dlt_injection_hash[i] = 0;
+        }
+    }
+}
+
+static void *dlt_user_injection_worker_function(void *ptr)
+{
+    DltUserInjectionWorker *worker = (DltUserInjectionWorker*) ptr;
+    DltUserInjectionJob job;
+    int (*injection_callback)(uint32_t service_id, void *data, uint32_t length);
+
+    while (1)
+    {
+        pthread_mutex_lock(&(worker->mutex));
+        while (worker->count == 0 && !worker->stop)
+        {
+            pthread_cond_wait(&(worker->cond), &(worker->mutex));
+        }
+        if (worker->count == 0)
+        {
+            pthread_mutex_unlock(&(worker->mutex));
+            break;
+        }
+        job = worker->jobs[worker->read];
+        worker->read = (worker->read + 1) % DLT_USER_INJECTION_QUEUE_SIZE;
+        worker->count--;
+
+        /* Callback is cleared before dlt_user_injection_purge() takes the mutex */
+        injection_callback = job.entry->injection_callback;
+        worker->busy_pos = job.entry->log_level_pos;
+        pthread_mutex_unlock(&(worker->mutex));
+
+        if (injection_callback != 0)
+        {
+            injection_callback(job.entry->service_id, job.data, job.length);
+        }
+        free(job.data);
+
+        pthread_mutex_lock(&(worker->mutex));
+        worker->busy_pos = -1;
+        pthread_cond_broadcast(&(worker->done));
+        pthread_mutex_unlock(&(worker->mutex));
+    }
+
+    return NULL;
+}
+
+void dlt_user_injection_start_workers(void)
+{
+    uint32_t i;
+
+    pthread_mutex_lock(&dlt_injection_workers_mutex);
+    if (dlt_injection_workers_started)
+    {
+        pthread_mutex_unlock(&dlt_injection_workers_mutex);
+        return;
+    }
+
+    for (i = 0; i < DLT_USER_INJECTION_WORKERS; i++)
+    {
+        DltUserInjectionWorker *worker = &(dlt_injection_workers[i]);
+
+        worker->read = 0;
+        worker->count = 0;
+        worker->busy_pos = -1;
+        worker->stop = 0;
+        pthread_mutex_init(&(worker->mutex), NULL);
+        pthread_cond_init(&(worker->cond), NULL);
+        pthread_cond_init(&(worker->done), NULL);
+        worker->running = 1;
+
+        /* Without worker, callbacks are executed by receiver thread */
+        if (pthread_create(&(worker->thread), NULL, dlt_user_injection_worker_function, worker) != 0)
+        {
+            worker->running = 0;
+            dlt_log(LOG_WARNING, "Can't create injection worker thread!\n");
+        }
+    }
+
+    /* Workers are completely initialised, publish them */
+    dlt_injection_workers_started = 1;
+    pthread_mutex_unlock(&dlt_injection_workers_mutex);
+}
+
+void dlt_user_injection_stop_workers(void)
+{
+    uint32_t i;
+
+    /* Withdraw workers first, dispatch does not use them afterwards */
+    pthread_mutex_lock(&dlt_injection_workers_mutex);
+    if (!dlt_injection_workers_started)
+    {
+        pthread_mutex_unlock(&dlt_injection_workers_mutex);
+        return;
+    }
+    dlt_injection_workers_started = 0;
+    pthread_mutex_unlock(&dlt_injection_workers_mutex);
+
+    for (i = 0; i < DLT_USER_INJECTION_WORKERS; i++)
+    {
+        DltUserInjectionWorker *worker = &(dlt_injection_workers[i]);
+
+        if (worker->running)
+        {
+            /* Pending injections are still executed */
+            pthread_mutex_lock(&(worker->mutex));
+            worker->stop = 1;
+            pthread_cond_signal(&(worker->cond));
+            pthread_mutex_unlock(&(worker->mutex));
+            if (!pthread_equal(worker->thread, pthread_self()))
+            {
+                pthread_join(worker->thread, NULL);
+            }
+            worker->running = 0;
+        }
+        pthread_mutex_destroy(&(worker->mutex));
+        pthread_cond_destroy(&(worker->cond));
+        pthread_cond_destroy(&(worker->done));
+    }
+}
+
+void dlt_user_injection_purge(int32_t log_level_pos)
+{
+    DltUserInjectionWorker *worker = &(dlt_injection_workers[(uint32_t)log_level_pos % DLT_USER_INJECTION_WORKERS]);
+    uint32_t i, kept;
+
+    pthread_mutex_lock(&dlt_injection_workers_mutex);
+    if (!dlt_injection_workers_started || !worker->running)
+    {
+        pthread_mutex_unlock(&dlt_injection_workers_mutex);
+        return;
+    }
+    pthread_mutex_lock(&(worker->mutex));
+    pthread_mutex_unlock(&dlt_injection_workers_mutex);
+
+    /* Remove pending jobs of the context, the order of the others is kept */
+    for (i = 0, kept = 0; i < worker->count; i++)
+    {
+        DltUserInjectionJob *job = &(worker->jobs[(worker->read + i) % DLT_USER_INJECTION_QUEUE_SIZE]);
+
+        if (job->entry->log_level_pos == log_level_pos)
+        {
+            free(job->data);
+        }
+        else
+        {
+            worker->jobs[(worker->read + kept) % DLT_USER_INJECTION_QUEUE_SIZE] = *job;
+            kept++;
+        }
+    }
+    worker->count = kept;
+
+    /* Wait for a running callback of the context, unless it unregisters its own context */
+    if (!pthread_equal(worker->thread, pthread_self()))
+    {
+        while (worker->busy_pos == log_level_pos)
+        {
+            pthread_cond_wait(&(worker->done), &(worker->mutex));
+        }
+    }
+    pthread_mutex_unlock(&(worker->mutex));
+}
+
+void dlt_user_injection_dispatch(DltUserInjectionEntry *entry, unsigned char *data, uint32_t length)
+{
+    DltUserInjectionWorker *worker = &(dlt_injection_workers[(uint32_t)entry->log_level_pos % DLT_USER_INJECTION_WORKERS]);
+    DltUserInjectionJob *job;
+    int (*injection_callback)(uint32_t service_id, void *data, uint32_t length);
+    unsigned char *copy;
+    char msg[255];
+
+    /* Buffer of receiver is reused, callback gets a copy */
+    copy = malloc(length);
+    if (copy == 0)
+    {
+        return;
+    }
+    memcpy(copy, data, length);
+
+    pthread_mutex_lock(&dlt_injection_workers_mutex);
+    if (dlt_injection_workers_started && worker->running)
+    {
+        pthread_mutex_lock(&(worker->mutex));
+        if (worker->count < DLT_USER_INJECTION_QUEUE_SIZE && !worker->stop)
+        {
+            job = &(worker->jobs[(worker->read + worker->count) % DLT_USER_INJECTION_QUEUE_SIZE]);
+            job->entry = entry;
+            job->length = length;
+            job->data = copy;
+            worker->count++;
+            pthread_cond_signal(&(worker->cond));
+            copy = 0;
+        }
+        pthread_mutex_unlock(&(worker->mutex));
+        pthread_mutex_unlock(&dlt_injection_workers_mutex);
+
+        /* Queue full: drop injection instead of blocking the receiver thread */
+        if (copy != 0)
+        {
+            snprintf(msg, sizeof(msg), "Injection queue full, service id %u dropped!\n", entry->service_id);
+            dlt_log(LOG_WARNING, msg);
+            free(copy);
+        }
+        return;
+    }
+    pthread_mutex_unlock(&dlt_injection_workers_mutex);
+
+    /* No worker available: execute in receiver thread */
+    injection_callback = entry->injection_callback;
+    if (injection_callback != 0)
+    {
+        injection_callback(entry->service_id, copy, length);
+    }
+    free(copy);
+}
+
 /**
  * NW Trace related
  */
@@ -3315,8 +3673,6 @@ int dlt_user_log_check_user_message(void)
     int offset=0;
     int leave_while=0;
 
-    uint32_t i;
-
     DltUserHeader *userheader;
     DltReceiver *receiver = &(dlt_user.receiver);
 
@@ -3325,14 +3681,7 @@ int dlt_user_log_check_user_message(void)
     DltUserControlMsgLogState *userlogstate;
     unsigned char *userbuffer;
 
-    /* For delayed calling of injection callback, to avoid deadlock */
-    DltUserInjectionCallback 	delayed_injection_callback;
-    unsigned char				*delayed_inject_buffer = 0;
-    uint32_t					delayed_inject_data_length = 0;
-
-    /* Ensure that callback is null before searching for it */
-    delayed_injection_callback.injection_callback = 0;
-    delayed_injection_callback.service_id = 0;
+    DltUserInjectionEntry *injentry;
 
     if (dlt_user.dlt_user_handle!=DLT_FD_INIT)
     {
@@ -3439,41 +3788,16 @@ int dlt_user_log_check_user_message(void)
                             break;
                         }
 
-                        DLT_SEM_LOCK();
-
-                        if ((usercontextinj->data_length_inject>0) && (dlt_user.dlt_ll_ts))
+                        /* Lookup of callback without lock, see dlt_register_injection_callback() */
+                        if (usercontextinj->data_length_inject>0)
                         {
-                            /* Check if injection callback is registered for this context */
-                            for (i=0; i<dlt_user.dlt_ll_ts[usercontextinj->log_level_pos].nrcallbacks;i++)
+                            injentry = dlt_user_injection_find(usercontextinj->log_level_pos, usercontextinj->service_id);
+                            if (injentry != 0 && injentry->injection_callback != 0)
                             {
-                                if ((dlt_user.dlt_ll_ts[usercontextinj->log_level_pos].injection_table) &&
-                                        (dlt_user.dlt_ll_ts[usercontextinj->log_level_pos].injection_table[i].service_id == usercontextinj->service_id))
-                                {
-                                	/* Prepare delayed injection callback call */
-									if (dlt_user.dlt_ll_ts[usercontextinj->log_level_pos].injection_table[i].injection_callback!=0)
-									{
-										delayed_injection_callback.injection_callback = dlt_user.dlt_ll_ts[usercontextinj->log_level_pos].injection_table[i].injection_callback;
-										delayed_injection_callback.service_id = usercontextinj->service_id;
-										delayed_inject_data_length = usercontextinj->data_length_inject;
-										delayed_inject_buffer = malloc(delayed_inject_data_length);
-										if(delayed_inject_buffer != 0) {
-											memcpy(delayed_inject_buffer, userbuffer, delayed_inject_data_length);
-										}
-
-									}
-                                    break;
-                                }
+                                dlt_user_injection_dispatch(injentry, userbuffer, usercontextinj->data_length_inject);
                             }
                         }
 
-                        DLT_SEM_FREE();
-
-                        /* Delayed injection callback call */
-                        if(delayed_inject_buffer != 0 && delayed_injection_callback.injection_callback != 0) {
-                        	delayed_injection_callback.injection_callback(delayed_injection_callback.service_id, delayed_inject_buffer, delayed_inject_data_length);
-                        	free(delayed_inject_buffer);
-                        }
-
                         /* keep not read data in buffer */
                         if (dlt_receiver_remove(receiver,(sizeof(DltUserHeader)+sizeof(DltUserControlMsgInjection)+usercontextinj->data_length_inject))==-1)
 						{
@@ -123,6 +123,15 @@
 /* Sleeps between resending user buffer at exit in usec (1000 usec = 1ms)*/
 #define DLT_USER_ATEXIT_RESEND_BUFFER_SLEEP 1000
 
+/* Size of hash table for lookup of injection callbacks, must be a power of two */
+#define DLT_USER_INJECTION_HASH_SIZE 256
+
+/* Number of threads executing injection callbacks */
+#define DLT_USER_INJECTION_WORKERS 2
+
+/* Maximum number of pending injections per worker thread, further injections are dropped */
+#define DLT_USER_INJECTION_QUEUE_SIZE 64
+
 
 /************************/
 /* Don't change please! */
@@ -2270,6 +2270,67 @@ int dlt_set_storageheader(DltStorageHeader *storageheader, const char *ecu)
     return 0;
 }
 
+int dlt_storageheader_cache_init(DltStorageHeaderCache *cache, const char *ecu)
+{
+    if (cache==0)
+    {
+        return -1;
+    }
+
+    /* encode pattern and ecu id once */
+    if (dlt_set_storageheader(&(cache->header),ecu)==-1)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+int dlt_storageheader_cache_update(DltStorageHeaderCache *cache)
+{
+#if !defined(_MSC_VER)
+    struct timespec ts;
+#endif
+
+    if (cache==0)
+    {
+        return -1;
+    }
+
+    /* all messages of one batch are received at the same time */
+#if defined(_MSC_VER)
+    time(&(cache->header.seconds));
+    cache->header.microseconds = 0;
+#else
+    if (clock_gettime(CLOCK_REALTIME,&ts)!=0)
+    {
+        return -1;
+    }
+    cache->header.seconds = (uint32_t)ts.tv_sec;
+    cache->header.microseconds = (int32_t)(ts.tv_nsec / 1000);
+#endif
+
+    return 0;
+}
+
+int dlt_set_storageheader_cached(DltStorageHeader *storageheader, DltStorageHeaderCache *cache, const char *ecu)
+{
+    if ((storageheader==0) || (cache==0))
+    {
+        return -1;
+    }
+
+    memcpy(storageheader,&(cache->header),sizeof(DltStorageHeader));
+
+    /* same comparison as dlt_set_id(), ecu id may not be terminated */
+    if ((ecu==0) || (strncmp(ecu,cache->header.ecu,DLT_ID_SIZE)!=0))
+    {
+        dlt_set_id(storageheader->ecu,ecu);
+    }
+
+    return 0;
+}
+
 int dlt_check_storageheader(DltStorageHeader *storageheader)
 {
     if (storageheader==0)
@@ -2795,6 +2856,264 @@ int dlt_buffer_get_message_count(DltBuffer *buf)
 	return ((int*)(buf->shm))[2];
 }
 
+static DltBufferChunk *dlt_segmented_buffer_alloc_chunk(DltSegmentedBuffer *buf)
+{
+	DltBufferChunk *chunk;
+
+	if(buf->pool) {
+		chunk = buf->pool;
+		buf->pool = chunk->next;
+		buf->pool_count--;
+	}
+	else {
+		if(buf->chunks >= buf->max_chunks) {
+			return 0;
+		}
+		chunk = malloc(sizeof(DltBufferChunk) + buf->chunk_entries * sizeof(uint16_t) + buf->chunk_size);
+		if(chunk == 0) {
+			return 0;
+		}
+		chunk->ends = (uint16_t *)(chunk + 1);
+		chunk->data = (unsigned char *)(chunk->ends + buf->chunk_entries);
+		buf->chunks++;
+	}
+
+	chunk->next = 0;
+	chunk->write = 0;
+	chunk->read = 0;
+	chunk->count = 0;
+	chunk->first = 0;
+
+	return chunk;
+}
+
+static void dlt_segmented_buffer_release_chunk(DltSegmentedBuffer *buf, DltBufferChunk *chunk)
+{
+	if(buf->chunks > buf->min_chunks) {
+		free(chunk);
+		buf->chunks--;
+	}
+	else {
+		chunk->next = buf->pool;
+		buf->pool = chunk;
+		buf->pool_count++;
+	}
+}
+
+int dlt_segmented_buffer_init(DltSegmentedBuffer *buf, uint32_t min_size, uint32_t max_size, uint32_t chunk_size)
+{
+	char str[256];
+	DltBufferChunk *chunk;
+	uint32_t i;
+
+	if(chunk_size == 0 || chunk_size > 0xffff || max_size < chunk_size) {
+		dlt_log(LOG_ERR,"Buffer: Invalid chunk size\n");
+		return -1;
+	}
+
+	memset(buf,0,sizeof(DltSegmentedBuffer));
+	buf->chunk_size = chunk_size;
+	/* a chunk is closed early if it is filled with many small entries */
+	buf->chunk_entries = chunk_size / 16;
+	buf->min_chunks = (min_size + chunk_size - 1) / chunk_size;
+	buf->max_chunks = max_size / chunk_size;
+
+	/* fill pool with minimum number of chunks */
+	for(i = 0; i < buf->min_chunks; i++) {
+		chunk = dlt_segmented_buffer_alloc_chunk(buf);
+		if(chunk == 0) {
+			snprintf(str,sizeof(str),"Buffer: Cannot allocate %u bytes\n",min_size);
+			dlt_log(LOG_EMERG, str);
+			dlt_segmented_buffer_free(buf);
+			return -1;
+		}
+		chunk->next = buf->pool;
+		buf->pool = chunk;
+		buf->pool_count++;
+	}
+
+	return 0; /* OK */
+}
+
+int dlt_segmented_buffer_free(DltSegmentedBuffer *buf)
+{
+	DltBufferChunk *chunk;
+
+	while(buf->head) {
+		chunk = buf->head;
+		buf->head = chunk->next;
+		free(chunk);
+	}
+	while(buf->pool) {
+		chunk = buf->pool;
+		buf->pool = chunk->next;
+		free(chunk);
+	}
+	buf->tail = 0;
+	buf->chunks = 0;
+	buf->pool_count = 0;
+	buf->used = 0;
+	buf->count = 0;
+
+	return 0;
+}
+
+int dlt_segmented_buffer_push3(DltSegmentedBuffer *buf,const unsigned char *data1,unsigned int size1,const unsigned char *data2,unsigned int size2,const unsigned char *data3,unsigned int size3)
+{
+	DltBufferChunk *chunk = buf->tail;
+	unsigned int size = size1 + size2 + size3;
+	unsigned char *ptr;
+
+	if(size == 0 || size > buf->chunk_size) {
+		dlt_log(LOG_ERR,"Buffer: Entry does not fit into chunk\n");
+		return -1; /* ERROR */
+	}
+
+	/* entries never span chunks, start a new chunk if the entry does not fit */
+	if(chunk == 0 || chunk->write + size > buf->chunk_size || chunk->count >= buf->chunk_entries) {
+		chunk = dlt_segmented_buffer_alloc_chunk(buf);
+		if(chunk == 0) {
+			dlt_log(LOG_ERR,"Buffer: Buffer full\n");
+			return -1; /* ERROR */
+		}
+		if(buf->tail) {
+			buf->tail->next = chunk;
+		}
+		else {
+			buf->head = chunk;
+		}
+		buf->tail = chunk;
+	}
+
+	ptr = chunk->data + chunk->write;
+	if(data1 && size1) {
+		memcpy(ptr,data1,size1);
+		ptr += size1;
+	}
+	if(data2 && size2) {
+		memcpy(ptr,data2,size2);
+		ptr += size2;
+	}
+	if(data3 && size3) {
+		memcpy(ptr,data3,size3);
+	}
+	chunk->write += size;
+	chunk->ends[chunk->count++] = chunk->write;
+
+	buf->used += size;
+	buf->count++;
+
+	return 0; /* OK */
+}
+
+int dlt_segmented_buffer_remove(DltSegmentedBuffer *buf, int count)
+{
+	DltBufferChunk *chunk;
+	int removed = 0;
+
+	while(removed < count && buf->head) {
+		chunk = buf->head;
+		if(chunk->first < chunk->count) {
+			buf->used -= chunk->ends[chunk->first] - chunk->read;
+			chunk->read = chunk->ends[chunk->first];
+			chunk->first++;
+			buf->count--;
+			removed++;
+		}
+		/* return empty chunk to pool, except the chunk currently written */
+		if(chunk->first >= chunk->count && chunk != buf->tail) {
+			buf->head = chunk->next;
+			dlt_segmented_buffer_release_chunk(buf,chunk);
+		}
+		else if(chunk->first >= chunk->count) {
+			/* last chunk is empty, reuse it from the beginning */
+			chunk->write = 0;
+			chunk->read = 0;
+			chunk->count = 0;
+			chunk->first = 0;
+			break;
+		}
+	}
+
+	return removed;
+}
+
+int dlt_segmented_buffer_pull(DltSegmentedBuffer *buf,unsigned char *data, int max_size)
+{
+	DltBufferChunk *chunk = buf->head;
+	int size;
+
+	if(chunk == 0 || chunk->first >= chunk->count) {
+		return 0; /* no data */
+	}
+
+	size = chunk->ends[chunk->first] - chunk->read;
+	if(size > max_size) {
+		dlt_log(LOG_ERR,"Buffer: Max size is smaller than read size\n");
+		return -1; /* ERROR */
+	}
+	memcpy(data,chunk->data + chunk->read,size);
+	dlt_segmented_buffer_remove(buf,1);
+
+	return size;
+}
+
+int dlt_segmented_buffer_get_used_size(DltSegmentedBuffer *buf)
+{
+	return buf->used;
+}
+
+int dlt_segmented_buffer_get_message_count(DltSegmentedBuffer *buf)
+{
+	return buf->count;
+}
+
+#if !defined (__WIN32__)
+
+int dlt_segmented_buffer_iov(DltSegmentedBuffer *buf, struct iovec *iov, int max_iov, const void *prefix, int prefix_size, int *count)
+{
+	DltBufferChunk *chunk;
+	uint32_t entry, offset;
+	int used = 0;
+
+	*count = 0;
+
+	for(chunk = buf->head; chunk; chunk = chunk->next) {
+		if(prefix == 0) {
+			/* entries of a chunk are contiguous */
+			if(chunk->first >= chunk->count) {
+				continue;
+			}
+			if(used >= max_iov) {
+				break;
+			}
+			iov[used].iov_base = chunk->data + chunk->read;
+			iov[used].iov_len = chunk->write - chunk->read;
+			used++;
+			*count += chunk->count - chunk->first;
+			continue;
+		}
+
+		offset = chunk->read;
+		for(entry = chunk->first; entry < chunk->count; entry++) {
+			if(used + 2 > max_iov) {
+				return used;
+			}
+			iov[used].iov_base = (void *)prefix;
+			iov[used].iov_len = prefix_size;
+			iov[used+1].iov_base = chunk->data + offset;
+			iov[used+1].iov_len = chunk->ends[entry] - offset;
+			offset = chunk->ends[entry];
+			used += 2;
+			(*count)++;
+		}
+	}
+
+	return used;
+}
+
+#endif
+
 #if !defined (__WIN32__)
 
 int dlt_setup_serial(int fd, speed_t speed)
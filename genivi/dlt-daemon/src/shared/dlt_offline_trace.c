@@ -65,7 +65,8 @@
 int dlt_offline_trace_create_new_file(DltOfflineTrace *trace) {
     time_t t;
     struct tm *tmp;
-    char outstr[200];
+    char outstr[32];
+    int index;
 
 	/* set filename */
     t = time(NULL);
@@ -74,7 +75,23 @@ int dlt_offline_trace_create_new_file(DltOfflineTrace *trace) {
     }
     if (strftime(outstr, sizeof(outstr),"%Y%m%d_%H%M%S", tmp) == 0) {
     }
-	sprintf(trace->filename,"%s/dlt_offlinetrace_%s.dlt",trace->directory,outstr);
+
+	/* files created in the same second get an increasing index, existing files are never overwritten */
+	index = 0;
+	if(strcmp(outstr,trace->timestamp) == 0) {
+		index = trace->index + 1;
+	}
+	while(1) {
+		if(index == 0)
+			sprintf(trace->filename,"%s/dlt_offlinetrace_%s.dlt",trace->directory,outstr);
+		else
+			sprintf(trace->filename,"%s/dlt_offlinetrace_%s_%03d.dlt",trace->directory,outstr,index);
+		if(access(trace->filename, F_OK) != 0 || index >= 999)
+			break;
+		index++;
+	}
+	strcpy(trace->timestamp,outstr);
+	trace->index = index;
 
     /* open DLT output file */
 	trace->ohandle = open(trace->filename,O_WRONLY|O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH); /* mode: wb */
@@ -126,7 +143,9 @@ int dlt_offline_trace_delete_oldest_file(DltOfflineTrace *trace) {
 		if(strstr(dp->d_name,".dlt")) {
 			sprintf(filename,"%s/%s",trace->directory,dp->d_name);
 			stat(filename,&status);
-			if(time_oldest == 0 || status.st_mtime < time_oldest) {
+			/* files of the same second are ordered by name */
+			if(time_oldest == 0 || status.st_mtime < time_oldest ||
+			   (status.st_mtime == time_oldest && strcmp(filename,filename_oldest) < 0)) {
 				time_oldest = status.st_mtime;
 				size_oldest = status.st_size;
 				strcpy(filename_oldest,filename);
@@ -169,6 +188,8 @@ int dlt_offline_trace_init(DltOfflineTrace *trace,const char *directory,int file
 
 	/* init parameters */
 	strcpy(trace->directory,directory);
+	trace->timestamp[0] = 0;
+	trace->index = 0;
 	trace->fileSize = fileSize;
 	trace->maxSize = maxSize;
 
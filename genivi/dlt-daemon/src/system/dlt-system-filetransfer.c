@@ -44,6 +44,8 @@
 
 #include <pthread.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <sys/inotify.h>
 #include <libgen.h>
 #include <dirent.h>
@@ -58,7 +60,8 @@
 
 #define INOTIFY_SZ (sizeof(struct inotify_event))
 #define INOTIFY_LEN (INOTIFY_SZ + 256)
-#define Z_CHUNK_SZ 1024*128
+// Size of the uncompressed blocks, which are compressed independently
+#define Z_BLOCK_SZ (1024*1024)
 
 extern DltSystemThreads threads;
 // From dlt_filetransfer
@@ -74,6 +77,55 @@ typedef struct {
 
 s_ft_inotify ino;
 
+/**
+ * File transfer pipeline.
+ * Files found in any of the watched directories are moved to the
+ * temporary directory and split into blocks. The blocks of all files go
+ * into one work queue, from which the compression threads take them.
+ * Each block is compressed into a gzip member of its own, so the blocks
+ * can be compressed in parallel; the concatenated members are a valid
+ * gzip file. Completed files go into the ready queue, from which the
+ * sender thread transfers them while the next files are compressed.
+ */
+struct s_ft_file;
+
+typedef struct s_ft_block {
+	struct s_ft_file *file;
+	off_t offset;
+	size_t len;
+	unsigned char *out;
+	size_t out_len;
+	int done;
+	struct s_ft_block *next;
+} s_ft_block;
+
+typedef struct s_ft_file {
+	char *path;         // file to be sent
+	char *src;          // uncompressed file while compressing
+	char *alias;        // file name used in transfer
+	int  src_fd;
+	int  dst_fd;
+	int  level;
+	int  blocks;
+	int  written;
+	int  writing;
+	int  error;
+	s_ft_block *block;
+	struct s_ft_file *next;
+} s_ft_file;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t  work_cond;
+	pthread_cond_t  ready_cond;
+	s_ft_block *work_head;
+	s_ft_block *work_tail;
+	s_ft_file  *ready_head;
+	s_ft_file  *ready_tail;
+} s_ft_pipeline;
+
+s_ft_pipeline pipeline = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, NULL, NULL };
+
 char *unique_name(const char *src)
 {
 	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
@@ -87,125 +139,332 @@ char *unique_name(const char *src)
 	return ret;
 }
 
-char *compress_file(char *src, int level)
+void free_file(s_ft_file *file)
 {
-	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
-			DLT_STRING("dlt-system-filetransfer, compressing file."));
-	char *buf;
-	char *dst = malloc(strlen(src)+4);
-	MALLOC_ASSERT(dst);
-	char dst_mode[8];
-	sprintf(dst, "%s.gz", src);
-	sprintf(dst_mode, "wb%d", level);
-
-	gzFile dst_file;
-	FILE *src_file;
-
-	dst_file = gzopen(dst, dst_mode);
-	if(dst_file == Z_NULL)
+	free(file->path);
+	free(file->src);
+	free(file->alias);
+	free(file->block);
+	free(file);
+}
+
+/**
+ * Put a file into the ready queue of the sender thread.
+ */
+void ready_file(s_ft_file *file)
+{
+	pthread_mutex_lock(&pipeline.mutex);
+	file->next = NULL;
+	if(pipeline.ready_tail != NULL)
+		pipeline.ready_tail->next = file;
+	else
+		pipeline.ready_head = file;
+	pipeline.ready_tail = file;
+	pthread_cond_signal(&pipeline.ready_cond);
+	pthread_mutex_unlock(&pipeline.mutex);
+}
+
+/**
+ * Compress one block into a complete gzip member.
+ */
+int compress_block(s_ft_block *block)
+{
+	z_stream strm;
+	unsigned char *in;
+	int ret;
+
+	in = malloc(block->len > 0 ? block->len : 1);
+	MALLOC_ASSERT(in);
+	if(pread(block->file->src_fd, in, block->len, block->offset) != (ssize_t) block->len)
 	{
-		free(dst);
-		return NULL;
+		free(in);
+		return -1;
+	}
+
+	memset(&strm, 0, sizeof(strm));
+	// window bits + 16 writes a gzip header and trailer
+	if(deflateInit2(&strm, block->file->level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		free(in);
+		return -1;
 	}
+	block->out = malloc(deflateBound(&strm, block->len));
+	MALLOC_ASSERT(block->out);
+
+	strm.next_in = in;
+	strm.avail_in = block->len;
+	strm.next_out = block->out;
+	strm.avail_out = deflateBound(&strm, block->len);
+	ret = deflate(&strm, Z_FINISH);
+	block->out_len = strm.total_out;
+	deflateEnd(&strm);
+	free(in);
+
+	return (ret == Z_STREAM_END) ? 0 : -1;
+}
 
-	src_file = fopen(src, "r");
+/**
+ * Write all compressed blocks of a file, which are ready, in order.
+ * Must be called with the pipeline mutex held; the mutex is released on
+ * return. Only one thread writes a file at a time, and only the thread
+ * which writes the last block hands the file over to the sender thread,
+ * so the caller must not touch the file or its blocks afterwards.
+ */
+void write_blocks(s_ft_file *file)
+{
+	s_ft_block *block;
+	int error;
 
-	if(src_file == NULL)
+	if(file->writing)
 	{
-		gzclose(dst_file);
-		free(dst);
-		return NULL;
+		// the thread writing the file also writes the block just done
+		pthread_mutex_unlock(&pipeline.mutex);
+		return;
+	}
+	file->writing = 1;
+	while(file->written < file->blocks && file->block[file->written].done)
+	{
+		block = &file->block[file->written];
+		error = file->error;
+		pthread_mutex_unlock(&pipeline.mutex);
+
+		if(!error && write(file->dst_fd, block->out, block->out_len) != (ssize_t) block->out_len)
+			error = 1;
+		free(block->out);
+		block->out = NULL;
+
+		pthread_mutex_lock(&pipeline.mutex);
+		if(error)
+			file->error = 1;
+		file->written++;
+	}
+	file->writing = 0;
+	if(file->written < file->blocks)
+	{
+		pthread_mutex_unlock(&pipeline.mutex);
+		return;
+	}
+	error = file->error;
+	pthread_mutex_unlock(&pipeline.mutex);
+
+	close(file->src_fd);
+	close(file->dst_fd);
+	if(error)
+	{
+		DLT_LOG(dltsystem, DLT_LOG_ERROR, DLT_STRING("Could not compress file"), DLT_STRING(file->src));
+		remove(file->path);
+		free_file(file);
+		return;
 	}
+	if(remove(file->src) < 0)
+		DLT_LOG(dltsystem, DLT_LOG_WARN, DLT_STRING("Could not remove file"), DLT_STRING(file->src));
+	ready_file(file);
+}
 
-	buf = malloc(Z_CHUNK_SZ);
-	MALLOC_ASSERT(buf);
+void compress_thread(void *v_conf)
+{
+	(void) v_conf;
+	s_ft_block *block;
+	int error;
 
-	while(!feof(src_file))
+	while(!threads.shutdown)
 	{
-		int read = fread(buf, 1, Z_CHUNK_SZ, src_file);
-		if(ferror(src_file))
-		{
-			free(buf);
-			free(dst);
-			gzclose(dst_file);
-			return NULL;
-		}
-		gzwrite(dst_file, buf, read);
+		pthread_mutex_lock(&pipeline.mutex);
+		while(pipeline.work_head == NULL)
+			pthread_cond_wait(&pipeline.work_cond, &pipeline.mutex);
+		block = pipeline.work_head;
+		pipeline.work_head = block->next;
+		if(pipeline.work_head == NULL)
+			pipeline.work_tail = NULL;
+		pthread_mutex_unlock(&pipeline.mutex);
+
+		error = compress_block(block) < 0;
+
+		pthread_mutex_lock(&pipeline.mutex);
+		block->done = 1;
+		if(error)
+			block->file->error = 1;
+		write_blocks(block->file);
 	}
+}
+
+/**
+ * Split a file into blocks and put them into the work queue.
+ */
+int compress_file(s_ft_file *file)
+{
+	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
+			DLT_STRING("dlt-system-filetransfer, compressing file."));
+	struct stat st;
+	int i;
 
-	if(remove(src) < 0)
-		DLT_LOG(dltsystem, DLT_LOG_WARN, DLT_STRING("Could not remove file"), DLT_STRING(src));
-	free(buf);
-	fclose(src_file);
-	gzclose(dst_file);
-	return dst;
+	file->src = file->path;
+	file->path = malloc(strlen(file->src)+4);
+	MALLOC_ASSERT(file->path);
+	sprintf(file->path, "%s.gz", file->src);
+
+	file->src_fd = open(file->src, O_RDONLY);
+	if(file->src_fd < 0)
+		return -1;
+	if(fstat(file->src_fd, &st) < 0)
+	{
+		close(file->src_fd);
+		return -1;
+	}
+	file->dst_fd = open(file->path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+	if(file->dst_fd < 0)
+	{
+		close(file->src_fd);
+		return -1;
+	}
+
+	// an empty file still gets one (empty) gzip member
+	file->blocks = st.st_size > 0 ? (st.st_size + Z_BLOCK_SZ - 1) / Z_BLOCK_SZ : 1;
+	file->block = calloc(file->blocks, sizeof(s_ft_block));
+	MALLOC_ASSERT(file->block);
+	for(i = 0;i < file->blocks;i++)
+	{
+		file->block[i].file = file;
+		file->block[i].offset = (off_t) i * Z_BLOCK_SZ;
+		file->block[i].len = (i == file->blocks - 1) ? st.st_size - file->block[i].offset : Z_BLOCK_SZ;
+		file->block[i].next = (i < file->blocks - 1) ? &file->block[i+1] : NULL;
+	}
+
+	pthread_mutex_lock(&pipeline.mutex);
+	if(pipeline.work_tail != NULL)
+		pipeline.work_tail->next = &file->block[0];
+	else
+		pipeline.work_head = &file->block[0];
+	pipeline.work_tail = &file->block[file->blocks - 1];
+	pthread_cond_broadcast(&pipeline.work_cond);
+	pthread_mutex_unlock(&pipeline.mutex);
+
+	return 0;
 }
 
+/**
+ * Move a new file to the temporary directory and put it into the pipeline.
+ */
 int send_one(char *src, FiletransferOptions opts, int which)
 {
 	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
-			DLT_STRING("dlt-system-filetransfer, sending a file."));
-	sleep(opts.TimeDelay);
+			DLT_STRING("dlt-system-filetransfer, queueing a file."));
 
 	// Prepare all needed file names
 	char *fn = basename(src);
 	char *rn = unique_name(src);
-	char *dst = malloc(strlen(opts.TempDir)+strlen(rn)+2);
+	s_ft_file *file = calloc(1, sizeof(s_ft_file));
 	MALLOC_ASSERT(fn);
-	MALLOC_ASSERT(rn);
-	MALLOC_ASSERT(dst);
+	MALLOC_ASSERT(file);
 
-	sprintf(dst, "%s/%s", opts.TempDir, rn);
-	if(rename(src, dst) < 0)
+	file->path = malloc(strlen(opts.TempDir)+strlen(rn)+2);
+	MALLOC_ASSERT(file->path);
+	sprintf(file->path, "%s/%s", opts.TempDir, rn);
+	free(rn);
+
+	if(rename(src, file->path) < 0)
 	{
 		DLT_LOG(dltsystem, DLT_LOG_ERROR,
 				DLT_STRING("Could not move file"),
 				DLT_STRING(src),
-				DLT_STRING(dst));
-		free(rn);
-		free(dst);
+				DLT_STRING(file->path));
+		free_file(file);
 		return -1;
 	}
 
 	// Compress if needed
 	if(opts.Compression[which] > 0)
 	{
-		dst = compress_file(dst, opts.CompressionLevel[which]);
-		char *old_fn = fn;
-		fn = malloc(strlen(old_fn)+4);
-		MALLOC_ASSERT(fn);
-		sprintf(fn, "%s.gz", old_fn);
+		file->alias = malloc(strlen(fn)+4);
+		MALLOC_ASSERT(file->alias);
+		sprintf(file->alias, "%s.gz", fn);
+		file->level = opts.CompressionLevel[which];
+		if(compress_file(file) < 0)
+		{
+			DLT_LOG(dltsystem, DLT_LOG_ERROR, DLT_STRING("Could not compress file"), DLT_STRING(file->src));
+			free_file(file);
+			return -1;
+		}
+	}
+	else
+	{
+		file->alias = strdup(fn);
+		MALLOC_ASSERT(file->alias);
+		ready_file(file);
 	}
 
-	if(dlt_user_log_file_header_alias(&filetransferContext, dst, fn) == 0)
+	return 0;
+}
+
+/**
+ * Transfer completed files one after another.
+ */
+void send_thread(void *v_conf)
+{
+	DltSystemConfiguration *conf = (DltSystemConfiguration *) v_conf;
+	FiletransferOptions opts = conf->Filetransfer;
+	s_ft_file *file;
+
+	while(!threads.shutdown)
 	{
-		int pkgcount = dlt_user_log_file_packagesCount(&filetransferContext, dst);
-		int lastpkg = 0;
-		while(lastpkg < pkgcount)
+		pthread_mutex_lock(&pipeline.mutex);
+		while(pipeline.ready_head == NULL)
+			pthread_cond_wait(&pipeline.ready_cond, &pipeline.mutex);
+		file = pipeline.ready_head;
+		pipeline.ready_head = file->next;
+		if(pipeline.ready_head == NULL)
+			pipeline.ready_tail = NULL;
+		pthread_mutex_unlock(&pipeline.mutex);
+
+		DLT_LOG(dltsystem, DLT_LOG_DEBUG,
+				DLT_STRING("dlt-system-filetransfer, sending a file."));
+		sleep(opts.TimeDelay);
+
+		if(dlt_user_log_file_header_alias(&filetransferContext, file->path, file->alias) == 0)
 		{
-			int total = 2;
-			int used = 2;
-            dlt_user_check_buffer(&total, &used);
-            while((total-used) < (total/2))
+			int pkgcount = dlt_user_log_file_packagesCount(&filetransferContext, file->path);
+			int lastpkg = 0;
+			while(lastpkg < pkgcount)
 			{
-				struct timespec t;
-				t.tv_sec = 0;
-				t.tv_nsec = 1000000ul*opts.TimeoutBetweenLogs;
-				nanosleep(&t, NULL);
+				int total = 2;
+				int used = 2;
 				dlt_user_check_buffer(&total, &used);
+				while((total-used) < (total/2))
+				{
+					struct timespec t;
+					t.tv_sec = 0;
+					t.tv_nsec = 1000000ul*opts.TimeoutBetweenLogs;
+					nanosleep(&t, NULL);
+					dlt_user_check_buffer(&total, &used);
+				}
+				lastpkg++;
+				if(dlt_user_log_file_data(&filetransferContext, file->path, lastpkg, opts.TimeoutBetweenLogs) < 0)
+					break;
 			}
-			lastpkg++;
-			if(dlt_user_log_file_data(&filetransferContext, dst, lastpkg, opts.TimeoutBetweenLogs) < 0)
-				break;
+			dlt_user_log_file_end(&filetransferContext, file->path, 1);
 		}
-		dlt_user_log_file_end(&filetransferContext, dst, 1);
+
+		free_file(file);
 	}
+}
 
-	if(opts.Compression[which] > 0)
-		free(fn);
-	free(rn);
-	free(dst);
-	return 0;
+/**
+ * Start the sender and the compression threads. They are registered like
+ * all other threads, so they are joined on shutdown.
+ */
+void start_pipeline(DltSystemConfiguration *conf)
+{
+	pthread_t pt;
+	int i;
+
+	pthread_create(&pt, NULL, (void *)send_thread, conf);
+	threads.threads[threads.count++] = pt;
+	// at least one thread is needed, otherwise compressed files are never sent
+	for(i = 0;(i < conf->Filetransfer.CompressionThreads || i == 0) && i < DLT_SYSTEM_COMPRESSION_THREADS_MAX;i++)
+	{
+		pthread_create(&pt, NULL, (void *)compress_thread, conf);
+		threads.threads[threads.count++] = pt;
+	}
 }
 
 int flush_dir(FiletransferOptions opts, int which)
@@ -230,7 +489,12 @@ int flush_dir(FiletransferOptions opts, int which)
 			MALLOC_ASSERT(fn);
 			sprintf(fn, "%s/%s", sdir, dp->d_name);
 			if(send_one(fn, opts, which) < 0)
+			{
+				free(fn);
+				closedir(dir);
 				return -1;
+			}
+			free(fn);
 		}
 	}
 	else
@@ -333,7 +597,6 @@ void filetransfer_thread(void *v_conf)
 			DLT_LOG(dltsystem, DLT_LOG_ERROR, DLT_STRING("Error while waiting files. File transfer shutdown."));
 			return;
 		}
-		sleep(conf->Filetransfer.TimeDelay);
 	}
 }
 
@@ -344,4 +607,6 @@ void start_filetransfer(DltSystemConfiguration *conf)
 	static pthread_t pt;
 	pthread_create(&pt, &t_attr, (void *)filetransfer_thread, conf);
 	threads.threads[threads.count++] = pt;
+	// started here, so all threads are registered before they are joined
+	start_pipeline(conf);
 }
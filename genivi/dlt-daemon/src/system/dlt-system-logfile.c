@@ -44,12 +44,44 @@
 
 #include <pthread.h>
 #include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <sys/stat.h>
+#include <sys/select.h>
+#include <sys/inotify.h>
 #include "dlt-system.h"
 
 // Modes of sending
 #define SEND_MODE_OFF  0
 #define SEND_MODE_ONCE 1
 #define SEND_MODE_ON   2
+#define SEND_MODE_TAIL 3
+
+// Maximum number of bytes of lines combined into one log message in tail mode
+#define TAIL_BATCH_SIZE 1024
+#define INOTIFY_BUFSIZE (64 * (sizeof(struct inotify_event) + 256))
+
+/**
+ * State of a file followed in tail mode.
+ * The file stays open, so lines appended to a file which was rotated
+ * away are still forwarded before switching to the new file.
+ */
+typedef struct {
+	int   fd;
+	dev_t dev;
+	ino_t ino;
+	off_t offset;
+	int   dirty;
+	int   wd;                          // inotify watch of the directory
+	char  *name;                       // file name within the directory
+	char  line[TAIL_BATCH_SIZE];       // incomplete last line
+	int   line_len;
+	char  batch[TAIL_BATCH_SIZE];      // complete lines not sent yet
+	int   batch_len;
+} TailState;
 
 DLT_IMPORT_CONTEXT(dltsystem);
 
@@ -95,6 +127,239 @@ void send_file(LogFileOptions fileopt, int n)
 	}
 }
 
+void tail_flush(TailState *tail, int n)
+{
+	if(tail->batch_len > 0)
+	{
+		tail->batch[tail->batch_len] = 0;
+		DLT_LOG(logfileContext[n], DLT_LOG_INFO, DLT_STRING(tail->batch));
+		tail->batch_len = 0;
+	}
+}
+
+/**
+ * Add one line (without newline) to the batch of a tail file.
+ * The batch is sent when the next line does not fit anymore.
+ */
+void tail_add_line(TailState *tail, int n, const char *line, int len)
+{
+	if(len > TAIL_BATCH_SIZE - 1)
+		len = TAIL_BATCH_SIZE - 1;
+	if(tail->batch_len + (tail->batch_len > 0 ? 1 : 0) + len > TAIL_BATCH_SIZE - 1)
+		tail_flush(tail, n);
+	if(tail->batch_len > 0)
+		tail->batch[tail->batch_len++] = '\n';
+	memcpy(tail->batch + tail->batch_len, line, len);
+	tail->batch_len += len;
+}
+
+/**
+ * Read everything appended to the open file since the last call and
+ * split it into lines. An incomplete last line is kept until it is completed.
+ */
+void tail_read(TailState *tail, int n)
+{
+	char buffer[4096];
+	int bytes, i, start;
+
+	while((bytes = pread(tail->fd, buffer, sizeof(buffer), tail->offset)) > 0)
+	{
+		tail->offset += bytes;
+		start = 0;
+		for(i = 0;i < bytes;i++)
+		{
+			if(buffer[i] != '\n')
+				continue;
+			if(tail->line_len > 0)
+			{
+				int len = i - start;
+				if(tail->line_len + len > TAIL_BATCH_SIZE)
+					len = TAIL_BATCH_SIZE - tail->line_len;
+				memcpy(tail->line + tail->line_len, buffer + start, len);
+				tail_add_line(tail, n, tail->line, tail->line_len + len);
+				tail->line_len = 0;
+			}
+			else
+			{
+				tail_add_line(tail, n, buffer + start, i - start);
+			}
+			start = i + 1;
+		}
+		// keep incomplete line, send it as it is if it gets too long
+		while(start < bytes)
+		{
+			int len = bytes - start;
+			if(len > TAIL_BATCH_SIZE - tail->line_len)
+				len = TAIL_BATCH_SIZE - tail->line_len;
+			memcpy(tail->line + tail->line_len, buffer + start, len);
+			tail->line_len += len;
+			start += len;
+			if(tail->line_len == TAIL_BATCH_SIZE)
+			{
+				tail_add_line(tail, n, tail->line, tail->line_len);
+				tail->line_len = 0;
+			}
+		}
+	}
+	tail_flush(tail, n);
+}
+
+/**
+ * Open the file to be followed. Reading starts at the end of the file,
+ * unless the file was newly created after rotation.
+ */
+void tail_open(TailState *tail, const char *filename, int from_start)
+{
+	struct stat st;
+
+	tail->fd = open(filename, O_RDONLY | O_CLOEXEC);
+	if(tail->fd < 0)
+		return;
+	if(fstat(tail->fd, &st) < 0)
+	{
+		close(tail->fd);
+		tail->fd = -1;
+		return;
+	}
+	tail->dev = st.st_dev;
+	tail->ino = st.st_ino;
+	tail->offset = from_start ? 0 : st.st_size;
+	tail->line_len = 0;
+	tail->batch_len = 0;
+}
+
+/**
+ * Forward new lines of a tail file and handle rotation and truncation.
+ */
+void send_tail(LogFileOptions fileopt, int n, TailState *tail)
+{
+	struct stat st;
+
+	tail->dirty = 0;
+
+	if(stat(fileopt.Filename[n], &st) < 0)
+	{
+		// file was removed, forward what was written before
+		if(tail->fd >= 0)
+		{
+			tail_read(tail, n);
+			close(tail->fd);
+			tail->fd = -1;
+		}
+		return;
+	}
+
+	if(tail->fd >= 0 && (st.st_dev != tail->dev || st.st_ino != tail->ino))
+	{
+		// file was rotated, finish the old file first
+		tail_read(tail, n);
+		if(tail->line_len > 0)
+		{
+			tail_add_line(tail, n, tail->line, tail->line_len);
+			tail_flush(tail, n);
+		}
+		close(tail->fd);
+		tail->fd = -1;
+		tail_open(tail, fileopt.Filename[n], 1);
+	}
+	else if(tail->fd < 0)
+	{
+		tail_open(tail, fileopt.Filename[n], 1);
+	}
+	else if(st.st_size < tail->offset)
+	{
+		DLT_LOG(dltsystem, DLT_LOG_INFO,
+				DLT_STRING("dlt-system-logfile, file truncated."),
+				DLT_STRING(fileopt.Filename[n]));
+		tail->offset = 0;
+		tail->line_len = 0;
+	}
+
+	if(tail->fd >= 0)
+		tail_read(tail, n);
+}
+
+/**
+ * Set up tail state for all files in tail mode and watch their directories.
+ * Returns inotify file descriptor, or -1 if tail files are polled instead.
+ */
+int tail_init(LogFileOptions fileopts, TailState *tails)
+{
+	int i;
+	int notify = -1;
+	char *path;
+
+	for(i = 0;i < fileopts.Count;i++)
+	{
+		tails[i].fd = -1;
+		tails[i].wd = -1;
+		tails[i].dirty = 0;
+		tails[i].name = NULL;
+		if(fileopts.Mode[i] != SEND_MODE_TAIL)
+			continue;
+
+		tail_open(&tails[i], fileopts.Filename[i], 0);
+
+		if(notify < 0)
+			notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if(notify < 0)
+			continue;
+
+		// watch the directory, so rotated and newly created files are noticed
+		path = strdup(fileopts.Filename[i]);
+		MALLOC_ASSERT(path);
+		tails[i].wd = inotify_add_watch(notify, dirname(path),
+				IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+		free(path);
+		path = strdup(fileopts.Filename[i]);
+		MALLOC_ASSERT(path);
+		tails[i].name = strdup(basename(path));
+		MALLOC_ASSERT(tails[i].name);
+		free(path);
+	}
+
+	return notify;
+}
+
+/**
+ * Wait up to one second for changes of tail files.
+ */
+void tail_wait(int notify, LogFileOptions fileopts, TailState *tails)
+{
+	char buffer[INOTIFY_BUFSIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+	struct inotify_event *event;
+	struct timeval timeout;
+	fd_set fds;
+	int bytes, pos, i;
+
+	if(notify < 0)
+	{
+		sleep(1);
+		return;
+	}
+
+	timeout.tv_sec = 1;
+	timeout.tv_usec = 0;
+	FD_ZERO(&fds);
+	FD_SET(notify, &fds);
+	if(select(notify + 1, &fds, NULL, NULL, &timeout) <= 0)
+		return;
+
+	while((bytes = read(notify, buffer, sizeof(buffer))) > 0)
+	{
+		for(pos = 0;pos < bytes;pos += sizeof(struct inotify_event) + event->len)
+		{
+			event = (struct inotify_event *) (buffer + pos);
+			for(i = 0;i < fileopts.Count;i++)
+			{
+				if(tails[i].wd == event->wd && event->len > 0 &&
+				   strcmp(tails[i].name, event->name) == 0)
+					tails[i].dirty = 1;
+			}
+		}
+	}
+}
+
 void register_contexts(LogFileOptions fileopts)
 {
 	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
@@ -116,18 +381,53 @@ void logfile_thread(void *v_conf)
 	register_contexts(conf->LogFile);
 
 	int logfile_delays[DLT_SYSTEM_LOG_FILE_MAX];
+	TailState *tails = malloc(sizeof(TailState) * DLT_SYSTEM_LOG_FILE_MAX);
+	MALLOC_ASSERT(tails);
+	int notify = tail_init(conf->LogFile, tails);
+	time_t last = time(NULL), now;
 	int i;
 	for(i = 0;i < conf->LogFile.Count;i++)
 		logfile_delays[i] = conf->LogFile.TimeDelay[i];
 
 	while(!threads.shutdown)
 	{
-		sleep(1);
+		tail_wait(notify, conf->LogFile, tails);
+
+		// tail files are forwarded as soon as they change
+		for(i = 0;i < conf->LogFile.Count;i++)
+		{
+			if(conf->LogFile.Mode[i] == SEND_MODE_TAIL && tails[i].dirty)
+				send_tail(conf->LogFile, i, &tails[i]);
+		}
+
+		// the other modes are handled once per second
+		now = time(NULL);
+		if(now == last)
+			continue;
+		last = now;
+
 		for(i = 0;i < conf->LogFile.Count;i++)
 		{
 			if(conf->LogFile.Mode[i] == SEND_MODE_OFF)
 				continue;
 
+			if(conf->LogFile.Mode[i] == SEND_MODE_TAIL)
+			{
+				// without inotify tail files are checked every TimeDelay seconds
+				if(tails[i].wd >= 0)
+					continue;
+				if(logfile_delays[i] <= 0)
+				{
+					send_tail(conf->LogFile, i, &tails[i]);
+					logfile_delays[i] = conf->LogFile.TimeDelay[i];
+				}
+				else
+				{
+					logfile_delays[i]--;
+				}
+				continue;
+			}
+
 			if(logfile_delays[i] <= 0)
 			{
 				send_file(conf->LogFile, i);
@@ -143,6 +143,7 @@ void init_configuration(DltSystemConfiguration *config)
 	config->Filetransfer.TimeDelay				= 10;
 	config->Filetransfer.TimeStartup			= 30;
 	config->Filetransfer.TimeoutBetweenLogs		= 10;
+	config->Filetransfer.CompressionThreads		= 2;
 	config->Filetransfer.Count					= 0;
 	for(i = 0;i < DLT_SYSTEM_LOG_DIRS_MAX;i++)
 	{
@@ -275,6 +276,10 @@ int read_configuration_file(DltSystemConfiguration *config, char *file_name)
 			{
 				config->Filetransfer.TimeoutBetweenLogs = atoi(value);
 			}
+			else if(strcmp(token, "FiletransferCompressionThreads") == 0)
+			{
+				config->Filetransfer.CompressionThreads = atoi(value);
+			}
 			else if(strcmp(token, "FiletransferTempDir") == 0)
 			{
 				config->Filetransfer.TempDir = malloc(strlen(value)+1);
@@ -46,10 +46,18 @@
 #include <unistd.h>
 #include <ctype.h>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
 
 #include "dlt-system.h"
 
@@ -58,70 +66,419 @@
 #define SEND_MODE_ONCE 1
 #define SEND_MODE_ON   2
 
+// Process cache
+#define PROCESS_CACHE_BUCKETS 1024
+#define PROCESS_NAME_MAX      1024
+// Without proc connector, cached names are re-read every n passes to notice exec()
+#define PROCESS_CACHE_REFRESH 60
+
 extern DltSystemThreads threads;
 
 DLT_IMPORT_CONTEXT(dltsystem)
 DLT_DECLARE_CONTEXT(procContext)
 
-void send_process(LogProcessOptions popts, int n)
+/**
+ * Cached information of one running process.
+ * The name is the first argument of /proc/<pid>/cmdline and is only read
+ * when the process is new or was replaced by exec(). The start time is read
+ * together with the name and tells a reused pid apart from the process the
+ * name was read for.
+ */
+typedef struct ProcessEntry {
+	pid_t pid;
+	int   name_valid;
+	int   generation;
+	unsigned long long start_time;
+	char  name[PROCESS_NAME_MAX];
+	struct ProcessEntry *next;
+} ProcessEntry;
+
+/**
+ * Cache of all running processes.
+ * With a netlink proc connector the cache is maintained from fork, exec and
+ * exit events and /proc is only scanned once. Without it (e.g. missing
+ * CAP_NET_ADMIN) /proc is rescanned each pass, but only new processes
+ * have their cmdline read.
+ */
+typedef struct {
+	ProcessEntry *buckets[PROCESS_CACHE_BUCKETS];
+	int count;
+	int generation;
+	int netlink;     // proc connector socket, -1 if not available
+	int rescan;      // full /proc scan needed
+	int passes;
+} ProcessCache;
+
+static ProcessEntry *process_cache_find(ProcessCache *cache, pid_t pid)
+{
+	ProcessEntry *entry = cache->buckets[pid % PROCESS_CACHE_BUCKETS];
+	while(entry != NULL && entry->pid != pid)
+		entry = entry->next;
+	return entry;
+}
+
+static ProcessEntry *process_cache_add(ProcessCache *cache, pid_t pid)
+{
+	ProcessEntry *entry = process_cache_find(cache, pid);
+	if(entry == NULL)
+	{
+		entry = malloc(sizeof(ProcessEntry));
+		MALLOC_ASSERT(entry);
+		entry->pid = pid;
+		entry->next = cache->buckets[pid % PROCESS_CACHE_BUCKETS];
+		cache->buckets[pid % PROCESS_CACHE_BUCKETS] = entry;
+		cache->count++;
+	}
+	entry->name_valid = 0;
+	entry->generation = cache->generation;
+	entry->start_time = 0;
+	return entry;
+}
+
+static void process_cache_remove(ProcessCache *cache, pid_t pid)
+{
+	ProcessEntry **link = &cache->buckets[pid % PROCESS_CACHE_BUCKETS];
+	while(*link != NULL)
+	{
+		if((*link)->pid == pid)
+		{
+			ProcessEntry *entry = *link;
+			*link = entry->next;
+			free(entry);
+			cache->count--;
+			return;
+		}
+		link = &(*link)->next;
+	}
+}
+
+/**
+ * Read a small file from /proc/<pid>/ into buffer.
+ * Returns number of bytes read, or -1 on error.
+ */
+static int read_proc_file(pid_t pid, const char *file, char *buffer, int size)
 {
-	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
-			DLT_STRING("dlt-system-processes, send process info."));
-	FILE * pFile;
-	struct dirent *dp;
 	char filename[256];
+	int fd, bytes;
+
+	snprintf(filename, sizeof(filename), "/proc/%d/%s", pid, file);
+	fd = open(filename, O_RDONLY);
+	if(fd < 0)
+		return -1;
+	bytes = read(fd, buffer, size-1);
+	close(fd);
+	if(bytes < 0)
+		return -1;
+	buffer[bytes] = 0;
+	return bytes;
+}
+
+/**
+ * Read the start time of a process (field 22 of /proc/<pid>/stat).
+ * Returns 0 on error.
+ */
+static unsigned long long read_proc_start_time(pid_t pid)
+{
 	char buffer[1024];
+	char *p;
+	int field;
+
+	if(read_proc_file(pid, "stat", buffer, sizeof(buffer)) < 0)
+		return 0;
+
+	// the command name may contain spaces, the fields start after its closing bracket
+	p = strrchr(buffer, ')');
+	for(field = 3;field <= 22 && p != NULL;field++)
+		p = strchr(p + 1, ' ');
+	if(p == NULL)
+		return 0;
+	return strtoull(p + 1, NULL, 10);
+}
+
+static const char *process_cache_name(ProcessEntry *entry)
+{
+	if(!entry->name_valid)
+	{
+		entry->start_time = read_proc_start_time(entry->pid);
+		if(read_proc_file(entry->pid, "cmdline", entry->name, sizeof(entry->name)) < 0)
+			entry->name[0] = 0;
+		entry->name_valid = 1;
+	}
+	return entry->name;
+}
+
+/**
+ * Get the name of a process which is about to be logged. If the pid was
+ * reused since the cached name was read, the name is read again.
+ */
+static const char *process_cache_current_name(ProcessEntry *entry)
+{
+	if(entry->name_valid && read_proc_start_time(entry->pid) != entry->start_time)
+		entry->name_valid = 0;
+	return process_cache_name(entry);
+}
+
+/**
+ * Subscribe to process events of the kernel proc connector.
+ * Returns socket, or -1 if the connector is not available.
+ */
+static int process_cache_connect()
+{
+	struct sockaddr_nl addr;
+	struct {
+		struct nlmsghdr hdr;
+		struct cn_msg msg;
+		enum proc_cn_mcast_op op;
+	} __attribute__((packed)) request;
+
+	int sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+	if(sock < 0)
+		return -1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = CN_IDX_PROC;
+	if(bind(sock, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+
+	memset(&request, 0, sizeof(request));
+	request.hdr.nlmsg_len = sizeof(request);
+	request.hdr.nlmsg_type = NLMSG_DONE;
+	request.hdr.nlmsg_pid = getpid();
+	request.msg.id.idx = CN_IDX_PROC;
+	request.msg.id.val = CN_VAL_PROC;
+	request.msg.len = sizeof(enum proc_cn_mcast_op);
+	request.op = PROC_CN_MCAST_LISTEN;
+	if(send(sock, &request, sizeof(request), 0) < 0)
+	{
+		close(sock);
+		return -1;
+	}
+
+	return sock;
+}
+
+/**
+ * Apply all pending proc connector events to the cache.
+ */
+static void process_cache_events(ProcessCache *cache)
+{
+	char buffer[4096] __attribute__((aligned(NLMSG_ALIGNTO)));
+	struct nlmsghdr *hdr;
+	struct cn_msg *msg;
+	struct proc_event *ev;
 	int bytes;
-	int found = 0;
 
-	/* go through all process files in directory */
+	while((bytes = recv(cache->netlink, buffer, sizeof(buffer), 0)) > 0)
+	{
+		for(hdr = (struct nlmsghdr *) buffer; NLMSG_OK(hdr, (unsigned int) bytes); hdr = NLMSG_NEXT(hdr, bytes))
+		{
+			if(hdr->nlmsg_type == NLMSG_NOOP || hdr->nlmsg_type == NLMSG_ERROR)
+				continue;
+			msg = (struct cn_msg *) NLMSG_DATA(hdr);
+			ev = (struct proc_event *) msg->data;
+			switch(ev->what)
+			{
+			case PROC_EVENT_FORK:
+				// threads share the /proc entry of their process
+				if(ev->event_data.fork.child_pid == ev->event_data.fork.child_tgid)
+					process_cache_add(cache, ev->event_data.fork.child_tgid);
+				break;
+			case PROC_EVENT_EXEC:
+				process_cache_add(cache, ev->event_data.exec.process_tgid);
+				break;
+			case PROC_EVENT_EXIT:
+				if(ev->event_data.exit.process_pid == ev->event_data.exit.process_tgid)
+					process_cache_remove(cache, ev->event_data.exit.process_tgid);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	// events were lost, the cache cannot be trusted anymore
+	if(bytes < 0 && errno == ENOBUFS)
+		cache->rescan = 1;
+}
+
+/**
+ * Scan /proc for running processes. Only the directory is read; the cmdline
+ * of a process is read later and only if it is not cached yet.
+ */
+static void process_cache_scan(ProcessCache *cache)
+{
+	struct dirent *dp;
+	ProcessEntry *entry, **link;
+	pid_t pid;
+	int i;
+
 	DIR *dir = opendir("/proc");
-	if(dir != NULL)
+	if(dir == NULL)
+	{
+		DLT_LOG(dltsystem, DLT_LOG_ERROR,
+				DLT_STRING("dlt-system-processes, failed to open /proc."));
+		return;
+	}
+
+	cache->generation++;
+	while((dp = readdir(dir)) != NULL)
 	{
-		while ((dp=readdir(dir)) != NULL)
+		if(!isdigit(dp->d_name[0]))
+			continue;
+		pid = atoi(dp->d_name);
+		entry = process_cache_find(cache, pid);
+		if(entry == NULL)
+			process_cache_add(cache, pid);
+		else
+			entry->generation = cache->generation;
+	}
+	closedir(dir);
+
+	// drop processes which are not running anymore
+	for(i = 0;i < PROCESS_CACHE_BUCKETS;i++)
+	{
+		link = &cache->buckets[i];
+		while(*link != NULL)
 		{
-			if(isdigit(dp->d_name[0]))
+			if((*link)->generation != cache->generation)
 			{
-				buffer[0] = 0;
-				sprintf(filename, "/proc/%s/cmdline",dp->d_name);
-				pFile = fopen(filename, "r");
-				if(pFile != NULL)
-				{
-					bytes = fread(buffer, 1, sizeof(buffer)-1, pFile);
-					fclose(pFile);
-				}
-				if((strcmp(popts.Name[n], "*")==0) ||
-				   (strcmp(buffer, popts.Name[n])==0))
+				entry = *link;
+				*link = entry->next;
+				free(entry);
+				cache->count--;
+			}
+			else
+			{
+				link = &(*link)->next;
+			}
+		}
+	}
+}
+
+static void process_cache_init(ProcessCache *cache)
+{
+	memset(cache, 0, sizeof(ProcessCache));
+	cache->netlink = process_cache_connect();
+	cache->rescan = 1;
+	if(cache->netlink < 0)
+		DLT_LOG(dltsystem, DLT_LOG_INFO,
+				DLT_STRING("dlt-system-processes, proc connector not available, scanning /proc."));
+}
+
+/**
+ * Bring the cache up to date before a pass over the processes.
+ */
+static void process_cache_update(ProcessCache *cache)
+{
+	int i;
+	ProcessEntry *entry;
+
+	if(cache->netlink >= 0)
+		process_cache_events(cache);
+
+	if(cache->netlink < 0 || cache->rescan)
+	{
+		process_cache_scan(cache);
+		cache->rescan = 0;
+	}
+
+	// without exec events cached names may be stale
+	if(cache->netlink < 0 && ++cache->passes >= PROCESS_CACHE_REFRESH)
+	{
+		cache->passes = 0;
+		for(i = 0;i < PROCESS_CACHE_BUCKETS;i++)
+			for(entry = cache->buckets[i];entry != NULL;entry = entry->next)
+				entry->name_valid = 0;
+	}
+}
+
+/**
+ * Wait one second. Proc connector events arriving meanwhile are applied
+ * to the cache, so the socket buffer does not overflow.
+ */
+static void process_cache_wait(ProcessCache *cache)
+{
+	struct timeval end, now, timeout;
+	fd_set fds;
+
+	if(cache->netlink < 0)
+	{
+		sleep(1);
+		return;
+	}
+
+	gettimeofday(&end, NULL);
+	end.tv_sec += 1;
+	while(!threads.shutdown)
+	{
+		gettimeofday(&now, NULL);
+		if(!timercmp(&now, &end, <))
+			break;
+		timersub(&end, &now, &timeout);
+		FD_ZERO(&fds);
+		FD_SET(cache->netlink, &fds);
+		if(select(cache->netlink + 1, &fds, NULL, NULL, &timeout) > 0)
+			process_cache_events(cache);
+	}
+}
+
+/**
+ * Send the process information of all due entries in one pass over the cache.
+ */
+void send_processes(LogProcessOptions *popts, int *due, ProcessCache *cache)
+{
+	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
+			DLT_STRING("dlt-system-processes, send process info."));
+	ProcessEntry *entry;
+	char buffer[1024];
+	int found[DLT_SYSTEM_LOG_PROCESSES_MAX];
+	int i, n, pending = 0;
+
+	for(n = 0;n < popts->Count;n++)
+	{
+		found[n] = 0;
+		if(due[n])
+			pending++;
+	}
+
+	process_cache_update(cache);
+
+	for(i = 0;i < PROCESS_CACHE_BUCKETS && pending > 0;i++)
+	{
+		for(entry = cache->buckets[i];entry != NULL && pending > 0;entry = entry->next)
+		{
+			for(n = 0;n < popts->Count;n++)
+			{
+				if(!due[n] || (found[n] && strcmp(popts->Name[n], "*") != 0))
+					continue;
+
+				// only a matching entry pays for the check of a reused pid
+				if((strcmp(popts->Name[n], "*") == 0) ||
+				   (strcmp(process_cache_name(entry), popts->Name[n]) == 0 &&
+				    strcmp(process_cache_current_name(entry), popts->Name[n]) == 0))
 				{
-					found = 1;
-					sprintf(filename, "/proc/%s/%s", dp->d_name,popts.Filename[n]);
-					pFile = fopen(filename, "r");
-					if(pFile != NULL)
+					found[n] = 1;
+					if(read_proc_file(entry->pid, popts->Filename[n], buffer, sizeof(buffer)) > 0)
 					{
-						bytes = fread(buffer, 1, sizeof(buffer)-1, pFile);
-						fclose(pFile);
-
-						if(bytes>0)
-						{
-							buffer[bytes] = 0;
-							DLT_LOG(procContext, DLT_LOG_INFO, DLT_INT(atoi(dp->d_name)), DLT_STRING(popts.Filename[n]), DLT_STRING(buffer));
-						}
+						DLT_LOG(procContext, DLT_LOG_INFO, DLT_INT(entry->pid), DLT_STRING(popts->Filename[n]), DLT_STRING(buffer));
 					}
-					if(strcmp(popts.Name[n], "*") !=0)
-						break;
+					// a named process is only logged once
+					if(strcmp(popts->Name[n], "*") != 0)
+						pending--;
 				}
 			}
 		}
-		closedir(dir);
-	}
-	else
-	{
-		DLT_LOG(dltsystem, DLT_LOG_ERROR,
-				DLT_STRING("dlt-system-processes, failed to open /proc."));
 	}
 
-	if(!found) {
-			DLT_LOG(procContext, DLT_LOG_INFO, DLT_STRING("Process"), DLT_STRING(popts.Name[n]),DLT_STRING("not running!"));
+	for(n = 0;n < popts->Count;n++)
+	{
+		if(due[n] && !found[n]) {
+			DLT_LOG(procContext, DLT_LOG_INFO, DLT_STRING("Process"), DLT_STRING(popts->Name[n]),DLT_STRING("not running!"));
+		}
 	}
 }
 
@@ -133,22 +490,30 @@ void logprocess_thread(void *v_conf)
 	DltSystemConfiguration *conf = (DltSystemConfiguration *) v_conf;
 	DLT_REGISTER_CONTEXT(procContext, conf->LogProcesses.ContextId, "Log Processes");
 
+	ProcessCache *cache = malloc(sizeof(ProcessCache));
+	MALLOC_ASSERT(cache);
+	process_cache_init(cache);
+
 	int process_delays[DLT_SYSTEM_LOG_PROCESSES_MAX];
-	int i;
+	int due[DLT_SYSTEM_LOG_PROCESSES_MAX];
+	int i, any;
 	for(i = 0;i < conf->LogProcesses.Count;i++)
 		process_delays[i] = conf->LogProcesses.TimeDelay[i];
 
 	while(!threads.shutdown)
 	{
-		sleep(1);
+		process_cache_wait(cache);
+		any = 0;
 		for(i = 0;i < conf->LogProcesses.Count;i++)
 		{
+			due[i] = 0;
 			if(conf->LogProcesses.Mode[i] == SEND_MODE_OFF)
 				continue;
 
 			if(process_delays[i] <= 0)
 			{
-				send_process(conf->LogProcesses, i);
+				due[i] = 1;
+				any = 1;
 				process_delays[i] = conf->LogProcesses.TimeDelay[i];
 				if(conf->LogProcesses.Mode[i] == SEND_MODE_ONCE)
 					conf->LogProcesses.Mode[i] = SEND_MODE_OFF;
@@ -158,6 +523,10 @@ void logprocess_thread(void *v_conf)
 				process_delays[i]--;
 			}
 		}
+
+		// all due entries share one pass over the processes
+		if(any)
+			send_processes(&conf->LogProcesses, due, cache);
 	}
 }
 
@@ -47,6 +47,7 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <strings.h>
+#include <string.h>
 #include <errno.h>
 
 #include "dlt-system.h"
@@ -56,6 +57,8 @@ extern DltSystemThreads threads;
 DLT_IMPORT_CONTEXT(dltsystem)
 DLT_DECLARE_CONTEXT(syslogContext)
 #define RECV_BUF_SZ 1024
+// Maximum number of datagrams received with one system call
+#define RECV_BATCH 32
 
 int init_socket(SyslogOptions opts)
 {
@@ -90,17 +93,105 @@ int init_socket(SyslogOptions opts)
 	return sock;
 }
 
+/**
+ * Get DLT log level from syslog priority "<PRI>" at start of message.
+ * Messages without priority are logged with level info.
+ */
+static DltLogLevelType syslog_level(const char *msg)
+{
+	int pri = 0;
+	const char *ptr = msg + 1;
+
+	if(msg[0] != '<')
+		return DLT_LOG_INFO;
+	while(*ptr >= '0' && *ptr <= '9' && (ptr - msg) <= 3)
+	{
+		pri = pri * 10 + (*ptr - '0');
+		ptr++;
+	}
+	if(*ptr != '>' || ptr == msg + 1 || pri > 191)
+		return DLT_LOG_INFO;
+
+	switch(pri & 0x07)
+	{
+	case 0: // emergency
+	case 1: // alert
+	case 2: // critical
+		return DLT_LOG_FATAL;
+	case 3:
+		return DLT_LOG_ERROR;
+	case 4:
+		return DLT_LOG_WARN;
+	case 7:
+		return DLT_LOG_DEBUG;
+	default: // notice, info
+		return DLT_LOG_INFO;
+	}
+}
+
+/**
+ * Forward a batch of received messages.
+ * Consecutive messages with the same log level are combined into one
+ * DLT message, separated by newlines, as long as they fit into RECV_BUF_SZ.
+ */
+static void forward_batch(struct mmsghdr *msgs, char recv_data[][RECV_BUF_SZ], int count)
+{
+	char text[RECV_BUF_SZ];
+	int text_len = 0;
+	DltLogLevelType level = DLT_LOG_INFO, msg_level;
+	int i, len;
+
+	for(i = 0;i < count;i++)
+	{
+		len = msgs[i].msg_len;
+		if(len == 0)
+			continue;
+		if(len >= RECV_BUF_SZ)
+			len = RECV_BUF_SZ - 1;
+		// syslog messages may be terminated by a newline already
+		if(recv_data[i][len-1] == '\n')
+			len--;
+		recv_data[i][len] = '\0';
+		msg_level = syslog_level(recv_data[i]);
+
+		if(text_len > 0 && (msg_level != level || text_len + 1 + len >= RECV_BUF_SZ))
+		{
+			DLT_LOG(syslogContext, level, DLT_STRING(text));
+			text_len = 0;
+		}
+		if(text_len > 0)
+			text[text_len++] = '\n';
+		memcpy(text + text_len, recv_data[i], len);
+		text_len += len;
+		text[text_len] = '\0';
+		level = msg_level;
+	}
+
+	if(text_len > 0)
+		DLT_LOG(syslogContext, level, DLT_STRING(text));
+}
+
 int read_socket(int sock)
 {
 	DLT_LOG(dltsystem, DLT_LOG_DEBUG,
 			DLT_STRING("dlt-system-syslog, read socket"));
-	char recv_data[RECV_BUF_SZ];
-	struct sockaddr_in client_addr;
-	socklen_t addr_len = sizeof(struct sockaddr_in);
+	static char recv_data[RECV_BATCH][RECV_BUF_SZ];
+	struct mmsghdr msgs[RECV_BATCH];
+	struct iovec iov[RECV_BATCH];
+	int i;
+
+	memset(msgs, 0, sizeof(msgs));
+	for(i = 0;i < RECV_BATCH;i++)
+	{
+		iov[i].iov_base = recv_data[i];
+		iov[i].iov_len = RECV_BUF_SZ;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
 
-	int bytes_read = recvfrom(sock, recv_data, RECV_BUF_SZ, 0,
-			(struct sockaddr *) &client_addr, &addr_len);
-	if(bytes_read == -1)
+	// wait for the first message, then take all messages already queued
+	int count = recvmmsg(sock, msgs, RECV_BATCH, MSG_WAITFORONE, NULL);
+	if(count == -1)
 	{
 		if(errno == EINTR)
 		{
@@ -114,13 +205,9 @@ int read_socket(int sock)
 		}
 	}
 
-	recv_data[bytes_read] = '\0';
+	forward_batch(msgs, recv_data, count);
 
-	if(bytes_read != 0)
-	{
-		DLT_LOG(syslogContext, DLT_LOG_INFO, DLT_STRING(recv_data));
-	}
-	return bytes_read;
+	return count;
 }
 
 void syslog_thread(void *v_conf)
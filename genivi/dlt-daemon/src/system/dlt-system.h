@@ -68,7 +68,9 @@
 
 #define MAX_LINE 1024
 
-#define MAX_THREADS 8
+#define DLT_SYSTEM_COMPRESSION_THREADS_MAX 8
+
+#define MAX_THREADS 16
 
 // Macros
 #define MALLOC_ASSERT(x) if(x == NULL) {\
@@ -100,6 +102,7 @@ typedef struct {
 	int  TimeDelay;
 	int  TimeoutBetweenLogs;
 	char *TempDir;
+	int  CompressionThreads;
 
 	// Variable number of file transfer dirs
 	int  Count;
@@ -0,0 +1,61 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-bench.c
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <stdio.h>      /* for printf() and fprintf() */
+#include <ctype.h>      /* for isprint() */
+#include <time.h>
+
+#include "dlt_common.h"
+#include "dlt-test-bench.h"
+
+uint64_t dlt_test_bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void dlt_test_bench_usage(const char *name, const char *description)
+{
+    char version[255];
+
+    dlt_get_version(version);
+
+    printf("Usage: %s [options]\n", name);
+    printf("%s\n", description);
+    printf("%s \n", version);
+    printf("Options:\n");
+}
+
+void dlt_test_bench_option_error(int option)
+{
+    if (isprint (option))
+    {
+        fprintf (stderr, "Unknown option or missing argument `-%c'.\n", option);
+    }
+    else
+    {
+        fprintf (stderr, "Unknown option character `\\x%x'.\n", option);
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-bench.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+/*
+ * Helpers shared by the benchmark tools dlt-test-benchmark,
+ * dlt-test-serial and dlt-test-storageheader.
+ */
+
+#ifndef DLT_TEST_BENCH_H_
+#define DLT_TEST_BENCH_H_
+
+#include "dlt_types.h"
+
+/**
+ * Get the current time of the monotonic clock.
+ * @return time in nanoseconds
+ */
+uint64_t dlt_test_bench_now(void);
+
+/**
+ * Print the common head of the usage information of a tool,
+ * the caller prints its options afterwards.
+ * @param name name of the tool
+ * @param description one line description of the tool
+ */
+void dlt_test_bench_usage(const char *name, const char *description);
+
+/**
+ * Print the error for an unknown option or a missing argument,
+ * as reported by getopt() in optopt.
+ * @param option the option character
+ */
+void dlt_test_bench_option_error(int option);
+
+#endif /* DLT_TEST_BENCH_H_ */
@@ -0,0 +1,802 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-benchmark.c
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+/*
+ * Benchmark of the complete DLT path from log call to client.
+ *
+ * The benchmark starts its own dlt-daemon with a generated configuration,
+ * attaches a TCP client, optionally a serial client on a pseudo terminal
+ * and an offline trace, and runs producer processes with several threads
+ * each. It reports throughput, latency percentiles of the log call and of
+ * the delivery to the TCP client, CPU usage of the daemon and the message
+ * loss per client type as JSON.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>      /* for printf() and fprintf() */
+#include <stdlib.h>     /* for atoi(), abort() */
+#include <string.h>     /* for memset() */
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "dlt.h"
+#include "dlt_client.h"
+#include "dlt-test-bench.h"
+
+#define BENCH_APID_PREFIX   "BM"        /* application ids are BM00, BM01, ... */
+#define BENCH_MAX_PAYLOAD   (DLT_USER_BUF_MAX_SIZE - 18) /* user buffer minus time stamp and raw argument headers */
+#define BENCH_RCVBUFSIZE    65536
+#define BENCH_DAEMON_WAIT   5000        /* ms to wait for daemon start */
+#define BENCH_IDLE_TIMEOUT  1000        /* ms without new messages after which the drain ends */
+
+typedef struct
+{
+    int processes;
+    int threads;
+    int count;
+    int rate;
+    int size;
+    int drain;
+    int serial;
+    int offline;
+    int verbose;
+    char *daemon_path;
+    char *output;
+} BenchOptions;
+
+/* Results of producers, shared between processes */
+typedef struct
+{
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uint32_t failed;        /* log calls which failed, the library may still resend them */
+    uint32_t not_built;     /* messages which did not fit into the user buffer and were not sent */
+    uint32_t latency_ns[];
+} BenchShared;
+
+typedef struct
+{
+    const char *name;
+    int active;
+    uint32_t received;
+    uint64_t last_ns;
+    uint32_t *latency_us;
+    uint32_t latency_count;
+    uint32_t latency_max;
+} BenchClient;
+
+typedef struct
+{
+    BenchOptions *opts;
+    BenchShared *shared;
+    int process;
+    int thread;
+} BenchThread;
+
+static pid_t daemon_pid = 0;
+static char work_dir[256];
+
+/**
+ * Print usage information of tool.
+ */
+void usage()
+{
+    dlt_test_bench_usage("dlt-test-benchmark", "Benchmark of DLT daemon throughput, latency and message loss.");
+    printf("  -D path       Path of dlt-daemon (Default: dlt-daemon)\n");
+    printf("  -p processes  Number of producer processes (Default: 1)\n");
+    printf("  -t threads    Number of threads per producer process (Default: 1)\n");
+    printf("  -n count      Number of messages per thread (Default: 10000)\n");
+    printf("  -r rate       Messages per second per thread, 0 is unlimited (Default: 0)\n");
+    printf("  -s size       Size of extra message data in bytes (Default: 100, Maximum: %d)\n", BENCH_MAX_PAYLOAD);
+    printf("  -w seconds    Maximum time to wait for outstanding messages (Default: 10)\n");
+    printf("  -y            Add serial client on a pseudo terminal\n");
+    printf("  -f            Add offline trace\n");
+    printf("  -o filename   Write JSON result to file instead of stdout\n");
+    printf("  -v            Verbose mode\n");
+}
+
+static int bench_cmp_uint32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t bench_percentile(uint32_t *sorted, uint32_t count, double p)
+{
+    uint32_t index;
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    index = (uint32_t)(p * (count - 1) + 0.5);
+
+    return sorted[index];
+}
+
+static void bench_print_latency(FILE *out, const char *name, uint32_t *values, uint32_t count)
+{
+    qsort(values, count, sizeof(uint32_t), bench_cmp_uint32);
+
+    fprintf(out, "\"%s\":{\"p50\":%u,\"p99\":%u,\"p999\":%u,\"max\":%u}", name,
+            bench_percentile(values, count, 0.5), bench_percentile(values, count, 0.99),
+            bench_percentile(values, count, 0.999), count ? values[count-1] : 0);
+}
+
+/* Read user and system time of a process in clock ticks */
+static uint64_t bench_cpu_ticks(pid_t pid)
+{
+    char filename[64], buf[1024], *p;
+    unsigned long utime = 0, stime = 0;
+    FILE *f;
+
+    snprintf(filename, sizeof(filename), "/proc/%d/stat", pid);
+    f = fopen(filename, "r");
+    if (f == 0)
+    {
+        return 0;
+    }
+    if (fgets(buf, sizeof(buf), f) == 0)
+    {
+        fclose(f);
+        return 0;
+    }
+    fclose(f);
+
+    /* skip pid and command name, which may contain spaces */
+    p = strrchr(buf, ')');
+    if (p == 0 || sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2)
+    {
+        return 0;
+    }
+
+    return utime + stime;
+}
+
+/**
+ * Producer thread, sends messages with the send time and extra data.
+ */
+static void *bench_producer_thread(void *ptr)
+{
+    BenchThread *bt = (BenchThread *)ptr;
+    BenchOptions *opts = bt->opts;
+    DltContext context;
+    DltContextData data;
+    static unsigned char payload[BENCH_MAX_PAYLOAD];
+    char ctid[DLT_ID_SIZE+1];
+    struct timespec next;
+    uint32_t *latency;
+    uint64_t period = 0, t0, t1;
+    int i;
+
+    snprintf(ctid, sizeof(ctid), "T%03u", (unsigned int)bt->thread % 1000);
+    dlt_register_context(&context, ctid, "Benchmark thread");
+
+    latency = bt->shared->latency_ns + ((size_t)bt->process * opts->threads + bt->thread) * opts->count;
+    if (opts->rate > 0)
+    {
+        period = 1000000000ULL / opts->rate;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    for (i = 0; i < opts->count; i++)
+    {
+        if (period)
+        {
+            next.tv_nsec += period;
+            while (next.tv_nsec >= 1000000000L)
+            {
+                next.tv_nsec -= 1000000000L;
+                next.tv_sec++;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, 0);
+        }
+
+        t0 = dlt_test_bench_now();
+        if (dlt_user_log_write_start(&context, &data, DLT_LOG_INFO) > 0)
+        {
+            /* a message which cannot be built completely is not sent */
+            if ((dlt_user_log_write_uint64(&data, t0) < 0) ||
+                ((opts->size > 0) && (dlt_user_log_write_raw(&data, payload, opts->size) < 0)))
+            {
+                __sync_fetch_and_add(&(bt->shared->not_built), 1);
+            }
+            else if (dlt_user_log_write_finish(&data) < 0)
+            {
+                __sync_fetch_and_add(&(bt->shared->failed), 1);
+            }
+        }
+        else
+        {
+            __sync_fetch_and_add(&(bt->shared->failed), 1);
+        }
+        t1 = dlt_test_bench_now();
+
+        latency[i] = (uint32_t)(t1 - t0);
+    }
+
+    dlt_unregister_context(&context);
+
+    return 0;
+}
+
+/**
+ * Producer process, registers one application and runs the threads.
+ */
+static void bench_producer(BenchOptions *opts, BenchShared *shared, int process)
+{
+    char apid[DLT_ID_SIZE+1];
+    pthread_t *threads;
+    BenchThread *bt;
+    uint64_t start;
+    int i;
+
+    snprintf(apid, sizeof(apid), BENCH_APID_PREFIX "%02u", (unsigned int)process % 100);
+    dlt_register_app(apid, "DLT benchmark producer");
+
+    threads = malloc(opts->threads * sizeof(pthread_t));
+    bt = malloc(opts->threads * sizeof(BenchThread));
+    if (threads == 0 || bt == 0)
+    {
+        exit(1);
+    }
+
+    start = dlt_test_bench_now();
+    __sync_bool_compare_and_swap(&(shared->start_ns), 0, start);
+    for (i = 0; i < opts->threads; i++)
+    {
+        bt[i].opts = opts;
+        bt[i].shared = shared;
+        bt[i].process = process;
+        bt[i].thread = i;
+        pthread_create(&threads[i], 0, bench_producer_thread, &bt[i]);
+    }
+    for (i = 0; i < opts->threads; i++)
+    {
+        pthread_join(threads[i], 0);
+    }
+
+    dlt_unregister_app();
+    dlt_free();
+
+    /* remember the end of the last producer */
+    start = dlt_test_bench_now();
+    while (1)
+    {
+        uint64_t end = shared->end_ns;
+        if (end >= start || __sync_bool_compare_and_swap(&(shared->end_ns), end, start))
+        {
+            break;
+        }
+    }
+
+    exit(0);
+}
+
+static int bench_message_callback(DltClient *client, const DltMessageView *messages, int count, void *data)
+{
+    BenchClient *bc = (BenchClient *)data;
+    uint64_t now, sent;
+    int i;
+
+    (void)client;
+
+    if (count == 0)
+    {
+        bc->active = 0;
+        return 0;
+    }
+
+    now = dlt_test_bench_now();
+    for (i = 0; i < count; i++)
+    {
+        const DltMessageView *m = &messages[i];
+
+        if (m->extendedheader == 0 || memcmp(m->extendedheader->apid, BENCH_APID_PREFIX, 2) != 0 ||
+            DLT_GET_MSIN_MSTP(m->extendedheader->msin) != DLT_TYPE_LOG)
+        {
+            continue;
+        }
+
+        bc->received++;
+        bc->last_ns = now;
+
+        /* first argument is the send time: type info followed by uint64 */
+        if (bc->latency_us && bc->latency_count < bc->latency_max && m->datasize >= 12)
+        {
+            memcpy(&sent, m->payload + 4, sizeof(sent));
+            if (DLT_IS_HTYP_MSBF(m->standardheader->htyp) != (BYTE_ORDER == BIG_ENDIAN))
+            {
+                sent = __builtin_bswap64(sent);
+            }
+            bc->latency_us[bc->latency_count++] = (uint32_t)((now - sent) / 1000);
+        }
+    }
+
+    return 0;
+}
+
+/* Count benchmark messages in offline trace files */
+static uint32_t bench_count_offline(const char *directory, int verbose)
+{
+    DltFile file;
+    DIR *dir;
+    struct dirent *dp;
+    char filename[1024];
+    uint32_t count = 0;
+    int i;
+
+    dir = opendir(directory);
+    if (dir == 0)
+    {
+        return 0;
+    }
+
+    while ((dp = readdir(dir)) != 0)
+    {
+        if (strstr(dp->d_name, ".dlt") == 0)
+        {
+            continue;
+        }
+        snprintf(filename, sizeof(filename), "%s/%s", directory, dp->d_name);
+
+        dlt_file_init(&file, verbose);
+        if (dlt_file_open(&file, filename, verbose) == 0)
+        {
+            while (dlt_file_read(&file, verbose) >= 0)
+            {
+            }
+            for (i = 0; i < file.counter; i++)
+            {
+                if (dlt_file_message(&file, i, verbose) >= 0 && file.msg.extendedheader &&
+                    memcmp(file.msg.extendedheader->apid, BENCH_APID_PREFIX, 2) == 0 &&
+                    DLT_GET_MSIN_MSTP(file.msg.extendedheader->msin) == DLT_TYPE_LOG)
+                {
+                    count++;
+                }
+            }
+        }
+        dlt_file_free(&file, verbose);
+    }
+    closedir(dir);
+
+    return count;
+}
+
+static void bench_stop_daemon(void)
+{
+    int status;
+
+    if (daemon_pid > 0)
+    {
+        kill(daemon_pid, SIGTERM);
+        waitpid(daemon_pid, &status, 0);
+        daemon_pid = 0;
+    }
+}
+
+static int bench_remove_file(const char *path, const struct stat *sb, int flag, struct FTW *ftwbuf)
+{
+    (void)sb;
+    (void)flag;
+    (void)ftwbuf;
+
+    return remove(path);
+}
+
+static int bench_start_daemon(BenchOptions *opts, const char *serial_device)
+{
+    char filename[512];
+    FILE *f;
+
+    /* configuration of daemon */
+    snprintf(filename, sizeof(filename), "%s/dlt.conf", work_dir);
+    f = fopen(filename, "w");
+    if (f == 0)
+    {
+        return -1;
+    }
+    fprintf(f, "ECUId = BNCH\n");
+    fprintf(f, "PersistanceStoragePath = %s\n", work_dir);
+    fprintf(f, "LoggingMode = 2\n");
+    fprintf(f, "LoggingFilename = %s/dlt-daemon.log\n", work_dir);
+    if (serial_device)
+    {
+        fprintf(f, "RS232DeviceName = %s\n", serial_device);
+    }
+    if (opts->offline)
+    {
+        fprintf(f, "OfflineTraceDirectory = %s/offline\n", work_dir);
+        fprintf(f, "OfflineTraceFileSize = 100000000\n");
+        fprintf(f, "OfflineTraceMaxSize = 1000000000\n");
+    }
+    fclose(f);
+
+    /* runtime configuration, offline trace is only written in mode both */
+    snprintf(filename, sizeof(filename), "%s/dlt-runtime.cfg", work_dir);
+    f = fopen(filename, "w");
+    if (f == 0)
+    {
+        return -1;
+    }
+    fprintf(f, "LoggingMode = %d\n", opts->offline ? DLT_USER_MODE_BOTH : DLT_USER_MODE_EXTERNAL);
+    fclose(f);
+
+    if (opts->offline)
+    {
+        snprintf(filename, sizeof(filename), "%s/offline", work_dir);
+        mkdir(filename, 0755);
+    }
+
+    daemon_pid = fork();
+    if (daemon_pid < 0)
+    {
+        return -1;
+    }
+    if (daemon_pid == 0)
+    {
+        snprintf(filename, sizeof(filename), "%s/dlt.conf", work_dir);
+        execlp(opts->daemon_path, opts->daemon_path, "-c", filename, (char *)0);
+        fprintf(stderr, "ERROR: Cannot start %s (%s)\n", opts->daemon_path, strerror(errno));
+        _exit(1);
+    }
+    atexit(bench_stop_daemon);
+
+    return 0;
+}
+
+/* Connect TCP client, retry until daemon is ready */
+static int bench_connect(DltClient *client, int verbose)
+{
+    struct sockaddr_in addr;
+    int i;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(DLT_DAEMON_TCP_PORT);
+
+    dlt_client_init(client, verbose);
+
+    for (i = 0; i < BENCH_DAEMON_WAIT / 10; i++)
+    {
+        client->sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (client->sock < 0)
+        {
+            return -1;
+        }
+        if (connect(client->sock, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+        {
+            return dlt_receiver_init(&(client->receiver), client->sock, BENCH_RCVBUFSIZE);
+        }
+        close(client->sock);
+        client->sock = -1;
+        usleep(10000);
+    }
+
+    return -1;
+}
+
+static void bench_print_client(FILE *out, BenchClient *bc, uint32_t sent, uint64_t start)
+{
+    double duration = bc->last_ns > start ? (bc->last_ns - start) / 1e9 : 0;
+
+    fprintf(out, "\"%s\":{\"received\":%u,\"lost\":%u,\"msg_per_s\":%.1f", bc->name,
+            bc->received, sent > bc->received ? sent - bc->received : 0,
+            duration > 0 ? bc->received / duration : 0);
+    if (bc->latency_us)
+    {
+        fprintf(out, ",");
+        bench_print_latency(out, "delivery_latency_us", bc->latency_us, bc->latency_count);
+    }
+    fprintf(out, "}");
+}
+
+/**
+ * Main function of tool.
+ */
+int main(int argc, char* argv[])
+{
+    BenchOptions opts;
+    BenchShared *shared;
+    BenchClient tcp, serial, offline;
+    DltClient tcp_client, serial_client;
+    DltClientLoop loop;
+    FILE *out = stdout;
+    char filename[512];
+    char *serial_device = 0;
+    uint64_t cpu_start, cpu_end, wall_start, wall_end, idle_since;
+    size_t samples, shared_size;
+    uint32_t sent, last_received;
+    int c, i, running, status;
+    pid_t pid;
+    double duration;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.processes = 1;
+    opts.threads = 1;
+    opts.count = 10000;
+    opts.size = 100;
+    opts.drain = 10;
+    opts.daemon_path = "dlt-daemon";
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "vyfhD:p:t:n:r:s:w:o:")) != -1)
+    {
+        switch (c)
+        {
+        case 'v':
+            opts.verbose = 1;
+            break;
+        case 'y':
+            opts.serial = 1;
+            break;
+        case 'f':
+            opts.offline = 1;
+            break;
+        case 'D':
+            opts.daemon_path = optarg;
+            break;
+        case 'p':
+            opts.processes = atoi(optarg);
+            break;
+        case 't':
+            opts.threads = atoi(optarg);
+            break;
+        case 'n':
+            opts.count = atoi(optarg);
+            break;
+        case 'r':
+            opts.rate = atoi(optarg);
+            break;
+        case 's':
+            opts.size = atoi(optarg);
+            break;
+        case 'w':
+            opts.drain = atoi(optarg);
+            break;
+        case 'o':
+            opts.output = optarg;
+            break;
+        case 'h':
+            usage();
+            return 0;
+        case '?':
+            dlt_test_bench_option_error(optopt);
+            /* unknown or wrong option used, show usage information and terminate */
+            usage();
+            return -1;
+        default:
+            abort ();
+        }
+    }
+
+    if (opts.processes < 1 || opts.processes > 100 || opts.threads < 1 || opts.count < 1 || opts.size < 0)
+    {
+        fprintf(stderr, "ERROR: Invalid parameters\n");
+        return -1;
+    }
+
+    if (opts.size > BENCH_MAX_PAYLOAD)
+    {
+        fprintf(stderr, "WARNING: Size limited to %d bytes by the user buffer\n", BENCH_MAX_PAYLOAD);
+        opts.size = BENCH_MAX_PAYLOAD;
+    }
+
+    /* latency of each log call is stored in memory shared with producers */
+    samples = (size_t)opts.processes * opts.threads * opts.count;
+    shared_size = sizeof(BenchShared) + samples * sizeof(uint32_t);
+    shared = mmap(0, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shared == MAP_FAILED)
+    {
+        fprintf(stderr, "ERROR: Cannot allocate %lu bytes\n", (unsigned long)shared_size);
+        return -1;
+    }
+
+    snprintf(work_dir, sizeof(work_dir), "/tmp/dlt-benchmark-XXXXXX");
+    if (mkdtemp(work_dir) == 0)
+    {
+        fprintf(stderr, "ERROR: Cannot create working directory\n");
+        return -1;
+    }
+
+    memset(&tcp, 0, sizeof(tcp));
+    memset(&serial, 0, sizeof(serial));
+    memset(&offline, 0, sizeof(offline));
+    tcp.name = "tcp";
+    serial.name = "serial";
+    offline.name = "offline";
+    tcp.latency_max = samples;
+    tcp.latency_us = malloc(samples * sizeof(uint32_t));
+
+    if (dlt_client_loop_init(&loop, 0, opts.verbose) < 0)
+    {
+        return -1;
+    }
+
+    /* serial client reads the master side of a pseudo terminal */
+    if (opts.serial)
+    {
+        dlt_client_init(&serial_client, opts.verbose);
+        serial_client.serial_mode = 1;
+        serial_client.sock = posix_openpt(O_RDWR | O_NOCTTY);
+        if (serial_client.sock < 0 || grantpt(serial_client.sock) < 0 || unlockpt(serial_client.sock) < 0)
+        {
+            fprintf(stderr, "ERROR: Cannot open pseudo terminal\n");
+            return -1;
+        }
+        serial_device = ptsname(serial_client.sock);
+        dlt_receiver_init(&(serial_client.receiver), serial_client.sock, BENCH_RCVBUFSIZE);
+        dlt_client_loop_add(&loop, &serial_client, bench_message_callback, &serial);
+        serial.active = 1;
+    }
+
+    if (bench_start_daemon(&opts, serial_device) < 0)
+    {
+        fprintf(stderr, "ERROR: Cannot start daemon\n");
+        return -1;
+    }
+
+    if (bench_connect(&tcp_client, opts.verbose) < 0)
+    {
+        fprintf(stderr, "ERROR: Cannot connect to daemon\n");
+        return -1;
+    }
+    dlt_client_loop_add(&loop, &tcp_client, bench_message_callback, &tcp);
+    tcp.active = 1;
+
+    /* start producers */
+    cpu_start = bench_cpu_ticks(daemon_pid);
+    wall_start = dlt_test_bench_now();
+    for (i = 0; i < opts.processes; i++)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            bench_producer(&opts, shared, i);
+        }
+        else if (pid < 0)
+        {
+            fprintf(stderr, "ERROR: Cannot start producer\n");
+            return -1;
+        }
+    }
+
+    /* receive until all producers are finished and no more messages arrive */
+    running = opts.processes;
+    sent = samples;
+    last_received = 0;
+    idle_since = dlt_test_bench_now();
+    while (1)
+    {
+        dlt_client_loop_dispatch(&loop, 100);
+
+        while (running > 0 && waitpid(-1, &status, WNOHANG) > 0)
+        {
+            running--;
+        }
+        if (tcp.received != last_received)
+        {
+            last_received = tcp.received;
+            idle_since = dlt_test_bench_now();
+        }
+        if (running == 0)
+        {
+            /* messages which could not be built were never sent */
+            sent = samples - shared->not_built;
+            if (tcp.received >= sent && (!opts.serial || serial.received >= sent))
+            {
+                break;
+            }
+            if (dlt_test_bench_now() - idle_since > BENCH_IDLE_TIMEOUT * 1000000ULL ||
+                dlt_test_bench_now() - shared->end_ns > (uint64_t)opts.drain * 1000000000ULL)
+            {
+                break;
+            }
+        }
+    }
+    wall_end = dlt_test_bench_now();
+    cpu_end = bench_cpu_ticks(daemon_pid);
+
+    dlt_client_loop_free(&loop);
+    dlt_client_cleanup(&tcp_client, opts.verbose);
+    bench_stop_daemon();
+
+    if (opts.offline)
+    {
+        snprintf(filename, sizeof(filename), "%s/offline", work_dir);
+        offline.received = bench_count_offline(filename, opts.verbose);
+    }
+
+    /* report */
+    if (opts.output)
+    {
+        out = fopen(opts.output, "w");
+        if (out == 0)
+        {
+            fprintf(stderr, "ERROR: Cannot open %s\n", opts.output);
+            return -1;
+        }
+    }
+
+    duration = shared->end_ns > shared->start_ns ? (shared->end_ns - shared->start_ns) / 1e9 : 0;
+
+    fprintf(out, "{\"config\":{\"processes\":%d,\"threads\":%d,\"count\":%d,\"rate\":%d,\"size\":%d,\"ipc\":\"%s\"},",
+            opts.processes, opts.threads, opts.count, opts.rate, opts.size,
+#ifdef DLT_SHM_ENABLE
+            "shm"
+#else
+            "fifo"
+#endif
+            );
+    fprintf(out, "\"producer\":{\"sent\":%u,\"failed\":%u,\"not_built\":%u,\"duration_s\":%.3f,\"msg_per_s\":%.1f,",
+            sent, shared->failed, shared->not_built, duration, duration > 0 ? sent / duration : 0);
+    bench_print_latency(out, "log_latency_ns", shared->latency_ns, samples);
+    fprintf(out, "},\"daemon\":{\"cpu_percent\":%.1f},\"clients\":{",
+            wall_end > wall_start ? 100.0 * (cpu_end - cpu_start) / sysconf(_SC_CLK_TCK) / ((wall_end - wall_start) / 1e9) : 0);
+    bench_print_client(out, &tcp, sent, shared->start_ns);
+    if (opts.serial)
+    {
+        fprintf(out, ",");
+        bench_print_client(out, &serial, sent, shared->start_ns);
+    }
+    if (opts.offline)
+    {
+        fprintf(out, ",\"offline\":{\"received\":%u,\"lost\":%u}", offline.received,
+                sent > offline.received ? sent - offline.received : 0);
+    }
+    fprintf(out, "}}\n");
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    if (opts.serial)
+    {
+        dlt_client_cleanup(&serial_client, opts.verbose);
+    }
+    free(tcp.latency_us);
+    nftw(work_dir, bench_remove_file, 16, FTW_DEPTH | FTW_PHYS);
+    munmap(shared, shared_size);
+
+    return 0;
+}
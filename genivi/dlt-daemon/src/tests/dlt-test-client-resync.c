@@ -0,0 +1,249 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-client-resync.c
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+/*
+ * Test of the resync of the client loop in serial mode.
+ *
+ * A stream of messages with serial header is written to a socket pair and
+ * read by a client loop in serial mode. In each test case one message in
+ * the middle of the stream is corrupted. Only the corrupted message may be
+ * lost, all other messages must arrive complete and in order.
+ */
+
+#include <stdio.h>      /* for printf() and fprintf() */
+#include <stdlib.h>     /* for atoi(), abort() */
+#include <string.h>     /* for memset() */
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "dlt.h"
+#include "dlt_client.h"
+#include "dlt-test-bench.h"
+
+#define RESYNC_APID     "RSYN"
+#define RESYNC_MESSAGES 100     /* messages per test case */
+#define RESYNC_CORRUPT  50      /* number of the corrupted message */
+#define RESYNC_RCVBUFSIZE 10024
+
+/* Layout of one message with serial header, as sent by the daemon */
+typedef struct
+{
+    char serialheader[DLT_ID_SIZE];
+    DltStandardHeader standardheader;
+    DltExtendedHeader extendedheader;
+    uint32_t seq;
+} PACKED ResyncMessage;
+
+typedef enum
+{
+    RESYNC_SERIALHEADER,        /* one byte of the serial header is changed */
+    RESYNC_SHORT_LENGTH,        /* length is smaller than the header */
+    RESYNC_GARBAGE              /* one byte is inserted in front of the message */
+} ResyncCorruption;
+
+typedef struct
+{
+    ResyncCorruption corruption;
+    const char *name;
+    int lost;                   /* number of messages which may be lost */
+} ResyncCase;
+
+typedef struct
+{
+    uint32_t received;
+    uint32_t next;
+    uint32_t errors;
+} ResyncResult;
+
+static const ResyncCase resync_cases[] =
+{
+    { RESYNC_SERIALHEADER, "corrupted serial header", 1 },
+    { RESYNC_SHORT_LENGTH, "implausible length", 1 },
+    { RESYNC_GARBAGE,      "garbage between messages", 0 }
+};
+
+/**
+ * Print usage information of tool.
+ */
+void usage()
+{
+    dlt_test_bench_usage("dlt-test-client-resync", "Test of the resync of the client loop in serial mode.");
+    printf("  -v            Verbose mode\n");
+}
+
+static int resync_message_callback(DltClient *client, const DltMessageView *messages, int count, void *data)
+{
+    ResyncResult *result = (ResyncResult *)data;
+    uint32_t seq;
+    int i;
+
+    (void)client;
+
+    for (i = 0; i < count; i++)
+    {
+        const DltMessageView *m = &messages[i];
+
+        if (!m->found_serialheader || m->extendedheader == 0 ||
+            memcmp(m->extendedheader->apid, RESYNC_APID, DLT_ID_SIZE) != 0 || m->datasize != sizeof(seq))
+        {
+            result->errors++;
+            continue;
+        }
+
+        memcpy(&seq, m->payload, sizeof(seq));
+        if (seq < result->next)
+        {
+            /* order of messages must be kept */
+            result->errors++;
+        }
+        result->next = seq + 1;
+        result->received++;
+    }
+
+    return 0;
+}
+
+static void resync_fill(ResyncMessage *msg, uint32_t seq)
+{
+    memset(msg, 0, sizeof(ResyncMessage));
+    memcpy(msg->serialheader, dltSerialHeader, sizeof(dltSerialHeader));
+    msg->standardheader.htyp = DLT_HTYP_UEH | DLT_HTYP_PROTOCOL_VERSION1;
+    msg->standardheader.mcnt = (uint8_t)seq;
+    msg->standardheader.len = DLT_HTOBE_16(sizeof(ResyncMessage) - sizeof(msg->serialheader));
+    msg->extendedheader.msin = (DLT_TYPE_LOG << DLT_MSIN_MSTP_SHIFT) | (DLT_LOG_INFO << DLT_MSIN_MTIN_SHIFT);
+    memcpy(msg->extendedheader.apid, RESYNC_APID, DLT_ID_SIZE);
+    memcpy(msg->extendedheader.ctid, "TEST", DLT_ID_SIZE);
+    msg->seq = seq;
+}
+
+/* Run one test case, returns number of errors */
+static int resync_run(const ResyncCase *test, int verbose)
+{
+    static uint8_t stream[RESYNC_MESSAGES * sizeof(ResyncMessage) + 1];
+    ResyncMessage msg;
+    ResyncResult result;
+    DltClientLoop loop;
+    DltClient client;
+    int sv[2], length = 0, written, ret, i;
+
+    for (i = 0; i < RESYNC_MESSAGES; i++)
+    {
+        resync_fill(&msg, i);
+        if (i == RESYNC_CORRUPT)
+        {
+            switch (test->corruption)
+            {
+            case RESYNC_SERIALHEADER:
+                msg.serialheader[2] ^= 0xff;
+                break;
+            case RESYNC_SHORT_LENGTH:
+                msg.standardheader.len = DLT_HTOBE_16(1);
+                break;
+            case RESYNC_GARBAGE:
+                stream[length++] = 0x55;
+                break;
+            }
+        }
+        memcpy(stream + length, &msg, sizeof(msg));
+        length += sizeof(msg);
+    }
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0)
+    {
+        fprintf(stderr, "ERROR: Cannot create socket pair\n");
+        return 1;
+    }
+
+    memset(&result, 0, sizeof(result));
+    dlt_client_loop_init(&loop, 0, verbose);
+    dlt_client_init(&client, verbose);
+    client.serial_mode = 1;
+    client.sock = sv[0];
+    dlt_receiver_init(&(client.receiver), client.sock, RESYNC_RCVBUFSIZE);
+    dlt_client_loop_add(&loop, &client, resync_message_callback, &result);
+
+    /* write in small pieces, so the corrupted message is split between reads */
+    for (written = 0; written < length; written += ret)
+    {
+        ret = write(sv[1], stream + written, (length - written < 17) ? length - written : 17);
+        if (ret <= 0)
+        {
+            break;
+        }
+        dlt_client_loop_dispatch(&loop, 0);
+    }
+    close(sv[1]);
+    dlt_client_loop_run(&loop);
+
+    dlt_client_loop_free(&loop);
+    dlt_client_cleanup(&client, verbose);
+
+    printf("%-26s received %u/%u, errors %u\n", test->name, result.received, RESYNC_MESSAGES, result.errors);
+
+    if (result.received < (uint32_t)(RESYNC_MESSAGES - test->lost) || result.next != RESYNC_MESSAGES)
+    {
+        result.errors++;
+    }
+
+    return result.errors;
+}
+
+/**
+ * Main function of tool.
+ */
+int main(int argc, char* argv[])
+{
+    int verbose = 0;
+    int c, i, failed = 0;
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "vh")) != -1)
+    {
+        switch (c)
+        {
+        case 'v':
+            verbose = 1;
+            break;
+        case 'h':
+            usage();
+            return 0;
+        case '?':
+            dlt_test_bench_option_error(optopt);
+            /* unknown or wrong option used, show usage information and terminate */
+            usage();
+            return -1;
+        default:
+            abort ();
+        }
+    }
+
+    for (i = 0; i < (int)(sizeof(resync_cases) / sizeof(resync_cases[0])); i++)
+    {
+        failed += resync_run(&resync_cases[i], verbose);
+    }
+
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-injection.c
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+/*
+ * Test of injection callbacks executed by the injection workers.
+ *
+ * The test writes injection messages directly to the FIFO of its own
+ * application, so no daemon is needed. The callback is slow, so the
+ * injections are still pending in the queue of the worker when
+ * the context is unregistered or the callback is replaced.
+ * No callback may start after dlt_unregister_context() returned, and
+ * the replaced callback may not start after the new one was registered.
+ */
+
+#include <stdio.h>      /* for printf() and fprintf() */
+#include <stdlib.h>     /* for atoi(), abort() */
+#include <string.h>     /* for memset() */
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "dlt.h"
+#include "dlt_user_shared.h"
+#include "dlt_user_shared_cfg.h"
+#include "dlt-test-bench.h"
+
+#define INJECTION_SERVICE_ID 0x1000
+#define INJECTION_COUNT      20         /* injections sent per test case */
+#define INJECTION_DELAY      20000      /* us each callback takes */
+#define INJECTION_TIMEOUT    2000       /* ms to wait for the first callback */
+
+static volatile int calls_first = 0;
+static volatile int calls_second = 0;
+
+/**
+ * Print usage information of tool.
+ */
+void usage()
+{
+    dlt_test_bench_usage("dlt-test-injection", "Test of injection callbacks after unregister and replacement.");
+}
+
+static int injection_first_callback(uint32_t service_id, void *data, uint32_t length)
+{
+    (void)service_id;
+    (void)data;
+    (void)length;
+
+    __sync_fetch_and_add(&calls_first, 1);
+    usleep(INJECTION_DELAY);
+
+    return 0;
+}
+
+static int injection_second_callback(uint32_t service_id, void *data, uint32_t length)
+{
+    (void)service_id;
+    (void)data;
+    (void)length;
+
+    __sync_fetch_and_add(&calls_second, 1);
+
+    return 0;
+}
+
+/* Write injections for the context to the FIFO of this application */
+static int injection_send(DltContext *context, int count)
+{
+    DltUserHeader userheader;
+    DltUserControlMsgInjection injection;
+    uint32_t data = 0;
+    char filename[256];
+    int fd, i;
+
+    snprintf(filename, sizeof(filename), "%s/dlt%d", DLT_USER_DIR, getpid());
+    fd = open(filename, O_WRONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    dlt_user_set_userheader(&userheader, DLT_USER_MESSAGE_INJECTION);
+    injection.log_level_pos = context->log_level_pos;
+    injection.service_id = INJECTION_SERVICE_ID;
+    injection.data_length_inject = sizeof(data);
+
+    for (i = 0; i < count; i++)
+    {
+        if (write(fd, &userheader, sizeof(userheader)) != sizeof(userheader) ||
+            write(fd, &injection, sizeof(injection)) != sizeof(injection) ||
+            write(fd, &data, sizeof(data)) != sizeof(data))
+        {
+            close(fd);
+            return -1;
+        }
+    }
+    close(fd);
+
+    return 0;
+}
+
+/* Wait until the first callback was started */
+static int injection_wait_first(void)
+{
+    int i;
+
+    for (i = 0; i < INJECTION_TIMEOUT && calls_first == 0; i++)
+    {
+        usleep(1000);
+    }
+
+    return calls_first ? 0 : -1;
+}
+
+/**
+ * Main function of tool.
+ */
+int main(int argc, char* argv[])
+{
+    DltContext context;
+    int c, started, failed = 0;
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "h")) != -1)
+    {
+        switch (c)
+        {
+        case 'h':
+            usage();
+            return 0;
+        case '?':
+            dlt_test_bench_option_error(optopt);
+            /* unknown or wrong option used, show usage information and terminate */
+            usage();
+            return -1;
+        default:
+            abort ();
+        }
+    }
+
+    dlt_register_app("INJT", "DLT injection test");
+
+    /* injections pending while the context is unregistered */
+    dlt_register_context(&context, "TEST", "DLT injection test context");
+    dlt_register_injection_callback(&context, INJECTION_SERVICE_ID, injection_first_callback);
+    if (injection_send(&context, INJECTION_COUNT) < 0 || injection_wait_first() < 0)
+    {
+        fprintf(stderr, "ERROR: Injections not received\n");
+        dlt_free();
+        return -1;
+    }
+    dlt_unregister_context(&context);
+    started = calls_first;
+    usleep(INJECTION_COUNT * INJECTION_DELAY);
+    printf("Unregister: %d/%d callbacks before, %d after unregister\n", started, INJECTION_COUNT, calls_first - started);
+    if (calls_first != started || started == INJECTION_COUNT)
+    {
+        failed = 1;
+    }
+
+    /* injections pending while the callback is replaced */
+    calls_first = 0;
+    dlt_register_context(&context, "TEST", "DLT injection test context");
+    dlt_register_injection_callback(&context, INJECTION_SERVICE_ID, injection_first_callback);
+    if (injection_send(&context, INJECTION_COUNT) < 0 || injection_wait_first() < 0)
+    {
+        fprintf(stderr, "ERROR: Injections not received\n");
+        dlt_free();
+        return -1;
+    }
+    dlt_register_injection_callback(&context, INJECTION_SERVICE_ID, injection_second_callback);
+    started = calls_first;
+    usleep(INJECTION_COUNT * INJECTION_DELAY);
+    printf("Replace: %d/%d callbacks before, %d after replacement, %d by new callback\n",
+           started, INJECTION_COUNT, calls_first - started, calls_second);
+    /* a callback which read the old pointer just before the replacement may still start */
+    if (calls_first > started + 1 || calls_first + calls_second != INJECTION_COUNT)
+    {
+        failed = 1;
+    }
+    dlt_unregister_context(&context);
+
+    dlt_unregister_app();
+    dlt_free();
+
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,406 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-serial.c
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+/*
+ * Test of the serial output of the dlt-daemon on a pseudo terminal.
+ *
+ * The test starts its own dlt-daemon, which writes to the slave side of a
+ * pseudo terminal, and reads the master side as serial client.
+ * In the first phase messages of high and low priority are read while
+ * they are logged; all of them must arrive complete and in order.
+ * In the second phase the client stops reading, so the serial link is
+ * saturated; all messages of high priority must arrive afterwards, while
+ * messages of low priority may be dropped.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>      /* for printf() and fprintf() */
+#include <stdlib.h>     /* for atoi(), abort() */
+#include <string.h>     /* for memset() */
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "dlt.h"
+#include "dlt_client.h"
+#include "dlt-test-bench.h"
+
+#define SERIAL_APID         "SERT"
+#define SERIAL_MAX_PAYLOAD  1000
+#define SERIAL_RCVBUFSIZE   65536
+#define SERIAL_DAEMON_WAIT  5000        /* ms to wait for daemon start */
+#define SERIAL_IDLE_TIMEOUT 1000        /* ms without new messages after which reading ends */
+#define SERIAL_QUEUE_SIZE   131072      /* size of each priority queue of daemon */
+#define SERIAL_LOW_RATIO    10          /* messages of low priority per message of high priority */
+
+typedef struct
+{
+    int count;
+    int size;
+    int verbose;
+    char *daemon_path;
+} SerialOptions;
+
+/* Messages received per priority, 0 is high and 1 is low priority */
+typedef struct
+{
+    uint32_t received[2];
+    uint32_t next[2];
+    uint32_t errors;
+} SerialResult;
+
+static pid_t daemon_pid = 0;
+static char work_dir[256];
+
+/**
+ * Print usage information of tool.
+ */
+void usage()
+{
+    dlt_test_bench_usage("dlt-test-serial", "Test of DLT daemon serial output on a pseudo terminal.");
+    printf("  -D path       Path of dlt-daemon (Default: dlt-daemon)\n");
+    printf("  -n count      Number of messages per phase (Default: 2000)\n");
+    printf("  -s size       Size of extra message data in bytes (Default: 200)\n");
+    printf("  -v            Verbose mode\n");
+}
+
+static int serial_message_callback(DltClient *client, const DltMessageView *messages, int count, void *data)
+{
+    SerialResult *result = (SerialResult *)data;
+    uint32_t seq;
+    int i, prio;
+
+    (void)client;
+
+    for (i = 0; i < count; i++)
+    {
+        const DltMessageView *m = &messages[i];
+
+        if (m->extendedheader == 0 || memcmp(m->extendedheader->apid, SERIAL_APID, DLT_ID_SIZE) != 0 ||
+            DLT_GET_MSIN_MSTP(m->extendedheader->msin) != DLT_TYPE_LOG)
+        {
+            continue;
+        }
+
+        /* the daemon sends each message with serial header */
+        if (!m->found_serialheader || m->datasize < 8)
+        {
+            result->errors++;
+            continue;
+        }
+
+        /* first argument is the sequence number per priority: type info followed by uint32 */
+        memcpy(&seq, m->payload + 4, sizeof(seq));
+        if (DLT_IS_HTYP_MSBF(m->standardheader->htyp) != (BYTE_ORDER == BIG_ENDIAN))
+        {
+            seq = __builtin_bswap32(seq);
+        }
+
+        prio = (DLT_GET_MSIN_MTIN(m->extendedheader->msin) == DLT_LOG_ERROR) ? 0 : 1;
+        if (seq < result->next[prio])
+        {
+            /* order of messages with same priority must be kept */
+            result->errors++;
+        }
+        result->next[prio] = seq + 1;
+        result->received[prio]++;
+    }
+
+    return 0;
+}
+
+static void serial_stop_daemon(void)
+{
+    int status;
+
+    if (daemon_pid > 0)
+    {
+        kill(daemon_pid, SIGTERM);
+        waitpid(daemon_pid, &status, 0);
+        daemon_pid = 0;
+    }
+}
+
+static int serial_remove_file(const char *path, const struct stat *sb, int flag, struct FTW *ftwbuf)
+{
+    (void)sb;
+    (void)flag;
+    (void)ftwbuf;
+
+    return remove(path);
+}
+
+static int serial_start_daemon(SerialOptions *opts, const char *serial_device)
+{
+    char filename[512];
+    FILE *f;
+
+    /* configuration of daemon */
+    snprintf(filename, sizeof(filename), "%s/dlt.conf", work_dir);
+    f = fopen(filename, "w");
+    if (f == 0)
+    {
+        return -1;
+    }
+    fprintf(f, "ECUId = SERT\n");
+    fprintf(f, "PersistanceStoragePath = %s\n", work_dir);
+    fprintf(f, "LoggingMode = 2\n");
+    fprintf(f, "LoggingFilename = %s/dlt-daemon.log\n", work_dir);
+    fprintf(f, "SendSerialHeader = 1\n");
+    fprintf(f, "RS232DeviceName = %s\n", serial_device);
+    fprintf(f, "RS232QueueSize = %d\n", SERIAL_QUEUE_SIZE);
+    fprintf(f, "RS232PriorityLevel = %d\n", DLT_LOG_ERROR);
+    fclose(f);
+
+    daemon_pid = fork();
+    if (daemon_pid < 0)
+    {
+        return -1;
+    }
+    if (daemon_pid == 0)
+    {
+        execlp(opts->daemon_path, opts->daemon_path, "-c", filename, (char *)0);
+        fprintf(stderr, "ERROR: Cannot start %s (%s)\n", opts->daemon_path, strerror(errno));
+        _exit(1);
+    }
+    atexit(serial_stop_daemon);
+
+    return 0;
+}
+
+/* Wait until the daemon accepts TCP connections */
+static int serial_wait_daemon(void)
+{
+    struct sockaddr_in addr;
+    int i, sock;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(DLT_DAEMON_TCP_PORT);
+
+    for (i = 0; i < SERIAL_DAEMON_WAIT / 10; i++)
+    {
+        sock = socket(AF_INET, SOCK_STREAM, 0);
+        if (sock < 0)
+        {
+            return -1;
+        }
+        if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+        {
+            close(sock);
+            return 0;
+        }
+        close(sock);
+        usleep(10000);
+    }
+
+    return -1;
+}
+
+/* Log one message, every SERIAL_LOW_RATIO+1th message with high priority */
+static void serial_log(DltContext *context, SerialOptions *opts, int i, uint32_t *sent)
+{
+    static unsigned char payload[SERIAL_MAX_PAYLOAD];
+    DltContextData data;
+    int prio;
+
+    prio = (i % (SERIAL_LOW_RATIO + 1)) ? 1 : 0;
+    if (dlt_user_log_write_start(context, &data, prio ? DLT_LOG_INFO : DLT_LOG_ERROR) > 0)
+    {
+        dlt_user_log_write_uint32(&data, sent[prio]);
+        if (opts->size > 0)
+        {
+            dlt_user_log_write_raw(&data, payload, opts->size);
+        }
+        dlt_user_log_write_finish(&data);
+    }
+    sent[prio]++;
+}
+
+/* Read messages until no more arrive */
+static void serial_drain(DltClientLoop *loop, SerialResult *result)
+{
+    uint64_t idle_since;
+    uint32_t last;
+
+    last = result->received[0] + result->received[1];
+    idle_since = dlt_test_bench_now();
+    while (dlt_test_bench_now() - idle_since < SERIAL_IDLE_TIMEOUT * 1000000ULL)
+    {
+        dlt_client_loop_dispatch(loop, 100);
+        if (result->received[0] + result->received[1] != last)
+        {
+            last = result->received[0] + result->received[1];
+            idle_since = dlt_test_bench_now();
+        }
+    }
+}
+
+/**
+ * Main function of tool.
+ */
+int main(int argc, char* argv[])
+{
+    SerialOptions opts;
+    SerialResult result[2];
+    DltClient serial_client;
+    DltClientLoop loop;
+    DltContext context;
+    char *serial_device;
+    uint32_t sent[2][2];
+    int c, i, failed;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.count = 2000;
+    opts.size = 200;
+    opts.daemon_path = "dlt-daemon";
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "vhD:n:s:")) != -1)
+    {
+        switch (c)
+        {
+        case 'v':
+            opts.verbose = 1;
+            break;
+        case 'D':
+            opts.daemon_path = optarg;
+            break;
+        case 'n':
+            opts.count = atoi(optarg);
+            break;
+        case 's':
+            opts.size = atoi(optarg);
+            break;
+        case 'h':
+            usage();
+            return 0;
+        case '?':
+            dlt_test_bench_option_error(optopt);
+            /* unknown or wrong option used, show usage information and terminate */
+            usage();
+            return -1;
+        default:
+            abort ();
+        }
+    }
+
+    if (opts.count < 1 || opts.size < 0 || opts.size > SERIAL_MAX_PAYLOAD)
+    {
+        fprintf(stderr, "ERROR: Invalid parameters\n");
+        return -1;
+    }
+
+    snprintf(work_dir, sizeof(work_dir), "/tmp/dlt-test-serial-XXXXXX");
+    if (mkdtemp(work_dir) == 0)
+    {
+        fprintf(stderr, "ERROR: Cannot create working directory\n");
+        return -1;
+    }
+
+    memset(result, 0, sizeof(result));
+    memset(sent, 0, sizeof(sent));
+
+    if (dlt_client_loop_init(&loop, 0, opts.verbose) < 0)
+    {
+        return -1;
+    }
+
+    /* serial client reads the master side of a pseudo terminal */
+    dlt_client_init(&serial_client, opts.verbose);
+    serial_client.serial_mode = 1;
+    serial_client.sock = posix_openpt(O_RDWR | O_NOCTTY);
+    if (serial_client.sock < 0 || grantpt(serial_client.sock) < 0 || unlockpt(serial_client.sock) < 0)
+    {
+        fprintf(stderr, "ERROR: Cannot open pseudo terminal\n");
+        return -1;
+    }
+    serial_device = ptsname(serial_client.sock);
+    dlt_receiver_init(&(serial_client.receiver), serial_client.sock, SERIAL_RCVBUFSIZE);
+    dlt_client_loop_add(&loop, &serial_client, serial_message_callback, &result[0]);
+
+    if (serial_start_daemon(&opts, serial_device) < 0 || serial_wait_daemon() < 0)
+    {
+        fprintf(stderr, "ERROR: Cannot start daemon\n");
+        return -1;
+    }
+
+    dlt_register_app(SERIAL_APID, "DLT serial test");
+    dlt_register_context(&context, "TEST", "DLT serial test context");
+
+    /* phase 1: client reads while messages are logged */
+    for (i = 0; i < opts.count; i++)
+    {
+        serial_log(&context, &opts, i, sent[0]);
+        dlt_client_loop_dispatch(&loop, 0);
+        usleep(100);
+    }
+    serial_drain(&loop, &result[0]);
+
+    /* phase 2: serial link is saturated while messages are logged */
+    dlt_client_loop_remove(&loop, &serial_client);
+    dlt_client_loop_add(&loop, &serial_client, serial_message_callback, &result[1]);
+    for (i = 0; i < opts.count; i++)
+    {
+        serial_log(&context, &opts, i, sent[1]);
+        usleep(100);
+    }
+    sleep(1);
+    serial_drain(&loop, &result[1]);
+
+    dlt_unregister_context(&context);
+    dlt_unregister_app();
+    dlt_free();
+
+    dlt_client_loop_free(&loop);
+    dlt_client_cleanup(&serial_client, opts.verbose);
+    serial_stop_daemon();
+    nftw(work_dir, serial_remove_file, 16, FTW_DEPTH | FTW_PHYS);
+
+    /* report */
+    for (i = 0; i < 2; i++)
+    {
+        printf("Phase %d: high priority %u/%u, low priority %u/%u, errors %u\n", i + 1,
+               result[i].received[0], sent[i][0], result[i].received[1], sent[i][1], result[i].errors);
+    }
+
+    failed = (result[0].errors || result[1].errors ||
+              result[0].received[0] != sent[0][0] || result[0].received[1] != sent[0][1] ||
+              result[1].received[0] != sent[1][0]);
+
+    printf("%s\n", failed ? "FAILED" : "PASSED");
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2026  DLT contributors
+ *
+ * This file is part of GENIVI Project Dlt - Diagnostic Log and Trace console apps.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ *
+ * \author DLT contributors 2026
+ *
+ * \file dlt-test-storageheader.c
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+
+/*
+ * Microbenchmark of storage header creation.
+ *
+ * Compares dlt_set_storageheader(), which reads the time and encodes the
+ * ECU id for each message, with the storage header cache, which reads the
+ * time once per batch of messages and copies the pre-encoded header.
+ */
+
+#include <stdio.h>      /* for printf() and fprintf() */
+#include <stdlib.h>     /* for atoi(), abort() */
+#include <string.h>     /* for memset() */
+#include <unistd.h>
+
+#include "dlt_common.h"
+#include "dlt-test-bench.h"
+
+#define STORAGEHEADER_MESSAGES 64      /* number of distinct message buffers written to */
+
+/**
+ * Print usage information of tool.
+ */
+void usage()
+{
+    dlt_test_bench_usage("dlt-test-storageheader", "Microbenchmark of storage header creation with and without cache.");
+    printf("  -n count      Number of storage headers (Default: 10000000)\n");
+    printf("  -b batch      Number of messages per receive batch (Default: 16)\n");
+    printf("  -e ecu        ECU id (Default: ECU1)\n");
+}
+
+/**
+ * Main function of tool.
+ */
+int main(int argc, char* argv[])
+{
+    static DltStorageHeader headers[STORAGEHEADER_MESSAGES];
+    DltStorageHeaderCache cache;
+    char ecu[DLT_ID_SIZE+1];
+    uint64_t start, plain, cached;
+    int count = 10000000;
+    int batch = 16;
+    int c, i, j;
+
+    strcpy(ecu, "ECU1");
+
+    opterr = 0;
+
+    while ((c = getopt (argc, argv, "hn:b:e:")) != -1)
+    {
+        switch (c)
+        {
+        case 'n':
+            count = atoi(optarg);
+            break;
+        case 'b':
+            batch = atoi(optarg);
+            break;
+        case 'e':
+            strncpy(ecu, optarg, DLT_ID_SIZE);
+            ecu[DLT_ID_SIZE] = 0;
+            break;
+        case 'h':
+            usage();
+            return 0;
+        case '?':
+            dlt_test_bench_option_error(optopt);
+            /* unknown or wrong option used, show usage information and terminate */
+            usage();
+            return -1;
+        default:
+            abort ();
+        }
+    }
+
+    if (count < 1 || batch < 1)
+    {
+        fprintf(stderr, "ERROR: Invalid parameters\n");
+        return -1;
+    }
+
+    /* storage header with time and ecu id for each message */
+    start = dlt_test_bench_now();
+    for (i = 0; i < count; i++)
+    {
+        dlt_set_storageheader(&headers[i % STORAGEHEADER_MESSAGES], ecu);
+    }
+    plain = dlt_test_bench_now() - start;
+
+    /* time read once per batch, pre-encoded header copied for each message */
+    dlt_storageheader_cache_init(&cache, ecu);
+    start = dlt_test_bench_now();
+    for (i = 0; i < count; i += batch)
+    {
+        dlt_storageheader_cache_update(&cache);
+        for (j = i; (j < i + batch) && (j < count); j++)
+        {
+            dlt_set_storageheader_cached(&headers[j % STORAGEHEADER_MESSAGES], &cache, ecu);
+        }
+    }
+    cached = dlt_test_bench_now() - start;
+
+    if (dlt_check_storageheader(&headers[0]) != 1 || strncmp(headers[0].ecu, ecu, DLT_ID_SIZE) != 0)
+    {
+        fprintf(stderr, "ERROR: Invalid storage header\n");
+        return -1;
+    }
+
+    printf("dlt_set_storageheader:        %8.1f ns per message\n", (double)plain / count);
+    printf("dlt_set_storageheader_cached: %8.1f ns per message (batch %d)\n", (double)cached / count, batch);
+    printf("Speedup:                      %8.1f\n", cached ? (double)plain / cached : 0);
+
+    return 0;
+}